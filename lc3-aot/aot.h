@@ -0,0 +1,89 @@
+#ifndef _AOT_H_
+#define _AOT_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "lc3.h"
+#include "cpu.h"
+#include "mem.h"
+#include "timer.h"
+#include "bank.h"
+#include "smp.h"
+#include "chan.h"
+#include "perf.h"
+
+// lc3-aot 生成的 C 代码与运行时之间的接口.
+//
+// 每个翻译入口 (基本块起点) 对应一段 [start, end] 的指令, end 是第一条控制转移指令.
+// 客户机改写了某段内的指令后该入口失效, 之后到达这里时改由解释器执行.
+struct aot_block {
+    uint16_t start;
+    uint16_t end;
+};
+
+// 由生成的代码提供
+extern const uint16_t aot_origin;
+extern const uint32_t aot_words;
+extern const uint16_t aot_image[];
+extern const struct aot_block aot_blocks[];
+extern const int aot_nblocks;
+int aot_run();
+
+// 由运行时提供
+extern uint16_t *aot_mem;
+extern uint8_t aot_entry[MEMORY_MAX];   /* 仍然有效的翻译入口 */
+extern uint8_t aot_code[MEMORY_MAX];    /* 有效入口覆盖的指令字 */
+extern int aot_smc;                     /* 刚刚有入口失效, 需要退回解释器 */
+extern uint64_t aot_fallbacks;
+
+// 与 mem_read/mem_write 中特殊处理的地址保持一致
+static inline int aot_device(uint16_t addr)
+{
+    return addr == MR_KBSR ||
+        (addr >= INTERRUPT_START && addr <= INTERRUPT_END) ||
+        (addr >= DEVICE_TIMER && addr < TIMER_END) ||
+        (addr >= DEVICE_BANK && addr < BANK_END) ||
+        (addr >= DEVICE_SMP && addr < SMP_END) ||
+        (addr >= DEVICE_CHAN && addr < CHAN_END) ||
+        (addr >= DEVICE_PERF && addr < PERF_END);
+}
+
+// pc 是下一条指令的地址, 设备访问时需要它计算已执行的指令数
+static inline uint16_t aot_load(uint16_t addr, uint16_t pc)
+{
+    if (aot_device(addr)) {
+        reg[R_PC] = pc;
+        return mem_read(addr);
+    }
+    PERF_COUNT(perf_loads);
+    return aot_mem[addr];
+}
+
+static inline void aot_store(uint16_t addr, uint16_t val, uint16_t pc)
+{
+    if (aot_code[addr] || aot_device(addr)) {
+        reg[R_PC] = pc;
+        mem_write(addr, val);
+    } else {
+        PERF_COUNT(perf_stores);
+        aot_mem[addr] = val;
+    }
+}
+
+#define AOT_SETCC(r) \
+    (reg[R_COND] = reg[r] == 0 ? FL_ZRO : ((reg[r] >> 15) ? FL_NEG : FL_POS))
+
+// 入口已失效时从这里退回解释器
+#define AOT_ENTRY(pc) \
+    if (!aot_entry[pc]) { reg[R_PC] = (pc); goto fallback; }
+
+// 存储之后检查是否改写了已翻译的代码
+#define AOT_SMC(next) \
+    if (aot_smc) { aot_smc = 0; reg[R_PC] = (next); goto fallback; }
+
+#define AOT_GOTO(pc, label) \
+    if (reg[R_PC] == (pc)) goto label;
+
+#endif
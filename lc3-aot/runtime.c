@@ -0,0 +1,215 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "aot.h"
+#include "virtio.h"
+#include "vhost.h"
+#include "interrupt.h"
+#include "bank.h"
+#include "disk.h"
+#include "dedup.h"
+
+// lc3-aot 生成的本地程序的运行时: 设备初始化, 装入镜像, 失效检测和解释器回退.
+// TRAP/键盘/virtio 的语义直接复用 lc3-vmm 的实现.
+
+uint16_t *aot_mem;
+uint8_t aot_entry[MEMORY_MAX];
+uint8_t aot_code[MEMORY_MAX];
+int aot_smc;
+uint64_t aot_fallbacks;
+
+static uint64_t aot_invalidations;
+
+static void aot_mark()
+{
+    int i;
+    uint32_t a;
+
+    memset(aot_code, 0, sizeof(aot_code));
+    for (i = 0; i < aot_nblocks; i++) {
+        if (!aot_entry[aot_blocks[i].start])
+            continue;
+        for (a = aot_blocks[i].start; a <= aot_blocks[i].end; a++) {
+            aot_code[a] = 1;
+        }
+    }
+}
+
+// 让包含 addr 的所有入口失效. 只在代码真正被改写时发生, 次数有限
+static void aot_invalidate(uint16_t addr)
+{
+    int i;
+
+    for (i = 0; i < aot_nblocks; i++) {
+        if (aot_blocks[i].start <= addr && addr <= aot_blocks[i].end) {
+            aot_entry[aot_blocks[i].start] = 0;
+        }
+    }
+    aot_mark();
+    aot_smc = 1;
+    aot_invalidations++;
+}
+
+static void aot_store_hook(uint16_t address, uint16_t val)
+{
+    if (aot_code[address] && aot_mem[address] != val) {
+        aot_invalidate(address);
+    }
+}
+
+static void handle_interrupt(int signal)
+{
+    restore_input_buffering();
+    printf("\n");
+    exit(-2);
+}
+
+static void usage(const char *prog)
+{
+    printf("Using: %s [options]\n", prog);
+    printf("  --vhost <socket>          use an out-of-process virtio backend\n");
+    printf("  --console <socket|fifo>   host side of the virtio console device\n");
+    printf("  --banks <n>               n banks of extended memory behind the xC000-xDFFF window\n");
+    printf("  --bank-file <file>        back the extended memory with file (sized by --banks or the file)\n");
+    printf("  --disk <file>             back the virtio block device with file\n");
+    printf("  --disk-cache <pages>      host page cache size for --disk, %d words per page (default %d)\n",
+            DISK_PAGE_WORDS, DISK_CACHE_PAGES);
+    printf("  --disk-writeback <ms>     write-back interval for --disk, 0 for write-through (default %d)\n",
+            DISK_WRITEBACK_MS);
+    printf("  --chan <file>             map the shared channel page in file at xF000-xF7FF\n");
+    printf("  --dedup <file>            share identical pages with other VMs through the page pool in file\n");
+    printf("  --smp <n>                 n virtual CPUs (up to %d), CPU 1 .. n-1 run in the interpreter\n", SMP_MAX);
+}
+
+int main(int argc, const char* argv[])
+{
+    const char *vhost_path = NULL;
+    const char *console_path = NULL;
+    const char *bank_path = NULL;
+    unsigned nbanks = 0;
+    const char *disk_path = NULL;
+    int disk_pages = 0, disk_writeback = -1;
+    int ncpus = 1;
+    const char *chan_path = NULL;
+    const char *dedup_path = NULL;
+    int ret = 0;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--vhost") && i + 1 < argc) {
+            vhost_path = argv[++i];
+        } else if (!strcmp(argv[i], "--console") && i + 1 < argc) {
+            console_path = argv[++i];
+        } else if (!strcmp(argv[i], "--banks") && i + 1 < argc) {
+            nbanks = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--bank-file") && i + 1 < argc) {
+            bank_path = argv[++i];
+        } else if (!strcmp(argv[i], "--disk") && i + 1 < argc) {
+            disk_path = argv[++i];
+        } else if (!strcmp(argv[i], "--disk-cache") && i + 1 < argc) {
+            disk_pages = strtol(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--disk-writeback") && i + 1 < argc) {
+            disk_writeback = strtol(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--chan") && i + 1 < argc) {
+            chan_path = argv[++i];
+        } else if (!strcmp(argv[i], "--dedup") && i + 1 < argc) {
+            dedup_path = argv[++i];
+        } else if (!strcmp(argv[i], "--smp") && i + 1 < argc) {
+            ncpus = strtol(argv[++i], NULL, 0);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    mem_init();
+    virtio_init();
+    timer_init();
+    mem_sync();
+
+    if ((nbanks || bank_path) && bank_init(bank_path, nbanks) < 0) {
+        printf("failed to set up extended memory: %s\n", bank_path ? bank_path : "memfd");
+        ret = 1;
+        goto exit;
+    }
+
+    if (disk_path && disk_open(disk_path, disk_pages, disk_writeback) < 0) {
+        printf("failed to open disk: %s\n", disk_path);
+        ret = 1;
+        goto exit;
+    }
+
+    if (chan_path && chan_attach(mem_addr(), chan_path) < 0) {
+        printf("failed to map channel: %s\n", chan_path);
+        ret = 1;
+        goto exit;
+    }
+
+    if (vconsole_init(console_path) < 0) {
+        printf("failed to open console: %s\n", console_path);
+        ret = 1;
+        goto exit;
+    }
+
+    if (vhost_path && vhost_connect(vhost_path) < 0) {
+        printf("failed to connect vhost backend: %s\n", vhost_path);
+        ret = 1;
+        goto exit;
+    }
+
+    aot_mem = mem_addr();
+    memcpy(aot_mem + aot_origin, aot_image, aot_words * sizeof(uint16_t));
+    for (i = 0; i < aot_nblocks; i++) {
+        aot_entry[aot_blocks[i].start] = 1;
+    }
+    aot_mark();
+    cpu_store_hook = aot_store_hook;
+
+    // 翻译后的代码直接写 aot_mem, 共享页同样由写时复制处理
+    if (dedup_path) {
+        if (nbanks || bank_path)
+            dedup_exclude(BANK_WINDOW_START, BANK_WINDOW_WORDS);
+        if (chan_path)
+            dedup_exclude(CHAN_WINDOW, CHAN_WORDS);
+        if (dedup_init(dedup_path) < 0) {
+            printf("failed to open page pool: %s\n", dedup_path);
+            ret = 1;
+            goto exit;
+        }
+    }
+
+    if (smp_init(ncpus) < 0) {
+        printf("bad --smp: %d (1 - %d)\n", ncpus, SMP_MAX);
+        ret = 1;
+        goto exit;
+    }
+
+    signal(SIGINT, handle_interrupt);
+    disable_input_buffering();
+
+    cpu_reset(0x3000);
+    aot_run();
+    smp_destroy();
+    dedup_destroy();
+
+    restore_input_buffering();
+
+    if (getenv("LC3_AOT_STATS")) {
+        fprintf(stderr, ">>> aot: %d blocks, %llu fallbacks, %llu invalidations\n", aot_nblocks,
+                (unsigned long long)aot_fallbacks, (unsigned long long)aot_invalidations);
+    }
+
+    dedup_report();
+
+exit:
+    vhost_disconnect();
+    vconsole_destroy();
+    bank_destroy();
+    disk_close();
+    mem_destroy();
+
+    return ret;
+}
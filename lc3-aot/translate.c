@@ -0,0 +1,425 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "lc3.h"
+#include "mem.h"
+#include "image.h"
+#include "sym.h"
+#include "opcodes.h"
+#include "aot.h"
+
+// LC-3 镜像到 C 的提前翻译器.
+//
+// 从 0x3000, 符号表中的地址, 以及镜像中指向镜像内部的常量 (lcc 的函数指针表)
+// 出发递归反汇编, 恢复控制流图. 每个基本块入口生成一个标号, 直接跳转在块结束
+// 后用 goto 连接; JMP/JSRR 等计算跳转通过 switch 分派, 目标不在翻译范围内时
+// 由运行时的解释器执行.
+
+#ifndef AOT_DIR
+#define AOT_DIR "."
+#endif
+
+#define AOT_MAX_BLOCKS MEMORY_MAX
+
+static uint16_t *memory;
+static uint16_t origin;
+static uint32_t words;
+
+static uint8_t is_code[MEMORY_MAX];
+static uint8_t is_entry[MEMORY_MAX];
+static uint16_t worklist[MEMORY_MAX];
+static int nwork;
+
+static struct aot_block blocks[AOT_MAX_BLOCKS];
+static int nblocks;
+
+// BR 的各种条件在翻译时共用一段代码, 条件位照样从指令中取
+#define BR_CASE(id, name, match, mask, fmt, flags) case INSN_##id:
+
+static inline int in_image(uint32_t addr)
+{
+    return addr >= origin && addr < (uint32_t)origin + words;
+}
+
+static void aot_root(uint16_t addr)
+{
+    if (in_image(addr) && !is_entry[addr]) {
+        is_entry[addr] = 1;
+        worklist[nwork++] = addr;
+    }
+}
+
+// 顺序反汇编到第一条控制转移指令, 并把后继加入工作表
+static void aot_block(uint16_t start)
+{
+    uint32_t a;
+    uint16_t instr, next;
+
+    for (a = start; in_image(a); a++) {
+        is_code[a] = 1;
+        instr = memory[a];
+        if (lc3_insn_end(instr))
+            break;
+    }
+    if (!in_image(a))
+        a--;
+
+    blocks[nblocks].start = start;
+    blocks[nblocks].end = a;
+    nblocks++;
+
+    instr = memory[a];
+    next = a + 1;
+    switch (lc3_decode(instr)) {
+        LC3_BR_INSNS(BR_CASE)
+            if ((instr >> 9) & 0x7)
+                aot_root(next + sign_extend(instr & 0x1FF, 9));
+            if (((instr >> 9) & 0x7) != 0x7)
+                aot_root(next);
+            break;
+        case INSN_JSR:
+            aot_root(next + sign_extend(instr & 0x7FF, 11));
+            aot_root(next);
+            break;
+        case INSN_JSRR:
+            aot_root(next);
+            break;
+        case INSN_TRAP:
+            if ((instr & 0xFF) != TRAP_HALT)
+                aot_root(next);
+            break;
+    }
+}
+
+static void aot_discover()
+{
+    const struct symbol *syms = sym_table();
+    int i, n = sym_count();
+    uint32_t a;
+
+    aot_root(0x3000);
+    for (i = 0; i < n; i++) {
+        aot_root(syms[i].addr);
+    }
+    // 没有 .sym 时也能找到通过函数指针表调用的代码
+    for (a = origin; in_image(a); a++) {
+        aot_root(memory[a]);
+    }
+
+    while (nwork > 0) {
+        aot_block(worklist[--nwork]);
+    }
+}
+
+static const char *aot_name(uint16_t addr)
+{
+    const struct symbol *s = sym_lookup(addr);
+    return s && s->addr == addr ? s->name : NULL;
+}
+
+static void emit_goto(FILE *out, uint16_t addr)
+{
+    if (in_image(addr) && is_entry[addr])
+        fprintf(out, "    AOT_GOTO(0x%04X, L_%04X)\n", addr, addr);
+}
+
+static void emit_instr(FILE *out, uint16_t pc)
+{
+    uint16_t instr = memory[pc];
+    uint16_t next = pc + 1;
+    uint16_t r0 = (instr >> 9) & 0x7;
+    uint16_t r1 = (instr >> 6) & 0x7;
+    uint16_t off9 = next + sign_extend(instr & 0x1FF, 9);
+    uint16_t off6 = sign_extend(instr & 0x3F, 6);
+    uint16_t target;
+    int insn = lc3_decode(instr);
+    char text[64];
+
+    lc3_disasm(pc, instr, text, sizeof(text));
+    fprintf(out, "    /* %04X: %s */\n", pc, text);
+
+    switch (insn) {
+        case INSN_ADD:
+        case INSN_AND:
+            fprintf(out, "    reg[%d] = reg[%d] %c reg[%d];", r0, r1,
+                    insn == INSN_ADD ? '+' : '&', instr & 0x7);
+            fprintf(out, " AOT_SETCC(%d);\n", r0);
+            break;
+        case INSN_ADDI:
+        case INSN_ANDI:
+            fprintf(out, "    reg[%d] = reg[%d] %c 0x%04X;", r0, r1,
+                    insn == INSN_ADDI ? '+' : '&', sign_extend(instr & 0x1F, 5));
+            fprintf(out, " AOT_SETCC(%d);\n", r0);
+            break;
+        case INSN_NOT:
+            fprintf(out, "    reg[%d] = ~reg[%d]; AOT_SETCC(%d);\n", r0, r1, r0);
+            break;
+        case INSN_LEA:
+            fprintf(out, "    reg[%d] = 0x%04X; AOT_SETCC(%d);\n", r0, off9, r0);
+            break;
+        case INSN_LD:
+            if (aot_device(off9)) {
+                fprintf(out, "    reg[%d] = aot_load(0x%04X, 0x%04X);", r0, off9, next);
+            } else {
+                fprintf(out, "    reg[%d] = M[0x%04X]; PERF_COUNT(perf_loads);", r0, off9);
+            }
+            fprintf(out, " AOT_SETCC(%d);\n", r0);
+            break;
+        case INSN_LDI:
+            fprintf(out, "    reg[%d] = aot_load(aot_load(0x%04X, 0x%04X), 0x%04X); AOT_SETCC(%d);\n",
+                    r0, off9, next, next, r0);
+            break;
+        case INSN_LDR:
+            fprintf(out, "    reg[%d] = aot_load(reg[%d] + 0x%04X, 0x%04X); AOT_SETCC(%d);\n",
+                    r0, r1, off6, next, r0);
+            break;
+        case INSN_ST:
+            // 写普通数据直接访问内存; 可能是代码或设备时走运行时
+            if (aot_device(off9) || is_code[off9]) {
+                fprintf(out, "    aot_store(0x%04X, reg[%d], 0x%04X); AOT_SMC(0x%04X)\n", off9, r0, next, next);
+            } else {
+                fprintf(out, "    M[0x%04X] = reg[%d]; PERF_COUNT(perf_stores);\n", off9, r0);
+            }
+            break;
+        case INSN_STI:
+            fprintf(out, "    aot_store(aot_load(0x%04X, 0x%04X), reg[%d], 0x%04X); AOT_SMC(0x%04X)\n",
+                    off9, next, r0, next, next);
+            break;
+        case INSN_STR:
+            fprintf(out, "    aot_store(reg[%d] + 0x%04X, reg[%d], 0x%04X); AOT_SMC(0x%04X)\n",
+                    r1, off6, r0, next, next);
+            break;
+        LC3_BR_INSNS(BR_CASE)
+            switch (r0) {
+                case 0:
+                    fprintf(out, "    reg[R_PC] = 0x%04X;\n", next);
+                    break;
+                case 7:
+                    fprintf(out, "    reg[R_PC] = 0x%04X; PERF_COUNT(perf_branches);\n", off9);
+                    break;
+                default:
+                    fprintf(out, "    reg[R_PC] = (reg[R_COND] & %d) ? 0x%04X : 0x%04X;", r0, off9, next);
+                    fprintf(out, " if (perf_running) perf_branches += (reg[R_COND] & %d) != 0;\n", r0);
+                    break;
+            }
+            fprintf(out, "    block_end(0x%04X);\n", pc);
+            if (r0)
+                emit_goto(out, off9);
+            if (r0 != 7)
+                emit_goto(out, next);
+            fprintf(out, "    goto dispatch;\n");
+            break;
+        case INSN_JMP:
+            fprintf(out, "    reg[R_PC] = reg[%d]; PERF_COUNT(perf_branches);\n", r1);
+            fprintf(out, "    block_end(0x%04X);\n", pc);
+            fprintf(out, "    goto dispatch;\n");
+            break;
+        case INSN_JSR:
+            target = next + sign_extend(instr & 0x7FF, 11);
+            fprintf(out, "    reg[R_R7] = 0x%04X; reg[R_PC] = 0x%04X; PERF_COUNT(perf_branches);\n", next, target);
+            fprintf(out, "    block_end(0x%04X);\n", pc);
+            emit_goto(out, target);
+            fprintf(out, "    goto dispatch;\n");
+            break;
+        case INSN_JSRR:
+            fprintf(out, "    reg[R_PC] = reg[%d]; reg[R_R7] = 0x%04X; PERF_COUNT(perf_branches);\n", r1, next);
+            fprintf(out, "    block_end(0x%04X);\n", pc);
+            fprintf(out, "    goto dispatch;\n");
+            break;
+        case INSN_TRAP:
+            fprintf(out, "    reg[R_R7] = 0x%04X; reg[R_PC] = 0x%04X;\n", next, next);
+            fprintf(out, "    if (!cpu_trap(0x%02X)) { block_end(0x%04X); return 0; }\n", instr & 0xFF, pc);
+            fprintf(out, "    block_end(0x%04X);\n", pc);
+            emit_goto(out, next);
+            fprintf(out, "    goto dispatch;\n");
+            break;
+        case INSN_RTI:
+            fprintf(out, "    reg[R_PC] = 0x%04X; cpu_rti();\n", next);
+            fprintf(out, "    block_end(0x%04X);\n", pc);
+            fprintf(out, "    goto dispatch;\n");
+            break;
+        case INSN_RES:
+            fprintf(out, "    abort(); /* RES 未使用 */\n");
+            break;
+    }
+}
+
+static void emit(FILE *out, const char *image)
+{
+    const char *name;
+    uint32_t a;
+    int i;
+
+    fprintf(out, "/* generated by lc3-aot from %s, do not edit */\n", image);
+    fprintf(out, "#include \"aot.h\"\n\n");
+
+    fprintf(out, "const uint16_t aot_origin = 0x%04X;\n", origin);
+    fprintf(out, "const uint32_t aot_words = %u;\n", words);
+    fprintf(out, "const uint16_t aot_image[] = {");
+    for (a = 0; a < words; a++) {
+        fprintf(out, "%s0x%04X,", a % 8 ? " " : "\n    ", memory[origin + a]);
+    }
+    fprintf(out, "\n};\n\n");
+
+    fprintf(out, "const int aot_nblocks = %d;\n", nblocks);
+    fprintf(out, "const struct aot_block aot_blocks[] = {");
+    for (i = 0; i < nblocks; i++) {
+        fprintf(out, "%s{0x%04X, 0x%04X},", i % 4 ? " " : "\n    ", blocks[i].start, blocks[i].end);
+    }
+    fprintf(out, "\n};\n\n");
+
+    fprintf(out, "int aot_run()\n{\n");
+    fprintf(out, "    uint16_t *M = aot_mem;\n\n");
+    fprintf(out, "    goto dispatch;\n\n");
+
+    for (a = origin; in_image(a); a++) {
+        if (!is_code[a])
+            continue;
+        if (is_entry[a]) {
+            name = aot_name(a);
+            if (name)
+                fprintf(out, "    /* %s */\n", name);
+            fprintf(out, "L_%04X:\n    AOT_ENTRY(0x%04X)\n", a, a);
+        }
+        emit_instr(out, a);
+        // 镜像末尾没有控制转移指令时交给解释器继续
+        if (!lc3_insn_end(memory[a]) && (!in_image(a + 1) || !is_code[a + 1])) {
+            fprintf(out, "    reg[R_PC] = 0x%04X;\n    goto fallback;\n", (uint16_t)(a + 1));
+        }
+    }
+
+    fprintf(out, "\ndispatch:\n    switch (reg[R_PC]) {\n");
+    for (a = origin; in_image(a); a++) {
+        if (is_entry[a])
+            fprintf(out, "        case 0x%04X: goto L_%04X;\n", a, a);
+    }
+    fprintf(out, "    }\n\n");
+    fprintf(out, "fallback:\n");
+    fprintf(out, "    aot_fallbacks++;\n");
+    fprintf(out, "    if (!cpu_run_until(aot_entry))\n        return 0;\n");
+    fprintf(out, "    goto dispatch;\n}\n");
+}
+
+static const char *aot_dir()
+{
+    const char *dir = getenv("LC3_AOT_DIR");
+    return dir ? dir : AOT_DIR;
+}
+
+static int aot_compile(const char *src, const char *out)
+{
+    char inc_aot[4096], inc_vmm[4096], lib[4096];
+    const char *cc = getenv("CC");
+    int status;
+    pid_t pid;
+
+    snprintf(inc_aot, sizeof(inc_aot), "-I%s", aot_dir());
+    snprintf(inc_vmm, sizeof(inc_vmm), "-I%s/../lc3-vmm", aot_dir());
+    snprintf(lib, sizeof(lib), "%s/libaotrt.a", aot_dir());
+
+    pid = fork();
+    if (pid < 0)
+        return -1;
+
+    if (pid == 0) {
+        cc = cc ? cc : "cc";
+        execlp(cc, cc, "-O2", "-w", "-D_GNU_SOURCE", inc_aot, inc_vmm, src, lib,
+                "-lpthread", "-o", out, (char *)NULL);
+        _exit(127);
+    }
+
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        return -1;
+    return 0;
+}
+
+static void usage()
+{
+    printf("Using: lc3-aot [-o output] image-file\n");
+    printf("  image-file may be an .obj (with its .sym), or a .c / .asm source\n");
+    printf("  output ending in .c only writes the translated C, otherwise it is compiled\n");
+    printf("  with $CC and the runtime into a native executable\n");
+}
+
+int main(int argc, const char* argv[])
+{
+    const char *image = NULL;
+    const char *output = NULL;
+    char path[4096];
+    char tmp[] = "/tmp/lc3-aot-XXXXXX.c";
+    size_t len;
+    FILE *out;
+    int fd, ret = 0;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+            output = argv[++i];
+        } else if (argv[i][0] == '-') {
+            usage();
+            return 2;
+        } else if (!image) {
+            image = argv[i];
+        }
+    }
+
+    if (!image) {
+        usage();
+        return 2;
+    }
+
+    if (!output) {
+        // 默认输出与镜像同名, 去掉扩展名
+        snprintf(path, sizeof(path), "%s", image);
+        if (strrchr(path, '.') && strrchr(path, '.') > strrchr(path, '/'))
+            *strrchr(path, '.') = '\0';
+        output = path;
+    }
+
+    mem_init();
+    if (!read_image(image)) {
+        printf("failed to load image: %s\n", image);
+        ret = 1;
+        goto exit;
+    }
+    memory = mem_addr();
+    image_extent(&origin, &words);
+
+    aot_discover();
+
+    len = strlen(output);
+    if (len > 2 && !strcmp(output + len - 2, ".c")) {
+        out = fopen(output, "w");
+        if (!out) {
+            printf("failed to open %s\n", output);
+            ret = 1;
+            goto exit;
+        }
+        emit(out, image);
+        fclose(out);
+        goto exit;
+    }
+
+    fd = mkstemps(tmp, 2);
+    if (fd < 0 || !(out = fdopen(fd, "w"))) {
+        printf("failed to create %s\n", tmp);
+        ret = 1;
+        goto exit;
+    }
+    emit(out, image);
+    fclose(out);
+
+    if (aot_compile(tmp, output) < 0) {
+        printf("failed to compile %s\n", tmp);
+        ret = 1;
+    }
+    unlink(tmp);
+
+exit:
+    mem_destroy();
+    return ret;
+}
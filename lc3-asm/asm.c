@@ -0,0 +1,835 @@
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "asm.h"
+
+int asm_peep_removed;
+
+// 上一个输出的项, 决定标号处是否开始新片段
+enum {
+    ST_NONE,   /* 片段为空 */
+    ST_FALL,   /* 会顺序执行到下一条的指令 */
+    ST_STOP,   /* 无条件跳转/返回 */
+    ST_DATA,   /* .FILL/.BLKW/.STRINGZ */
+};
+
+struct asm_frag {
+    uint32_t flags;
+    uint16_t *words;
+    int size, cap;
+};
+
+struct asm_ctx {
+    const char *path;
+    int line;
+    int errors;
+
+    uint32_t origin;
+    uint32_t flags;
+
+    struct asm_frag *frags;
+    int nfrags, capfrags;
+    int cur;    /* 当前代码片段 */
+    int gcur;   /* 当前全局数据表项 */
+    int state;
+
+    char **pending;  /* 等待下一项确定所在片段的标号 */
+    int npending, cappending;
+
+    struct obj_sym *syms;
+    int nsyms, capsyms;
+    struct obj_reloc *relocs;
+    int nrelocs, caprelocs;
+    char *strtab;
+    int strsize, capstr;
+
+    char **exports;
+    int nexports, capexports;
+
+    // 数字 PC 偏移的目标, 汇编结束后检查是否越出所在片段
+    struct obj_reloc *numeric;
+    int nnumeric, capnumeric;
+};
+
+#define ASM_GROW(ptr, n, cap) do { \
+        if ((n) == (cap)) { \
+            (cap) = (cap) ? (cap) * 2 : 64; \
+            (ptr) = realloc((ptr), (cap) * sizeof(*(ptr))); \
+        } \
+    } while (0)
+
+static void asm_error(struct asm_ctx *ctx, const char *msg, const char *arg)
+{
+    printf("%s:%d: error: %s%s%s\n", ctx->path, ctx->line, msg, arg ? ": " : "", arg ? arg : "");
+    ctx->errors++;
+}
+
+static uint32_t asm_str(struct asm_ctx *ctx, const char *s)
+{
+    int len = strlen(s) + 1;
+    uint32_t off;
+
+    while (ctx->strsize + len > ctx->capstr) {
+        ctx->capstr = ctx->capstr ? ctx->capstr * 2 : 4096;
+        ctx->strtab = realloc(ctx->strtab, ctx->capstr);
+    }
+    off = ctx->strsize;
+    memcpy(ctx->strtab + off, s, len);
+    ctx->strsize += len;
+    return off;
+}
+
+static int asm_new_frag(struct asm_ctx *ctx, uint32_t flags)
+{
+    ASM_GROW(ctx->frags, ctx->nfrags, ctx->capfrags);
+    memset(&ctx->frags[ctx->nfrags], 0, sizeof(struct asm_frag));
+    ctx->frags[ctx->nfrags].flags = flags;
+    return ctx->nfrags++;
+}
+
+static void asm_add_sym(struct asm_ctx *ctx, const char *name, int frag, uint32_t flags)
+{
+    struct obj_sym *sym;
+
+    ASM_GROW(ctx->syms, ctx->nsyms, ctx->capsyms);
+    sym = &ctx->syms[ctx->nsyms++];
+    sym->name = asm_str(ctx, name);
+    sym->frag = frag;
+    sym->offset = ctx->frags[frag].size;
+    sym->flags = flags;
+}
+
+static int asm_is_label(const char *s)
+{
+    if (!isalpha((unsigned char)*s) && *s != '_')
+        return 0;
+    while (*++s) {
+        if (!isalnum((unsigned char)*s) && *s != '_')
+            return 0;
+    }
+    return 1;
+}
+
+// #十进制, x十六进制, 0x十六进制, 以及不带前缀的十进制
+static int asm_number(const char *s, int32_t *out)
+{
+    const char *p = s;
+    int base = 10, neg = 0;
+    char *end;
+    long v;
+
+    if (*p == '#') {
+        p++;
+    } else if ((*p == 'x' || *p == 'X') && p[1]) {
+        p++;
+        base = 16;
+    } else if (p[0] == '0' && (p[1] == 'x' || p[1] == 'X') && p[2]) {
+        p += 2;
+        base = 16;
+    } else if (!isdigit((unsigned char)*p) && !(*p == '-' && isdigit((unsigned char)p[1]))) {
+        return 0;
+    }
+    if (*p == '-') {
+        neg = 1;
+        p++;
+    }
+    if (!*p)
+        return 0;
+    v = strtol(p, &end, base);
+    if (*end || v > 0XFFFF)
+        return 0;
+    *out = neg ? -v : v;
+    return 1;
+}
+
+// label, label+n 或 label-n. 返回 0 表示不是符号引用
+static int asm_symref(const char *s, char *name, int32_t *addend)
+{
+    const char *op = strpbrk(s, "+-");
+    size_t len = op ? (size_t)(op - s) : strlen(s);
+
+    *addend = 0;
+    if (len == 0 || len >= ASM_LINE_MAX)
+        return 0;
+    memcpy(name, s, len);
+    name[len] = '\0';
+    if (!asm_is_label(name))
+        return 0;
+    if (op && (!isdigit((unsigned char)op[1]) || !asm_number(op + 1, addend)))
+        return 0;
+    if (op && *op == '-')
+        *addend = -*addend;
+    return 1;
+}
+
+static void asm_add_reloc(struct asm_ctx *ctx, int frag, uint32_t type, const char *ref)
+{
+    struct obj_reloc *reloc;
+    char name[ASM_LINE_MAX];
+    int32_t addend;
+
+    if (!asm_symref(ref, name, &addend)) {
+        asm_error(ctx, "bad operand", ref);
+        return;
+    }
+
+    ASM_GROW(ctx->relocs, ctx->nrelocs, ctx->caprelocs);
+    reloc = &ctx->relocs[ctx->nrelocs++];
+    reloc->frag = frag;
+    reloc->offset = ctx->frags[frag].size;
+    reloc->type = type;
+    reloc->sym = asm_str(ctx, name);
+    reloc->addend = addend;
+}
+
+static void asm_put(struct asm_ctx *ctx, int frag, uint16_t word)
+{
+    struct asm_frag *f = &ctx->frags[frag];
+
+    ASM_GROW(f->words, f->size, f->cap);
+    f->words[f->size++] = word;
+}
+
+// 标号处是否开始新片段: 前一项是无条件跳转, 或者从数据进入代码
+static int asm_code_frag(struct asm_ctx *ctx, int instr)
+{
+    int i;
+
+    if (ctx->cur < 0 ||
+            (ctx->npending && ctx->frags[ctx->cur].size > 0 &&
+             (ctx->state == ST_STOP || (ctx->state == ST_DATA && instr)))) {
+        ctx->cur = asm_new_frag(ctx, 0);
+    }
+
+    for (i = 0; i < ctx->npending; i++) {
+        asm_add_sym(ctx, ctx->pending[i], ctx->cur, 0);
+        free(ctx->pending[i]);
+    }
+    ctx->npending = 0;
+    return ctx->cur;
+}
+
+static int asm_reg(const char *s)
+{
+    if ((s[0] == 'R' || s[0] == 'r') && s[1] >= '0' && s[1] <= '7' && !s[2])
+        return s[1] - '0';
+    return -1;
+}
+
+static int asm_imm(struct asm_ctx *ctx, const char *s, int bits, int is_signed)
+{
+    int32_t v = 0;
+    int32_t lo = is_signed ? -(1 << (bits - 1)) : 0;
+    int32_t hi = is_signed ? (1 << (bits - 1)) - 1 : (1 << bits) - 1;
+
+    if (!asm_number(s, &v)) {
+        asm_error(ctx, "bad number", s);
+        return 0;
+    }
+    if (v < lo || v > hi) {
+        asm_error(ctx, "immediate out of range", s);
+        return 0;
+    }
+    return v & ((1 << bits) - 1);
+}
+
+// PC 相对操作数: 标号生成重定位, 数字直接编码并记录目标供片段检查
+static uint16_t asm_pcrel(struct asm_ctx *ctx, int frag, const char *s, int bits)
+{
+    int32_t v;
+    struct obj_reloc *n;
+
+    if (asm_number(s, &v)) {
+        if (v < -(1 << (bits - 1)) || v > (1 << (bits - 1)) - 1) {
+            asm_error(ctx, "offset out of range", s);
+            return 0;
+        }
+        ASM_GROW(ctx->numeric, ctx->nnumeric, ctx->capnumeric);
+        n = &ctx->numeric[ctx->nnumeric++];
+        n->frag = frag;
+        n->offset = ctx->frags[frag].size + 1 + v;
+        return v & ((1 << bits) - 1);
+    }
+    asm_add_reloc(ctx, frag, bits == 9 ? RELOC_PC9 : RELOC_PC11, s);
+    return 0;
+}
+
+// 把一行拆成记号, 逗号和空白为分隔符, 引号内的字符串作为一个记号 (保留引号)
+int asm_tokenize(char *line, char *tok[])
+{
+    char *p = line;
+    int n = 0;
+
+    while (*p && n < ASM_TOKENS) {
+        while (*p && (isspace((unsigned char)*p) || *p == ','))
+            p++;
+        if (!*p || *p == ';')
+            break;
+        tok[n++] = p;
+        if (*p == '"') {
+            for (p++; *p && *p != '"'; p++) {
+                if (*p == '\\' && p[1])
+                    p++;
+            }
+            if (*p)
+                p++;
+        } else {
+            while (*p && !isspace((unsigned char)*p) && *p != ',' && *p != ';')
+                p++;
+        }
+        if (*p == ';') {
+            *p = '\0';
+            break;
+        }
+        if (*p)
+            *p++ = '\0';
+    }
+    return n;
+}
+
+enum {
+    OP_ADD, OP_NOT, OP_BR, OP_JMP, OP_RET, OP_JSR, OP_JSRR, OP_PC9,
+    OP_BASE, OP_RTI, OP_TRAP, OP_FIXED,
+};
+
+static const struct {
+    const char *name;
+    int kind;
+    uint16_t code;
+} asm_ops[] = {
+    { "ADD",   OP_ADD,   0X1000 },
+    { "AND",   OP_ADD,   0X5000 },
+    { "NOT",   OP_NOT,   0X903F },
+    { "JMP",   OP_JMP,   0XC000 },
+    { "RET",   OP_RET,   0XC1C0 },
+    { "JSR",   OP_JSR,   0X4800 },
+    { "JSRR",  OP_JSRR,  0X4000 },
+    { "LD",    OP_PC9,   0X2000 },
+    { "LDI",   OP_PC9,   0XA000 },
+    { "LEA",   OP_PC9,   0XE000 },
+    { "ST",    OP_PC9,   0X3000 },
+    { "STI",   OP_PC9,   0XB000 },
+    { "LDR",   OP_BASE,  0X6000 },
+    { "STR",   OP_BASE,  0X7000 },
+    { "RTI",   OP_RTI,   0X8000 },
+    { "TRAP",  OP_TRAP,  0XF000 },
+    { "GETC",  OP_FIXED, 0XF020 },
+    { "OUT",   OP_FIXED, 0XF021 },
+    { "PUTS",  OP_FIXED, 0XF022 },
+    { "IN",    OP_FIXED, 0XF023 },
+    { "PUTSP", OP_FIXED, 0XF024 },
+    { "HALT",  OP_FIXED, 0XF025 },
+};
+
+// BR 后面是 n/z/p 的任意组合, 不带条件等同于 BRnzp. 返回 nzp, 不是 BR 时返回 -1
+static int asm_br(const char *s)
+{
+    int nzp = 0;
+
+    if (strncasecmp(s, "BR", 2) != 0)
+        return -1;
+    for (s += 2; *s; s++) {
+        switch (tolower((unsigned char)*s)) {
+            case 'n': nzp |= 4; break;
+            case 'z': nzp |= 2; break;
+            case 'p': nzp |= 1; break;
+            default: return -1;
+        }
+    }
+    return nzp ? nzp : 7;
+}
+
+static int asm_op(const char *s)
+{
+    int i;
+
+    for (i = 0; i < (int)(sizeof(asm_ops) / sizeof(asm_ops[0])); i++) {
+        if (!strcasecmp(s, asm_ops[i].name))
+            return i;
+    }
+    return asm_br(s) >= 0 ? OP_BR + 1000 : -1;
+}
+
+int asm_is_instr(const char *s)
+{
+    return asm_op(s) >= 0;
+}
+
+static int asm_nargs(struct asm_ctx *ctx, int n, int want, const char *op)
+{
+    if (n != want) {
+        asm_error(ctx, "wrong number of operands", op);
+        return 0;
+    }
+    return 1;
+}
+
+static int asm_regarg(struct asm_ctx *ctx, const char *s)
+{
+    int r = asm_reg(s);
+
+    if (r < 0) {
+        asm_error(ctx, "bad register", s);
+        return 0;
+    }
+    return r;
+}
+
+// 指令. tok[0] 为操作码
+static void asm_instr(struct asm_ctx *ctx, char *tok[], int n)
+{
+    int op = asm_op(tok[0]);
+    int kind, frag, state = ST_FALL, r;
+    uint16_t word;
+
+    if (op < 0) {
+        asm_error(ctx, "unknown instruction", tok[0]);
+        return;
+    }
+
+    frag = asm_code_frag(ctx, 1);
+    if (op >= 1000) {
+        r = asm_br(tok[0]);
+        if (!asm_nargs(ctx, n, 2, tok[0]))
+            return;
+        word = (r << 9) | asm_pcrel(ctx, frag, tok[1], 9);
+        if (r == 7)
+            state = ST_STOP;
+        asm_put(ctx, frag, word);
+        ctx->state = state;
+        return;
+    }
+
+    kind = asm_ops[op].kind;
+    word = asm_ops[op].code;
+    switch (kind) {
+        case OP_ADD:
+            if (!asm_nargs(ctx, n, 4, tok[0]))
+                return;
+            word |= asm_regarg(ctx, tok[1]) << 9 | asm_regarg(ctx, tok[2]) << 6;
+            if ((r = asm_reg(tok[3])) >= 0) {
+                word |= r;
+            } else {
+                word |= 0X20 | asm_imm(ctx, tok[3], 5, 1);
+            }
+            break;
+        case OP_NOT:
+            if (!asm_nargs(ctx, n, 3, tok[0]))
+                return;
+            word |= asm_regarg(ctx, tok[1]) << 9 | asm_regarg(ctx, tok[2]) << 6;
+            break;
+        case OP_JMP:
+        case OP_JSRR:
+            if (!asm_nargs(ctx, n, 2, tok[0]))
+                return;
+            word |= asm_regarg(ctx, tok[1]) << 6;
+            if (kind == OP_JMP)
+                state = ST_STOP;
+            break;
+        case OP_RET:
+        case OP_RTI:
+            if (!asm_nargs(ctx, n, 1, tok[0]))
+                return;
+            state = ST_STOP;
+            break;
+        case OP_JSR:
+            if (!asm_nargs(ctx, n, 2, tok[0]))
+                return;
+            word |= asm_pcrel(ctx, frag, tok[1], 11);
+            break;
+        case OP_PC9:
+            if (!asm_nargs(ctx, n, 3, tok[0]))
+                return;
+            word |= asm_regarg(ctx, tok[1]) << 9;
+            word |= asm_pcrel(ctx, frag, tok[2], 9);
+            break;
+        case OP_BASE:
+            if (!asm_nargs(ctx, n, 4, tok[0]))
+                return;
+            word |= asm_regarg(ctx, tok[1]) << 9 | asm_regarg(ctx, tok[2]) << 6;
+            word |= asm_imm(ctx, tok[3], 6, 1);
+            break;
+        case OP_TRAP:
+            if (!asm_nargs(ctx, n, 2, tok[0]))
+                return;
+            word |= asm_imm(ctx, tok[1], 8, 0);
+            break;
+        case OP_FIXED:
+            if (!asm_nargs(ctx, n, 1, tok[0]))
+                return;
+            break;
+    }
+    asm_put(ctx, frag, word);
+    ctx->state = state;
+}
+
+// .STRINGZ 的字符串, 支持 lc3as 的转义
+static int asm_string(struct asm_ctx *ctx, int frag, const char *s)
+{
+    int len = strlen(s);
+
+    if (len < 2 || s[0] != '"' || s[len - 1] != '"') {
+        asm_error(ctx, "bad string", s);
+        return -1;
+    }
+    for (s++; *s != '"'; s++) {
+        int c = (unsigned char)*s;
+
+        if (c == '\\') {
+            switch (*++s) {
+                case 'n': c = '\n'; break;
+                case 't': c = '\t'; break;
+                case 'r': c = '\r'; break;
+                case 'e': c = 27; break;
+                case '0': c = 0; break;
+                default: c = (unsigned char)*s; break;
+            }
+        }
+        asm_put(ctx, frag, c);
+    }
+    asm_put(ctx, frag, 0);
+    return 0;
+}
+
+// 数据伪指令, frag < 0 时放在当前代码片段
+static void asm_data(struct asm_ctx *ctx, int frag, char *tok[], int n)
+{
+    int32_t v;
+    int i;
+
+    if (!strcasecmp(tok[0], ".FILL")) {
+        if (!asm_nargs(ctx, n, 2, tok[0]))
+            return;
+        if (frag < 0)
+            frag = asm_code_frag(ctx, 0);
+        if (asm_number(tok[1], &v)) {
+            asm_put(ctx, frag, v);
+        } else {
+            asm_add_reloc(ctx, frag, RELOC_ABS16, tok[1]);
+            asm_put(ctx, frag, 0);
+        }
+    } else if (!strcasecmp(tok[0], ".BLKW")) {
+        if (n < 2 || n > 3 || !asm_number(tok[1], &v) || v < 0) {
+            asm_error(ctx, "bad .BLKW", n > 1 ? tok[1] : NULL);
+            return;
+        }
+        if (frag < 0)
+            frag = asm_code_frag(ctx, 0);
+        for (i = 0; i < v; i++) {
+            asm_put(ctx, frag, 0);
+        }
+    } else if (!strcasecmp(tok[0], ".STRINGZ")) {
+        // rcc 生成的 .STRINGZ 在字符串前带有长度
+        if (n == 3 && asm_number(tok[1], &v)) {
+            tok[1] = tok[2];
+            n = 2;
+        }
+        if (!asm_nargs(ctx, n, 2, tok[0]))
+            return;
+        if (frag < 0)
+            frag = asm_code_frag(ctx, 0);
+        asm_string(ctx, frag, tok[1]);
+    } else {
+        asm_error(ctx, "unknown directive", tok[0]);
+        return;
+    }
+    if (!(ctx->frags[frag].flags & FRAG_GDATA))
+        ctx->state = ST_DATA;
+}
+
+// LC3_GFLAG name LC3_GFLAG .FILL/.BLKW/.STRINGZ ... 开始一个新表项,
+// LC3_GFLAG .FILL ... 接在上一个表项后面 (数组的后续元素)
+static void asm_gflag(struct asm_ctx *ctx, char *tok[], int n)
+{
+    int i = 1;
+
+    if (n > 1 && tok[1][0] != '.') {
+        if (n < 4 || strcmp(tok[2], "LC3_GFLAG")) {
+            asm_error(ctx, "bad LC3_GFLAG", NULL);
+            return;
+        }
+        ctx->gcur = asm_new_frag(ctx, FRAG_GDATA);
+        asm_add_sym(ctx, tok[1], ctx->gcur, SYM_GDATA | SYM_GLOBAL);
+        i = 3;
+    }
+    if (n <= i) {
+        asm_error(ctx, "bad LC3_GFLAG", NULL);
+        return;
+    }
+    if (ctx->gcur < 0) {
+        asm_error(ctx, "LC3_GFLAG continuation without entry", NULL);
+        return;
+    }
+    asm_data(ctx, ctx->gcur, tok + i, n - i);
+}
+
+static void asm_tokens(struct asm_ctx *ctx, char *tok[], int n)
+{
+    int32_t v;
+    int frag, r;
+
+    if (!strcmp(tok[0], "LC3_GFLAG")) {
+        asm_gflag(ctx, tok, n);
+        return;
+    }
+
+    if (tok[0][0] == '.') {
+        if (!strcasecmp(tok[0], ".ORIG")) {
+            if (n != 2 || !asm_number(tok[1], &v)) {
+                asm_error(ctx, "bad .ORIG", n > 1 ? tok[1] : NULL);
+            } else if (ctx->origin == OBJ_NO_ORIGIN) {
+                ctx->origin = v & 0XFFFF;
+            }
+        } else if (!strcasecmp(tok[0], ".global")) {
+            for (r = 1; r < n; r++) {
+                ASM_GROW(ctx->exports, ctx->nexports, ctx->capexports);
+                ctx->exports[ctx->nexports++] = strdup(tok[r]);
+            }
+        } else if (!strcasecmp(tok[0], ".extern") || !strcasecmp(tok[0], ".EXTERNAL")) {
+            // 未定义的符号在链接时查找, 不需要声明
+        } else if (!strcasecmp(tok[0], ".LC3GLOBAL")) {
+            // rcc 对 switch 跳转表会生成 .LC3GLOBAL table-1 reg
+            if (n != 3 || (r = asm_reg(tok[2])) < 0) {
+                // rcc 用不带 R 的寄存器号
+                if (n != 3 || !asm_number(tok[2], &v) || v < 0 || v > 7) {
+                    asm_error(ctx, "bad .LC3GLOBAL", NULL);
+                    return;
+                }
+                r = v;
+            }
+            frag = asm_code_frag(ctx, 1);
+            asm_add_reloc(ctx, frag, RELOC_GADDR, tok[1]);
+            asm_put(ctx, frag, 0X1000 | r << 9 | 4 << 6 | 0X20);
+            ctx->state = ST_FALL;
+            ctx->flags |= OBJ_F_LCC;
+        } else {
+            asm_data(ctx, -1, tok, n);
+        }
+        return;
+    }
+
+    // 第一个记号不是指令时为标号
+    if (asm_op(tok[0]) < 0) {
+        if (!asm_is_label(tok[0])) {
+            asm_error(ctx, "bad label", tok[0]);
+            return;
+        }
+        ASM_GROW(ctx->pending, ctx->npending, ctx->cappending);
+        ctx->pending[ctx->npending++] = strdup(tok[0]);
+        if (n > 1)
+            asm_tokens(ctx, tok + 1, n - 1);
+        return;
+    }
+    asm_instr(ctx, tok, n);
+}
+
+static void asm_line(struct asm_ctx *ctx, char *line)
+{
+    char *tok[ASM_TOKENS];
+    int n = asm_tokenize(line, tok);
+
+    if (n > 0)
+        asm_tokens(ctx, tok, n);
+}
+
+static int asm_reloc_cmp(const void *a, const void *b)
+{
+    const struct obj_reloc *x = a, *y = b;
+
+    if (x->frag != y->frag)
+        return x->frag < y->frag ? -1 : 1;
+    return x->offset < y->offset ? -1 : x->offset > y->offset;
+}
+
+// 合并各片段的字, 生成 lc3_obj
+static void asm_finish(struct asm_ctx *ctx, struct lc3_obj *obj)
+{
+    uint32_t nwords = 0;
+    int i, j;
+
+    // 文件末尾的标号
+    if (ctx->npending)
+        asm_code_frag(ctx, 0);
+
+    for (i = 0; i < ctx->nnumeric; i++) {
+        if (ctx->numeric[i].offset > (uint32_t)ctx->frags[ctx->numeric[i].frag].size) {
+            ctx->flags |= OBJ_F_NOGC;
+        }
+    }
+
+    for (i = 0; i < ctx->nexports; i++) {
+        for (j = 0; j < ctx->nsyms; j++) {
+            if (!strcmp(ctx->strtab + ctx->syms[j].name, ctx->exports[i]))
+                ctx->syms[j].flags |= SYM_GLOBAL;
+        }
+        free(ctx->exports[i]);
+    }
+
+    memset(obj, 0, sizeof(*obj));
+    obj->path = ctx->path;
+    obj->hdr.magic = OBJ_MAGIC;
+    obj->hdr.version = OBJ_VERSION;
+    obj->hdr.origin = ctx->origin;
+    obj->hdr.flags = ctx->flags;
+    obj->hdr.nfrags = ctx->nfrags;
+
+    obj->frags = calloc(ctx->nfrags + 1, sizeof(struct obj_frag));
+    for (i = 0; i < ctx->nfrags; i++) {
+        obj->frags[i].start = nwords;
+        obj->frags[i].size = ctx->frags[i].size;
+        obj->frags[i].flags = ctx->frags[i].flags;
+        nwords += ctx->frags[i].size;
+    }
+    obj->hdr.nwords = nwords;
+    obj->words = malloc((nwords + 1) * sizeof(uint16_t));
+    for (i = 0; i < ctx->nfrags; i++) {
+        memcpy(obj->words + obj->frags[i].start, ctx->frags[i].words,
+                ctx->frags[i].size * sizeof(uint16_t));
+        free(ctx->frags[i].words);
+    }
+
+    qsort(ctx->relocs, ctx->nrelocs, sizeof(struct obj_reloc), asm_reloc_cmp);
+    obj->hdr.nsyms = ctx->nsyms;
+    obj->syms = ctx->syms;
+    obj->hdr.nrelocs = ctx->nrelocs;
+    obj->relocs = ctx->relocs;
+    obj->hdr.strsize = ctx->strsize;
+    obj->strtab = ctx->strtab;
+
+    free(ctx->frags);
+    free(ctx->pending);
+    free(ctx->exports);
+    free(ctx->numeric);
+}
+
+int asm_file(const char *path, int flags, struct lc3_obj *obj)
+{
+    struct asm_ctx ctx;
+    char buf[ASM_LINE_MAX];
+    char **lines = NULL;
+    int i, n = 0, cap = 0;
+    FILE *file = fopen(path, "r");
+
+    if (!file) {
+        printf("%s: cannot open\n", path);
+        return -1;
+    }
+
+    while (fgets(buf, sizeof(buf), file)) {
+        // .END 之后的内容忽略
+        if (!strncasecmp(buf, ".END", 4) && !isalnum((unsigned char)buf[4]))
+            break;
+        ASM_GROW(lines, n, cap);
+        lines[n++] = strdup(buf);
+    }
+    fclose(file);
+
+    // 行号不变, 出错时仍指向源文件中的位置
+    if (flags & ASM_OPT)
+        asm_peep_removed += peep_run(lines, n);
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.path = path;
+    ctx.origin = OBJ_NO_ORIGIN;
+    ctx.cur = -1;
+    ctx.gcur = -1;
+    // 偏移 0 为空串, 没有符号的模块 strtab 也不为空
+    asm_str(&ctx, "");
+
+    for (i = 0; i < n; i++) {
+        ctx.line = i + 1;
+        asm_line(&ctx, lines[i]);
+        free(lines[i]);
+    }
+    free(lines);
+
+    asm_finish(&ctx, obj);
+    if (ctx.errors) {
+        obj_free(obj);
+        return -1;
+    }
+    return 0;
+}
+
+static const char *asm_lcc_path()
+{
+    const char *path = getenv("LCC_PATH");
+    return path ? path : ASM_LCC_PATH;
+}
+
+static int asm_run(char *const argv[])
+{
+    int status;
+    pid_t pid = fork();
+
+    if (pid < 0)
+        return -1;
+    if (pid == 0) {
+        execv(argv[0], argv);
+        _exit(127);
+    }
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        return -1;
+    return 0;
+}
+
+// 与 lcc 驱动相同的参数调用 cpp 和 rcc, 只是不经过 lc3pp 和 lc3as
+int asm_c_file(const char *path, const char *incs[], int nincs, int flags, struct lc3_obj *obj)
+{
+    char dir[] = "/tmp/lc3-asm.XXXXXX";
+    char cpp[PATH_MAX], rcc[PATH_MAX], inc[PATH_MAX + 2], lib[PATH_MAX + 16];
+    char ifile[sizeof(dir) + 8], lfile[sizeof(dir) + 8];
+    char *argv[ASM_TOKENS + 16];
+    char *incargs[ASM_TOKENS];
+    int i, n = 0, ret = -1;
+
+    if (nincs > ASM_TOKENS || !mkdtemp(dir))
+        return -1;
+    snprintf(ifile, sizeof(ifile), "%s/m.i", dir);
+    snprintf(lfile, sizeof(lfile), "%s/m.lcc", dir);
+    snprintf(cpp, sizeof(cpp), "%s/cpp", asm_lcc_path());
+    snprintf(rcc, sizeof(rcc), "%s/rcc", asm_lcc_path());
+    snprintf(inc, sizeof(inc), "-I%s/include", asm_lcc_path());
+    snprintf(lib, sizeof(lib), "-I%s/../lc3lib", asm_lcc_path());
+
+    argv[n++] = cpp;
+    argv[n++] = "-U__GNUC__";
+    argv[n++] = "-D__STDC__=1";
+    argv[n++] = "-D__STRICT_ANSI__";
+    argv[n++] = "-D__signed__=signed";
+    argv[n++] = "-D__LCC__";
+    for (i = 0; i < nincs; i++) {
+        incargs[i] = malloc(strlen(incs[i]) + 3);
+        sprintf(incargs[i], "-I%s", incs[i]);
+        argv[n++] = incargs[i];
+    }
+    argv[n++] = inc;
+    argv[n++] = lib;
+    argv[n++] = (char *)path;
+    argv[n++] = ifile;
+    argv[n] = NULL;
+
+    if (asm_run(argv) < 0) {
+        printf("%s: preprocessing failed\n", path);
+    } else {
+        char *rargv[] = { rcc, "-target=lc3", "-w", ifile, lfile, NULL };
+        if (asm_run(rargv) < 0) {
+            printf("%s: compilation failed\n", path);
+        } else if (asm_file(lfile, flags, obj) == 0) {
+            obj->path = path;
+            ret = 0;
+        }
+    }
+
+    for (i = 0; i < nincs; i++) {
+        free(incargs[i]);
+    }
+    unlink(ifile);
+    unlink(lfile);
+    rmdir(dir);
+    return ret;
+}
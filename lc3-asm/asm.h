@@ -0,0 +1,126 @@
+#ifndef _ASM_H_
+#define _ASM_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// 可重定位目标文件 (.o), 所有字段为主机字节序:
+// obj_header | obj_frag frags[nfrags] | uint16_t words[nwords]
+//   | obj_sym syms[nsyms] | obj_reloc relocs[nrelocs] | char strtab[strsize]
+//
+// 模块按片段 (fragment) 组织. 片段从一个标号开始, 且前面的指令不会顺序执行进来
+// (无条件跳转/返回之后, 或数据之后的代码), 链接时以片段为单位删除没有被引用的部分.
+// lcc 的全局数据表项 (LC3_GFLAG) 各自成为一个片段, 链接时统一排在 GLOBAL_DATA_START 之后,
+// .LC3GLOBAL 引用在链接时按表内偏移展开成 ADD 链, 与 lc3pp 的结果相同.
+#define OBJ_MAGIC     0X5233434C  /* "LC3R" */
+#define OBJ_VERSION   1
+#define OBJ_NO_ORIGIN 0XFFFFFFFF
+
+#define ASM_DEFAULT_ORIGIN 0X3000
+#define ASM_LINE_MAX       1024
+#define ASM_TOKENS         16
+// 默认的 lcc 安装目录, 编译 .c 时使用其中的 cpp 和 rcc, 可以用 LCC_PATH 环境变量覆盖
+#define ASM_LCC_PATH "/usr/local/bin/lcc-1.3/install"
+
+enum {
+    ASM_OPT      = 1 << 0,  /* 汇编前做窥孔优化 */
+};
+
+enum {
+    LINK_GC      = 1 << 0,  /* 删除没有被引用的片段 */
+    LINK_THREAD  = 1 << 1,  /* 跳转到无条件跳转的 BR 直接跳到最终目标 */
+    LINK_VERBOSE = 1 << 2,
+};
+
+enum {
+    OBJ_F_LCC  = 1 << 0,  /* 使用了全局数据表, 链接时需要 lc3lib */
+    OBJ_F_NOGC = 1 << 1,  /* 有跨片段的数字偏移, 片段不能删除或拆开 */
+};
+
+enum {
+    FRAG_GDATA = 1 << 0,  /* 全局数据表项 */
+};
+
+enum {
+    SYM_GLOBAL = 1 << 0,  /* .global 导出, 其他模块可见 */
+    SYM_GDATA  = 1 << 1,  /* 全局数据表项名, 所有模块共用一个名字空间 */
+};
+
+enum {
+    RELOC_ABS16,  /* .FILL label */
+    RELOC_PC9,    /* BR/LD/LDI/LEA/ST/STI label */
+    RELOC_PC11,   /* JSR label */
+    RELOC_GADDR,  /* .LC3GLOBAL name reg, 占位为 ADD reg, R4, #0 */
+};
+
+struct obj_header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t origin;
+    uint32_t flags;
+    uint32_t nfrags;
+    uint32_t nwords;
+    uint32_t nsyms;
+    uint32_t nrelocs;
+    uint32_t strsize;
+    uint32_t reserved;
+};
+
+struct obj_frag {
+    uint32_t start;   /* 在 words 中的位置 */
+    uint32_t size;
+    uint32_t flags;
+};
+
+struct obj_sym {
+    uint32_t name;    /* strtab 偏移 */
+    uint32_t frag;
+    uint32_t offset;  /* 片段内偏移 */
+    uint32_t flags;
+};
+
+// 重定位按片段内偏移递增排列
+struct obj_reloc {
+    uint32_t frag;
+    uint32_t offset;
+    uint32_t type;
+    uint32_t sym;     /* 目标符号名的 strtab 偏移 */
+    int32_t addend;   /* label+n / label-n */
+};
+
+struct lc3_obj {
+    const char *path;
+    struct obj_header hdr;
+    struct obj_frag *frags;
+    uint16_t *words;
+    struct obj_sym *syms;
+    struct obj_reloc *relocs;
+    char *strtab;
+};
+
+// 汇编 .asm (lc3as 语法), 或 rcc 生成的 .lcc, 格式由内容决定
+int asm_file(const char *path, int flags, struct lc3_obj *obj);
+// 调用 lcc 的 cpp 和 rcc 编译 .c, 再汇编生成的 .lcc
+int asm_c_file(const char *path, const char *incs[], int nincs, int flags, struct lc3_obj *obj);
+// 把一行拆成记号, 会修改 line. 返回记号数
+int asm_tokenize(char *line, char *tok[]);
+int asm_is_instr(const char *s);
+// ASM_OPT 时窥孔优化删除的指令总数
+extern int asm_peep_removed;
+
+// 对一个模块的源代码行做窥孔优化, 删除的行置为空串, 改写的行重新生成. 返回删除的指令数
+int peep_run(char **lines, int n);
+
+int obj_read(const char *path, struct lc3_obj *obj);
+int obj_write(const char *path, const struct lc3_obj *obj);
+void obj_free(struct lc3_obj *obj);
+static inline const char *obj_str(const struct lc3_obj *obj, uint32_t off)
+{
+    return obj->strtab + off;
+}
+
+// 链接成 lc3as 兼容的 out (.obj) 和同名 .sym, flags 为 LINK_*
+int link_objs(struct lc3_obj *objs, int nobjs, const char *out, int flags);
+
+#endif
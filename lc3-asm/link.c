@@ -0,0 +1,600 @@
+#include <string.h>
+
+#include "asm.h"
+
+#define LINK_MEMORY_MAX   (1 << 16)
+#define LINK_DATA_START   "GLOBAL_DATA_START"
+#define LINK_THREAD_HOPS  16
+
+// 符号作用域: 模块内标号用模块下标, 导出的标号和全局数据表项各用一个公共作用域
+enum {
+    SCOPE_GLOBAL = -1,
+    SCOPE_GDATA  = -2,
+};
+
+struct link_ent {
+    const char *name;
+    int scope;
+    int obj;
+    int sym;
+};
+
+struct link_ctx {
+    struct lc3_obj *objs;
+    int nobjs;
+    int errors;
+
+    struct link_ent *hash;
+    uint32_t hash_mask;
+
+    int *frag_base;     /* 每个模块的第一个片段的全局编号 */
+    int *reloc_first;   /* 片段 g 的重定位为模块中的 [reloc_first[g], reloc_end[g]) */
+    int *reloc_end;
+    int nfrags;
+    uint8_t *keep;
+    uint32_t *gdata_off;  /* 全局数据表项在表内的偏移 */
+    uint16_t **amap;      /* 片段内偏移 -> 地址, .LC3GLOBAL 展开后的字计入其中 */
+    uint32_t data_start;
+    int data_used;        /* 有全局数据表或引用了 GLOBAL_DATA_START */
+};
+
+static uint32_t link_hash_key(const char *name, int scope)
+{
+    uint32_t h = 2166136261u ^ (uint32_t)scope;
+
+    while (*name) {
+        h ^= (uint8_t)*name++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static struct link_ent *link_lookup(struct link_ctx *ctx, const char *name, int scope)
+{
+    uint32_t i = link_hash_key(name, scope) & ctx->hash_mask;
+
+    while (ctx->hash[i].name) {
+        if (ctx->hash[i].scope == scope && !strcmp(ctx->hash[i].name, name))
+            return &ctx->hash[i];
+        i = (i + 1) & ctx->hash_mask;
+    }
+    return &ctx->hash[i];
+}
+
+static void link_define(struct link_ctx *ctx, int o, int s, int scope)
+{
+    const char *name = obj_str(&ctx->objs[o], ctx->objs[o].syms[s].name);
+    struct link_ent *ent = link_lookup(ctx, name, scope);
+
+    if (ent->name) {
+        printf("%s: multiple definition of %s (first defined in %s)\n",
+                ctx->objs[o].path, name, ctx->objs[ent->obj].path);
+        ctx->errors++;
+        return;
+    }
+    ent->name = name;
+    ent->scope = scope;
+    ent->obj = o;
+    ent->sym = s;
+}
+
+static int link_symbols(struct link_ctx *ctx)
+{
+    uint32_t total = 0, size = 64;
+    uint32_t s;
+    int o;
+
+    for (o = 0; o < ctx->nobjs; o++) {
+        total += ctx->objs[o].hdr.nsyms;
+    }
+    while (size < total * 3)
+        size *= 2;
+    ctx->hash = calloc(size, sizeof(struct link_ent));
+    ctx->hash_mask = size - 1;
+
+    for (o = 0; o < ctx->nobjs; o++) {
+        for (s = 0; s < ctx->objs[o].hdr.nsyms; s++) {
+            uint32_t flags = ctx->objs[o].syms[s].flags;
+
+            if (flags & SYM_GDATA) {
+                link_define(ctx, o, s, SCOPE_GDATA);
+                continue;
+            }
+            link_define(ctx, o, s, o);
+            if (flags & SYM_GLOBAL)
+                link_define(ctx, o, s, SCOPE_GLOBAL);
+        }
+    }
+    return ctx->errors ? -1 : 0;
+}
+
+// 查找重定位的目标. 代码引用依次查模块内, 导出的标号, 全局数据表项 (全局变量的地址);
+// .LC3GLOBAL 只查全局数据表. 返回 NULL 且 *data 为 1 表示 GLOBAL_DATA_START
+static struct link_ent *link_resolve(struct link_ctx *ctx, int o, const struct obj_reloc *reloc, int *data)
+{
+    const char *name = obj_str(&ctx->objs[o], reloc->sym);
+    struct link_ent *ent;
+
+    *data = 0;
+    if (reloc->type == RELOC_GADDR) {
+        ent = link_lookup(ctx, name, SCOPE_GDATA);
+        return ent->name ? ent : NULL;
+    }
+    ent = link_lookup(ctx, name, o);
+    if (!ent->name)
+        ent = link_lookup(ctx, name, SCOPE_GLOBAL);
+    if (!ent->name)
+        ent = link_lookup(ctx, name, SCOPE_GDATA);
+    if (ent->name)
+        return ent;
+    *data = !strcmp(name, LINK_DATA_START);
+    return NULL;
+}
+
+static int link_frag_of(struct link_ctx *ctx, struct link_ent *ent)
+{
+    return ctx->frag_base[ent->obj] + ctx->objs[ent->obj].syms[ent->sym].frag;
+}
+
+// 从入口片段出发标记所有被引用的片段
+static int link_gc(struct link_ctx *ctx, int gc)
+{
+    int *stack = malloc((ctx->nfrags + 1) * sizeof(int));
+    int top = 0, o, f, i, data;
+    struct link_ent *ent;
+
+    for (o = 0; o < ctx->nobjs; o++) {
+        for (f = 0; f < (int)ctx->objs[o].hdr.nfrags; f++) {
+            int g = ctx->frag_base[o] + f;
+
+            if (!gc || (ctx->objs[o].hdr.flags & OBJ_F_NOGC)) {
+                ctx->keep[g] = 1;
+                stack[top++] = g;
+            }
+        }
+    }
+    // 入口: 第一个模块的第一个代码片段, 放在起始地址
+    for (f = 0; f < (int)ctx->objs[0].hdr.nfrags; f++) {
+        if (!(ctx->objs[0].frags[f].flags & FRAG_GDATA)) {
+            if (!ctx->keep[f]) {
+                ctx->keep[f] = 1;
+                stack[top++] = f;
+            }
+            break;
+        }
+    }
+
+    while (top > 0) {
+        f = stack[--top];
+        for (o = ctx->nobjs - 1; ctx->frag_base[o] > f; o--)
+            ;
+        for (i = ctx->reloc_first[f]; i < ctx->reloc_end[f]; i++) {
+            ent = link_resolve(ctx, o, &ctx->objs[o].relocs[i], &data);
+            if (!ent) {
+                if (!data) {
+                    printf("%s: undefined reference to %s\n", ctx->objs[o].path,
+                            obj_str(&ctx->objs[o], ctx->objs[o].relocs[i].sym));
+                    ctx->errors++;
+                }
+                continue;
+            }
+            if (!ctx->keep[link_frag_of(ctx, ent)]) {
+                ctx->keep[link_frag_of(ctx, ent)] = 1;
+                stack[top++] = link_frag_of(ctx, ent);
+            }
+        }
+    }
+    free(stack);
+    return ctx->errors ? -1 : 0;
+}
+
+// .LC3GLOBAL 的目标: R4 (GLOBAL_DATA_START) 加上的偏移
+static int32_t link_gdata_off(struct link_ctx *ctx, struct link_ent *ent, const struct obj_reloc *reloc)
+{
+    return ctx->gdata_off[link_frag_of(ctx, ent)] + ctx->objs[ent->obj].syms[ent->sym].offset + reloc->addend;
+}
+
+// 展开的 ADD 条数, 每条立即数在 -16..15 之间
+static uint32_t link_gaddr_len(int32_t off)
+{
+    if (off == 0)
+        return 1;
+    return off > 0 ? (off + 14) / 15 : (-off + 15) / 16;
+}
+
+static int32_t link_gaddr_step(int32_t left)
+{
+    return left > 15 ? 15 : left < -16 ? -16 : left;
+}
+
+struct link_gdata {
+    int frag;
+    uint32_t size;
+    uint32_t refs;
+};
+
+// 表项的顺序决定 ADD 链的长度. 按 大小/引用次数 从小到大排列 (Smith 规则),
+// 使所有 .LC3GLOBAL 的偏移之和最小, 只被 .FILL 引用的表项放在最后
+static int link_gdata_cmp(const void *a, const void *b)
+{
+    const struct link_gdata *x = a, *y = b;
+    uint64_t l = (uint64_t)x->size * y->refs, r = (uint64_t)y->size * x->refs;
+
+    if (!x->refs != !y->refs)
+        return x->refs ? -1 : 1;
+    if (l != r)
+        return l < r ? -1 : 1;
+    return x->frag - y->frag;
+}
+
+static void link_gdata_order(struct link_ctx *ctx)
+{
+    struct link_gdata *order = calloc(ctx->nfrags + 1, sizeof(struct link_gdata));
+    uint32_t *refs = calloc(ctx->nfrags + 1, sizeof(uint32_t));
+    uint32_t table = 0;
+    int n = 0, o, f, g, i, data;
+    struct link_ent *ent;
+
+    for (o = 0; o < ctx->nobjs; o++) {
+        for (f = 0; f < (int)ctx->objs[o].hdr.nfrags; f++) {
+            g = ctx->frag_base[o] + f;
+            if (!ctx->keep[g])
+                continue;
+            for (i = ctx->reloc_first[g]; i < ctx->reloc_end[g]; i++) {
+                if (ctx->objs[o].relocs[i].type == RELOC_GADDR &&
+                        (ent = link_resolve(ctx, o, &ctx->objs[o].relocs[i], &data)))
+                    refs[link_frag_of(ctx, ent)]++;
+            }
+            if (ctx->objs[o].frags[f].flags & FRAG_GDATA) {
+                order[n].frag = g;
+                order[n].size = ctx->objs[o].frags[f].size;
+                n++;
+            }
+        }
+    }
+
+    for (i = 0; i < n; i++) {
+        order[i].refs = refs[order[i].frag];
+    }
+    qsort(order, n, sizeof(struct link_gdata), link_gdata_cmp);
+    for (i = 0; i < n; i++) {
+        ctx->gdata_off[order[i].frag] = table;
+        table += order[i].size;
+    }
+    free(order);
+    free(refs);
+}
+
+// 依次排列保留的代码片段, 全局数据表放在最后. 返回结束地址
+static uint32_t link_layout(struct link_ctx *ctx, uint32_t origin)
+{
+    uint32_t addr = origin, end = origin, off, size;
+    int o, f, g, i, data, pass;
+    const struct obj_frag *frag;
+    struct obj_reloc *reloc;
+    struct link_ent *ent;
+
+    link_gdata_order(ctx);
+
+    // 先排代码, 再按 gdata_off 排全局数据表
+    for (pass = 0; pass < 2; pass++) {
+        if (pass == 1)
+            ctx->data_start = addr;
+        for (o = 0; o < ctx->nobjs; o++) {
+            for (f = 0; f < (int)ctx->objs[o].hdr.nfrags; f++) {
+                g = ctx->frag_base[o] + f;
+                frag = &ctx->objs[o].frags[f];
+                if (!ctx->keep[g] || !(frag->flags & FRAG_GDATA) != !pass)
+                    continue;
+
+                if (pass == 1)
+                    addr = ctx->data_start + ctx->gdata_off[g];
+                size = frag->size;
+                ctx->amap[g] = malloc((size + 1) * sizeof(uint16_t));
+                i = ctx->reloc_first[g];
+                for (off = 0; off <= size; off++) {
+                    ctx->amap[g][off] = addr;
+                    if (off == size)
+                        break;
+                    addr++;
+                    reloc = &ctx->objs[o].relocs[i];
+                    if (i < ctx->reloc_end[g] && reloc->offset == off) {
+                        if (reloc->type == RELOC_GADDR && (ent = link_resolve(ctx, o, reloc, &data)))
+                            addr += link_gaddr_len(link_gdata_off(ctx, ent, reloc)) - 1;
+                        i++;
+                    }
+                }
+                if (addr > end)
+                    end = addr;
+            }
+        }
+    }
+    return end;
+}
+
+static uint16_t link_addr(struct link_ctx *ctx, struct link_ent *ent)
+{
+    const struct obj_sym *sym = &ctx->objs[ent->obj].syms[ent->sym];
+
+    return ctx->amap[link_frag_of(ctx, ent)][sym->offset];
+}
+
+static void link_range(struct link_ctx *ctx, int o, const struct obj_reloc *reloc, int32_t d, int bits)
+{
+    if (d < -(1 << (bits - 1)) || d > (1 << (bits - 1)) - 1) {
+        printf("%s: offset to %s out of range (%d)\n", ctx->objs[o].path,
+                obj_str(&ctx->objs[o], reloc->sym), d);
+        ctx->errors++;
+    }
+}
+
+// 把片段 g 写到 image 中, 应用重定位
+static void link_emit(struct link_ctx *ctx, int o, int f, uint16_t *image, uint32_t origin)
+{
+    const struct lc3_obj *obj = &ctx->objs[o];
+    int g = ctx->frag_base[o] + f;
+    int i = ctx->reloc_first[g], data;
+    uint32_t off, addr, target;
+    int32_t left, step;
+    const struct obj_reloc *reloc;
+    struct link_ent *ent;
+    uint16_t word, reg;
+
+    for (off = 0; off < obj->frags[f].size; off++) {
+        word = obj->words[obj->frags[f].start + off];
+        addr = ctx->amap[g][off];
+        reloc = &obj->relocs[i];
+        if (i >= ctx->reloc_end[g] || reloc->offset != off) {
+            image[addr - origin] = word;
+            continue;
+        }
+        i++;
+
+        ent = link_resolve(ctx, o, reloc, &data);
+        if (!ent)
+            ctx->data_used = 1;
+        target = (ent ? link_addr(ctx, ent) : ctx->data_start) + reloc->addend;
+        switch (reloc->type) {
+            case RELOC_ABS16:
+                word = target;
+                break;
+            case RELOC_PC9:
+                link_range(ctx, o, reloc, (int32_t)target - (int32_t)(addr + 1), 9);
+                word = (word & ~0X1FF) | ((target - addr - 1) & 0X1FF);
+                break;
+            case RELOC_PC11:
+                link_range(ctx, o, reloc, (int32_t)target - (int32_t)(addr + 1), 11);
+                word = (word & ~0X7FF) | ((target - addr - 1) & 0X7FF);
+                break;
+            case RELOC_GADDR:
+                // ADD reg, R4, #n; ADD reg, reg, #n ... 与 lc3pp 生成的代码相同
+                reg = (word >> 9) & 7;
+                left = link_gdata_off(ctx, ent, reloc);
+                step = link_gaddr_step(left);
+                image[addr++ - origin] = 0X1000 | reg << 9 | 4 << 6 | 0X20 | (step & 0X1F);
+                for (left -= step; left != 0; left -= step) {
+                    step = link_gaddr_step(left);
+                    image[addr++ - origin] = 0X1000 | reg << 9 | reg << 6 | 0X20 | (step & 0X1F);
+                }
+                continue;
+        }
+        image[addr - origin] = word;
+    }
+}
+
+static int32_t link_br_off(uint16_t word)
+{
+    return (int32_t)((word & 0X1FF) ^ 0X100) - 0X100;
+}
+
+// 跳转链: BR 的目标仍是条件包含它的 BR 时, 直接跳到最终目标.
+// 只处理带重定位的 BR, 即汇编出来的指令而不是碰巧像 BR 的数据. 返回改写的条数
+static int link_thread(struct link_ctx *ctx, uint16_t *image, uint32_t origin, uint32_t end)
+{
+    uint8_t *br = calloc(LINK_MEMORY_MAX, 1);
+    const struct lc3_obj *obj;
+    uint32_t addr, target, next, hop;
+    int o, f, g, i, n = 0;
+    uint16_t word, nzp;
+
+    for (o = 0; o < ctx->nobjs; o++) {
+        obj = &ctx->objs[o];
+        for (f = 0; f < (int)obj->hdr.nfrags; f++) {
+            g = ctx->frag_base[o] + f;
+            if (!ctx->keep[g])
+                continue;
+            for (i = ctx->reloc_first[g]; i < ctx->reloc_end[g]; i++) {
+                addr = ctx->amap[g][obj->relocs[i].offset];
+                if (obj->relocs[i].type == RELOC_PC9 && (image[addr - origin] >> 12) == 0)
+                    br[addr] = 1;
+            }
+        }
+    }
+
+    for (addr = origin; addr < end; addr++) {
+        if (!br[addr])
+            continue;
+        word = image[addr - origin];
+        nzp = word & 0X0E00;
+        target = (addr + 1 + link_br_off(word)) & 0XFFFF;
+        for (hop = 0; hop < LINK_THREAD_HOPS; hop++) {
+            if (target == addr || target < origin || target >= end || !br[target])
+                break;
+            // 跳过去时条件码不变, 目标 BR 的条件包含当前条件才一定会跳
+            if ((image[target - origin] & nzp) != nzp)
+                break;
+            next = (target + 1 + link_br_off(image[target - origin])) & 0XFFFF;
+            if ((int32_t)next - (int32_t)(addr + 1) < -256 || (int32_t)next - (int32_t)(addr + 1) > 255)
+                break;
+            target = next;
+        }
+        if (target != ((addr + 1 + link_br_off(word)) & 0XFFFF)) {
+            image[addr - origin] = (word & ~0X1FF) | ((target - addr - 1) & 0X1FF);
+            n++;
+        }
+    }
+    free(br);
+    return n;
+}
+
+static int link_write_sym(struct link_ctx *ctx, const char *path)
+{
+    FILE *file = fopen(path, "w");
+    const struct lc3_obj *obj;
+    uint32_t s;
+    int o, g;
+
+    if (!file) {
+        printf("%s: cannot create\n", path);
+        return -1;
+    }
+
+    // 与 lc3as 的格式相同, lc3-vmm 的 sym_load 可以直接读取
+    fprintf(file, "// Symbol table\n// Scope level 0:\n");
+    fprintf(file, "//\tSymbol Name       Page Address\n");
+    fprintf(file, "//\t----------------  ------------\n");
+    for (o = 0; o < ctx->nobjs; o++) {
+        obj = &ctx->objs[o];
+        for (s = 0; s < obj->hdr.nsyms; s++) {
+            g = ctx->frag_base[o] + obj->syms[s].frag;
+            if (ctx->keep[g]) {
+                fprintf(file, "//\t%-16s  %04X\n", obj_str(obj, obj->syms[s].name),
+                        ctx->amap[g][obj->syms[s].offset]);
+            }
+        }
+    }
+    if (ctx->data_used)
+        fprintf(file, "//\t%-16s  %04X\n", LINK_DATA_START, ctx->data_start);
+    fprintf(file, "\n");
+    return fclose(file) == 0 ? 0 : -1;
+}
+
+static int link_write_obj(const char *path, const uint16_t *image, uint32_t origin, uint32_t words)
+{
+    FILE *file = fopen(path, "wb");
+    uint32_t i;
+    uint8_t be[2];
+    int ok = 1;
+
+    if (!file) {
+        printf("%s: cannot create\n", path);
+        return -1;
+    }
+
+    // LC-3 目标文件为大端: 起始地址后接镜像
+    be[0] = origin >> 8;
+    be[1] = origin & 0XFF;
+    ok = fwrite(be, 1, 2, file) == 2;
+    for (i = 0; i < words && ok; i++) {
+        be[0] = image[i] >> 8;
+        be[1] = image[i] & 0XFF;
+        ok = fwrite(be, 1, 2, file) == 2;
+    }
+    ok = (fclose(file) == 0) && ok;
+    return ok ? 0 : -1;
+}
+
+int link_objs(struct lc3_obj *objs, int nobjs, const char *out, int flags)
+{
+    struct link_ctx ctx;
+    char sym_path[4096];
+    uint32_t origin = ASM_DEFAULT_ORIGIN, end, total = 0, kept = 0, stripped = 0;
+    uint16_t *image = NULL;
+    int o, f, g, threaded = 0, ret = -1;
+    uint32_t r;
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.objs = objs;
+    ctx.nobjs = nobjs;
+
+    // 起始地址取第一个带 .ORIG 的模块
+    for (o = 0; o < nobjs; o++) {
+        if (objs[o].hdr.origin != OBJ_NO_ORIGIN) {
+            origin = objs[o].hdr.origin;
+            break;
+        }
+    }
+
+    ctx.frag_base = calloc(nobjs + 1, sizeof(int));
+    for (o = 0; o < nobjs; o++) {
+        ctx.frag_base[o] = ctx.nfrags;
+        ctx.nfrags += objs[o].hdr.nfrags;
+    }
+    ctx.frag_base[nobjs] = ctx.nfrags;
+    ctx.reloc_first = calloc(ctx.nfrags + 1, sizeof(int));
+    ctx.reloc_end = calloc(ctx.nfrags + 1, sizeof(int));
+    ctx.keep = calloc(ctx.nfrags + 1, 1);
+    ctx.gdata_off = calloc(ctx.nfrags + 1, sizeof(uint32_t));
+    ctx.amap = calloc(ctx.nfrags + 1, sizeof(uint16_t *));
+
+    // 重定位按片段排好序
+    for (o = 0; o < nobjs; o++) {
+        r = 0;
+        for (f = 0; f < (int)objs[o].hdr.nfrags; f++) {
+            ctx.reloc_first[ctx.frag_base[o] + f] = r;
+            while (r < objs[o].hdr.nrelocs && objs[o].relocs[r].frag == (uint32_t)f)
+                r++;
+            ctx.reloc_end[ctx.frag_base[o] + f] = r;
+        }
+    }
+
+    if (nobjs == 0 || link_symbols(&ctx) < 0 || link_gc(&ctx, flags & LINK_GC) < 0)
+        goto out;
+
+    end = link_layout(&ctx, origin);
+    if (end > LINK_MEMORY_MAX) {
+        printf("%s: image does not fit in memory (x%04X-x%05X)\n", out, origin, end);
+        goto out;
+    }
+
+    image = calloc(end - origin + 1, sizeof(uint16_t));
+    for (o = 0; o < nobjs; o++) {
+        for (f = 0; f < (int)objs[o].hdr.nfrags; f++) {
+            g = ctx.frag_base[o] + f;
+            total += objs[o].frags[f].size;
+            if (ctx.keep[g]) {
+                kept += objs[o].frags[f].size;
+                link_emit(&ctx, o, f, image, origin);
+            } else {
+                stripped++;
+            }
+        }
+    }
+    if (ctx.errors)
+        goto out;
+    if (end > ctx.data_start)
+        ctx.data_used = 1;
+    if (flags & LINK_THREAD)
+        threaded = link_thread(&ctx, image, origin, end);
+
+    snprintf(sym_path, sizeof(sym_path), "%s", out);
+    if (strrchr(sym_path, '.') > strrchr(sym_path, '/'))
+        *strrchr(sym_path, '.') = '\0';
+    strncat(sym_path, ".sym", sizeof(sym_path) - strlen(sym_path) - 1);
+
+    if (link_write_obj(out, image, origin, end - origin) < 0 || link_write_sym(&ctx, sym_path) < 0) {
+        printf("%s: write error\n", out);
+        goto out;
+    }
+    if (flags & LINK_VERBOSE) {
+        fprintf(stderr, ">>> %s: %u words at x%04X, global data %u words, stripped %u of %u words (%u fragments)\n",
+                out, end - origin, origin, end - ctx.data_start, total - kept, total, stripped);
+        if (flags & LINK_THREAD)
+            fprintf(stderr, ">>> %s: threaded %d branches\n", out, threaded);
+    }
+    ret = 0;
+
+out:
+    for (g = 0; g < ctx.nfrags; g++) {
+        free(ctx.amap[g]);
+    }
+    free(image);
+    free(ctx.amap);
+    free(ctx.gdata_off);
+    free(ctx.keep);
+    free(ctx.reloc_first);
+    free(ctx.reloc_end);
+    free(ctx.frag_base);
+    free(ctx.hash);
+    return ret;
+}
@@ -0,0 +1,143 @@
+#include <string.h>
+#include <limits.h>
+
+#include "asm.h"
+
+#ifndef ASM_LIB
+#define ASM_LIB "lc3lib.o"
+#endif
+
+#define ASM_MAX_INCS 16
+
+static void usage(const char *prog)
+{
+    printf("usage: %s [-c] [-o output] [-I dir] [-O] [--no-gc] [-nostdlib] [-v] file...\n", prog);
+    printf("  file      .asm / .lcc / .c source, or .o object\n");
+    printf("  -c        assemble each file to a relocatable .o instead of linking\n");
+    printf("  -o        output file (default: first input with .o or .obj)\n");
+    printf("  -I        include directory for .c sources\n");
+    printf("  -O        peephole-optimize lcc output and thread branch chains\n");
+    printf("  --no-gc   keep unreferenced fragments\n");
+    printf("  -nostdlib do not link lc3lib (default: %s, or LC3_ASM_LIB)\n", ASM_LIB);
+    printf("  -v        print image size, stripped and optimized words\n");
+}
+
+static const char *ext_of(const char *path)
+{
+    const char *ext = strrchr(path, '.');
+    return ext && ext > strrchr(path, '/') ? ext : "";
+}
+
+// 源文件名换成 ext 作为默认输出
+static void default_output(char *out, size_t len, const char *src, const char *ext)
+{
+    snprintf(out, len, "%s", src);
+    if (*ext_of(out))
+        *strrchr(out, '.') = '\0';
+    strncat(out, ext, len - strlen(out) - 1);
+}
+
+static int load_input(const char *path, const char *incs[], int nincs, int flags,
+        struct lc3_obj *obj)
+{
+    const char *ext = ext_of(path);
+
+    if (!strcmp(ext, ".o"))
+        return obj_read(path, obj);
+    if (!strcmp(ext, ".c"))
+        return asm_c_file(path, incs, nincs, flags, obj);
+    return asm_file(path, flags, obj);
+}
+
+int main(int argc, const char* argv[])
+{
+    const char *incs[ASM_MAX_INCS];
+    const char **inputs;
+    const char *output = NULL, *lib;
+    char out[PATH_MAX];
+    struct lc3_obj *objs;
+    int i, nincs = 0, ninputs = 0, nobjs = 0;
+    int compile = 0, stdlib = 1, lcc = 0, ret = 1;
+    int aflags = 0, lflags = LINK_GC;
+
+    inputs = calloc(argc, sizeof(char *));
+    objs = calloc(argc + 1, sizeof(struct lc3_obj));
+
+    for (i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-c")) {
+            compile = 1;
+        } else if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+            output = argv[++i];
+        } else if (!strcmp(argv[i], "-I") && i + 1 < argc && nincs < ASM_MAX_INCS) {
+            incs[nincs++] = argv[++i];
+        } else if (!strncmp(argv[i], "-I", 2) && argv[i][2] && nincs < ASM_MAX_INCS) {
+            incs[nincs++] = argv[i] + 2;
+        } else if (!strcmp(argv[i], "-O")) {
+            aflags |= ASM_OPT;
+            lflags |= LINK_THREAD;
+        } else if (!strcmp(argv[i], "--no-gc")) {
+            lflags &= ~LINK_GC;
+        } else if (!strcmp(argv[i], "-nostdlib")) {
+            stdlib = 0;
+        } else if (!strcmp(argv[i], "-v")) {
+            lflags |= LINK_VERBOSE;
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            goto exit;
+        } else {
+            inputs[ninputs++] = argv[i];
+        }
+    }
+
+    if (ninputs == 0 || (compile && output && ninputs > 1)) {
+        usage(argv[0]);
+        goto exit;
+    }
+
+    if (compile) {
+        for (i = 0; i < ninputs; i++) {
+            struct lc3_obj obj;
+
+            if (load_input(inputs[i], incs, nincs, aflags, &obj) < 0)
+                goto exit;
+            default_output(out, sizeof(out), inputs[i], ".o");
+            if (obj_write(output ? output : out, &obj) < 0) {
+                obj_free(&obj);
+                goto exit;
+            }
+            obj_free(&obj);
+        }
+        ret = 0;
+        goto exit;
+    }
+
+    for (i = 0; i < ninputs; i++) {
+        if (load_input(inputs[i], incs, nincs, aflags, &objs[nobjs]) < 0)
+            goto exit;
+        lcc |= objs[nobjs++].hdr.flags & OBJ_F_LCC;
+    }
+
+    // lcc 编译的模块需要 lc3lib 中的 printf/scanf 等, 没用到的部分会被删除
+    if (lcc && stdlib) {
+        lib = getenv("LC3_ASM_LIB");
+        if (!lib)
+            lib = ASM_LIB;
+        if (load_input(lib, incs, nincs, 0, &objs[nobjs]) < 0)
+            goto exit;
+        nobjs++;
+    }
+
+    default_output(out, sizeof(out), inputs[0], ".obj");
+    if (link_objs(objs, nobjs, output ? output : out, lflags) == 0)
+        ret = 0;
+    if ((lflags & LINK_VERBOSE) && (aflags & ASM_OPT))
+        fprintf(stderr, ">>> peephole: removed %d instructions\n", asm_peep_removed);
+
+exit:
+    for (i = 0; i < nobjs; i++) {
+        obj_free(&objs[i]);
+    }
+    free(objs);
+    free(inputs);
+    return ret;
+}
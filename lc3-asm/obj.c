@@ -0,0 +1,122 @@
+#include <string.h>
+#include <unistd.h>
+
+#include "asm.h"
+
+int obj_write(const char *path, const struct lc3_obj *obj)
+{
+    const struct obj_header *hdr = &obj->hdr;
+    FILE *file = fopen(path, "wb");
+    int ok;
+
+    if (!file) {
+        printf("%s: cannot create\n", path);
+        return -1;
+    }
+
+    ok = fwrite(hdr, sizeof(*hdr), 1, file) == 1 &&
+        fwrite(obj->frags, sizeof(struct obj_frag), hdr->nfrags, file) == hdr->nfrags &&
+        fwrite(obj->words, sizeof(uint16_t), hdr->nwords, file) == hdr->nwords &&
+        fwrite(obj->syms, sizeof(struct obj_sym), hdr->nsyms, file) == hdr->nsyms &&
+        fwrite(obj->relocs, sizeof(struct obj_reloc), hdr->nrelocs, file) == hdr->nrelocs &&
+        fwrite(obj->strtab, 1, hdr->strsize, file) == hdr->strsize;
+    ok = (fclose(file) == 0) && ok;
+
+    if (!ok) {
+        printf("%s: write error\n", path);
+        unlink(path);
+        return -1;
+    }
+    return 0;
+}
+
+static void *obj_part(FILE *file, size_t size, uint32_t n)
+{
+    // 多分配一个元素, n 为 0 时也返回有效指针
+    void *p = calloc(n + 1, size);
+
+    if (p && fread(p, size, n, file) != n) {
+        free(p);
+        return NULL;
+    }
+    return p;
+}
+
+// 检查所有索引都在范围内, 之后链接时不再检查
+static int obj_check(const struct lc3_obj *obj)
+{
+    const struct obj_header *hdr = &obj->hdr;
+    uint32_t i;
+
+    if (hdr->strsize == 0 || obj->strtab[hdr->strsize - 1] != '\0')
+        return -1;
+    for (i = 0; i < hdr->nfrags; i++) {
+        if (obj->frags[i].start > hdr->nwords || obj->frags[i].size > hdr->nwords - obj->frags[i].start)
+            return -1;
+    }
+    for (i = 0; i < hdr->nsyms; i++) {
+        if (obj->syms[i].name >= hdr->strsize || obj->syms[i].frag >= hdr->nfrags ||
+                obj->syms[i].offset > obj->frags[obj->syms[i].frag].size)
+            return -1;
+    }
+    for (i = 0; i < hdr->nrelocs; i++) {
+        if (obj->relocs[i].sym >= hdr->strsize || obj->relocs[i].frag >= hdr->nfrags ||
+                obj->relocs[i].offset >= obj->frags[obj->relocs[i].frag].size ||
+                obj->relocs[i].type > RELOC_GADDR)
+            return -1;
+        if (i > 0 && obj->relocs[i].frag == obj->relocs[i - 1].frag &&
+                obj->relocs[i].offset <= obj->relocs[i - 1].offset)
+            return -1;
+        if (i > 0 && obj->relocs[i].frag < obj->relocs[i - 1].frag)
+            return -1;
+    }
+    return 0;
+}
+
+int obj_read(const char *path, struct lc3_obj *obj)
+{
+    struct obj_header *hdr = &obj->hdr;
+    FILE *file = fopen(path, "rb");
+
+    memset(obj, 0, sizeof(*obj));
+    obj->path = path;
+    if (!file) {
+        printf("%s: cannot open\n", path);
+        return -1;
+    }
+
+    if (fread(hdr, sizeof(*hdr), 1, file) != 1 || hdr->magic != OBJ_MAGIC ||
+            hdr->version != OBJ_VERSION) {
+        printf("%s: not an lc3-asm object\n", path);
+        fclose(file);
+        return -1;
+    }
+
+    obj->frags = obj_part(file, sizeof(struct obj_frag), hdr->nfrags);
+    obj->words = obj->frags ? obj_part(file, sizeof(uint16_t), hdr->nwords) : NULL;
+    obj->syms = obj->words ? obj_part(file, sizeof(struct obj_sym), hdr->nsyms) : NULL;
+    obj->relocs = obj->syms ? obj_part(file, sizeof(struct obj_reloc), hdr->nrelocs) : NULL;
+    obj->strtab = obj->relocs ? obj_part(file, 1, hdr->strsize) : NULL;
+    fclose(file);
+
+    if (!obj->strtab || obj_check(obj) < 0) {
+        printf("%s: corrupt object\n", path);
+        obj_free(obj);
+        return -1;
+    }
+    return 0;
+}
+
+void obj_free(struct lc3_obj *obj)
+{
+    free(obj->frags);
+    free(obj->words);
+    free(obj->syms);
+    free(obj->relocs);
+    free(obj->strtab);
+    obj->frags = NULL;
+    obj->words = NULL;
+    obj->syms = NULL;
+    obj->relocs = NULL;
+    obj->strtab = NULL;
+}
@@ -0,0 +1,584 @@
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+
+#include "asm.h"
+
+// 对 rcc 生成的代码做窥孔优化, 在汇编之前按行改写:
+//   1. 合并栈调整: 相邻的 ADD R6, R6, #k 合成一条, 中间基于 R6 的偏移相应修正.
+//      中断会压栈到 R6 之下, 所以只把分配提前, 把释放推后, 数据不会落在栈顶之下
+//   2. 删除多余的 ADD Rx, Rx, #0 (条件码已经由 Rx 设置), 紧接 STR 之后的同址 LDR 等
+//   3. 跳转: 删除跳到下一行的跳转, 跳转到间接跳转的 .LC3GLOBAL 直接指向最终目标
+// 链接时的 BR 跳转链在 link.c 中处理, 那里才知道偏移是否够用.
+// 只处理 lcc 调用约定的模块, 数字 PC 偏移 (LEA R6, #-1) 跨过的行不做改动.
+
+#define PEEP_PASSES 16
+#define PEEP_HOPS   16
+
+enum {
+    PK_NONE,   /* 空行, 注释, .global/.extern */
+    PK_INSTR,
+    PK_GADDR,  /* .LC3GLOBAL name reg */
+    PK_OTHER,  /* 数据, LC3_GFLAG, INIT_CODE 等, 分析到这里为止 */
+};
+
+enum {
+    PF_CC     = 1 << 0,  /* 设置条件码 */
+    PF_JUMP   = 1 << 1,  /* 改变控制流 */
+    PF_CALL   = 1 << 2,  /* JSR/JSRR/RET, 按 lcc 的约定不跨越它们传递条件码 */
+    PF_IMM    = 1 << 3,  /* ADD/AND 的立即数形式 */
+    PF_LABEL  = 1 << 4,  /* 操作数是标号 */
+    PF_NUMPC  = 1 << 5,  /* 数字 PC 偏移 */
+};
+
+struct peep_ins {
+    char *label;      /* 行首标号 */
+    int kind;
+    int dead;
+    int dirty;        /* 需要重新生成这一行 */
+    char op[8];       /* 大写的操作码, BR 为 "BR" */
+    int flags;
+    int nzp;
+    int reg[3];       /* 寄存器操作数, 没有时为 -1 */
+    int imm;
+    char *target;     /* 标号操作数, 或 .LC3GLOBAL 的表项名 */
+    char *gflag;      /* LC3_GFLAG name LC3_GFLAG .FILL target 的 name */
+};
+
+struct peep_ctx {
+    char **lines;
+    struct peep_ins *ins;
+    int n;
+    int removed;
+};
+
+static int peep_reg(const char *s)
+{
+    if ((s[0] == 'R' || s[0] == 'r') && s[1] >= '0' && s[1] <= '7' && !s[2])
+        return s[1] - '0';
+    return -1;
+}
+
+static int peep_imm(const char *s, int *v)
+{
+    char *end;
+    long x;
+
+    if (*s == '#') {
+        x = strtol(++s, &end, 10);
+    } else if (*s == 'x' || *s == 'X') {
+        x = strtol(++s, &end, 16);
+    } else if (isdigit((unsigned char)*s) || *s == '-') {
+        x = strtol(s, &end, 0);
+    } else {
+        return 0;
+    }
+    if (end == s || *end)
+        return 0;
+    *v = x;
+    return 1;
+}
+
+static int peep_in(int v, int bits)
+{
+    return v >= -(1 << (bits - 1)) && v < (1 << (bits - 1));
+}
+
+// 解析一条指令, 返回 -1 表示这个模块不能优化
+static int peep_instr(struct peep_ins *p, char *tok[], int n)
+{
+    const char *op = tok[0];
+    int i;
+
+    p->kind = PK_INSTR;
+    p->reg[0] = p->reg[1] = p->reg[2] = -1;
+    for (i = 0; op[i] && i < (int)sizeof(p->op) - 1; i++) {
+        p->op[i] = toupper((unsigned char)op[i]);
+    }
+    p->op[i] = '\0';
+
+    if (!strncmp(p->op, "BR", 2)) {
+        p->nzp = 0;
+        for (i = 2; p->op[i]; i++) {
+            p->nzp |= p->op[i] == 'N' ? 4 : p->op[i] == 'Z' ? 2 : 1;
+        }
+        if (!p->nzp)
+            p->nzp = 7;
+        p->op[2] = '\0';
+        p->flags = PF_JUMP;
+    } else if (!strcmp(p->op, "ADD") || !strcmp(p->op, "AND") || !strcmp(p->op, "NOT")) {
+        p->flags = PF_CC;
+    } else if (!strcmp(p->op, "LDR") || !strcmp(p->op, "LD") || !strcmp(p->op, "LDI") ||
+            !strcmp(p->op, "LEA")) {
+        p->flags = PF_CC;
+    } else if (!strcmp(p->op, "STR") || !strcmp(p->op, "ST") || !strcmp(p->op, "STI")) {
+        p->flags = 0;
+    } else if (!strcmp(p->op, "JSR") || !strcmp(p->op, "JSRR") || !strcmp(p->op, "RET")) {
+        p->flags = PF_JUMP | PF_CALL;
+    } else {
+        // JMP, RTI, TRAP 及其别名
+        p->flags = PF_JUMP;
+    }
+
+    for (i = 1; i < n; i++) {
+        int r = peep_reg(tok[i]);
+
+        if (r >= 0 && i <= 3) {
+            p->reg[i - 1] = r;
+        } else if (peep_imm(tok[i], &p->imm)) {
+            // BR/LD/JSR 等的数字偏移, 删改中间的指令会破坏它
+            if (!strcmp(p->op, "BR") || !strcmp(p->op, "JSR") || !strcmp(p->op, "LD") ||
+                    !strcmp(p->op, "LDI") || !strcmp(p->op, "LEA") || !strcmp(p->op, "ST") ||
+                    !strcmp(p->op, "STI"))
+                p->flags |= PF_NUMPC;
+            if (!strcmp(p->op, "ADD") || !strcmp(p->op, "AND"))
+                p->flags |= PF_IMM;
+        } else {
+            p->target = tok[i];
+            p->flags |= PF_LABEL;
+        }
+    }
+    return 0;
+}
+
+// 数字 PC 偏移跨过的行 (每行至少一个字) 都当作不能分析的行, 不删除也不改变长度
+static void peep_fix_numeric(struct peep_ctx *ctx)
+{
+    int i, k, left, step;
+
+    for (i = 0; i < ctx->n; i++) {
+        if (!(ctx->ins[i].flags & PF_NUMPC))
+            continue;
+        step = ctx->ins[i].imm < 0 ? -1 : 1;
+        left = (ctx->ins[i].imm < 0 ? -ctx->ins[i].imm : ctx->ins[i].imm) + 1;
+        for (k = i; k >= 0 && k < ctx->n && left > 0; k += step) {
+            if (ctx->ins[k].kind == PK_INSTR || ctx->ins[k].kind == PK_GADDR)
+                left--;
+            ctx->ins[k].kind = PK_OTHER;
+        }
+    }
+}
+
+// 返回 -1 表示这个模块不能优化
+static int peep_parse(struct peep_ins *p, char *line)
+{
+    char *tok[ASM_TOKENS];
+    int n = asm_tokenize(line, tok);
+
+    memset(p, 0, sizeof(*p));
+    if (n == 0)
+        return 0;
+
+    if (!strcmp(tok[0], "LC3_GFLAG")) {
+        p->kind = PK_OTHER;
+        if (n == 5 && !strcmp(tok[2], "LC3_GFLAG") && !strcasecmp(tok[3], ".FILL")) {
+            p->gflag = tok[1];
+            p->target = tok[4];
+        }
+        return 0;
+    }
+    if (!strcasecmp(tok[0], ".global") || !strcasecmp(tok[0], ".extern") ||
+            !strcasecmp(tok[0], ".EXTERNAL"))
+        return 0;
+    if (!strcasecmp(tok[0], ".LC3GLOBAL")) {
+        if (n != 3)
+            return -1;
+        p->kind = PK_GADDR;
+        p->target = tok[1];
+        p->reg[0] = peep_reg(tok[2]);
+        if (tok[2][0] >= '0' && tok[2][0] <= '7' && !tok[2][1])
+            p->reg[0] = tok[2][0] - '0';
+        if (p->reg[0] < 0)
+            return -1;
+        p->flags = PF_CC;
+        return 0;
+    }
+    if (tok[0][0] == '.' || !strcmp(tok[0], "INIT_CODE")) {
+        p->kind = PK_OTHER;
+        return 0;
+    }
+
+    if (!asm_is_instr(tok[0])) {
+        p->label = tok[0];
+        if (n == 1)
+            return 0;
+        if (tok[1][0] == '.' || !asm_is_instr(tok[1])) {
+            p->kind = PK_OTHER;
+            return 0;
+        }
+        return peep_instr(p, tok + 1, n - 1);
+    }
+    return peep_instr(p, tok, n);
+}
+
+static int peep_is(const struct peep_ins *p, const char *op)
+{
+    return p->kind == PK_INSTR && !p->dead && !strcmp(p->op, op);
+}
+
+// ADD R6, R6, #k
+static int peep_is_adjust(const struct peep_ins *p)
+{
+    return peep_is(p, "ADD") && (p->flags & PF_IMM) && p->reg[0] == 6 && p->reg[1] == 6;
+}
+
+static int peep_uses(const struct peep_ins *p, int r)
+{
+    return p->reg[0] == r || p->reg[1] == r || p->reg[2] == r;
+}
+
+// 下一条有效的行, 跳过空行和删除的指令, stop_label 时遇到标号返回 -1
+static int peep_next(struct peep_ctx *ctx, int i, int stop_label)
+{
+    for (i++; i < ctx->n; i++) {
+        struct peep_ins *p = &ctx->ins[i];
+
+        if (p->label && stop_label)
+            return -1;
+        if (p->kind != PK_NONE && !p->dead)
+            return i;
+    }
+    return -1;
+}
+
+// 第 i 行之后的条件码是否不再被读取
+static int peep_cc_dead(struct peep_ctx *ctx, int i)
+{
+    while ((i = peep_next(ctx, i, 0)) >= 0) {
+        struct peep_ins *p = &ctx->ins[i];
+
+        if (p->kind == PK_OTHER)
+            return 0;
+        if (p->flags & PF_CC)
+            return 1;
+        if (p->flags & PF_CALL)
+            return 1;
+        if (p->flags & PF_JUMP)
+            return 0;
+    }
+    return 0;
+}
+
+static void peep_delete(struct peep_ctx *ctx, int i)
+{
+    ctx->ins[i].dead = 1;
+    ctx->removed++;
+}
+
+// 在 [i, j) 之间的 R6 偏移都加上 d, 先检查都在范围内
+static int peep_shift(struct peep_ctx *ctx, int i, int j, int d, int apply)
+{
+    for (i++; i < j; i++) {
+        struct peep_ins *p = &ctx->ins[i];
+
+        if (p->dead || p->kind != PK_INSTR || !peep_uses(p, 6))
+            continue;
+        if (!peep_in(p->imm + d, strcmp(p->op, "ADD") ? 6 : 5))
+            return 0;
+        if (apply) {
+            p->imm += d;
+            p->dirty = 1;
+        }
+    }
+    return 1;
+}
+
+// 从栈调整 i 开始找下一条栈调整, 中间只能有可以修正偏移的 R6 访问.
+// mem 为中间访问内存的指令数, 有访存时栈调整只能往安全的方向移动
+static int peep_stack_window(struct peep_ctx *ctx, int i, int *mem)
+{
+    int k;
+
+    *mem = 0;
+    for (k = i; (k = peep_next(ctx, k, 1)) >= 0; ) {
+        struct peep_ins *p = &ctx->ins[k];
+
+        if (peep_is_adjust(p))
+            return k;
+        if (p->kind == PK_GADDR && p->reg[0] != 6)
+            continue;
+        if (p->kind != PK_INSTR || (p->flags & PF_JUMP))
+            return -1;
+        if (!strncmp(p->op, "LD", 2) || !strncmp(p->op, "ST", 2))
+            (*mem)++;
+        if (!peep_uses(p, 6))
+            continue;
+        // LDR/STR Rx, R6, #k 和 ADD Rx, R6, #k
+        if ((!strcmp(p->op, "LDR") || !strcmp(p->op, "STR")) && p->reg[1] == 6 && p->reg[0] != 6)
+            continue;
+        if (!strcmp(p->op, "ADD") && (p->flags & PF_IMM) && p->reg[1] == 6 && p->reg[0] != 6)
+            continue;
+        return -1;
+    }
+    return -1;
+}
+
+static int peep_stack(struct peep_ctx *ctx)
+{
+    int i, j, a, b, mem, changed = 0;
+
+    for (i = 0; i < ctx->n; i++) {
+        if (!peep_is_adjust(&ctx->ins[i]))
+            continue;
+        j = peep_stack_window(ctx, i, &mem);
+        if (j < 0)
+            continue;
+        a = ctx->ins[i].imm;
+        b = ctx->ins[j].imm;
+        if (!peep_in(a + b, 5))
+            continue;
+
+        // 释放推后: 删除 i, 中间的偏移加上 a, 结果和条件码与原来的 j 相同
+        if ((a > 0 || mem == 0) && peep_shift(ctx, i, j, a, 0)) {
+            peep_shift(ctx, i, j, a, 1);
+            peep_delete(ctx, i);
+            ctx->ins[j].imm = a + b;
+            ctx->ins[j].dirty = 1;
+            if (a + b == 0 && peep_cc_dead(ctx, j))
+                peep_delete(ctx, j);
+            changed = 1;
+            continue;
+        }
+        // 分配提前: 删除 j, 中间的偏移减去 b, j 之后不能再用它设置的条件码
+        if ((b < 0 || mem == 0) && peep_cc_dead(ctx, j) && peep_shift(ctx, i, j, -b, 0)) {
+            peep_shift(ctx, i, j, -b, 1);
+            peep_delete(ctx, j);
+            ctx->ins[i].imm = a + b;
+            ctx->ins[i].dirty = 1;
+            if (a + b == 0)
+                peep_delete(ctx, i);
+            changed = 1;
+        }
+    }
+    return changed;
+}
+
+// 紧邻的两条指令间的冗余
+static int peep_local(struct peep_ctx *ctx)
+{
+    int i, j, k, changed = 0;
+
+    for (i = 0; i < ctx->n; i++) {
+        struct peep_ins *p = &ctx->ins[i], *q;
+
+        if (p->kind != PK_INSTR || p->dead)
+            continue;
+        j = peep_next(ctx, i, 1);
+        q = j >= 0 ? &ctx->ins[j] : NULL;
+
+        // STR Rs, Rb, #k; LDR Rs, Rb, #k
+        if (q && peep_is(p, "STR") && peep_is(q, "LDR") && p->reg[0] == q->reg[0] &&
+                p->reg[1] == q->reg[1] && p->imm == q->imm && q->reg[0] != q->reg[1] &&
+                peep_cc_dead(ctx, j)) {
+            peep_delete(ctx, j);
+            changed = 1;
+            continue;
+        }
+        // LDR Rs, Rb, #k; STR Rs, Rb, #k
+        if (q && peep_is(p, "LDR") && peep_is(q, "STR") && p->reg[0] == q->reg[0] &&
+                p->reg[1] == q->reg[1] && p->imm == q->imm && p->reg[0] != p->reg[1]) {
+            peep_delete(ctx, j);
+            changed = 1;
+            continue;
+        }
+
+        // ADD Rx, Rx, #0 只为设置条件码, 往前找最近设置条件码的指令
+        if (peep_is(p, "ADD") && (p->flags & PF_IMM) && p->imm == 0 && p->reg[0] == p->reg[1] &&
+                !p->label) {
+            for (k = i - 1; k >= 0; k--) {
+                struct peep_ins *c = &ctx->ins[k];
+
+                if (c->dead || c->kind == PK_NONE) {
+                    if (c->label)
+                        break;
+                    continue;
+                }
+                if ((c->kind != PK_INSTR && c->kind != PK_GADDR) || (c->flags & PF_JUMP))
+                    break;
+                if (c->flags & PF_CC) {
+                    if (c->reg[0] == p->reg[0]) {
+                        peep_delete(ctx, i);
+                        changed = 1;
+                    }
+                    break;
+                }
+                if (c->label)
+                    break;
+            }
+        }
+    }
+    return changed;
+}
+
+// 标号 name 所在的行
+static int peep_label(struct peep_ctx *ctx, const char *name)
+{
+    int i;
+
+    for (i = 0; i < ctx->n; i++) {
+        if (ctx->ins[i].label && !strcmp(ctx->ins[i].label, name))
+            return i;
+    }
+    return -1;
+}
+
+// 全局数据表项 name 指向的标号
+static const char *peep_gflag(struct peep_ctx *ctx, const char *name)
+{
+    int i;
+
+    for (i = 0; i < ctx->n; i++) {
+        if (ctx->ins[i].gflag && !strcmp(ctx->ins[i].gflag, name))
+            return ctx->ins[i].target;
+    }
+    return NULL;
+}
+
+// i 处是否是 .LC3GLOBAL name r; LDR r, r, #0; JMP r, 是时返回表项名
+static const char *peep_far_jump(struct peep_ctx *ctx, int i, int *reg, int *last)
+{
+    struct peep_ins *g = &ctx->ins[i], *l, *j;
+    int k, m;
+
+    if (g->kind != PK_GADDR || g->dead || (k = peep_next(ctx, i, 1)) < 0 ||
+            (m = peep_next(ctx, k, 1)) < 0)
+        return NULL;
+    l = &ctx->ins[k];
+    j = &ctx->ins[m];
+    if (!peep_is(l, "LDR") || l->reg[0] != g->reg[0] || l->reg[1] != g->reg[0] || l->imm != 0 ||
+            !peep_is(j, "JMP") || j->reg[0] != g->reg[0])
+        return NULL;
+    *reg = g->reg[0];
+    *last = m;
+    return g->target;
+}
+
+// 从第 i 行开始, 跳过空行后是否到达标号 name
+static int peep_falls_to(struct peep_ctx *ctx, int i, const char *name)
+{
+    for (i++; i < ctx->n; i++) {
+        struct peep_ins *p = &ctx->ins[i];
+
+        if (p->label && !strcmp(p->label, name))
+            return 1;
+        if (p->kind != PK_NONE && !p->dead)
+            return 0;
+    }
+    return 0;
+}
+
+static int peep_jumps(struct peep_ctx *ctx)
+{
+    const char *name, *dest, *next;
+    int i, k, t, hop, reg, reg2, last, changed = 0;
+
+    for (i = 0; i < ctx->n; i++) {
+        struct peep_ins *p = &ctx->ins[i];
+
+        // BRx L; L
+        if (peep_is(p, "BR") && p->target && peep_falls_to(ctx, i, p->target)) {
+            peep_delete(ctx, i);
+            changed = 1;
+            continue;
+        }
+
+        name = peep_far_jump(ctx, i, &reg, &last);
+        if (!name)
+            continue;
+
+        // 跳到的位置仍然是同一寄存器的间接跳转时, 直接用最终的表项
+        for (hop = 0; hop < PEEP_HOPS; hop++) {
+            dest = peep_gflag(ctx, name);
+            if (!dest || (t = peep_label(ctx, dest)) < 0)
+                break;
+            k = ctx->ins[t].kind == PK_NONE ? peep_next(ctx, t, 1) : t;
+            if (k < 0 || k == i)
+                break;
+            next = peep_far_jump(ctx, k, &reg2, &t);
+            if (!next || reg2 != reg || !strcmp(next, name))
+                break;
+            name = next;
+        }
+        if (name != p->target) {
+            p->target = (char *)name;
+            p->dirty = 1;
+            changed = 1;
+        }
+
+        // 间接跳转到紧接着的标号
+        dest = peep_gflag(ctx, name);
+        if (dest && peep_falls_to(ctx, last, dest)) {
+            for (k = i; k <= last; k++) {
+                if (ctx->ins[k].kind != PK_NONE && !ctx->ins[k].dead)
+                    peep_delete(ctx, k);
+            }
+            changed = 1;
+        }
+    }
+    return changed;
+}
+
+// 重新生成改动过的行
+static void peep_emit(struct peep_ctx *ctx, int i)
+{
+    struct peep_ins *p = &ctx->ins[i];
+    const char *label = p->label ? p->label : "";
+    char buf[ASM_LINE_MAX];
+
+    // 只有 .LC3GLOBAL, LDR/STR 和 ADD/AND 立即数会被改写
+    if (p->dead) {
+        snprintf(buf, sizeof(buf), "%s\n", label);
+    } else if (p->kind == PK_GADDR) {
+        snprintf(buf, sizeof(buf), ".LC3GLOBAL %s %d\n", p->target, p->reg[0]);
+    } else {
+        snprintf(buf, sizeof(buf), "%s %s R%d, R%d, #%d\n", label, p->op, p->reg[0], p->reg[1], p->imm);
+    }
+
+    free(ctx->lines[i]);
+    ctx->lines[i] = strdup(buf);
+}
+
+int peep_run(char **lines, int n)
+{
+    struct peep_ctx ctx;
+    char **copy;
+    int i, pass, lcc = 0, ok = 1;
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.lines = lines;
+    ctx.n = n;
+    ctx.ins = calloc(n + 1, sizeof(struct peep_ins));
+    // 解析时记号指向副本, 原来的行在没有改动时原样保留
+    copy = calloc(n + 1, sizeof(char *));
+
+    for (i = 0; i < n && ok; i++) {
+        copy[i] = strdup(lines[i]);
+        if (peep_parse(&ctx.ins[i], copy[i]) < 0)
+            ok = 0;
+        if (ctx.ins[i].kind == PK_GADDR || ctx.ins[i].gflag)
+            lcc = 1;
+    }
+
+    if (ok && lcc) {
+        peep_fix_numeric(&ctx);
+        for (pass = 0; pass < PEEP_PASSES; pass++) {
+            int changed = peep_stack(&ctx);
+
+            changed |= peep_local(&ctx);
+            changed |= peep_jumps(&ctx);
+            if (!changed)
+                break;
+        }
+        for (i = 0; i < n; i++) {
+            if (ctx.ins[i].dead || ctx.ins[i].dirty)
+                peep_emit(&ctx, i);
+        }
+    }
+
+    for (i = 0; i < n; i++) {
+        free(copy[i]);
+    }
+    free(copy);
+    free(ctx.ins);
+    return ok && lcc ? ctx.removed : 0;
+}
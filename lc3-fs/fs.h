@@ -0,0 +1,53 @@
+#ifndef _FS_H_
+#define _FS_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// lc3fs: virtio 块设备上的只读文件系统, 由 lc3-mkfs 把主机上的一个目录打包成磁盘镜像,
+// 客户机通过 lc3lib 的 fs.h 访问. 所有单位都是 16 位字, 镜像文件中每个字按主机字节序
+// 占两个字节 (同 --disk). 块设备的 pos 是 16 位, 所以镜像最多 FS_MAX_BLOCKS 块.
+//
+// 块 0:  超级块, 见 struct fs_super
+// 块 1 开始: 目录, 每项 FS_ENTRY_WORDS 个字, 见 struct fs_entry
+// 之后:  文件数据. 每个文件由最多 FS_EXTENTS 个区段 (起始块, 块数) 组成,
+//        lc3-mkfs 把每个文件连续存放, 只用一个区段, 客户机一次请求就能读一大段.
+//
+// 文件内容每个字节占一个字 (同 lcc 的 char), 所以文本文件可以直接交给 printf("%c").
+// 文件大小以字为单位, 不超过 FS_MAX_FILE (lcc 的 int 是有符号 16 位).
+#define FS_MAGIC       0X4C46  /* "LF" */
+#define FS_VERSION     1
+#define FS_BLOCK_SHIFT 8
+#define FS_BLOCK_WORDS (1 << FS_BLOCK_SHIFT)
+#define FS_MAX_BLOCKS  (0X10000 >> FS_BLOCK_SHIFT)
+#define FS_MAX_FILE    0X7FFF
+
+#define FS_NAME_MAX    20      /* 含结尾的 0 */
+#define FS_EXTENTS     5
+#define FS_ENTRY_WORDS 32
+#define FS_ENTRIES_PER_BLOCK (FS_BLOCK_WORDS / FS_ENTRY_WORDS)
+
+struct fs_super {
+    uint16_t magic;
+    uint16_t version;
+    uint16_t block_words;
+    uint16_t blocks;      /* 镜像总块数 */
+    uint16_t dir_start;
+    uint16_t dir_blocks;
+    uint16_t files;
+};
+
+struct fs_extent {
+    uint16_t start;
+    uint16_t blocks;
+};
+
+struct fs_entry {
+    uint16_t name[FS_NAME_MAX];
+    uint16_t size;
+    uint16_t extents;
+    struct fs_extent extent[FS_EXTENTS];
+};
+
+#endif
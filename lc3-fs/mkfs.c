@@ -0,0 +1,206 @@
+#include <string.h>
+#include <dirent.h>
+#include <limits.h>
+#include <sys/stat.h>
+
+#include "fs.h"
+
+struct fs_file {
+    char name[FS_NAME_MAX];
+    char path[PATH_MAX];
+    uint16_t size;
+};
+
+static void usage(const char *prog)
+{
+    printf("usage: %s image dir\n", prog);
+    printf("       %s -l image\n", prog);
+    printf("  pack the regular files in dir into an lc3fs image for lc3-vmm --disk,\n");
+    printf("  one byte per word, each file in one contiguous extent\n");
+    printf("  -l        list the files in image\n");
+}
+
+static int fs_cmp(const void *a, const void *b)
+{
+    return strcmp(((const struct fs_file *)a)->name, ((const struct fs_file *)b)->name);
+}
+
+// 目录中的普通文件, 按名字排序, 镜像的内容与 readdir 的顺序无关
+static int fs_scan(const char *dir, struct fs_file **files)
+{
+    struct fs_file *f = NULL;
+    struct dirent *de;
+    struct stat st;
+    DIR *d;
+    int n = 0, cap = 0;
+
+    d = opendir(dir);
+    if (!d) {
+        printf("cannot open directory %s\n", dir);
+        return -1;
+    }
+    while ((de = readdir(d))) {
+        char path[PATH_MAX];
+
+        snprintf(path, sizeof(path), "%s/%s", dir, de->d_name);
+        if (stat(path, &st) < 0 || !S_ISREG(st.st_mode))
+            continue;
+        if (strlen(de->d_name) >= FS_NAME_MAX) {
+            printf("%s: name longer than %d characters\n", path, FS_NAME_MAX - 1);
+            goto fail;
+        }
+        if (st.st_size > FS_MAX_FILE) {
+            printf("%s: %lld bytes, more than %d\n", path, (long long)st.st_size, FS_MAX_FILE);
+            goto fail;
+        }
+        if (n == cap) {
+            cap = cap ? cap * 2 : 16;
+            f = realloc(f, cap * sizeof(*f));
+        }
+        strcpy(f[n].name, de->d_name);
+        strcpy(f[n].path, path);
+        f[n].size = st.st_size;
+        n++;
+    }
+    closedir(d);
+
+    qsort(f, n, sizeof(*f), fs_cmp);
+    *files = f;
+    return n;
+
+fail:
+    closedir(d);
+    free(f);
+    return -1;
+}
+
+static int fs_pack(const char *image, const char *dir)
+{
+    struct fs_file *files = NULL;
+    struct fs_super *super;
+    struct fs_entry *e;
+    uint16_t *disk;
+    unsigned blocks, dir_blocks, next;
+    int i, j, n, c, ret = -1;
+    FILE *in, *out;
+
+    n = fs_scan(dir, &files);
+    if (n < 0)
+        return -1;
+
+    dir_blocks = n ? (n + FS_ENTRIES_PER_BLOCK - 1) / FS_ENTRIES_PER_BLOCK : 1;
+    blocks = 1 + dir_blocks;
+    for (i = 0; i < n; i++) {
+        blocks += (files[i].size + FS_BLOCK_WORDS - 1) >> FS_BLOCK_SHIFT;
+    }
+    if (blocks > FS_MAX_BLOCKS) {
+        printf("%s needs %u blocks, more than %d\n", dir, blocks, FS_MAX_BLOCKS);
+        free(files);
+        return -1;
+    }
+
+    disk = calloc(blocks, FS_BLOCK_WORDS * sizeof(uint16_t));
+    super = (struct fs_super *)disk;
+    super->magic = FS_MAGIC;
+    super->version = FS_VERSION;
+    super->block_words = FS_BLOCK_WORDS;
+    super->blocks = blocks;
+    super->dir_start = 1;
+    super->dir_blocks = dir_blocks;
+    super->files = n;
+
+    next = 1 + dir_blocks;
+    for (i = 0; i < n; i++) {
+        e = (struct fs_entry *)(disk + FS_BLOCK_WORDS) + i;
+        for (j = 0; files[i].name[j]; j++) {
+            e->name[j] = (unsigned char)files[i].name[j];
+        }
+        e->size = files[i].size;
+        if (!e->size)
+            continue;
+
+        e->extents = 1;
+        e->extent[0].start = next;
+        e->extent[0].blocks = (e->size + FS_BLOCK_WORDS - 1) >> FS_BLOCK_SHIFT;
+
+        in = fopen(files[i].path, "rb");
+        if (!in) {
+            printf("cannot read %s\n", files[i].path);
+            goto out;
+        }
+        for (j = 0; j < e->size && (c = fgetc(in)) != EOF; j++) {
+            disk[next * FS_BLOCK_WORDS + j] = c;
+        }
+        fclose(in);
+        next += e->extent[0].blocks;
+    }
+
+    out = fopen(image, "wb");
+    if (!out || fwrite(disk, FS_BLOCK_WORDS * sizeof(uint16_t), blocks, out) != blocks) {
+        printf("cannot write %s\n", image);
+        if (out)
+            fclose(out);
+        goto out;
+    }
+    if (fclose(out) == 0) {
+        printf("%s: %d files, %u blocks of %d words\n", image, n, blocks, FS_BLOCK_WORDS);
+        ret = 0;
+    }
+
+out:
+    free(disk);
+    free(files);
+    return ret;
+}
+
+static int fs_list(const char *image)
+{
+    struct fs_super super;
+    struct fs_entry e;
+    char name[FS_NAME_MAX];
+    int i, j, ret = -1;
+    FILE *in;
+
+    in = fopen(image, "rb");
+    if (!in) {
+        printf("cannot open %s\n", image);
+        return -1;
+    }
+    if (fread(&super, sizeof(super), 1, in) != 1 || super.magic != FS_MAGIC ||
+            super.block_words != FS_BLOCK_WORDS) {
+        printf("%s: not an lc3fs image\n", image);
+        goto out;
+    }
+
+    printf("%s: %u files, %u blocks\n", image, super.files, super.blocks);
+    for (i = 0; i < super.files; i++) {
+        if (fseek(in, ((long)super.dir_start * FS_BLOCK_WORDS + i * FS_ENTRY_WORDS) * 2, SEEK_SET) < 0 ||
+                fread(&e, sizeof(e), 1, in) != 1)
+            goto out;
+        for (j = 0; j < FS_NAME_MAX - 1 && e.name[j]; j++) {
+            name[j] = e.name[j];
+        }
+        name[j] = '\0';
+        printf("%-20s %6u", name, e.size);
+        for (j = 0; j < e.extents && j < FS_EXTENTS; j++) {
+            printf("  %u+%u", e.extent[j].start, e.extent[j].blocks);
+        }
+        printf("\n");
+    }
+    ret = 0;
+
+out:
+    fclose(in);
+    return ret;
+}
+
+int main(int argc, const char* argv[])
+{
+    if (argc == 3 && !strcmp(argv[1], "-l"))
+        return fs_list(argv[2]) < 0;
+    if (argc == 3 && argv[1][0] != '-')
+        return fs_pack(argv[1], argv[2]) < 0;
+
+    usage(argv[0]);
+    return 2;
+}
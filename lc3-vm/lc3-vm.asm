@@ -0,0 +1,1770 @@
+.Orig x3000
+INIT_CODE
+LEA R6, #-1
+ADD R5, R6, #0
+ADD R6, R6, R6
+ADD R6, R6, R6
+ADD R6, R6, R5
+ADD R6, R6, #-1
+ADD R5, R5, R5
+ADD R5, R6, #0
+LD R4, GLOBAL_DATA_POINTER
+LD R7, GLOBAL_MAIN_POINTER
+jsrr R7
+HALT
+
+GLOBAL_DATA_POINTER .FILL GLOBAL_DATA_START
+GLOBAL_MAIN_POINTER .FILL main
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;virtio_find_empty;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+lc3_virtio_find_empty
+ADD R6, R6, #-2
+STR R7, R6, #0
+ADD R6, R6, #-1
+STR R5, R6, #0
+ADD R5, R6, #-1
+
+ADD R6, R6, #-2
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #7
+ldr R7, R7, #0
+str R7, R5, #-1
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #5
+ldr R7, R7, #0
+str R7, R5, #0
+lc3_L4_main
+ldr R7, R5, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #4
+ldr R3, R3, #0
+;LSH
+ADD R6, R6, #-1
+STR R0, R6, #0
+ADD R0, R7, #0
+ADD R3, R3, #0
+BRz L19
+L18
+ADD R0, R0, R0
+ADD R3, R3, #-1
+BRnp L18
+L19
+ADD R7, R0, #0
+LDR R0, R6, #0
+ADD R6, R6, #1
+ldr R3, R5, #-1
+ADD R2, R4, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #3
+ldr R2, R2, #0
+add R3, R3, R2
+add R7, R7, R3
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #2
+ldr R3, R3, #0
+add R7, R7, R3
+ldr R7, R7, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #1
+ldr R3, R3, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRz L20
+ADD R7, R4, #2
+LDR R7, R7, #0
+jmp R7
+L20
+ldr R7, R5, #0
+ADD R0, R4, #4
+LDR R0, R0, #0
+JMP R0
+lc3_L9_main
+lc3_L5_main
+ldr R7, R5, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #6
+ldr R3, R3, #0
+add R7, R7, R3
+str R7, R5, #0
+ldr R7, R5, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ldr R3, R3, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRnz L21
+ADD R7, R4, #1
+LDR R7, R7, #0
+jmp R7
+L21
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #14
+ldr R7, R7, #0
+lc3_L2_main
+STR R7, R5, #3
+ADD R6, R5, #1
+LDR R5, R6, #0
+ADD R6, R6, #1
+LDR R7, R6, #0
+ADD R6, R6, #1
+RET
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;virtio_blk_read;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+lc3_virtio_blk_read
+ADD R6, R6, #-2
+STR R7, R6, #0
+ADD R6, R6, #-1
+STR R5, R6, #0
+ADD R5, R6, #-1
+
+ADD R6, R6, #-7
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #7
+ldr R7, R7, #0
+str R7, R5, #-1
+AND R7, R7, #0
+str R7, R5, #-6
+ADD R0, R4, #0
+LDR R0, R0, #0
+jsrr R0
+LDR R7, R6, #0
+ADD R6, R6, #1
+str R7, R5, #-2
+ldr R7, R5, #-2
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #1
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R0, R4, #15
+ADD R0, R0, #15
+ADD R0, R0, #1
+LDR R0, R0, #0
+jsrr R0
+LDR R7, R6, #0
+ADD R6, R6, #1
+ldr R7, R5, #-2
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #5
+ldr R3, R3, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRp L41
+ADD R7, R4, #6
+LDR R7, R7, #0
+jmp R7
+L41
+ldr R7, R5, #-2
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #9
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R0, R4, #15
+ADD R0, R0, #15
+ADD R0, R0, #1
+LDR R0, R0, #0
+jsrr R0
+LDR R7, R6, #0
+ADD R6, R6, #1
+ADD R0, R4, #12
+LDR R0, R0, #0
+JMP R0
+lc3_L24_main
+ldr R7, R5, #-2
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #4
+ldr R3, R3, #0
+;LSH
+ADD R6, R6, #-1
+STR R0, R6, #0
+ADD R0, R7, #0
+ADD R3, R3, #0
+BRz L43
+L42
+ADD R0, R0, R0
+ADD R3, R3, #-1
+BRnp L42
+L43
+ADD R7, R0, #0
+LDR R0, R6, #0
+ADD R6, R6, #1
+ldr R3, R5, #-1
+ADD R2, R4, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #3
+ldr R2, R2, #0
+add R3, R3, R2
+add R7, R7, R3
+ldr R3, R7, #0
+ldr R2, R5, #-6
+add R3, R3, R2
+str R3, R5, #-3
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #2
+ldr R3, R3, #0
+add R7, R7, R3
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #8
+ldr R3, R3, #0
+str R3, R7, #0
+ldr R7, R5, #-3
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #6
+ldr R3, R3, #0
+str R3, R7, #0
+ldr R7, R5, #-3
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #3
+ldr R3, R3, #0
+add R7, R7, R3
+ldr R3, R5, #4
+str R3, R7, #0
+ldr R7, R5, #-3
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #2
+ldr R3, R3, #0
+add R7, R7, R3
+ldr R3, R5, #5
+str R3, R7, #0
+ldr R7, R5, #-1
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #7
+ldr R3, R3, #0
+add R7, R7, R3
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #8
+ldr R3, R3, #0
+str R3, R7, #0
+ldr R7, R5, #-1
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #6
+ldr R3, R3, #0
+add R7, R7, R3
+ldr R3, R5, #-2
+str R3, R7, #0
+ADD R0, R4, #15
+ADD R0, R0, #4
+LDR R0, R0, #0
+jsrr R0
+LDR R7, R6, #0
+ADD R6, R6, #1
+ADD R0, R4, #15
+ADD R0, R0, #6
+LDR R0, R0, #0
+jsrr R0
+LDR R7, R6, #0
+ADD R6, R6, #1
+ldr R7, R5, #-1
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #5
+ldr R3, R3, #0
+add R7, R7, R3
+ldr R7, R7, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #8
+ldr R3, R3, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRz L44
+ADD R7, R4, #11
+LDR R7, R7, #0
+jmp R7
+L44
+ldr R7, R5, #-1
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #5
+ldr R3, R3, #0
+add R7, R7, R3
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #1
+ldr R3, R3, #0
+str R3, R7, #0
+ldr R7, R5, #-1
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #4
+ldr R3, R3, #0
+add R3, R7, R3
+ldr R3, R3, #0
+str R3, R5, #-2
+ldr R3, R5, #-2
+ADD R2, R4, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #4
+ldr R2, R2, #0
+;LSH
+ADD R6, R6, #-1
+STR R0, R6, #0
+ADD R0, R3, #0
+ADD R2, R2, #0
+BRz L46
+L45
+ADD R0, R0, R0
+ADD R2, R2, #-1
+BRnp L45
+L46
+ADD R3, R0, #0
+LDR R0, R6, #0
+ADD R6, R6, #1
+ADD R2, R4, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #3
+ldr R2, R2, #0
+add R7, R7, R2
+add R7, R3, R7
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #2
+ldr R3, R3, #0
+add R7, R7, R3
+ldr R7, R7, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #8
+ldr R3, R3, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRz L47
+ADD R7, R4, #10
+LDR R7, R7, #0
+jmp R7
+L47
+ldr R7, R5, #-2
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #4
+ldr R3, R3, #0
+;LSH
+ADD R6, R6, #-1
+STR R0, R6, #0
+ADD R0, R7, #0
+ADD R3, R3, #0
+BRz L49
+L48
+ADD R0, R0, R0
+ADD R3, R3, #-1
+BRnp L48
+L49
+ADD R7, R0, #0
+LDR R0, R6, #0
+ADD R6, R6, #1
+ldr R3, R5, #-1
+ADD R2, R4, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #3
+ldr R2, R2, #0
+add R3, R3, R2
+add R7, R7, R3
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #2
+ldr R3, R3, #0
+add R7, R7, R3
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #1
+ldr R3, R3, #0
+str R3, R7, #0
+ldr R7, R5, #-2
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #4
+ldr R3, R3, #0
+;LSH
+ADD R6, R6, #-1
+STR R0, R6, #0
+ADD R0, R7, #0
+ADD R3, R3, #0
+BRz L51
+L50
+ADD R0, R0, R0
+ADD R3, R3, #-1
+BRnp L50
+L51
+ADD R7, R0, #0
+LDR R0, R6, #0
+ADD R6, R6, #1
+ldr R3, R5, #-1
+ADD R2, R4, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #3
+ldr R2, R2, #0
+add R3, R3, R2
+add R7, R7, R3
+ldr R7, R7, #0
+ldr R3, R5, #-6
+add R7, R7, R3
+str R7, R5, #-5
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #3
+ldr R7, R7, #0
+str R7, R5, #-4
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #5
+ldr R7, R7, #0
+str R7, R5, #0
+ADD R0, R4, #9
+LDR R0, R0, #0
+JMP R0
+lc3_L37_main
+ldr R7, R5, #0
+ldr R3, R5, #6
+add R3, R7, R3
+ldr R2, R5, #-4
+add R7, R2, R7
+ldr R2, R5, #-5
+add R7, R7, R2
+ldr R7, R7, #0
+str R7, R3, #0
+lc3_L38_main
+ldr R7, R5, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #6
+ldr R3, R3, #0
+add R7, R7, R3
+str R7, R5, #0
+lc3_L40_main
+ldr R7, R5, #0
+ldr R3, R5, #5
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRnz L52
+ADD R7, R4, #7
+LDR R7, R7, #0
+jmp R7
+L52
+lc3_L34_main
+lc3_L30_main
+lc3_L22_main
+STR R7, R5, #3
+ADD R6, R5, #1
+LDR R5, R6, #0
+ADD R6, R6, #1
+LDR R7, R6, #0
+ADD R6, R6, #1
+RET
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;virtio_blk_write;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+lc3_virtio_blk_write
+ADD R6, R6, #-2
+STR R7, R6, #0
+ADD R6, R6, #-1
+STR R5, R6, #0
+ADD R5, R6, #-1
+
+ADD R6, R6, #-7
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #7
+ldr R7, R7, #0
+str R7, R5, #-4
+AND R7, R7, #0
+str R7, R5, #-6
+ADD R0, R4, #0
+LDR R0, R0, #0
+jsrr R0
+LDR R7, R6, #0
+ADD R6, R6, #1
+str R7, R5, #-3
+ldr R7, R5, #-3
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #5
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R0, R4, #15
+ADD R0, R0, #15
+ADD R0, R0, #1
+LDR R0, R0, #0
+jsrr R0
+LDR R7, R6, #0
+ADD R6, R6, #1
+ldr R7, R5, #-3
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #5
+ldr R3, R3, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRp L62
+ADD R7, R4, #14
+LDR R7, R7, #0
+jmp R7
+L62
+ldr R7, R5, #-3
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #12
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R0, R4, #15
+ADD R0, R0, #15
+ADD R0, R0, #1
+LDR R0, R0, #0
+jsrr R0
+LDR R7, R6, #0
+ADD R6, R6, #1
+ADD R0, R4, #15
+ADD R0, R0, #3
+LDR R0, R0, #0
+JMP R0
+lc3_L55_main
+ldr R7, R5, #-3
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #4
+ldr R3, R3, #0
+;LSH
+ADD R6, R6, #-1
+STR R0, R6, #0
+ADD R0, R7, #0
+ADD R3, R3, #0
+BRz L64
+L63
+ADD R0, R0, R0
+ADD R3, R3, #-1
+BRnp L63
+L64
+ADD R7, R0, #0
+LDR R0, R6, #0
+ADD R6, R6, #1
+ldr R3, R5, #-4
+ADD R2, R4, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #3
+ldr R2, R2, #0
+add R3, R3, R2
+add R7, R7, R3
+ldr R3, R7, #0
+ldr R2, R5, #-6
+add R3, R3, R2
+str R3, R5, #-5
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #2
+ldr R3, R3, #0
+add R7, R7, R3
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #8
+ldr R3, R3, #0
+str R3, R7, #0
+ldr R7, R5, #-5
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #4
+ldr R3, R3, #0
+str R3, R7, #0
+ldr R7, R5, #-5
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #3
+ldr R3, R3, #0
+add R7, R7, R3
+ldr R3, R5, #4
+str R3, R7, #0
+ldr R7, R5, #-5
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #2
+ldr R3, R3, #0
+add R7, R7, R3
+ldr R3, R5, #5
+str R3, R7, #0
+ldr R7, R5, #-3
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #4
+ldr R3, R3, #0
+;LSH
+ADD R6, R6, #-1
+STR R0, R6, #0
+ADD R0, R7, #0
+ADD R3, R3, #0
+BRz L66
+L65
+ADD R0, R0, R0
+ADD R3, R3, #-1
+BRnp L65
+L66
+ADD R7, R0, #0
+LDR R0, R6, #0
+ADD R6, R6, #1
+ldr R3, R5, #-4
+ADD R2, R4, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #3
+ldr R2, R2, #0
+add R3, R3, R2
+add R7, R7, R3
+ldr R7, R7, #0
+ldr R3, R5, #-6
+add R7, R7, R3
+str R7, R5, #-2
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #3
+ldr R7, R7, #0
+str R7, R5, #-1
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #5
+ldr R7, R7, #0
+str R7, R5, #0
+ADD R0, R4, #15
+ADD R0, R0, #2
+LDR R0, R0, #0
+JMP R0
+lc3_L58_main
+ldr R7, R5, #0
+ldr R3, R5, #-1
+add R3, R3, R7
+ldr R2, R5, #-2
+add R3, R3, R2
+ldr R2, R5, #6
+add R7, R7, R2
+ldr R7, R7, #0
+str R7, R3, #0
+lc3_L59_main
+ldr R7, R5, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #6
+ldr R3, R3, #0
+add R7, R7, R3
+str R7, R5, #0
+lc3_L61_main
+ldr R7, R5, #0
+ldr R3, R5, #5
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRnz L67
+ADD R7, R4, #15
+ADD R7, R7, #0
+LDR R7, R7, #0
+jmp R7
+L67
+ldr R7, R5, #-4
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #7
+ldr R3, R3, #0
+add R7, R7, R3
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #8
+ldr R3, R3, #0
+str R3, R7, #0
+ldr R7, R5, #-4
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #6
+ldr R3, R3, #0
+add R7, R7, R3
+ldr R3, R5, #-3
+str R3, R7, #0
+ADD R0, R4, #15
+ADD R0, R0, #4
+LDR R0, R0, #0
+jsrr R0
+LDR R7, R6, #0
+ADD R6, R6, #1
+ADD R0, R4, #15
+ADD R0, R0, #6
+LDR R0, R0, #0
+jsrr R0
+LDR R7, R6, #0
+ADD R6, R6, #1
+lc3_L53_main
+STR R7, R5, #3
+ADD R6, R5, #1
+LDR R5, R6, #0
+ADD R6, R6, #1
+LDR R7, R6, #0
+ADD R6, R6, #1
+RET
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;virtio_kick;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+lc3_virtio_kick
+ADD R6, R6, #-2
+STR R7, R6, #0
+ADD R6, R6, #-1
+STR R5, R6, #0
+ADD R5, R6, #-1
+
+ADD R6, R6, #-1
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #11
+ldr R7, R7, #0
+str R7, R5, #0
+ldr R7, R5, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #8
+ldr R3, R3, #0
+str R3, R7, #0
+lc3_L68_main
+STR R7, R5, #3
+ADD R6, R5, #1
+LDR R5, R6, #0
+ADD R6, R6, #1
+LDR R7, R6, #0
+ADD R6, R6, #1
+RET
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;virtio_wait_replay;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+lc3_virtio_wait_replay
+ADD R6, R6, #-2
+STR R7, R6, #0
+ADD R6, R6, #-1
+STR R5, R6, #0
+ADD R5, R6, #-1
+
+ADD R6, R6, #-1
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #11
+ldr R7, R7, #0
+str R7, R5, #0
+ADD R0, R4, #15
+ADD R0, R0, #9
+LDR R0, R0, #0
+JMP R0
+lc3_L71_main
+ldr R7, R5, #0
+ldr R7, R7, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #10
+ldr R3, R3, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRz L77
+ADD R7, R4, #15
+ADD R7, R7, #8
+LDR R7, R7, #0
+jmp R7
+L77
+ADD R0, R4, #15
+ADD R0, R0, #10
+LDR R0, R0, #0
+JMP R0
+lc3_L74_main
+lc3_L72_main
+ADD R0, R4, #15
+ADD R0, R0, #7
+LDR R0, R0, #0
+JMP R0
+lc3_L73_main
+lc3_L70_main
+STR R7, R5, #3
+ADD R6, R5, #1
+LDR R5, R6, #0
+ADD R6, R6, #1
+LDR R7, R6, #0
+ADD R6, R6, #1
+RET
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;main;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+main
+ADD R6, R6, #-2
+STR R7, R6, #0
+ADD R6, R6, #-1
+STR R5, R6, #0
+ADD R5, R6, #-1
+
+ADD R6, R6, #-16
+ADD R6, R6, #-3
+ADD R7, R5, #-16
+ADD R7, R7, #-2
+str R7, R5, #-1
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ldr R7, R7, #0
+str R7, R5, #-2
+ldr R7, R5, #-1
+ADD R6, R6, #-1
+STR R7, R6, #0
+ldr R7, R5, #-2
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #9
+ldr R7, R7, #0
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R0, R4, #5
+LDR R0, R0, #0
+jsrr R0
+ldr R7, R5, #-1
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #7
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R0, R4, #15
+ADD R0, R0, #15
+ADD R0, R0, #1
+LDR R0, R0, #0
+jsrr R0
+LDR R7, R6, #0
+ADD R6, R6, #1
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #5
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R0, R4, #15
+ADD R0, R0, #15
+ADD R0, R0, #1
+LDR R0, R0, #0
+jsrr R0
+LDR R7, R6, #0
+ADD R6, R6, #1
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #5
+ldr R7, R7, #0
+str R7, R5, #0
+ADD R0, R4, #15
+ADD R0, R0, #14
+LDR R0, R0, #0
+JMP R0
+lc3_L82_main
+ldr R7, R5, #0
+ldr R3, R5, #-1
+add R7, R7, R3
+ldr R3, R7, #0
+ADD R2, R4, #15
+ADD R2, R2, #15
+ADD R2, R2, #4
+ldr R2, R2, #0
+ADD R6, R6, #-1
+STR R0, R6, #0
+ADD R6, R6, #-1
+STR R2, R6, #0
+NOT R2, R2
+ADD R2, R2, #1
+ADD R0, R3, R2
+LDR R2, R6, #0
+ADD R6, R6, #1
+ADD R3, R0, #0
+LDR R0, R6, #0
+ADD R6, R6, #1
+str R3, R7, #0
+lc3_L83_main
+ldr R7, R5, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #6
+ldr R3, R3, #0
+add R7, R7, R3
+str R7, R5, #0
+lc3_L85_main
+ldr R7, R5, #0
+ldr R3, R5, #-2
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRnz L88
+ADD R7, R4, #15
+ADD R7, R7, #12
+LDR R7, R7, #0
+jmp R7
+L88
+ldr R7, R5, #-1
+ADD R6, R6, #-1
+STR R7, R6, #0
+ldr R7, R5, #-2
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ldr R7, R7, #0
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R0, R4, #13
+LDR R0, R0, #0
+jsrr R0
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #2
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R0, R4, #15
+ADD R0, R0, #15
+ADD R0, R0, #1
+LDR R0, R0, #0
+jsrr R0
+LDR R7, R6, #0
+ADD R6, R6, #1
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #5
+ldr R7, R7, #0
+lc3_L78_main
+STR R7, R5, #3
+ADD R6, R5, #1
+LDR R5, R6, #0
+ADD R6, R6, #1
+LDR R7, R6, #0
+ADD R6, R6, #1
+RET
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+;	void printf(const char *format, ...)
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+
+PRINTF_PERCENT .FILL -37
+PRINTF_C .FILL -99
+PRINTF_D .FILL -100
+PRINTF_S .FILL -115
+PRINTF_B .FILL -98
+PRINTF_O .FILL -111
+PRINTF_X .FILL -120
+PRINTF_ASCII .FILL 48 		;postive ascii value of '0'
+.FILL 49
+.FILL 50
+.FILL 51
+.FILL 52
+.FILL 53
+.FILL 54
+.FILL 55
+.FILL 56
+.FILL 57
+.FILL 65        ;A
+.FILL 66
+.FILL 67
+.FILL 68
+.FILL 69
+.FILL 70
+PRINTF_MINUS .FILL 45  
+PRINTF_BUF .BLKW 18
+ 
+
+lc3_printf
+ADD R6, R6, #-2
+STR R7, R6, #0		;return address
+ADD R6, R6, #-1
+STR R5, R6, #0
+ADD R5, R6, #-1
+
+ADD R6, R6, #-1
+STR R4, R6, #0
+
+ADD R5, R5, #4		;cheating with the bp (no longer bp)
+LDR R4, R5, #0		;got addr of format string
+
+
+PRINTF_LOOP	;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+
+LDR R0, R4, #0
+
+ADD R0, R0, #0		;End of string? (0x0000)
+BRz PRINTF_DONE
+
+ADD R2, R0, #0
+LD R1, PRINTF_PERCENT
+ADD R2, R2, R1
+BRnp PRINTF_CHAR		
+
+ADD R4, R4, #1
+LDR R0, R4, #0
+;is it %c?
+ADD R2, R0, #0
+LD R3, PRINTF_C
+ADD R2, R2, R3
+BRnp PRINTF_CHECKSTR
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;%c
+ADD R5, R5, #1
+LDR R0, R5, #0
+
+PRINTF_CHAR
+OUT
+
+ADD R4, R4, #1
+BRnzp PRINTF_LOOP
+
+PRINTF_CHECKSTR
+;is it %s?
+ADD R2, R0, #0
+LD R7, PRINTF_S
+ADD R2, R2, R7
+BRnp PRINTF_CHECKDEC		
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;%s
+
+ADD R5, R5, #1
+LDR R0, R5, #0
+PUTS
+
+ADD R4, R4, #1
+BRnzp PRINTF_LOOP
+
+PRINTF_CHECKDEC
+;is it %d?
+ADD R2, R0, #0
+LD R7, PRINTF_D
+ADD R2, R2, R7
+;BRnp PRINTF_ERROR
+BRnp PRINTF_CHECKHEX
+
+AND R2, R2, #0
+ADD R2, R2, #-10		;going to divide by 10 by using sub loop
+BRnzp PRINTF_NUM
+
+PRINTF_CHECKHEX
+
+ADD R2, R0, #0
+LD R7, PRINTF_X
+ADD R2, R2, R7
+BRnp PRINTF_CHECKOCT
+
+AND R2, R2, #0
+ADD R2, R2, #-16		;going to divide by 10 by using sub loop
+BRnzp PRINTF_NUM
+
+PRINTF_CHECKOCT
+
+ADD R2, R0, #0
+LD R7, PRINTF_O
+ADD R2, R2, R7
+BRnp PRINTF_CHECKBIN
+
+AND R2, R2, #0
+ADD R2, R2, #-8		;going to divide by 10 by using sub loop
+BRnzp PRINTF_NUM
+
+PRINTF_CHECKBIN
+
+ADD R2, R0, #0
+LD R7, PRINTF_B
+ADD R2, R2, R7
+BRnp PRINTF_ERROR
+
+AND R2, R2, #0
+ADD R2, R2, #-2		;going to divide by 10 by using sub loop
+;BRnzp PRINTF_NUM
+
+
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;%d
+PRINTF_NUM
+
+LEA R7, PRINTF_BUF
+ADD R7, R7, #15 
+ADD R7, R7, #1 
+
+;AND R2, R2, #0
+;ADD R2, R2, #-10		;going to divide by 10 by using sub loop
+
+ADD R5, R5, #1			;acquire the binary number
+LDR R0, R5, #0
+
+ADD R0, R0, #0
+BRzp PRINTF_DECPOS 
+
+NOT R0, R0				;make num positive for sub loop
+ADD R0, R0, #1
+
+PRINTF_DECPOS
+
+AND R3, R3, #0
+ADD R3, R3, #-1
+
+PRINTF_DIVLOOP
+ADD R3, R3, #1			;num/10 
+ADD R0, R0, R2			;R0 = num % 10 - 10
+BRzp PRINTF_DIVLOOP
+
+ADD R3, R3, #0
+BRz PRINTF_LASTDIGIT
+
+;LD R1, PRINTF_ASCII
+;ADD R1, R1, R0
+;NOT R2, R2
+;ADD R1, R1, R2 
+;ADD R1, R1, #1
+;NOT R2, R2
+;;;;;ADD R1, R1, #10
+;STR R1, R7, #0
+;ADD R7, R7, #-1			;stored ascii value of one digit
+
+LEA R1, PRINTF_ASCII
+ADD R1, R1, R0
+NOT R2, R2
+ADD R1, R1, R2 
+ADD R1, R1, #1
+NOT R2, R2
+LDR R1, R1, #0
+STR R1, R7, #0
+ADD R7, R7, #-1			;stored ascii value of one digit
+
+ADD R0, R3, #0			;num/10
+
+BRnzp PRINTF_DECPOS
+
+PRINTF_LASTDIGIT
+
+;LD R1, PRINTF_ASCII
+;ADD R1, R1, R0
+;ADD R1, R1, #10
+;STR R1, R7, #0
+
+LEA R1, PRINTF_ASCII
+ADD R1, R1, R0
+NOT R2, R2
+ADD R1, R1, R2 
+ADD R1, R1, #1
+NOT R2, R2
+LDR R1, R1, #0
+STR R1, R7, #0			;stored ascii value of highest order digit
+
+LDR R0, R5, #0
+ADD R0, R0, #0
+BRzp PRINTF_DECSTRING
+
+LD R0, PRINTF_MINUS		;num was negative
+ADD R7, R7, #-1
+STR R0, R7, #0			;stored ascii value negative sign
+
+PRINTF_DECSTRING		;print the calculated string
+ADD R0, R7, #0
+PUTS
+
+ADD R4, R4, #1
+BRnzp PRINTF_LOOP
+
+PRINTF_ERROR
+PRINTF_DONE
+
+LDR R4, R6, #0		;restore R4
+ADD R6, R6, #1
+
+LDR R5, R6, #0		;restore bp
+ADD R6, R6, #1
+
+LDR R7, R6, #0		;restore ret addr
+ADD R6, R6, #1
+
+RET
+
+GLOBAL_DATA_START
+virtio_find_empty .FILL lc3_virtio_find_empty
+L4_main .FILL lc3_L4_main
+L9_main .FILL lc3_L9_main
+L5_main .FILL lc3_L5_main
+L2_main .FILL lc3_L2_main
+virtio_blk_read .FILL lc3_virtio_blk_read
+L24_main .FILL lc3_L24_main
+L37_main .FILL lc3_L37_main
+L38_main .FILL lc3_L38_main
+L40_main .FILL lc3_L40_main
+L34_main .FILL lc3_L34_main
+L30_main .FILL lc3_L30_main
+L22_main .FILL lc3_L22_main
+virtio_blk_write .FILL lc3_virtio_blk_write
+L55_main .FILL lc3_L55_main
+L58_main .FILL lc3_L58_main
+L59_main .FILL lc3_L59_main
+L61_main .FILL lc3_L61_main
+L53_main .FILL lc3_L53_main
+virtio_kick .FILL lc3_virtio_kick
+L68_main .FILL lc3_L68_main
+virtio_wait_replay .FILL lc3_virtio_wait_replay
+L71_main .FILL lc3_L71_main
+L74_main .FILL lc3_L74_main
+L72_main .FILL lc3_L72_main
+L73_main .FILL lc3_L73_main
+L70_main .FILL lc3_L70_main
+L82_main .FILL lc3_L82_main
+L83_main .FILL lc3_L83_main
+L85_main .FILL lc3_L85_main
+L78_main .FILL lc3_L78_main
+printf .FILL lc3_printf
+L87_main .STRINGZ "\n"
+L86_main .FILL #3
+L81_main .STRINGZ "\n"
+L80_main .STRINGZ "- read buf: %s \n"
+L79_main .FILL #20
+L76_main .FILL #2
+L69_main .FILL #256
+L57_main .STRINGZ "- write error idx: %d\n"
+L54_main .STRINGZ "- find empty desc idx: %d \n"
+L36_main .FILL #3
+L33_main .FILL #44
+L32_main .FILL #43
+L29_main .FILL #42
+L28_main .FILL #41
+L27_main .FILL #1
+L26_main .STRINGZ "- read error idx: %d\n"
+L23_main .STRINGZ "- find empty desc idx: %d \n"
+L17_main .FILL #-1
+L16_main .FILL #10
+L14_main .FILL #0
+L13_main .FILL #2
+L12_main .FILL #1
+L11_main .FILL #2
+L8_main .FILL #0
+L15_main .FILL #1
+L3_main .FILL #32767
+.END
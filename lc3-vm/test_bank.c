@@ -0,0 +1,50 @@
+// 扩展内存: 窗口 xC000 - xDFFF 映射到 BANK_SELECT 选中的 bank, 需要 --banks 启动
+#define BANK_SELECT ((int *)0x7F10)
+#define BANK_COUNT  ((int *)0x7F11)
+// xC000, lcc 把大于 x7FFF 的整数常量截成 x8000, 这里写成负数
+#define WINDOW      ((int *)-16384)
+#define WINDOW_WORDS 8192
+
+fill(b) {
+	int i, *p;
+
+	*BANK_SELECT = b;
+	p = WINDOW;
+	for (i = 0; i < WINDOW_WORDS; i++) {
+		*p++ = b + i;
+	}
+}
+
+check(b) {
+	int i, *p, bad;
+
+	*BANK_SELECT = b;
+	p = WINDOW;
+	bad = 0;
+	for (i = 0; i < WINDOW_WORDS; i++) {
+		if (*p++ != b + i)
+			bad++;
+	}
+	return bad;
+}
+
+main() {
+	int b, n, bad;
+
+	n = *BANK_COUNT;
+	printf("banks %d\n", n);
+	for (b = 0; b < n; b++) {
+		fill(b);
+	}
+
+	bad = 0;
+	for (b = n - 1; b >= 0; b--) {
+		bad = bad + check(b);
+	}
+	printf("mismatch %d\n", bad);
+
+	// 超出范围的选择被忽略
+	*BANK_SELECT = 2;
+	*BANK_SELECT = n;
+	printf("select %d first %d\n", *BANK_SELECT, WINDOW[0]);
+}
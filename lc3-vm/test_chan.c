@@ -0,0 +1,101 @@
+// 虚拟机间通道: 需要 --chan 和 --smp 2 启动. CPU 1 从队列 0 取数, 加工后放入队列 1,
+// CPU 0 生产队列 0 并检查队列 1 的结果和顺序. 多个 lc3-vmm 进程映射同一文件时用法相同
+#define CHAN_KICK    ((int *)0x7F30)
+#define CHAN_WAIT_RX ((int *)0x7F31)
+#define CHAN_WAIT_TX ((int *)0x7F32)
+// xF000, lcc 把大于 x7FFF 的整数常量截成 x8000, 这里写成负数
+#define CHAN         ((int *)-4096)
+#define SMP_BOOT_PC  ((int *)0x7F28)
+#define SMP_BOOT_SP  ((int *)0x7F29)
+#define SMP_BOOT     ((int *)0x7F2A)
+#define STACK_TOP    (-8192)
+#define COUNT        3000
+#define BATCH        200
+
+// 队列头: HEAD, TAIL, SIZE, DATA
+#define RING(n)      (CHAN + 16 + (n) * 8)
+
+send(n, v) {
+	int *r, head;
+
+	r = RING(n);
+	head = r[0];
+	while (head - r[1] == r[2])
+		*CHAN_WAIT_TX = n;
+	CHAN[r[3] + (head & (r[2] - 1))] = v;
+	r[0] = head + 1;
+	*CHAN_KICK = n;
+}
+
+recv(n) {
+	int *r, tail, v;
+
+	r = RING(n);
+	tail = r[1];
+	while (r[0] == tail)
+		*CHAN_WAIT_RX = n;
+	v = CHAN[r[3] + (tail & (r[2] - 1))];
+	r[1] = tail + 1;
+	*CHAN_KICK = n;
+	return v;
+}
+
+// lcc 在循环中调用带参数的函数时, 实参留在栈上直到外层函数返回,
+// 所以循环按批分到单独的函数里, 否则栈会一直向下长到另一个 CPU 的栈
+stage_batch() {
+	int i, v;
+
+	// lcc 的移位循环会改掉存放常量的寄存器, 这里不用 * 2
+	for (i = 0; i < BATCH; i++) {
+		v = recv(0);
+		send(1, v + v + 1);
+	}
+}
+
+stage() {
+	int i;
+
+	for (i = 0; i < COUNT; i += BATCH)
+		stage_batch();
+}
+
+produce(first) {
+	int i;
+
+	for (i = 0; i < BATCH; i++)
+		send(0, first + i);
+}
+
+// 返回顺序或数值不对的个数
+consume(first) {
+	int i, bad;
+
+	bad = 0;
+	for (i = 0; i < BATCH; i++) {
+		if (recv(1) != first + first + i + i + 1)
+			bad++;
+	}
+	return bad;
+}
+
+main() {
+	int i, bad;
+
+	if (CHAN[0] != 17224) {
+		printf("no channel\n");
+		return 1;
+	}
+
+	*SMP_BOOT_PC = *(int *)stage;
+	*SMP_BOOT_SP = STACK_TOP;
+	*SMP_BOOT = 1;
+
+	// 每批不超过一个队列的容量, 两个队列都满时不会互相等待
+	bad = 0;
+	for (i = 0; i < COUNT; i += BATCH) {
+		produce(i);
+		bad += consume(i);
+	}
+	printf("sent %d received %d bad %d\n", COUNT, i, bad);
+	return 0;
+}
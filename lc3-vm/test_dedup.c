@@ -0,0 +1,45 @@
+// 页去重: 内容相同的页共用池中的一份, 写入时复制, 不影响其它共享同一份的页
+int a[3000];
+
+// 每页 2048 字
+int *page(n) {
+	return (int *)(n * 2048);
+}
+
+sum(p, n) int *p; {
+	int i, s;
+
+	s = 0;
+	for (i = 0; i < n; i++)
+		s = s + p[i];
+	return s;
+}
+
+main() {
+	int i, j, *p, *q;
+
+	// x8000 和 x8800 都是全零页, 合并到池中的同一页
+	p = page(16);
+	q = page(17);
+	p[5] = 7;
+	printf("zero %d %d %d\n", p[5], q[5], sum(q, 2048));
+
+	// 跨页的全局数组, 全部写一遍
+	for (i = 0; i < 3000; i++)
+		a[i] = i;
+	printf("array %d %d\n", sum(a, 3000), a[2999]);
+
+	// 两页写成相同的内容, 运行一段时间让扫描线程有机会合并, 再分别改写
+	p = page(20);
+	q = page(21);
+	for (i = 0; i < 2048; i++) {
+		p[i] = i;
+		q[i] = i;
+	}
+	for (j = 0; j < 20; j++)
+		i = sum(a, 3000);
+	p[100] = -1;
+	q[200] = -2;
+	printf("copy %d %d %d %d\n", p[100], p[200], q[100], q[200]);
+	printf("sum %d %d\n", sum(p, 2048), sum(q, 2048));
+}
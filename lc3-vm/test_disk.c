@@ -0,0 +1,113 @@
+// virtio 块设备读写, 需要 --disk 启动; 磁盘第 i 个字为 3i+1 (test/golden/test_disk.disk)
+#define INTERRUPT_VIRTIO 0x0100
+#define DEVICE_VIRTIO    0x7FFF
+#define VRING_SIZE       10
+#define BLK_R            1
+#define BLK_W            2
+#define CHUNK            16
+
+struct vring_desc {
+	int addr;
+	int len;
+	int flags;
+	int next;
+};
+
+struct vring {
+	int num;
+	struct vring_desc desc[VRING_SIZE];
+	int avail_flags;
+	int avail_idx;
+	int used_flags;
+	int used_idx;
+};
+
+struct virtio_blk {
+	int flag;
+	int pos;
+	int len;
+	int buf[CHUNK];
+};
+
+request(flag, pos, len, buf)
+int *buf;
+{
+	struct vring *ring;
+	struct virtio_blk *vb;
+	int *kick;
+	int i, idx;
+
+	ring = (struct vring *)DEVICE_VIRTIO;
+	kick = (int *)INTERRUPT_VIRTIO;
+	for (idx = 0; idx < VRING_SIZE; idx++) {
+		if (ring->desc[idx].flags == 0)
+			break;
+	}
+	if (idx == VRING_SIZE)
+		return -1;
+
+	vb = (struct virtio_blk *)ring->desc[idx].addr;
+	ring->desc[idx].flags = 1;
+	vb->flag = flag;
+	vb->pos = pos;
+	vb->len = len;
+	if (flag == BLK_W) {
+		for (i = 0; i < len; i++)
+			vb->buf[i] = buf[i];
+	}
+	ring->avail_flags = 1;
+	ring->avail_idx = idx;
+
+	*kick = 1;
+	while (*kick != 2)
+		;
+
+	if (flag == BLK_R && ring->used_flags == 1) {
+		ring->used_flags = 0;
+		idx = ring->used_idx;
+		ring->desc[idx].flags = 0;
+		vb = (struct virtio_blk *)ring->desc[idx].addr;
+		for (i = 0; i < len; i++)
+			buf[i] = vb->buf[i];
+	}
+	return 0;
+}
+
+// 顺序读 [pos, pos + n), 返回与 3i+1 不符的字数
+check(pos, n) {
+	int buf[CHUNK];
+	int i, j, bad;
+
+	bad = 0;
+	for (i = pos; i < pos + n; i += CHUNK) {
+		request(BLK_R, i, CHUNK, buf);
+		for (j = 0; j < CHUNK; j++) {
+			if (buf[j] != 3 * (i + j) + 1)
+				bad++;
+		}
+	}
+	return bad;
+}
+
+main() {
+	int buf[CHUNK];
+	int i, bad;
+
+	printf("sequential mismatch %d\n", check(0, 512));
+
+	// 跨页写入 (页大小 256 字), 再读回
+	for (i = 0; i < CHUNK; i++)
+		buf[i] = -i;
+	request(BLK_W, 760, CHUNK, buf);
+	for (i = 0; i < CHUNK; i++)
+		buf[i] = 0;
+	request(BLK_R, 760, CHUNK, buf);
+	bad = 0;
+	for (i = 0; i < CHUNK; i++) {
+		if (buf[i] != -i)
+			bad++;
+	}
+	printf("write mismatch %d\n", bad);
+	printf("tail mismatch %d\n", check(776, 64));
+	return 0;
+}
@@ -0,0 +1,99 @@
+// lc3fs: 列目录, 读文本文件, 大文件按不同大小顺序读和随机定位 (test/fs 打包成 test/golden/test_fs.disk)
+#include "fs.h"
+
+int buf[100];
+
+// 从头读完 fd, 每次最多 chunk 个字; 返回行数, 字节和 (模 10000) 放在 sum[0]
+lines(fd, chunk, sum) int *sum; {
+	int n, i, nl, s;
+
+	fs_seek(fd, 0);
+	nl = 0;
+	s = 0;
+	while ((n = fs_read(fd, buf, chunk)) > 0) {
+		for (i = 0; i < n; i++) {
+			if (buf[i] == '\n')
+				nl++;
+			s = s + buf[i];
+			if (s >= 10000)
+				s = s - 10000;
+		}
+	}
+	sum[0] = s;
+	return nl;
+}
+
+// 从 pos 读到文件末尾 (不超过 1000 个字), 一次 fs_read; 返回读到的字数, 字节和 (模 10000) 放在 sum[0].
+// 数组放在栈上: lcc 用一串 ADD 访问大全局数组后面的全局变量, 程序会长到设备区
+whole(fd, pos, sum) int *sum; {
+	int w[1000];
+	int n, i, s;
+
+	fs_seek(fd, pos);
+	n = fs_read(fd, w, 1000);
+	s = 0;
+	for (i = 0; i < n; i++) {
+		s = s + w[i];
+		if (s >= 10000)
+			s = s - 10000;
+	}
+	sum[0] = s;
+	return n;
+}
+
+show(n) {
+	int i;
+
+	for (i = 0; i < n; i++)
+		printf("%c", buf[i] == '\n' ? '|' : buf[i]);
+	printf("\n");
+}
+
+main() {
+	char name[FS_NAME_MAX];
+	int i, n, fd, sum[1];
+
+	printf("files %d\n", fs_mount());
+	for (i = 0; (n = fs_list(i, name)) >= 0; i++)
+		printf("%s %d\n", name, n);
+
+	fd = fs_open("hello.txt");
+	n = fs_read(fd, buf, 100);
+	printf("hello %d ", n);
+	show(n);
+	printf("eof %d\n", fs_read(fd, buf, 100));
+	fs_close(fd);
+
+	printf("missing %d\n", fs_open("nothere"));
+	fd = fs_open("empty.txt");
+	printf("empty %d %d\n", fs_length(fd), fs_read(fd, buf, 10));
+	fs_close(fd);
+
+	// 顺序读: 每 FS_BUF 个字一次请求, 小块读从缓冲区取
+	fd = fs_open("numbers.txt");
+	n = lines(fd, 100, sum);
+	printf("numbers %d lines %d sum %d\n", fs_length(fd), n, sum[0]);
+	n = lines(fd, 7, sum);
+	printf("chunk 7 lines %d sum %d\n", n, sum[0]);
+
+	// 跨块和跨缓冲区的位置
+	fs_seek(fd, 250);
+	n = fs_read(fd, buf, 12);
+	show(n);
+	fs_seek(fd, 1020);
+	n = fs_read(fd, buf, 12);
+	show(n);
+	fs_seek(fd, 3880);
+	n = fs_read(fd, buf, 100);
+	printf("tail %d ", n);
+	show(n);
+
+	// 要读的字数盖住区段的剩余部分: 跨 5 个块也只有一次请求, 直接读进调用者的数组
+	n = whole(fd, 2900, sum);
+	printf("from 2900 %d sum %d\n", n, sum[0]);
+	n = whole(fd, 3840, sum);
+	printf("from 3840 %d sum %d\n", n, sum[0]);
+	printf("eof %d\n", fs_read(fd, buf, 10));
+	fs_close(fd);
+	return 0;
+}
@@ -0,0 +1,12 @@
+; test/gdb.sh 的客户机: 在 x3005 设断点, 停下时 R0 = MSG, R1 = 0
+	.ORIG x3000
+	LEA R0, MSG
+	AND R1, R1, #0
+	ADD R1, R1, #5
+LOOP	ADD R1, R1, #-1
+	BRp LOOP
+	ADD R2, R1, #7
+	PUTS
+	HALT
+MSG	.STRINGZ "gdb done"
+	.END
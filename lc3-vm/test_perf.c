@@ -0,0 +1,77 @@
+// 性能计数器: 开始/停止/清零, 各计数器的下限, 停止后不再变化, 超过 16 位的值
+#include "perf.h"
+
+int a[100];
+
+// 计数器 n 是否至少为 x (x < 32768)
+atleast(n, x) {
+	int v[4];
+
+	perf_read(n, v);
+	return v[1] || v[2] || v[3] || v[0] < 0 || v[0] >= x;
+}
+
+same(n) {
+	int v[4], w[4], i;
+
+	perf_read(n, v);
+	for (i = 0; i < 100; i++)
+		a[i] = a[i] + 1;
+	perf_read(n, w);
+	return v[0] == w[0] && v[1] == w[1] && v[2] == w[2] && v[3] == w[3];
+}
+
+fill() {
+	int i;
+
+	for (i = 0; i < 100; i++)
+		a[i] = i;
+}
+
+main() {
+	int i, j, n, v[4];
+
+	printf("idle %d %d\n", *PERF_CTRL, atleast(PERF_INSNS, 1));
+
+	perf_reset();
+	perf_start();
+	fill();
+	perf_stop();
+	printf("running %d\n", *PERF_CTRL);
+	printf("insns %d loads %d stores %d branches %d\n", atleast(PERF_INSNS, 300),
+			atleast(PERF_LOADS, 100), atleast(PERF_STORES, 100), atleast(PERF_BRANCHES, 99));
+	printf("traps ");
+	perf_print(PERF_TRAPS);
+	printf("\n");
+	printf("frozen %d %d\n", same(PERF_INSNS), same(PERF_USEC));
+
+	// 再次开始时在原来的值上累加
+	perf_start();
+	for (j = 0; j < 3; j++)
+		fill();
+	perf_stop();
+	printf("more %d\n", atleast(PERF_STORES, 400));
+
+	perf_reset();
+	printf("reset %d %d\n", atleast(PERF_INSNS, 1), atleast(PERF_STORES, 1));
+
+	// 每个 TRAP 都计数
+	perf_start();
+	printf("abc\n");
+	perf_stop();
+	printf("printf traps ");
+	perf_print(PERF_TRAPS);
+	printf("\n");
+
+	// 超过 16 位
+	perf_reset();
+	perf_start();
+	n = 0;
+	for (j = 0; j < 100; j++) {
+		for (i = 0; i < 100; i++)
+			n = n + a[i];
+	}
+	perf_stop();
+	perf_read(PERF_INSNS, v);
+	printf("wide %d\n", v[1] != 0 || v[2] != 0);
+}
@@ -0,0 +1,37 @@
+// 行输入: scanf 的 %d %s %c 和格式中的字符, 数字后面的字符留给下一次读,
+// 比输入缓冲区长的行, getchar 读到输入结束 (test/golden/test_scanf.in)
+char s[100];
+
+main() {
+	int a, b, c, d, n, lines, sum, last;
+
+	scanf("%d", &a);
+	scanf("%d", &b);
+	printf("a %d b %d\n", a, b);
+	scanf("%d,%d", &a, &b);
+	printf("pair %d %d\n", a, b);
+	scanf("%s", s);
+	printf("str [%s]\n", s);
+	scanf("%c%c", &c, &d);
+	printf("chars %c %c\n", c, d);
+	printf("newline %d\n", getchar() == '\n');
+
+	// 300 个数字的一行和没有换行结尾的最后一行
+	n = 0;
+	lines = 0;
+	sum = 0;
+	while ((c = getchar()) != -1) {
+		n++;
+		if (c == '\n')
+			lines++;
+		else if (c >= '0' && c <= '9')
+			sum = sum + c - '0';
+		last = c;
+	}
+	printf("\nrest %d lines %d sum %d last %c\n", n, lines, sum, last);
+	printf("eof %d\n", getchar());
+	a = 99;
+	scanf("%d", &a);
+	printf("eof scanf %d\n", a);
+	return 0;
+}
@@ -0,0 +1,74 @@
+// 多处理器: 需要 --smp 启动. 每个 CPU 在自旋锁下累加 counter, 再用 CAS 累加 cas_counter
+#define SMP_CPUID   ((int *)0x7F20)
+#define SMP_NCPUS   ((int *)0x7F21)
+#define SMP_ADDR    ((int *)0x7F23)
+#define SMP_OLD     ((int *)0x7F24)
+#define SMP_NEW     ((int *)0x7F25)
+#define SMP_CAS     ((int *)0x7F26)
+#define SMP_TAS     ((int *)0x7F27)
+#define SMP_BOOT_PC ((int *)0x7F28)
+#define SMP_BOOT_SP ((int *)0x7F29)
+#define SMP_BOOT    ((int *)0x7F2A)
+// xE000, lcc 把大于 x7FFF 的整数常量截成 x8000, 这里写成负数
+#define STACK_TOP   (-8192)
+#define STACK_WORDS 512
+#define ROUNDS      200
+
+int lock;
+int counter;
+int cas_counter;
+int done;
+int hits[8];
+
+acquire() {
+	*SMP_ADDR = (int)&lock;
+	while (*SMP_TAS)
+		;
+}
+
+release() {
+	lock = 0;
+}
+
+worker() {
+	int i, id, old;
+
+	id = *SMP_CPUID;
+	for (i = 0; i < ROUNDS; i++) {
+		acquire();
+		counter = counter + 1;
+		hits[id] = hits[id] + 1;
+		release();
+
+		do {
+			old = cas_counter;
+			*SMP_ADDR = (int)&cas_counter;
+			*SMP_OLD = old;
+			*SMP_NEW = old + 1;
+		} while (*SMP_CAS != old);
+	}
+
+	acquire();
+	done = done + 1;
+	release();
+}
+
+main() {
+	int n, c;
+
+	n = *SMP_NCPUS;
+	for (c = 1; c < n; c++) {
+		// lcc 的函数指针指向全局数据表中的表项, 表项里才是函数的地址
+		*SMP_BOOT_PC = *(int *)worker;
+		*SMP_BOOT_SP = STACK_TOP - c * STACK_WORDS;
+		*SMP_BOOT = c;
+	}
+	worker();
+	while (done != n)
+		;
+
+	printf("cpus %d counter %d cas %d\n", n, counter, cas_counter);
+	for (c = 0; c < n; c++)
+		printf("cpu %d: %d\n", c, hits[c]);
+	return 0;
+}
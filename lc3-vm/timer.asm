@@ -0,0 +1,61 @@
+; 定时器设备示例: 每 200 条指令触发一次中断, 中断处理程序打印 '.' 并计数,
+; 主程序等待 5 次中断后关闭定时器.
+.ORIG x3000
+
+LEA R0, TIMER_HANDLER
+STI R0, TIMER_VECTOR        ; 安装中断处理程序
+
+LD R0, TIMER_PERIOD
+STI R0, TIMER_PERIOD_L
+AND R0, R0, #0
+STI R0, TIMER_PERIOD_H
+LD R0, TIMER_MODE
+STI R0, TIMER_CTRL          ; 使能, 周期, 中断
+
+WAIT_LOOP
+LD R1, TICKS
+ADD R1, R1, #-5
+BRn WAIT_LOOP
+
+AND R0, R0, #0
+STI R0, TIMER_CTRL          ; 关闭定时器
+LEA R0, DONE_MSG
+PUTS
+HALT
+
+; 中断处理程序: TRAP 会覆盖 R7, 需要一起保存
+TIMER_HANDLER
+ST R0, SAVE_R0
+ST R1, SAVE_R1
+ST R7, SAVE_R7
+
+LD R1, TICKS
+ADD R1, R1, #1
+ST R1, TICKS
+
+LD R0, TICK_CHAR
+OUT
+
+AND R0, R0, #0
+STI R0, TIMER_STATUS        ; 清除到期标志
+
+LD R0, SAVE_R0
+LD R1, SAVE_R1
+LD R7, SAVE_R7
+RTI
+
+TIMER_VECTOR   .FILL x0181
+TIMER_CTRL     .FILL x7F00
+TIMER_STATUS   .FILL x7F01
+TIMER_PERIOD_L .FILL x7F02
+TIMER_PERIOD_H .FILL x7F03
+TIMER_PERIOD   .FILL #200
+TIMER_MODE     .FILL x000D
+TICKS          .FILL #0
+TICK_CHAR      .FILL x002E
+SAVE_R0        .FILL #0
+SAVE_R1        .FILL #0
+SAVE_R7        .FILL #0
+DONE_MSG       .STRINGZ "\n- timer done\n"
+
+.END
@@ -0,0 +1,6840 @@
+.Orig x3000
+INIT_CODE
+LEA R6, #-1
+ADD R5, R6, #0
+ADD R6, R6, R6
+ADD R6, R6, R6
+ADD R6, R6, R5
+ADD R6, R6, #-1
+ADD R5, R5, R5
+ADD R5, R6, #0
+LD R4, GLOBAL_DATA_POINTER
+LD R7, GLOBAL_MAIN_POINTER
+jsrr R7
+HALT
+
+GLOBAL_DATA_POINTER .FILL GLOBAL_DATA_START
+GLOBAL_MAIN_POINTER .FILL main
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;vconsole_kick;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+lc3_vconsole_kick
+ADD R6, R6, #-2
+STR R7, R6, #0
+ADD R6, R6, #-1
+STR R5, R6, #0
+ADD R5, R6, #-1
+
+ADD R6, R6, #-1
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #13
+ldr R7, R7, #0
+str R7, R5, #0
+ldr R7, R5, #0
+ldr R3, R5, #4
+str R3, R7, #0
+ADD R0, R4, #4
+LDR R0, R0, #0
+JMP R0
+lc3_L6_vconsole
+ldr R7, R5, #0
+ldr R7, R7, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #11
+ldr R3, R3, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRz L12
+ADD R7, R4, #3
+LDR R7, R7, #0
+jmp R7
+L12
+ADD R0, R4, #5
+LDR R0, R0, #0
+JMP R0
+lc3_L9_vconsole
+lc3_L7_vconsole
+ADD R0, R4, #2
+LDR R0, R0, #0
+JMP R0
+lc3_L8_vconsole
+lc3_L4_vconsole
+STR R7, R5, #3
+ADD R6, R5, #1
+LDR R5, R6, #0
+ADD R6, R6, #1
+LDR R7, R6, #0
+ADD R6, R6, #1
+RET
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;vconsole_shl8;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+lc3_vconsole_shl8
+ADD R6, R6, #-2
+STR R7, R6, #0
+ADD R6, R6, #-1
+STR R5, R6, #0
+ADD R5, R6, #-1
+
+ADD R6, R6, #-1
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #10
+ldr R7, R7, #0
+str R7, R5, #0
+lc3_L14_vconsole
+ldr R7, R5, #4
+add R7, R7, R7
+str R7, R5, #4
+lc3_L15_vconsole
+ldr R7, R5, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #12
+ldr R3, R3, #0
+add R7, R7, R3
+str R7, R5, #0
+ldr R7, R5, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #9
+ldr R3, R3, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRnz L21
+ADD R7, R4, #8
+LDR R7, R7, #0
+jmp R7
+L21
+ldr R7, R5, #4
+lc3_L13_vconsole
+STR R7, R5, #3
+ADD R6, R5, #1
+LDR R5, R6, #0
+ADD R6, R6, #1
+LDR R7, R6, #0
+ADD R6, R6, #1
+RET
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;vconsole_hibyte;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+lc3_vconsole_hibyte
+ADD R6, R6, #-2
+STR R7, R6, #0
+ADD R6, R6, #-1
+STR R5, R6, #0
+ADD R5, R6, #-1
+
+ADD R6, R6, #-1
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #10
+ldr R7, R7, #0
+str R7, R5, #0
+lc3_L23_vconsole
+ldr R7, R5, #4
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #10
+ldr R3, R3, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRp L30
+ADD R7, R4, #13
+LDR R7, R7, #0
+jmp R7
+L30
+ldr R7, R5, #4
+add R7, R7, R7
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #8
+ldr R3, R3, #0
+add R7, R7, R3
+str R7, R5, #4
+ADD R0, R4, #14
+LDR R0, R0, #0
+JMP R0
+lc3_L27_vconsole
+ldr R7, R5, #4
+add R7, R7, R7
+str R7, R5, #4
+lc3_L28_vconsole
+lc3_L24_vconsole
+ldr R7, R5, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #12
+ldr R3, R3, #0
+add R7, R7, R3
+str R7, R5, #0
+ldr R7, R5, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #9
+ldr R3, R3, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRnz L31
+ADD R7, R4, #12
+LDR R7, R7, #0
+jmp R7
+L31
+ldr R7, R5, #4
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #8
+ldr R3, R3, #0
+and R7, R7, R3
+lc3_L22_vconsole
+STR R7, R5, #3
+ADD R6, R5, #1
+LDR R5, R6, #0
+ADD R6, R6, #1
+LDR R7, R6, #0
+ADD R6, R6, #1
+RET
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;vconsole_post_rx;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+lc3_vconsole_post_rx
+ADD R6, R6, #-2
+STR R7, R6, #0
+ADD R6, R6, #-1
+STR R5, R6, #0
+ADD R5, R6, #-1
+
+ADD R6, R6, #-3
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #7
+ldr R7, R7, #0
+str R7, R5, #0
+ADD R0, R4, #15
+ADD R0, R0, #4
+LDR R0, R0, #0
+JMP R0
+lc3_L34_vconsole
+ldr R7, R5, #0
+ldr R3, R7, #0
+ADD R2, R4, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #6
+ldr R2, R2, #0
+and R3, R3, R2
+str R3, R5, #-2
+ldr R3, R5, #-2
+ADD R2, R4, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #5
+ldr R2, R2, #0
+;LSH
+ADD R6, R6, #-1
+STR R0, R6, #0
+ADD R0, R3, #0
+ADD R2, R2, #0
+BRz L45
+L44
+ADD R0, R0, R0
+ADD R2, R2, #-1
+BRnp L44
+L45
+ADD R2, R0, #0
+LDR R0, R6, #0
+ADD R6, R6, #1
+ADD R1, R4, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #15
+ADD R1, R1, #4
+ldr R1, R1, #0
+add R7, R7, R1
+add R7, R2, R7
+str R7, R5, #-1
+ldr R7, R5, #-1
+ADD R2, R4, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #3
+ldr R2, R2, #0
+;LSH
+ADD R6, R6, #-1
+STR R0, R6, #0
+ADD R0, R3, #0
+ADD R2, R2, #0
+BRz L47
+L46
+ADD R0, R0, R0
+ADD R2, R2, #-1
+BRnp L46
+L47
+ADD R3, R0, #0
+LDR R0, R6, #0
+ADD R6, R6, #1
+ADD R2, R4, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #10
+add R3, R3, R2
+str R3, R7, #0
+ldr R7, R5, #-1
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #2
+ldr R3, R3, #0
+add R7, R7, R3
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #1
+ldr R3, R3, #0
+str R3, R7, #0
+ldr R7, R5, #0
+ldr R3, R7, #0
+ADD R2, R4, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #8
+ldr R2, R2, #0
+add R3, R3, R2
+str R3, R7, #0
+lc3_L35_vconsole
+ldr R7, R5, #0
+ldr R7, R7, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #9
+ldr R3, R3, #0
+ADD R6, R6, #-1
+STR R0, R6, #0
+ADD R6, R6, #-1
+STR R3, R6, #0
+NOT R3, R3
+ADD R3, R3, #1
+ADD R0, R7, R3
+LDR R3, R6, #0
+ADD R6, R6, #1
+ADD R7, R0, #0
+LDR R0, R6, #0
+ADD R6, R6, #1
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ldr R3, R3, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRnz L48
+ADD R7, R4, #15
+ADD R7, R7, #3
+LDR R7, R7, #0
+jmp R7
+L48
+lc3_L32_vconsole
+STR R7, R5, #3
+ADD R6, R5, #1
+LDR R5, R6, #0
+ADD R6, R6, #1
+LDR R7, R6, #0
+ADD R6, R6, #1
+RET
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;vconsole_write;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+lc3_vconsole_write
+ADD R6, R6, #-2
+STR R7, R6, #0
+ADD R6, R6, #-1
+STR R5, R6, #0
+ADD R5, R6, #-1
+
+ADD R6, R6, #-7
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #7
+ldr R7, R7, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #14
+ldr R3, R3, #0
+add R7, R7, R3
+str R7, R5, #-3
+ldr R7, R5, #-3
+ldr R3, R7, #0
+ADD R2, R4, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #2
+ldr R2, R2, #0
+add R7, R7, R2
+ldr R7, R7, #0
+ADD R6, R6, #-1
+STR R0, R6, #0
+ADD R6, R6, #-1
+STR R7, R6, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R0, R3, R7
+LDR R7, R6, #0
+ADD R6, R6, #1
+ADD R7, R0, #0
+LDR R0, R6, #0
+ADD R6, R6, #1
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ldr R3, R3, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRnz L62
+ADD R7, R4, #15
+ADD R7, R7, #7
+LDR R7, R7, #0
+jmp R7
+L62
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #13
+ldr R7, R7, #0
+ADD R0, R4, #15
+ADD R0, R0, #14
+LDR R0, R0, #0
+JMP R0
+lc3_L51_vconsole
+ldr R7, R5, #-3
+ldr R7, R7, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #6
+ldr R3, R3, #0
+and R7, R7, R3
+str R7, R5, #-5
+ldr R7, R5, #-5
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #3
+ldr R3, R3, #0
+;LSH
+ADD R6, R6, #-1
+STR R0, R6, #0
+ADD R0, R7, #0
+ADD R3, R3, #0
+BRz L64
+L63
+ADD R0, R0, R0
+ADD R3, R3, #-1
+BRnp L63
+L64
+ADD R7, R0, #0
+LDR R0, R6, #0
+ADD R6, R6, #1
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #12
+add R7, R7, R3
+str R7, R5, #-2
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #10
+ldr R7, R7, #0
+str R7, R5, #-1
+str R7, R5, #0
+ADD R0, R4, #15
+ADD R0, R0, #12
+LDR R0, R0, #0
+JMP R0
+lc3_L54_vconsole
+ldr R7, R5, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #12
+ldr R3, R3, #0
+and R7, R7, R3
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #10
+ldr R3, R3, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRnp L65
+ADD R7, R4, #15
+ADD R7, R7, #9
+LDR R7, R7, #0
+jmp R7
+L65
+ldr R7, R5, #0
+ldr R3, R5, #4
+add R7, R7, R3
+ldr R7, R7, #0
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R0, R4, #7
+LDR R0, R0, #0
+jsrr R0
+LDR R7, R6, #0
+ADD R6, R6, #1
+ldr R3, R5, #-1
+ldr R2, R5, #-2
+add R3, R3, R2
+ldr R2, R3, #0
+add R7, R2, R7
+str R7, R3, #0
+ldr R7, R5, #-1
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #12
+ldr R3, R3, #0
+add R7, R7, R3
+str R7, R5, #-1
+ADD R0, R4, #15
+ADD R0, R0, #10
+LDR R0, R0, #0
+JMP R0
+lc3_L58_vconsole
+ldr R7, R5, #-1
+ldr R3, R5, #-2
+add R7, R7, R3
+ldr R3, R5, #0
+ldr R2, R5, #4
+add R3, R3, R2
+ldr R3, R3, #0
+str R3, R7, #0
+lc3_L59_vconsole
+lc3_L55_vconsole
+ldr R7, R5, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #12
+ldr R3, R3, #0
+add R7, R7, R3
+str R7, R5, #0
+lc3_L57_vconsole
+ldr R7, R5, #0
+str R7, R5, #-6
+ldr R3, R5, #4
+add R3, R7, R3
+ldr R3, R3, #0
+ADD R2, R4, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #10
+ldr R2, R2, #0
+ADD R7, R2, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRnp L66
+ADD R7, R4, #15
+ADD R7, R7, #13
+LDR R7, R7, #0
+jmp R7
+L66
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #12
+ldr R7, R7, #0
+ldr R3, R5, #-6
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRzp L67
+ADD R7, R4, #15
+ADD R7, R7, #8
+LDR R7, R7, #0
+jmp R7
+L67
+lc3_L60_vconsole
+ldr R7, R5, #-5
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #5
+ldr R3, R3, #0
+;LSH
+ADD R6, R6, #-1
+STR R0, R6, #0
+ADD R0, R7, #0
+ADD R3, R3, #0
+BRz L69
+L68
+ADD R0, R0, R0
+ADD R3, R3, #-1
+BRnp L68
+L69
+ADD R7, R0, #0
+LDR R0, R6, #0
+ADD R6, R6, #1
+ldr R3, R5, #-3
+ADD R2, R4, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #4
+ldr R2, R2, #0
+add R3, R3, R2
+add R7, R7, R3
+str R7, R5, #-4
+ldr R7, R5, #-4
+ldr R3, R5, #-2
+str R3, R7, #0
+ldr R7, R5, #-4
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #2
+ldr R3, R3, #0
+add R7, R7, R3
+ldr R3, R5, #0
+str R3, R7, #0
+ldr R7, R5, #-3
+ldr R3, R7, #0
+ADD R2, R4, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #8
+ldr R2, R2, #0
+add R3, R3, R2
+str R3, R7, #0
+ldr R7, R5, #0
+lc3_L49_vconsole
+STR R7, R5, #3
+ADD R6, R5, #1
+LDR R5, R6, #0
+ADD R6, R6, #1
+LDR R7, R6, #0
+ADD R6, R6, #1
+RET
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;vconsole_flush;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+lc3_vconsole_flush
+ADD R6, R6, #-2
+STR R7, R6, #0
+ADD R6, R6, #-1
+STR R5, R6, #0
+ADD R5, R6, #-1
+
+ADD R6, R6, #-1
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #8
+ldr R7, R7, #0
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R0, R4, #1
+LDR R0, R0, #0
+jsrr R0
+lc3_L70_vconsole
+STR R7, R5, #3
+ADD R6, R5, #1
+LDR R5, R6, #0
+ADD R6, R6, #1
+LDR R7, R6, #0
+ADD R6, R6, #1
+RET
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;vconsole_read;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+lc3_vconsole_read
+ADD R6, R6, #-2
+STR R7, R6, #0
+ADD R6, R6, #-1
+STR R5, R6, #0
+ADD R5, R6, #-1
+
+ADD R6, R6, #-8
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #7
+ldr R7, R7, #0
+str R7, R5, #-2
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #13
+ldr R7, R7, #0
+str R7, R5, #-3
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #11
+ldr R7, R7, #0
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R0, R4, #1
+LDR R0, R0, #0
+jsrr R0
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #10
+ldr R7, R7, #0
+str R7, R5, #-5
+ADD R0, R4, #15
+ADD R0, R0, #15
+ADD R0, R0, #6
+LDR R0, R0, #0
+JMP R0
+lc3_L73_vconsole
+ldr R7, R5, #-3
+ldr R7, R7, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #11
+ldr R3, R3, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRz L88
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #4
+LDR R7, R7, #0
+jmp R7
+L88
+ldr R7, R5, #-5
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #12
+ldr R3, R3, #0
+add R7, R7, R3
+str R7, R5, #-5
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #10
+ldr R3, R3, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRn L89
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #5
+LDR R7, R7, #0
+jmp R7
+L89
+lc3_L78_vconsole
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #13
+ldr R7, R7, #0
+ADD R0, R4, #15
+ADD R0, R0, #15
+ADD R0, R0, #13
+LDR R0, R0, #0
+JMP R0
+lc3_L76_vconsole
+lc3_L74_vconsole
+ldr R7, R5, #-2
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #2
+ldr R3, R3, #0
+add R7, R7, R3
+ldr R7, R7, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #9
+ldr R3, R3, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRnp L90
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #3
+LDR R7, R7, #0
+jmp R7
+L90
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #9
+ldr R7, R7, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #6
+ldr R3, R3, #0
+and R7, R7, R3
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #5
+ldr R3, R3, #0
+ldr R3, R5, #-2
+ADD R2, R4, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #4
+ldr R2, R2, #0
+add R3, R3, R2
+add R7, R7, R3
+str R7, R5, #-6
+ldr R7, R5, #-6
+ldr R3, R7, #0
+str R3, R5, #-1
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #2
+ldr R3, R3, #0
+add R7, R7, R3
+ldr R7, R7, #0
+str R7, R5, #-4
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #10
+ldr R7, R7, #0
+str R7, R5, #0
+ADD R0, R4, #15
+ADD R0, R0, #15
+ADD R0, R0, #11
+LDR R0, R0, #0
+JMP R0
+lc3_L80_vconsole
+ldr R7, R5, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #12
+ldr R3, R3, #0
+and R7, R7, R3
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #10
+ldr R3, R3, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRnp L91
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #8
+LDR R7, R7, #0
+jmp R7
+L91
+ldr R7, R5, #-1
+ldr R7, R7, #0
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R0, R4, #11
+LDR R0, R0, #0
+jsrr R0
+LDR R7, R6, #0
+ADD R6, R6, #1
+ldr R3, R5, #0
+ldr R2, R5, #4
+add R3, R3, R2
+str R7, R3, #0
+ldr R7, R5, #-1
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #2
+ldr R3, R3, #0
+add R7, R7, R3
+str R7, R5, #-1
+ADD R0, R4, #15
+ADD R0, R0, #15
+ADD R0, R0, #9
+LDR R0, R0, #0
+JMP R0
+lc3_L84_vconsole
+ldr R7, R5, #0
+ldr R3, R5, #4
+add R7, R7, R3
+ldr R3, R5, #-1
+ldr R3, R3, #0
+ADD R2, R4, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #8
+ldr R2, R2, #0
+and R3, R3, R2
+str R3, R7, #0
+lc3_L85_vconsole
+lc3_L81_vconsole
+ldr R7, R5, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #12
+ldr R3, R3, #0
+add R7, R7, R3
+str R7, R5, #0
+lc3_L83_vconsole
+ldr R7, R5, #0
+str R7, R5, #-7
+ldr R3, R5, #-4
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRp L92
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #12
+LDR R7, R7, #0
+jmp R7
+L92
+ldr R7, R5, #5
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #12
+ldr R3, R3, #0
+ADD R6, R6, #-1
+STR R0, R6, #0
+ADD R6, R6, #-1
+STR R3, R6, #0
+NOT R3, R3
+ADD R3, R3, #1
+ADD R0, R7, R3
+LDR R3, R6, #0
+ADD R6, R6, #1
+ADD R7, R0, #0
+LDR R0, R6, #0
+ADD R6, R6, #1
+ldr R3, R5, #-7
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRzp L93
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #7
+LDR R7, R7, #0
+jmp R7
+L93
+lc3_L86_vconsole
+ldr R7, R5, #0
+ldr R3, R5, #4
+add R7, R7, R3
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #9
+ldr R3, R3, #0
+str R3, R7, #0
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #9
+ldr R3, R7, #0
+ADD R2, R4, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #8
+ldr R2, R2, #0
+add R3, R3, R2
+str R3, R7, #0
+ADD R0, R4, #15
+ADD R0, R0, #2
+LDR R0, R0, #0
+jsrr R0
+ldr R7, R5, #0
+lc3_L71_vconsole
+STR R7, R5, #3
+ADD R6, R5, #1
+LDR R5, R6, #0
+ADD R6, R6, #1
+LDR R7, R6, #0
+ADD R6, R6, #1
+RET
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;main;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+main
+ADD R6, R6, #-2
+STR R7, R6, #0
+ADD R6, R6, #-1
+STR R5, R6, #0
+ADD R5, R6, #-1
+
+ADD R6, R6, #-16
+ADD R6, R6, #-16
+ADD R6, R6, #-16
+ADD R6, R6, #-16
+ADD R6, R6, #-16
+ADD R6, R6, #-10
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #8
+ldr R7, R7, #0
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R0, R4, #7
+LDR R0, R0, #0
+jsrr R0
+LDR R7, R6, #0
+ADD R6, R6, #1
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #8
+ADD R2, R4, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #15
+ADD R2, R2, #8
+ldr R2, R2, #0
+ADD R6, R6, #-1
+STR R0, R6, #0
+ADD R6, R6, #-1
+STR R2, R6, #0
+NOT R2, R2
+ADD R2, R2, #1
+ADD R0, R7, R2
+LDR R2, R6, #0
+ADD R6, R6, #1
+ADD R7, R0, #0
+LDR R0, R6, #0
+ADD R6, R6, #1
+str R7, R3, #0
+ADD R0, R4, #15
+ADD R0, R0, #2
+LDR R0, R0, #0
+jsrr R0
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #10
+ldr R7, R7, #0
+str R7, R5, #0
+ADD R0, R4, #15
+ADD R0, R0, #15
+ADD R0, R0, #15
+ADD R0, R0, #1
+LDR R0, R0, #0
+JMP R0
+lc3_L95_vconsole
+ldr R7, R5, #0
+ADD R3, R5, #-16
+ADD R3, R3, #-8
+add R3, R7, R3
+ADD R2, R4, #0
+ldr R2, R2, #0
+add R7, R7, R2
+ldr R7, R7, #0
+str R7, R3, #0
+lc3_L96_vconsole
+ldr R7, R5, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #12
+ldr R3, R3, #0
+add R7, R7, R3
+str R7, R5, #0
+lc3_L98_vconsole
+ldr R7, R5, #0
+ADD R3, R4, #0
+ldr R3, R3, #0
+add R7, R7, R3
+ldr R7, R7, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #10
+ldr R3, R3, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRz L110
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #14
+LDR R7, R7, #0
+jmp R7
+L110
+ldr R7, R5, #0
+ADD R3, R5, #-16
+ADD R3, R3, #-8
+add R7, R7, R3
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #9
+ldr R3, R3, #0
+str R3, R7, #0
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #10
+ldr R7, R7, #0
+str R7, R5, #0
+lc3_L99_vconsole
+ldr R7, R5, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #8
+ldr R3, R3, #0
+add R7, R7, R3
+str R7, R5, #-5
+ADD R7, R5, #-16
+ADD R7, R7, #-8
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R0, R4, #15
+ADD R0, R0, #6
+LDR R0, R0, #0
+jsrr R0
+LDR R7, R6, #0
+ADD R6, R6, #1
+lc3_L100_vconsole
+ldr R7, R5, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #12
+ldr R3, R3, #0
+add R7, R7, R3
+str R7, R5, #0
+ldr R7, R5, #0
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #9
+ldr R3, R3, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRnz L111
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #2
+LDR R7, R7, #0
+jmp R7
+L111
+ADD R0, R4, #15
+ADD R0, R0, #15
+LDR R0, R0, #0
+jsrr R0
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #7
+ldr R7, R7, #0
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R7, R5, #-16
+ADD R7, R7, #-16
+ADD R7, R7, #-16
+ADD R7, R7, #-16
+ADD R7, R7, #-16
+ADD R7, R7, #-9
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R0, R4, #15
+ADD R0, R0, #15
+ADD R0, R0, #2
+LDR R0, R0, #0
+jsrr R0
+LDR R7, R6, #0
+ADD R6, R6, #1
+ADD R3, R4, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #15
+ADD R3, R3, #10
+ldr R3, R3, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R7, R3
+BRp L112
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #4
+LDR R7, R7, #0
+jmp R7
+L112
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #8
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R0, R4, #15
+ADD R0, R0, #15
+ADD R0, R0, #15
+ADD R0, R0, #7
+LDR R0, R0, #0
+jsrr R0
+LDR R7, R6, #0
+ADD R6, R6, #1
+ADD R0, R4, #15
+ADD R0, R0, #15
+ADD R0, R0, #15
+ADD R0, R0, #5
+LDR R0, R0, #0
+JMP R0
+lc3_L105_vconsole
+ADD R7, R5, #-16
+ADD R7, R7, #-16
+ADD R7, R7, #-16
+ADD R7, R7, #-16
+ADD R7, R7, #-16
+ADD R7, R7, #-9
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #14
+ADD R6, R6, #-1
+STR R7, R6, #0
+ADD R0, R4, #15
+ADD R0, R0, #15
+ADD R0, R0, #15
+ADD R0, R0, #7
+LDR R0, R0, #0
+jsrr R0
+LDR R7, R6, #0
+ADD R6, R6, #1
+lc3_L106_vconsole
+ADD R7, R4, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #15
+ADD R7, R7, #10
+ldr R7, R7, #0
+lc3_L94_vconsole
+STR R7, R5, #3
+ADD R6, R5, #1
+LDR R5, R6, #0
+ADD R6, R6, #1
+LDR R7, R6, #0
+ADD R6, R6, #1
+RET
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+;	void printf(const char *format, ...)
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+
+PRINTF_PERCENT .FILL -37
+PRINTF_C .FILL -99
+PRINTF_D .FILL -100
+PRINTF_S .FILL -115
+PRINTF_B .FILL -98
+PRINTF_O .FILL -111
+PRINTF_X .FILL -120
+PRINTF_ASCII .FILL 48 		;postive ascii value of '0'
+.FILL 49
+.FILL 50
+.FILL 51
+.FILL 52
+.FILL 53
+.FILL 54
+.FILL 55
+.FILL 56
+.FILL 57
+.FILL 65        ;A
+.FILL 66
+.FILL 67
+.FILL 68
+.FILL 69
+.FILL 70
+PRINTF_MINUS .FILL 45  
+PRINTF_BUF .BLKW 18
+ 
+
+lc3_printf
+ADD R6, R6, #-2
+STR R7, R6, #0		;return address
+ADD R6, R6, #-1
+STR R5, R6, #0
+ADD R5, R6, #-1
+
+ADD R6, R6, #-1
+STR R4, R6, #0
+
+ADD R5, R5, #4		;cheating with the bp (no longer bp)
+LDR R4, R5, #0		;got addr of format string
+
+
+PRINTF_LOOP	;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+
+LDR R0, R4, #0
+
+ADD R0, R0, #0		;End of string? (0x0000)
+BRz PRINTF_DONE
+
+ADD R2, R0, #0
+LD R1, PRINTF_PERCENT
+ADD R2, R2, R1
+BRnp PRINTF_CHAR		
+
+ADD R4, R4, #1
+LDR R0, R4, #0
+;is it %c?
+ADD R2, R0, #0
+LD R3, PRINTF_C
+ADD R2, R2, R3
+BRnp PRINTF_CHECKSTR
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;%c
+ADD R5, R5, #1
+LDR R0, R5, #0
+
+PRINTF_CHAR
+OUT
+
+ADD R4, R4, #1
+BRnzp PRINTF_LOOP
+
+PRINTF_CHECKSTR
+;is it %s?
+ADD R2, R0, #0
+LD R7, PRINTF_S
+ADD R2, R2, R7
+BRnp PRINTF_CHECKDEC		
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;%s
+
+ADD R5, R5, #1
+LDR R0, R5, #0
+PUTS
+
+ADD R4, R4, #1
+BRnzp PRINTF_LOOP
+
+PRINTF_CHECKDEC
+;is it %d?
+ADD R2, R0, #0
+LD R7, PRINTF_D
+ADD R2, R2, R7
+;BRnp PRINTF_ERROR
+BRnp PRINTF_CHECKHEX
+
+AND R2, R2, #0
+ADD R2, R2, #-10		;going to divide by 10 by using sub loop
+BRnzp PRINTF_NUM
+
+PRINTF_CHECKHEX
+
+ADD R2, R0, #0
+LD R7, PRINTF_X
+ADD R2, R2, R7
+BRnp PRINTF_CHECKOCT
+
+AND R2, R2, #0
+ADD R2, R2, #-16		;going to divide by 10 by using sub loop
+BRnzp PRINTF_NUM
+
+PRINTF_CHECKOCT
+
+ADD R2, R0, #0
+LD R7, PRINTF_O
+ADD R2, R2, R7
+BRnp PRINTF_CHECKBIN
+
+AND R2, R2, #0
+ADD R2, R2, #-8		;going to divide by 10 by using sub loop
+BRnzp PRINTF_NUM
+
+PRINTF_CHECKBIN
+
+ADD R2, R0, #0
+LD R7, PRINTF_B
+ADD R2, R2, R7
+BRnp PRINTF_ERROR
+
+AND R2, R2, #0
+ADD R2, R2, #-2		;going to divide by 10 by using sub loop
+;BRnzp PRINTF_NUM
+
+
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;%d
+PRINTF_NUM
+
+LEA R7, PRINTF_BUF
+ADD R7, R7, #15 
+ADD R7, R7, #1 
+
+;AND R2, R2, #0
+;ADD R2, R2, #-10		;going to divide by 10 by using sub loop
+
+ADD R5, R5, #1			;acquire the binary number
+LDR R0, R5, #0
+
+ADD R0, R0, #0
+BRzp PRINTF_DECPOS 
+
+NOT R0, R0				;make num positive for sub loop
+ADD R0, R0, #1
+
+PRINTF_DECPOS
+
+AND R3, R3, #0
+ADD R3, R3, #-1
+
+PRINTF_DIVLOOP
+ADD R3, R3, #1			;num/10 
+ADD R0, R0, R2			;R0 = num % 10 - 10
+BRzp PRINTF_DIVLOOP
+
+ADD R3, R3, #0
+BRz PRINTF_LASTDIGIT
+
+;LD R1, PRINTF_ASCII
+;ADD R1, R1, R0
+;NOT R2, R2
+;ADD R1, R1, R2 
+;ADD R1, R1, #1
+;NOT R2, R2
+;;;;;ADD R1, R1, #10
+;STR R1, R7, #0
+;ADD R7, R7, #-1			;stored ascii value of one digit
+
+LEA R1, PRINTF_ASCII
+ADD R1, R1, R0
+NOT R2, R2
+ADD R1, R1, R2 
+ADD R1, R1, #1
+NOT R2, R2
+LDR R1, R1, #0
+STR R1, R7, #0
+ADD R7, R7, #-1			;stored ascii value of one digit
+
+ADD R0, R3, #0			;num/10
+
+BRnzp PRINTF_DECPOS
+
+PRINTF_LASTDIGIT
+
+;LD R1, PRINTF_ASCII
+;ADD R1, R1, R0
+;ADD R1, R1, #10
+;STR R1, R7, #0
+
+LEA R1, PRINTF_ASCII
+ADD R1, R1, R0
+NOT R2, R2
+ADD R1, R1, R2 
+ADD R1, R1, #1
+NOT R2, R2
+LDR R1, R1, #0
+STR R1, R7, #0			;stored ascii value of highest order digit
+
+LDR R0, R5, #0
+ADD R0, R0, #0
+BRzp PRINTF_DECSTRING
+
+LD R0, PRINTF_MINUS		;num was negative
+ADD R7, R7, #-1
+STR R0, R7, #0			;stored ascii value negative sign
+
+PRINTF_DECSTRING		;print the calculated string
+ADD R0, R7, #0
+PUTS
+
+ADD R4, R4, #1
+BRnzp PRINTF_LOOP
+
+PRINTF_ERROR
+PRINTF_DONE
+
+LDR R4, R6, #0		;restore R4
+ADD R6, R6, #1
+
+LDR R5, R6, #0		;restore bp
+ADD R6, R6, #1
+
+LDR R7, R6, #0		;restore ret addr
+ADD R6, R6, #1
+
+RET
+
+GLOBAL_DATA_START
+tx_text .FILL L3_vconsole
+vconsole_kick .FILL lc3_vconsole_kick
+L6_vconsole .FILL lc3_L6_vconsole
+L9_vconsole .FILL lc3_L9_vconsole
+L7_vconsole .FILL lc3_L7_vconsole
+L8_vconsole .FILL lc3_L8_vconsole
+L4_vconsole .FILL lc3_L4_vconsole
+vconsole_shl8 .FILL lc3_vconsole_shl8
+L14_vconsole .FILL lc3_L14_vconsole
+L15_vconsole .FILL lc3_L15_vconsole
+L13_vconsole .FILL lc3_L13_vconsole
+vconsole_hibyte .FILL lc3_vconsole_hibyte
+L23_vconsole .FILL lc3_L23_vconsole
+L27_vconsole .FILL lc3_L27_vconsole
+L28_vconsole .FILL lc3_L28_vconsole
+L24_vconsole .FILL lc3_L24_vconsole
+L22_vconsole .FILL lc3_L22_vconsole
+vconsole_post_rx .FILL lc3_vconsole_post_rx
+L34_vconsole .FILL lc3_L34_vconsole
+L35_vconsole .FILL lc3_L35_vconsole
+L32_vconsole .FILL lc3_L32_vconsole
+vconsole_write .FILL lc3_vconsole_write
+L51_vconsole .FILL lc3_L51_vconsole
+L54_vconsole .FILL lc3_L54_vconsole
+L58_vconsole .FILL lc3_L58_vconsole
+L59_vconsole .FILL lc3_L59_vconsole
+L55_vconsole .FILL lc3_L55_vconsole
+L57_vconsole .FILL lc3_L57_vconsole
+L60_vconsole .FILL lc3_L60_vconsole
+L49_vconsole .FILL lc3_L49_vconsole
+vconsole_flush .FILL lc3_vconsole_flush
+L70_vconsole .FILL lc3_L70_vconsole
+vconsole_read .FILL lc3_vconsole_read
+L73_vconsole .FILL lc3_L73_vconsole
+L78_vconsole .FILL lc3_L78_vconsole
+L76_vconsole .FILL lc3_L76_vconsole
+L74_vconsole .FILL lc3_L74_vconsole
+L80_vconsole .FILL lc3_L80_vconsole
+L84_vconsole .FILL lc3_L84_vconsole
+L85_vconsole .FILL lc3_L85_vconsole
+L81_vconsole .FILL lc3_L81_vconsole
+L83_vconsole .FILL lc3_L83_vconsole
+L86_vconsole .FILL lc3_L86_vconsole
+L71_vconsole .FILL lc3_L71_vconsole
+L95_vconsole .FILL lc3_L95_vconsole
+L96_vconsole .FILL lc3_L96_vconsole
+L98_vconsole .FILL lc3_L98_vconsole
+L99_vconsole .FILL lc3_L99_vconsole
+L100_vconsole .FILL lc3_L100_vconsole
+L105_vconsole .FILL lc3_L105_vconsole
+L106_vconsole .FILL lc3_L106_vconsole
+L94_vconsole .FILL lc3_L94_vconsole
+printf .FILL lc3_printf
+byte_mask .BLKW 1
+rx_last .BLKW 1
+rx_buf .BLKW 512
+tx_buf .BLKW 512
+L109_vconsole .STRINGZ "- rx: %s"
+L108_vconsole .STRINGZ "- rx timeout\n"
+L107_vconsole .FILL #65
+L104_vconsole .FILL #48
+L87_vconsole .FILL #0
+L79_vconsole .FILL #2000
+L72_vconsole .FILL #4
+L61_vconsole .FILL #64
+L53_vconsole .FILL #-1
+L50_vconsole .FILL #66
+L43_vconsole .FILL #16
+L42_vconsole .FILL #64
+L41_vconsole .FILL #1
+L40_vconsole .FILL #5
+L39_vconsole .FILL #2
+L38_vconsole .FILL #2
+L37_vconsole .FILL #15
+L33_vconsole .FILL #32256
+L29_vconsole .FILL #1
+L20_vconsole .FILL #8
+L18_vconsole .FILL #0
+L11_vconsole .FILL #2
+L19_vconsole .FILL #1
+L5_vconsole .FILL #257
+L3_vconsole .STRINGZ "- vconsole tx line 0\n"
+.END
@@ -0,0 +1,201 @@
+#define uint16_t unsigned int
+#define int16_t int
+
+#define __virtio64 uint16_t
+#define __virtio32 uint16_t
+#define __virtio16 uint16_t
+
+#define INTERRUPT_VCONSOLE 0X0101
+#define DEVICE_VCONSOLE    0X7E00
+
+enum { VCONSOLE_QUEUE_SIZE = 16 };
+enum { VCONSOLE_BUF_SIZE = 32 };
+
+#define VCONSOLE_KICK_TX 0X0001
+#define VCONSOLE_REPLAY  0X0002
+#define VCONSOLE_KICK_RX 0X0004
+
+#define VCONSOLE_RX_POLLS 2000
+
+struct vring_desc {
+    __virtio64 addr;
+    __virtio32 len;
+    __virtio16 flags;
+    __virtio16 next;
+};
+
+struct vconsole_queue {
+    __virtio16 avail_idx;
+    __virtio16 used_idx;
+    struct vring_desc desc[VCONSOLE_QUEUE_SIZE];
+};
+
+/* lcc 限制结构体不超过 127 个字, rx/tx 两个队列分开寻址 */
+#define VCONSOLE_RX ((struct vconsole_queue *)DEVICE_VCONSOLE)
+#define VCONSOLE_TX ((struct vconsole_queue *)(DEVICE_VCONSOLE + sizeof(struct vconsole_queue)))
+
+uint16_t tx_buf[VCONSOLE_QUEUE_SIZE][VCONSOLE_BUF_SIZE];
+uint16_t rx_buf[VCONSOLE_QUEUE_SIZE][VCONSOLE_BUF_SIZE];
+uint16_t rx_last;
+uint16_t byte_mask;
+
+char *tx_text = "- vconsole tx line 0\n";
+
+void vconsole_kick(uint16_t flags)
+{
+    uint16_t *vconsole_flags = (uint16_t *)INTERRUPT_VCONSOLE;
+
+    *vconsole_flags = flags;
+    while (1) {
+        if (*vconsole_flags == (uint16_t)VCONSOLE_REPLAY) {
+            break;
+        }
+    }
+}
+
+/* lcc 按 8 位 int 处理移位和常量, 移 8 位以上不可靠, 这里用加法实现 */
+uint16_t vconsole_shl8(uint16_t w)
+{
+    int16_t i;
+
+    for (i = 0; i < 8; i++) {
+        w = w + w;
+    }
+    return w;
+}
+
+uint16_t vconsole_hibyte(uint16_t w)
+{
+    int16_t i;
+
+    for (i = 0; i < 8; i++) {
+        if ((int16_t)w < 0) {
+            w = w + w + 1;
+        } else {
+            w = w + w;
+        }
+    }
+    return w & byte_mask;
+}
+
+/* 把所有空闲的接收缓冲区交给主机 */
+void vconsole_post_rx()
+{
+    struct vconsole_queue *rx = VCONSOLE_RX;
+    struct vring_desc *desc;
+    int16_t slot;
+
+    while ((uint16_t)(rx->avail_idx - rx_last) < (uint16_t)VCONSOLE_QUEUE_SIZE) {
+        slot = rx->avail_idx & (VCONSOLE_QUEUE_SIZE - 1);
+        desc = &(rx->desc[slot]);
+        desc->addr = (uint16_t)&(rx_buf[slot][0]);
+        desc->len = VCONSOLE_BUF_SIZE * 2;
+        rx->avail_idx = rx->avail_idx + 1;
+    }
+}
+
+/* 把字符串打包 (每字两个字节, 低字节在前) 放入发送队列, 不通知主机 */
+int16_t vconsole_write(char *s)
+{
+    struct vconsole_queue *tx = VCONSOLE_TX;
+    struct vring_desc *desc;
+    uint16_t *buf;
+    int16_t slot, len, w;
+
+    if ((uint16_t)(tx->avail_idx - tx->used_idx) >= (uint16_t)VCONSOLE_QUEUE_SIZE) {
+        return (int16_t)-1;
+    }
+
+    slot = tx->avail_idx & (VCONSOLE_QUEUE_SIZE - 1);
+    buf = &(tx_buf[slot][0]);
+    w = 0;
+    for (len = 0; s[len] && len < VCONSOLE_BUF_SIZE * 2; len++) {
+        if (len & 1) {
+            buf[w] = buf[w] + vconsole_shl8(s[len]);
+            w++;
+        } else {
+            buf[w] = s[len];
+        }
+    }
+
+    desc = &(tx->desc[slot]);
+    desc->addr = (uint16_t)buf;
+    desc->len = len;
+    tx->avail_idx = tx->avail_idx + 1;
+
+    return len;
+}
+
+/* 一次通知提交所有排队的发送缓冲区 */
+void vconsole_flush()
+{
+    vconsole_kick(VCONSOLE_KICK_TX);
+}
+
+/* 读取一个已完成的接收缓冲区到 out, 超时返回 -1 */
+int16_t vconsole_read(char *out, int16_t max)
+{
+    struct vconsole_queue *rx = VCONSOLE_RX;
+    uint16_t *vconsole_flags = (uint16_t *)INTERRUPT_VCONSOLE;
+    struct vring_desc *desc;
+    uint16_t *buf;
+    int16_t i, len, polls;
+
+    vconsole_kick(VCONSOLE_KICK_RX);
+
+    polls = 0;
+    while (rx->used_idx == rx_last) {
+        /* 读中断标志会让主机检查是否有新数据 */
+        if (*vconsole_flags != (uint16_t)VCONSOLE_REPLAY || ++polls > VCONSOLE_RX_POLLS) {
+            return (int16_t)-1;
+        }
+    }
+
+    desc = &(rx->desc[rx_last & (VCONSOLE_QUEUE_SIZE - 1)]);
+    buf = (uint16_t *)desc->addr;
+    len = desc->len;
+    for (i = 0; i < len && i < max - 1; i++) {
+        if (i & 1) {
+            out[i] = vconsole_hibyte(*buf);
+            buf++;
+        } else {
+            out[i] = *buf & byte_mask;
+        }
+    }
+    out[i] = 0;
+
+    rx_last = rx_last + 1;
+    vconsole_post_rx();
+
+    return i;
+}
+
+int main()
+{
+    char line[VCONSOLE_BUF_SIZE * 2 + 1];
+    char msg[24];
+    int16_t i;
+
+    byte_mask = vconsole_shl8(1) - 1;
+
+    vconsole_post_rx();
+
+    for (i = 0; tx_text[i]; i++) {
+        msg[i] = tx_text[i];
+    }
+    msg[i] = 0;
+
+    for (i = 0; i < 8; i++) {
+        msg[19] = '0' + i;
+        vconsole_write(msg);
+    }
+    vconsole_flush();
+
+    if (vconsole_read(line, sizeof(line)) < 0) {
+        printf("- rx timeout\n");
+    } else {
+        printf("- rx: %s", line);
+    }
+
+    return 0;
+}
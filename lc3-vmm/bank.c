@@ -0,0 +1,94 @@
+#include <string.h>
+#include <sys/stat.h>
+
+#include "mem.h"
+#include "bank.h"
+
+static int bank_fd = -1;
+static uint16_t bank_count;
+static uint16_t bank_cur;
+
+// 把第 bank 个 bank 映射到窗口, 原来窗口处的映射被替换
+static int bank_map(uint16_t bank)
+{
+    void *window = mem_addr() + BANK_WINDOW_START;
+    void *p;
+
+    p = mmap(window, BANK_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED,
+            bank_fd, (off_t)bank * BANK_BYTES);
+    if (p == MAP_FAILED)
+        return -1;
+    bank_cur = bank;
+    mem_set(BANK_SELECT, bank);
+    return 0;
+}
+
+int bank_init(const char *path, unsigned nbanks)
+{
+    struct stat st;
+
+    if (!mem_addr() || bank_fd >= 0)
+        return -1;
+
+    if (path) {
+        bank_fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (bank_fd < 0 || fstat(bank_fd, &st) < 0)
+            goto fail;
+        if (nbanks == 0)
+            nbanks = st.st_size / BANK_BYTES;
+    } else {
+        bank_fd = memfd_create("lc3-bank", MFD_CLOEXEC);
+        if (bank_fd < 0)
+            goto fail;
+        st.st_size = 0;
+    }
+
+    if (nbanks == 0 || nbanks > BANK_MAX)
+        goto fail;
+    // 只设置大小, 页在客户机第一次写入时才分配
+    if ((off_t)nbanks * BANK_BYTES > st.st_size &&
+            ftruncate(bank_fd, (off_t)nbanks * BANK_BYTES) < 0)
+        goto fail;
+
+    bank_count = nbanks;
+    mem_set(BANK_COUNT, bank_count);
+    if (bank_map(0) < 0)
+        goto fail;
+    return 0;
+
+fail:
+    if (bank_fd >= 0)
+        close(bank_fd);
+    bank_fd = -1;
+    bank_count = 0;
+    return -1;
+}
+
+void bank_write(uint16_t address, uint16_t val)
+{
+    if (bank_fd < 0)
+        return;
+
+    switch (address) {
+        case BANK_SELECT:
+            if (val >= bank_count || val == bank_cur || bank_map(val) < 0)
+                mem_set(BANK_SELECT, bank_cur);
+            break;
+        case BANK_COUNT:
+            mem_set(BANK_COUNT, bank_count);
+            break;
+        default:
+            break;
+    }
+}
+
+void bank_destroy()
+{
+    if (bank_fd < 0)
+        return;
+    // 窗口的映射随客户机内存一起由 mem_destroy 释放
+    close(bank_fd);
+    bank_fd = -1;
+    bank_count = 0;
+    bank_cur = 0;
+}
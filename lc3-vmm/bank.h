@@ -0,0 +1,35 @@
+#ifndef _BANK_H_
+#define _BANK_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "mem.h"
+
+// 扩展内存: 地址空间中的一个窗口通过选择寄存器映射到主机端更大的存储上.
+// 存储是稀疏的 memfd 或文件, 切换时把它的一段 MAP_FIXED 映射到客户机内存的窗口处,
+// 所以解释器访问窗口仍然是一次数组下标, 不需要额外的查表.
+//
+// SELECT: 映射到窗口的 bank 号, 超出范围的写入被忽略 (读回仍是当前 bank)
+// COUNT:  可用的 bank 数, 只读
+//
+// 窗口不在 vhost 后端共享的内存中, virtio 的缓冲区不能放在窗口里.
+#define BANK_SELECT (DEVICE_BANK + 0)
+#define BANK_COUNT  (DEVICE_BANK + 1)
+#define BANK_END    (DEVICE_BANK + 2)
+
+// 窗口 xC000 − xDFFF, 8K 字, 与主机页对齐; lcc 的栈从 xEFFF 向下增长
+#define BANK_WINDOW_START 0XC000
+#define BANK_WINDOW_WORDS 0X2000
+#define BANK_BYTES        (BANK_WINDOW_WORDS * sizeof(uint16_t))
+#define BANK_MAX          0XFFFF
+
+// path 为 NULL 时使用匿名的 memfd; 文件已有内容时 nbanks 可以为 0, 按文件大小计算.
+// 文件不足 nbanks 个 bank 时扩展 (稀疏). 返回 -1 表示失败
+int bank_init(const char *path, unsigned nbanks);
+void bank_write(uint16_t address, uint16_t val);
+void bank_destroy();
+
+#endif
@@ -0,0 +1,510 @@
+#include <string.h>
+
+#include "lc3.h"
+#include "mem.h"
+#include "batch.h"
+#include "opcodes.h"
+
+// 16 个 16 位通道正好是一个 AVX2 寄存器, 没有 AVX2 时编译器拆成两个 SSE 寄存器
+typedef uint16_t vec16 __attribute__((vector_size(BATCH_LANES * sizeof(uint16_t))));
+typedef int16_t svec16 __attribute__((vector_size(BATCH_LANES * sizeof(uint16_t))));
+
+#define BLEND(m, new, old) (((new) & (m)) | ((old) & ~(m)))
+#define SPLAT(x) ((vec16){0} + (uint16_t)(x))
+
+struct batch {
+    vec16 reg[R_COUNT];             /* reg[r][lane] */
+    uint16_t *mem[BATCH_LANES];
+    FILE *in[BATCH_LANES];
+    FILE *out[BATCH_LANES];
+    uint32_t active;                /* 未停机的通道 */
+    uint32_t dirty;                 /* 通道写过或内容不同的页 (每页一位), 其中的指令逐通道比较 */
+    uint64_t steps;                 /* 执行的指令数 (按组计) */
+    uint64_t lane_steps;            /* 执行的指令数 (按通道计) */
+    uint64_t icount[BATCH_LANES];   /* 每个通道执行的指令数, 在块结束时累加 */
+};
+
+static inline uint16_t bsext(uint16_t x, int bit_count)
+{
+    if ((x >> (bit_count - 1)) & 1) {
+        x |= (0xFFFF << bit_count);
+    }
+    return x;
+}
+
+// 向量按指针传递: 不同 target 的克隆函数之间按值传递 32 字节向量的 ABI 不一致
+static inline __attribute__((always_inline)) void batch_set(struct batch *b, const vec16 *m, int r, vec16 v)
+{
+    vec16 zero = (vec16)(v == 0);
+    vec16 neg = (vec16)((svec16)v < 0);
+    vec16 cc = (zero & FL_ZRO) | (neg & FL_NEG) | (~(zero | neg) & FL_POS);
+
+    b->reg[r] = BLEND(*m, v, b->reg[r]);
+    b->reg[R_COND] = BLEND(*m, cc, b->reg[R_COND]);
+}
+
+static inline __attribute__((always_inline)) void batch_mask_vec(vec16 *m, uint32_t mask)
+{
+    int i;
+
+    for (i = 0; i < BATCH_LANES; i++) {
+        (*m)[i] = (mask >> i) & 1 ? 0xFFFF : 0;
+    }
+}
+
+static void batch_fault(struct batch *b, int lane, const char *what, uint16_t addr)
+{
+    fprintf(b->out[lane], "\nbatch: lane %d stopped, %s at 0x%04x\n", lane, what, addr);
+    b->active &= ~(1u << lane);
+}
+
+// 设备访问按通道执行. 键盘寄存器从通道自己的输入读取, 其它设备在批量模式下不支持.
+static inline uint16_t batch_read(struct batch *b, int lane, uint16_t addr)
+{
+    uint16_t *mem = b->mem[lane];
+    int c;
+
+    if (addr == MR_KBSR) {
+        c = getc(b->in[lane]);
+        if (c != EOF) {
+            ungetc(c, b->in[lane]);
+            mem[MR_KBSR] = 1 << 15;
+            mem[MR_KBDR] = getc(b->in[lane]);
+        } else {
+            mem[MR_KBDR] = 0;
+        }
+    }
+    return mem[addr];
+}
+
+static inline void batch_write(struct batch *b, int lane, uint16_t addr, uint16_t val)
+{
+    if ((addr >= INTERRUPT_START && addr <= INTERRUPT_END) ||
+            (addr >= DEVICE_START && addr < DEVICE_VIRTIO + 0x100)) {
+        batch_fault(b, lane, "device write", addr);
+        return;
+    }
+    b->dirty |= 1u << (addr >> MEM_PAGE_SHIFT);
+    b->mem[lane][addr] = val;
+}
+
+static void batch_trap(struct batch *b, int lane, uint16_t trap)
+{
+    uint16_t *mem = b->mem[lane];
+    FILE *out = b->out[lane];
+    uint16_t *c;
+    uint16_t r0;
+
+    switch (trap) {
+        case TRAP_GETC:
+            r0 = (uint16_t)getc(b->in[lane]);
+            b->reg[R_R0][lane] = r0;
+            b->reg[R_COND][lane] = r0 == 0 ? FL_ZRO : (r0 >> 15 ? FL_NEG : FL_POS);
+            break;
+        case TRAP_OUT:
+            putc((char)b->reg[R_R0][lane], out);
+            break;
+        case TRAP_PUTS:
+            for (c = mem + b->reg[R_R0][lane]; *c; ++c) {
+                putc((char)*c, out);
+            }
+            break;
+        case TRAP_IN:
+            {
+                char ch = getc(b->in[lane]);
+                putc(ch, out);
+                r0 = (uint16_t)ch;
+                b->reg[R_R0][lane] = r0;
+                b->reg[R_COND][lane] = r0 == 0 ? FL_ZRO : (r0 >> 15 ? FL_NEG : FL_POS);
+            }
+            break;
+        case TRAP_PUTSP:
+            for (c = mem + b->reg[R_R0][lane]; *c; ++c) {
+                putc((*c) & 0xFF, out);
+                if ((*c) >> 8) {
+                    putc((*c) >> 8, out);
+                }
+            }
+            break;
+        case TRAP_HALT:
+            b->active &= ~(1u << lane);
+            break;
+        case TRAP_GETS:
+            {
+                uint16_t addr = b->reg[R_R0][lane];
+                uint32_t max = b->reg[R_R1][lane], n = 0;
+                int ch;
+
+                if (max > MEMORY_MAX - addr)
+                    max = MEMORY_MAX - addr;
+                while (n < max && (ch = getc(b->in[lane])) != EOF) {
+                    batch_write(b, lane, addr + n++, (uint16_t)ch);
+                    putc(ch, out);
+                    if (ch == '\n')
+                        break;
+                }
+                r0 = (uint16_t)n;
+                b->reg[R_R0][lane] = r0;
+                b->reg[R_COND][lane] = r0 == 0 ? FL_ZRO : (r0 >> 15 ? FL_NEG : FL_POS);
+            }
+            break;
+    }
+}
+
+// 选出 PC 最小的一组通道. 落后的通道先执行, 分支发散后最容易重新汇合.
+static int batch_regroup(struct batch *b, uint16_t *pc, uint32_t *mask)
+{
+    uint32_t active = b->active;
+    uint16_t min = 0xFFFF;
+    int i;
+
+    if (!active)
+        return 0;
+
+    for (i = 0; i < BATCH_LANES; i++) {
+        if (((active >> i) & 1) && b->reg[R_PC][i] <= min) {
+            min = b->reg[R_PC][i];
+        }
+    }
+
+    *mask = 0;
+    for (i = 0; i < BATCH_LANES; i++) {
+        if (((active >> i) & 1) && b->reg[R_PC][i] == min) {
+            *mask |= 1u << i;
+        }
+    }
+    *pc = min;
+    return 1;
+}
+
+#define FOR_EACH_LANE(lane, mask) \
+    for (uint32_t _m = (mask); _m && ((lane) = __builtin_ctz(_m), 1); _m &= _m - 1)
+
+// 设备访问可能让某些通道停下
+#define BATCH_STORE_END() \
+    do { \
+        if ((mask & b->active) != mask) { \
+            batch_count(b, mask & ~b->active, pc - start); \
+            mask &= b->active; \
+            batch_mask_vec(&m, mask); \
+        } \
+    } while (0)
+
+static inline void batch_count(struct batch *b, uint32_t mask, uint16_t n)
+{
+    int lane;
+
+    FOR_EACH_LANE(lane, mask) {
+        b->icount[lane] += n;
+    }
+}
+
+// 执行一个基本块, 遇到控制转移指令后返回, 各通道的下一条 PC 写回 reg[R_PC]
+__attribute__((target_clones("avx2", "default")))
+void batch_block(struct batch *b, uint16_t pc, uint32_t mask)
+{
+    uint16_t start = pc;
+    vec16 m;
+    int lane;
+
+    batch_mask_vec(&m, mask);
+    while (mask) {
+        uint16_t instr = b->mem[__builtin_ctz(mask)][pc];
+
+        // 通道写过这一页时各通道的指令可能不同, 不同的通道留到下一轮单独成组
+        if ((b->dirty >> (pc >> MEM_PAGE_SHIFT)) & 1) {
+            uint32_t same = 0;
+            FOR_EACH_LANE(lane, mask) {
+                if (b->mem[lane][pc] == instr) {
+                    same |= 1u << lane;
+                }
+            }
+            if (same != mask) {
+                FOR_EACH_LANE(lane, mask) {
+                    b->reg[R_PC][lane] = pc;
+                }
+                batch_count(b, mask & ~same, pc - start);
+                mask = same;
+                batch_mask_vec(&m, mask);
+            }
+        }
+
+        uint16_t r0 = (instr >> 9) & 0x7;
+        uint16_t r1 = (instr >> 6) & 0x7;
+
+        b->steps++;
+        b->lane_steps += __builtin_popcount(mask);
+        pc++;
+
+        switch (lc3_decode(instr)) {
+            case INSN_ADD:
+                batch_set(b, &m, r0, b->reg[r1] + b->reg[instr & 0x7]);
+                break;
+            case INSN_ADDI:
+                batch_set(b, &m, r0, b->reg[r1] + bsext(instr & 0x1F, 5));
+                break;
+            case INSN_AND:
+                batch_set(b, &m, r0, b->reg[r1] & b->reg[instr & 0x7]);
+                break;
+            case INSN_ANDI:
+                batch_set(b, &m, r0, b->reg[r1] & bsext(instr & 0x1F, 5));
+                break;
+            case INSN_NOT:
+                batch_set(b, &m, r0, ~b->reg[r1]);
+                break;
+            case INSN_LEA:
+                {
+                    vec16 v = SPLAT(pc + bsext(instr & 0x1FF, 9));
+                    batch_set(b, &m, r0, v);
+                }
+                break;
+            case INSN_LD:
+                {
+                    vec16 v = b->reg[r0];
+                    uint16_t addr = pc + bsext(instr & 0x1FF, 9);
+                    FOR_EACH_LANE(lane, mask) {
+                        v[lane] = batch_read(b, lane, addr);
+                    }
+                    batch_set(b, &m, r0, v);
+                }
+                break;
+            case INSN_LDI:
+                {
+                    vec16 v = b->reg[r0];
+                    uint16_t addr = pc + bsext(instr & 0x1FF, 9);
+                    FOR_EACH_LANE(lane, mask) {
+                        v[lane] = batch_read(b, lane, batch_read(b, lane, addr));
+                    }
+                    batch_set(b, &m, r0, v);
+                }
+                break;
+            case INSN_LDR:
+                {
+                    vec16 v = b->reg[r0];
+                    vec16 addr = b->reg[r1] + bsext(instr & 0x3F, 6);
+                    FOR_EACH_LANE(lane, mask) {
+                        v[lane] = batch_read(b, lane, addr[lane]);
+                    }
+                    batch_set(b, &m, r0, v);
+                }
+                break;
+            case INSN_ST:
+                {
+                    uint16_t addr = pc + bsext(instr & 0x1FF, 9);
+                    FOR_EACH_LANE(lane, mask) {
+                        batch_write(b, lane, addr, b->reg[r0][lane]);
+                    }
+                }
+                BATCH_STORE_END();
+                break;
+            case INSN_STI:
+                {
+                    uint16_t addr = pc + bsext(instr & 0x1FF, 9);
+                    FOR_EACH_LANE(lane, mask) {
+                        batch_write(b, lane, batch_read(b, lane, addr), b->reg[r0][lane]);
+                    }
+                }
+                BATCH_STORE_END();
+                break;
+            case INSN_STR:
+                {
+                    vec16 addr = b->reg[r1] + bsext(instr & 0x3F, 6);
+                    FOR_EACH_LANE(lane, mask) {
+                        batch_write(b, lane, addr[lane], b->reg[r0][lane]);
+                    }
+                }
+                BATCH_STORE_END();
+                break;
+            // 条件位是常量, NOP 和 BRnzp 不需要比较 R_COND
+#define BR_HANDLER(id, name, match, mask_, fmt, flags) \
+            case INSN_##id: \
+                { \
+                    vec16 taken = (vec16)((b->reg[R_COND] & LC3_BR_NZP(match)) != 0); \
+                    if (LC3_BR_NZP(match) == 0x7) \
+                        taken = SPLAT(0xFFFF); \
+                    vec16 next = (taken & (uint16_t)(pc + bsext(instr & 0x1FF, 9))) | (~taken & pc); \
+                    b->reg[R_PC] = BLEND(m, next, b->reg[R_PC]); \
+                } \
+                batch_count(b, mask, pc - start); \
+                return;
+            LC3_BR_INSNS(BR_HANDLER)
+#undef BR_HANDLER
+            case INSN_JMP:
+                b->reg[R_PC] = BLEND(m, b->reg[r1], b->reg[R_PC]);
+                batch_count(b, mask, pc - start);
+                return;
+            case INSN_JSR:
+                b->reg[R_R7] = BLEND(m, SPLAT(pc), b->reg[R_R7]);
+                b->reg[R_PC] = BLEND(m, SPLAT(pc + bsext(instr & 0x7FF, 11)), b->reg[R_PC]);
+                batch_count(b, mask, pc - start);
+                return;
+            case INSN_JSRR:
+                {
+                    vec16 target = b->reg[r1];
+                    b->reg[R_R7] = BLEND(m, SPLAT(pc), b->reg[R_R7]);
+                    b->reg[R_PC] = BLEND(m, target, b->reg[R_PC]);
+                }
+                batch_count(b, mask, pc - start);
+                return;
+            case INSN_TRAP:
+                b->reg[R_R7] = BLEND(m, SPLAT(pc), b->reg[R_R7]);
+                b->reg[R_PC] = BLEND(m, SPLAT(pc), b->reg[R_PC]);
+                FOR_EACH_LANE(lane, mask) {
+                    batch_trap(b, lane, instr & 0xFF);
+                }
+                batch_count(b, mask, pc - start);
+                return;
+            case INSN_RTI:
+            case INSN_RES:
+                FOR_EACH_LANE(lane, mask) {
+                    batch_fault(b, lane, "unsupported instruction", pc - 1);
+                }
+                batch_count(b, mask, pc - start);
+                return;
+        }
+    }
+}
+
+static int batch_group(const char *inputs[], int n, uint64_t *steps, uint64_t *lane_steps)
+{
+    struct batch *b;
+    char path[4096];
+    uint32_t mask;
+    uint16_t pc;
+    int i, ret = 0;
+
+    b = (struct batch *)aligned_alloc(64, sizeof(struct batch));
+    if (!b)
+        return -1;
+    memset(b, 0, sizeof(*b));
+
+    for (i = 0; i < n; i++) {
+        snprintf(path, sizeof(path), "%s.out", inputs[i]);
+        b->mem[i] = (uint16_t *)malloc(MEMORY_MAX * sizeof(uint16_t));
+        b->in[i] = fopen(inputs[i], "rb");
+        b->out[i] = fopen(path, "wb");
+        if (!b->mem[i] || !b->in[i] || !b->out[i]) {
+            printf("batch: failed to open lane %d: %s\n", i, inputs[i]);
+            ret = -1;
+            n = i + 1;
+            goto out;
+        }
+        memcpy(b->mem[i], mem_addr(), MEMORY_MAX * sizeof(uint16_t));
+        b->reg[R_COND][i] = FL_ZRO;
+        b->reg[R_PC][i] = 0x3000;
+        b->active |= 1u << i;
+    }
+
+    while (batch_regroup(b, &pc, &mask)) {
+        batch_block(b, pc, mask);
+    }
+
+    *steps += b->steps;
+    *lane_steps += b->lane_steps;
+
+out:
+    for (i = 0; i < n; i++) {
+        if (b->in[i])
+            fclose(b->in[i]);
+        if (b->out[i])
+            fclose(b->out[i]);
+        free(b->mem[i]);
+    }
+    free(b);
+    return ret;
+}
+
+int batch_run(const char *inputs[], int ninputs)
+{
+    uint64_t steps = 0, lane_steps = 0;
+    int i, n;
+
+    for (i = 0; i < ninputs; i += BATCH_LANES) {
+        n = ninputs - i < BATCH_LANES ? ninputs - i : BATCH_LANES;
+        if (batch_group(inputs + i, n, &steps, &lane_steps) < 0)
+            return -1;
+    }
+
+    fprintf(stderr, ">>> batch: %d guests, %llu steps, %.2f lanes/step\n", ninputs,
+            (unsigned long long)steps, steps ? (double)lane_steps / steps : 0.0);
+    return 0;
+}
+
+struct batch *batch_new(uint16_t *mem[], const uint16_t *regs[], int n)
+{
+    struct batch *b;
+    int i, r, p;
+
+    if (n < 1 || n > BATCH_LANES)
+        return NULL;
+    b = (struct batch *)aligned_alloc(64, sizeof(struct batch));
+    if (!b)
+        return NULL;
+    memset(b, 0, sizeof(*b));
+
+    for (i = 0; i < n; i++) {
+        b->mem[i] = mem[i];
+        b->in[i] = fopen("/dev/null", "rb");
+        b->out[i] = fopen("/dev/null", "wb");
+        if (!b->in[i] || !b->out[i]) {
+            b->active = (1u << i) - 1;
+            batch_free(b);
+            return NULL;
+        }
+        for (r = 0; r < R_COUNT; r++)
+            b->reg[r][i] = regs[i][r];
+        b->active |= 1u << i;
+
+        // 与通道 0 内容不同的页从一开始就逐通道取指令
+        for (p = 0; p < MEM_PAGES; p++) {
+            if (memcmp(mem[i] + p * MEM_PAGE_WORDS, mem[0] + p * MEM_PAGE_WORDS,
+                    MEM_PAGE_WORDS * sizeof(uint16_t)))
+                b->dirty |= 1u << p;
+        }
+    }
+    return b;
+}
+
+uint32_t batch_next(struct batch *b)
+{
+    uint32_t mask;
+    uint16_t pc;
+
+    if (!batch_regroup(b, &pc, &mask))
+        return 0;
+    batch_block(b, pc, mask);
+    return mask;
+}
+
+uint32_t batch_active(struct batch *b)
+{
+    return b->active;
+}
+
+void batch_lane(struct batch *b, int lane, uint16_t regs[], uint64_t *icount)
+{
+    int r;
+
+    for (r = 0; r < R_COUNT; r++)
+        regs[r] = b->reg[r][lane];
+    *icount = b->icount[lane];
+}
+
+void batch_stop(struct batch *b, int lane)
+{
+    b->active &= ~(1u << lane);
+}
+
+void batch_free(struct batch *b)
+{
+    int i;
+
+    // 只关闭 batch_new 打开的文件, 内存属于调用者
+    for (i = 0; i < BATCH_LANES; i++) {
+        if (b->in[i])
+            fclose(b->in[i]);
+        if (b->out[i])
+            fclose(b->out[i]);
+    }
+    free(b);
+}
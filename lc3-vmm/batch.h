@@ -0,0 +1,30 @@
+#ifndef _BATCH_H_
+#define _BATCH_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// 批量执行: 同一个镜像的多个客户机按 SIMD 通道同步执行.
+// 寄存器以结构数组 (SoA) 存放, 一条解码后的指令作用于所有通道;
+// 分支发散时按 PC 重新分组, TRAP 和设备访问按通道逐个执行.
+#define BATCH_LANES 16
+
+// 以当前客户机内存为模板, 每个输入文件对应一个通道,
+// 通道的输出写到 <input>.out
+int batch_run(const char *inputs[], int ninputs);
+
+// 逐块执行的接口, 供差分测试 (difftest.h) 与参考解释器对照.
+// 每个通道使用调用者的内存 mem[i] 和初始寄存器 regs[i][R_COUNT], TRAP 的输入输出为 /dev/null.
+// 各通道的内存可以不同
+struct batch;
+struct batch *batch_new(uint16_t *mem[], const uint16_t *regs[], int n);
+// 选出 PC 最小的一组通道执行一个基本块, 返回这组通道, 0 表示全部停机
+uint32_t batch_next(struct batch *b);
+uint32_t batch_active(struct batch *b);
+// 通道的寄存器和累计执行的指令数
+void batch_lane(struct batch *b, int lane, uint16_t regs[], uint64_t *icount);
+void batch_stop(struct batch *b, int lane);
+void batch_free(struct batch *b);
+
+#endif
@@ -0,0 +1,151 @@
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "cpu.h"
+#include "mem.h"
+#include "chan.h"
+
+__thread int chan_nowait;
+
+static struct {
+    uint64_t kicks;
+    uint64_t wakes;
+    uint64_t waits;
+    uint64_t sleeps;
+} chan_stats;
+
+// HEAD 和 TAIL 相邻且 4 字节对齐, 合起来作为 futex 字, 任一方改动下标都会让等待者的比较失败.
+// 文件是 MAP_SHARED 映射, 用非私有的 futex 才能跨进程唤醒
+static uint32_t *chan_futex(struct chan_ring *r)
+{
+    return (uint32_t *)&r->head;
+}
+
+static struct chan_ring *chan_ring(uint16_t n)
+{
+    uint16_t *page = mem_addr() + CHAN_WINDOW;
+
+    if (page[0] != CHAN_MAGIC || n >= page[1])
+        return NULL;
+    return (struct chan_ring *)(page + CHAN_RING_HDR) + n;
+}
+
+static void chan_init(uint16_t *page)
+{
+    struct chan_ring *r = (struct chan_ring *)(page + CHAN_RING_HDR);
+    int i;
+
+    for (i = 0; i < CHAN_RINGS; i++) {
+        memset(&r[i], 0, sizeof(r[i]));
+        r[i].size = CHAN_RING_WORDS;
+        r[i].data = CHAN_RING_DATA + i * CHAN_RING_WORDS;
+    }
+    page[1] = CHAN_RINGS;
+    __atomic_store_n(&page[0], CHAN_MAGIC, __ATOMIC_RELEASE);
+}
+
+int chan_attach(uint16_t *memory, const char *path)
+{
+    struct stat st;
+    uint16_t *page;
+    int fd, ret = -1;
+
+    fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0)
+        return -1;
+
+    // 多个进程同时创建时只由一个初始化
+    if (flock(fd, LOCK_EX) < 0 || fstat(fd, &st) < 0)
+        goto out;
+    if (st.st_size < CHAN_BYTES && ftruncate(fd, CHAN_BYTES) < 0)
+        goto out;
+
+    page = mmap(memory + CHAN_WINDOW, CHAN_BYTES, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_FIXED, fd, 0);
+    if (page == MAP_FAILED)
+        goto out;
+    if (page[0] != CHAN_MAGIC)
+        chan_init(page);
+    ret = 0;
+
+out:
+    // 映射不依赖 fd, 随客户机内存一起释放
+    flock(fd, LOCK_UN);
+    close(fd);
+    return ret;
+}
+
+static void chan_wait(struct chan_ring *r, int tx)
+{
+    uint16_t *flag = tx ? &r->tx_wait : &r->rx_wait;
+    uint32_t v;
+    uint16_t head, tail;
+    struct timespec ts = { 0, CHAN_WAIT_MS * 1000000L };
+
+    // 等待之后回到 cpu_run_budget 的调用者, --smp 的其他 CPU 借此及时发现虚拟机已结束
+    cpu_yield = 1;
+    __atomic_add_fetch(&chan_stats.waits, 1, __ATOMIC_RELAXED);
+    if (chan_nowait)
+        return;
+
+    // 先登记再检查, 与 chan_kick 中先改下标再检查登记配对, 不会丢失唤醒
+    __atomic_store_n(flag, 1, __ATOMIC_SEQ_CST);
+    v = __atomic_load_n(chan_futex(r), __ATOMIC_SEQ_CST);
+    head = v & 0xFFFF;
+    tail = v >> 16;
+    if (tx ? (uint16_t)(head - tail) >= r->size : head == tail) {
+        __atomic_add_fetch(&chan_stats.sleeps, 1, __ATOMIC_RELAXED);
+        syscall(SYS_futex, chan_futex(r), FUTEX_WAIT, v, &ts, NULL, 0);
+    }
+    __atomic_store_n(flag, 0, __ATOMIC_SEQ_CST);
+}
+
+static void chan_kick(struct chan_ring *r)
+{
+    __atomic_add_fetch(&chan_stats.kicks, 1, __ATOMIC_RELAXED);
+    // 唤醒的同时清除登记, 对方醒来之前的后续 KICK 不再进入内核
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if ((__atomic_load_n(&r->rx_wait, __ATOMIC_RELAXED) |
+            __atomic_load_n(&r->tx_wait, __ATOMIC_RELAXED)) &&
+            (__atomic_exchange_n(&r->rx_wait, 0, __ATOMIC_SEQ_CST) |
+             __atomic_exchange_n(&r->tx_wait, 0, __ATOMIC_SEQ_CST))) {
+        __atomic_add_fetch(&chan_stats.wakes, 1, __ATOMIC_RELAXED);
+        syscall(SYS_futex, chan_futex(r), FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+    }
+}
+
+void chan_write(uint16_t address, uint16_t val)
+{
+    struct chan_ring *r = chan_ring(val);
+
+    if (!r)
+        return;
+
+    switch (address) {
+        case CHAN_KICK:
+            chan_kick(r);
+            break;
+        case CHAN_WAIT_RX:
+            chan_wait(r, 0);
+            break;
+        case CHAN_WAIT_TX:
+            chan_wait(r, 1);
+            break;
+        default:
+            break;
+    }
+}
+
+void chan_report()
+{
+    if (!getenv("LC3_CHAN_STATS") || (!chan_stats.kicks && !chan_stats.waits))
+        return;
+    fprintf(stderr, ">>> chan: %llu kicks (%llu woke a peer), %llu waits (%llu slept)\n",
+            (unsigned long long)chan_stats.kicks, (unsigned long long)chan_stats.wakes,
+            (unsigned long long)chan_stats.waits, (unsigned long long)chan_stats.sleeps);
+}
@@ -0,0 +1,67 @@
+#ifndef _CHAN_H_
+#define _CHAN_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "mem.h"
+
+// 虚拟机间通道: 一个共享文件 (例如 /dev/shm 下的文件) 以 MAP_SHARED | MAP_FIXED 映射到
+// 每个客户机的 xF000 − xF7FF, 里面有 CHAN_RINGS 个单生产者/单消费者的环形队列.
+// 客户机直接读写队列中的数据和下标, 不经过主机拷贝. 同一进程内的多个 VM (lc3vm.h, --smp)
+// 和不同进程的 lc3-vmm 映射同一个文件即可通信, 每个队列由哪个 VM 生产, 哪个 VM 消费由客户机约定.
+//
+// 页内布局 (字):
+//   +0  CHAN_MAGIC, 映射成功后可见
+//   +1  队列个数
+//   +16 + n * 8 第 n 个队列的头: HEAD, TAIL, SIZE, DATA, RX_WAIT, TX_WAIT
+//       HEAD 只由生产者写, TAIL 只由消费者写, 都是自由增长的 16 位计数;
+//       HEAD == TAIL 为空, HEAD - TAIL == SIZE 为满. 数据在 xF000 + DATA + (下标 & (SIZE - 1))
+//       RX_WAIT/TX_WAIT 由主机维护, 表示消费者/生产者正在等待
+//
+// 门铃寄存器 (DEVICE_CHAN 起始), 写入队列号:
+// KICK:    改动 HEAD 或 TAIL 之后写入. 只有对方在等待时才唤醒它 (一次 futex 系统调用),
+//          对方在运行时只是一次内存读
+// WAIT_RX: 队列为空时写入, 睡眠到队列非空, 被唤醒或 CHAN_WAIT_MS 超时. 返回后客户机需要重新检查
+// WAIT_TX: 队列为满时写入, 睡眠到队列有空位
+//
+// 下标与数据之间依赖主机的内存顺序 (x86 的存储按序可见).
+#define CHAN_KICK    (DEVICE_CHAN + 0)
+#define CHAN_WAIT_RX (DEVICE_CHAN + 1)
+#define CHAN_WAIT_TX (DEVICE_CHAN + 2)
+#define CHAN_END     (DEVICE_CHAN + 3)
+
+// 窗口是一个主机页, lcc 的栈从 xEFFF 向下增长, 不会用到这里
+#define CHAN_WINDOW 0XF000
+#define CHAN_WORDS  MEM_PAGE_WORDS
+#define CHAN_BYTES  (CHAN_WORDS * sizeof(uint16_t))
+#define CHAN_MAGIC  0X4348
+
+#define CHAN_RINGS      4
+#define CHAN_RING_HDR   16
+#define CHAN_RING_WORDS 256
+#define CHAN_RING_DATA  0X400
+#define CHAN_WAIT_MS    10
+
+struct chan_ring {
+    uint16_t head;
+    uint16_t tail;
+    uint16_t size;
+    uint16_t data;
+    uint16_t rx_wait;
+    uint16_t tx_wait;
+    uint16_t reserved[2];
+};
+
+// 为 1 时 WAIT_RX/WAIT_TX 不睡眠, 只让 cpu_run_budget 返回 CPU_YIELD,
+// 由宿主去运行别的 VM (同一进程内交替运行的 lc3vm)
+extern __thread int chan_nowait;
+
+// 把通道文件映射到 memory 的窗口处, 文件不存在时创建并初始化. 返回 -1 表示失败
+int chan_attach(uint16_t *memory, const char *path);
+void chan_write(uint16_t address, uint16_t val);
+// LC3_CHAN_STATS 时在 stderr 打印门铃统计
+void chan_report();
+
+#endif
@@ -0,0 +1,585 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/termios.h>
+
+#include "lc3.h"
+#include "mem.h"
+#include "interrupt.h"
+#include "timer.h"
+#include "bank.h"
+#include "cpu.h"
+#include "fuzz.h"
+#include "gdb.h"
+#include "memprof.h"
+#include "smp.h"
+#include "sample.h"
+#include "chan.h"
+#include "opcodes.h"
+#include "perf.h"
+
+// Register Storage
+// CPU 状态按线程存放, 多处理器时每个 vCPU 是一个主机线程 (见 smp.h)
+__thread uint16_t reg[R_COUNT];
+
+// 当前优先级和保存的栈指针, PSR 的定义见 cpu.h
+__thread int cpu_priority = 0;
+__thread uint16_t saved_ssp = 0x3000;
+__thread uint16_t saved_usp;
+
+// 已执行的指令数. 只在基本块结束 (跳转/陷入) 时按块长度累加,
+// 设备的到期检查也只在那时进行, 不增加每条指令的开销.
+__thread uint64_t icount;
+__thread uint16_t block_start;
+
+// 为 1 时 cpu_run_budget 在当前指令后返回 CPU_YIELD
+__thread int cpu_yield;
+
+// 带符号的数值扩展
+// 最高位正数填充0, 负数填充1, 以便保留原始值
+uint16_t sign_extend(uint16_t x, int bit_count)
+{
+    if ((x >> (bit_count - 1)) & 1) {
+        x |= (0xFFFF << bit_count);
+    }
+    return x;
+}
+
+void update_flags(uint16_t r)
+{
+    if (reg[r] == 0) {
+        reg[R_COND] = FL_ZRO;
+    } else if (reg[r] >> 15) { // 最左边的位为 1 表示负数
+        reg[R_COND] = FL_NEG;
+    } else {
+        reg[R_COND] = FL_POS;
+    }
+}
+
+// 块内已执行但尚未累加的指令也计算在内
+uint64_t cpu_icount()
+{
+    return icount + (uint16_t)(reg[R_PC] - block_start);
+}
+
+// 写内存前的回调, AOT 运行时用它发现对已翻译代码的改写
+void (*cpu_store_hook)(uint16_t address, uint16_t val);
+
+// 嵌入时由宿主处理的 TRAP 和 [cpu_io_start, cpu_io_start + cpu_io_size) 内的访存, 见 cpu.h
+int (*cpu_trap_hook)(uint16_t trap);
+int (*cpu_io_read_hook)(uint16_t address, uint16_t *val);
+int (*cpu_io_write_hook)(uint16_t address, uint16_t val);
+uint16_t cpu_io_start;
+uint32_t cpu_io_size;
+
+jmp_buf *cpu_fault_jmp;
+
+// 非法指令 (RES, 用户态 RTI): 嵌入时返回到 cpu_fault_jmp, 否则结束进程
+static void cpu_fault(int fault)
+{
+    if (cpu_fault_jmp) {
+        longjmp(*cpu_fault_jmp, fault);
+    }
+    abort();
+}
+
+static inline int cpu_io(uint16_t address)
+{
+    return (uint16_t)(address - cpu_io_start) < cpu_io_size;
+}
+
+void mem_write(uint16_t address, uint16_t val)
+{
+    PERF_COUNT(perf_stores);
+    if (cpu_store_hook) {
+        cpu_store_hook(address, val);
+    }
+    if (cpu_io(address) && !cpu_io_write_hook(address, val)) {
+        return;
+    }
+    if (mem_watch[address >> MEM_PAGE_SHIFT]) {
+        gdb_access(address, 1);
+    }
+    if (memprof_enabled) {
+        memprof_access(address, 1);
+    }
+    mem_set(address, val);
+
+    if (address >= INTERRUPT_START && address <= INTERRUPT_END) {
+        smp_lock();
+        int_handler(address);
+        smp_unlock();
+    } else if (address >= DEVICE_TIMER && address < TIMER_END) {
+        timer_write(address, val, cpu_icount());
+    } else if (address >= DEVICE_BANK && address < BANK_END) {
+        smp_lock();
+        bank_write(address, val);
+        smp_unlock();
+    } else if (address >= DEVICE_SMP && address < SMP_END) {
+        smp_write(address, val);
+    } else if (address >= DEVICE_CHAN && address < CHAN_END) {
+        chan_write(address, val);
+    } else if (address >= DEVICE_PERF && address < PERF_END) {
+        perf_write(address, val, cpu_icount());
+    }
+
+}
+
+struct termios original_tio;
+
+void disable_input_buffering()
+{
+    tcgetattr(STDIN_FILENO, &original_tio);
+    struct termios new_tio = original_tio;
+    new_tio.c_lflag &= ~ICANON & ~ECHO;
+    tcsetattr(STDIN_FILENO, TCSANOW, &new_tio);
+}
+
+void restore_input_buffering()
+{
+    tcsetattr(STDIN_FILENO, TCSANOW, &original_tio);
+}
+
+uint16_t check_key()
+{
+    fd_set readfds;
+    FD_ZERO(&readfds);
+    FD_SET(STDIN_FILENO, &readfds);
+
+    struct timeval timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_usec = 0;
+    // 被 SIGPROF 等信号打断时返回 -1, 不是按键
+    return select(1, &readfds, NULL, NULL, &timeout) > 0;
+}
+
+uint16_t mem_read(uint16_t address)
+{
+    uint16_t val;
+
+    PERF_COUNT(perf_loads);
+    if (mem_watch[address >> MEM_PAGE_SHIFT]) {
+        gdb_access(address, 0);
+    }
+    if (memprof_enabled) {
+        memprof_access(address, 0);
+    }
+    if (cpu_io(address) && !cpu_io_read_hook(address, &val)) {
+        return val;
+    }
+
+    if (address == MR_KBSR) {
+        if (check_key()) {
+            mem_set(MR_KBSR, 1 << 15);
+            mem_set(MR_KBDR, getchar());
+        } else {
+            mem_set(MR_KBDR, 0);
+        }
+    } else if (address >= INTERRUPT_START && address <= INTERRUPT_END) {
+        smp_lock();
+        int_poll(address);
+        smp_unlock();
+    } else if (address >= DEVICE_TIMER && address < TIMER_END) {
+        timer_read(address, cpu_icount());
+    } else if (address >= DEVICE_SMP && address < SMP_END) {
+        // 每个 CPU 读到的值不同, 不经过共用的内存
+        return smp_read(address);
+    } else if (address >= DEVICE_PERF && address < PERF_END) {
+        return perf_read(address, cpu_icount());
+    }
+    return mem_get(address);
+}
+
+// 保存 PSR 和 PC, 跳转到中断向量指向的处理程序
+void deliver_interrupt()
+{
+    uint16_t psr = (cpu_priority ? 0 : PSR_USER) | (cpu_priority << 8) | reg[R_COND];
+    int priority = int_pending();
+    uint16_t vector = int_ack();
+
+    if (!cpu_priority) {
+        saved_usp = reg[R_R6];
+        reg[R_R6] = saved_ssp;
+    }
+    reg[R_R6]--;
+    mem_write(reg[R_R6], psr);
+    reg[R_R6]--;
+    mem_write(reg[R_R6], reg[R_PC]);
+
+    cpu_priority = priority;
+    reg[R_PC] = mem_read(vector);
+}
+
+// 基本块结束: 累加指令数, 检查定时器和待处理中断
+void block_end(uint16_t instr_pc)
+{
+    icount += (uint16_t)(instr_pc - block_start) + 1;
+
+    if (fuzz_map) {
+        fuzz_edge(reg[R_PC]);
+    }
+
+    if (icount >= timer_deadline) {
+        timer_tick(icount);
+    }
+    if (smp_active && smp_ipi[smp_id]) {
+        smp_ipi_ack();
+    }
+    if (int_pending() > cpu_priority) {
+        deliver_interrupt();
+    }
+
+    block_start = reg[R_PC];
+
+    if (sample_pending) {
+        sample_take();
+    }
+    if (gdb_attached) {
+        gdb_block(reg[R_PC]);
+    }
+}
+
+// 执行一个 TRAP, 调用前 R7 已保存返回地址. 返回 0 表示 HALT
+int cpu_trap(uint16_t trap)
+{
+    int ret;
+
+    PERF_COUNT(perf_traps);
+    if (cpu_trap_hook && (ret = cpu_trap_hook(trap)) >= 0) {
+        return ret;
+    }
+
+    switch (trap)
+    {
+        case TRAP_GETC:
+            reg[R_R0] = (uint16_t)getchar();
+            update_flags(R_R0);
+            break;
+        case TRAP_OUT:
+            putc((char)reg[R_R0], stdout);
+            fflush(stdout);
+            break;
+        case TRAP_PUTS:
+            {
+                // 16 bit 表示一个字符
+                uint16_t* c = mem_addr() + reg[R_R0];
+                while (*c) {
+                    putc((char)*c, stdout);
+                    ++c;
+                }
+                fflush(stdout);
+            }
+            break;
+        case TRAP_IN:
+            {
+                char c = getchar();
+                putc(c, stdout);
+                fflush(stdout);
+                reg[R_R0] = (uint16_t)c;
+                update_flags(R_R0);
+            }
+            break;
+        case TRAP_PUTSP:
+            {
+                uint16_t* c = mem_addr() + reg[R_R0];
+                while (*c) {
+                    char char1 = (*c) & 0xFF;
+                    putc(char1, stdout);
+                    char char2 = (*c) >> 8;
+                    if (char2) {
+                        putc(char2, stdout);
+                    }
+                    ++c;
+                }
+                fflush(stdout);
+            }
+            break;
+        case TRAP_HALT:
+            fflush(stdout);
+            return 0;
+        case TRAP_GETS:
+            {
+                // 读一行 (含 '\n') 或最多 R1 个字符到 R0 处, 每个字一个字符, 并回显.
+                // R0 返回读到的字符数, 0 表示输入结束.
+                // 和 STR 一样经过 mem_write, 观察点, --memprof 和 AOT 的自修改检查都能看到
+                uint16_t buf = reg[R_R0];
+                uint32_t max = reg[R_R1], n = 0;
+                int c;
+
+                if (max > MEMORY_MAX - buf)
+                    max = MEMORY_MAX - buf;
+                while (n < max && (c = getchar()) != EOF) {
+                    mem_write(buf + n++, (uint16_t)c);
+                    putc(c, stdout);
+                    if (c == '\n')
+                        break;
+                }
+                fflush(stdout);
+                reg[R_R0] = (uint16_t)n;
+                update_flags(R_R0);
+            }
+            break;
+    }
+    return 1;
+}
+
+void cpu_rti()
+{
+    if (!cpu_priority) {
+        cpu_fault(CPU_FAULT_RTI); /* 用户态执行 RTI */
+    }
+    reg[R_PC] = mem_read(reg[R_R6]++);
+    uint16_t psr = mem_read(reg[R_R6]++);
+    cpu_priority = (psr >> 8) & 0x7;
+    reg[R_COND] = psr & 0x7;
+    if (psr & PSR_USER) {
+        saved_ssp = reg[R_R6];
+        reg[R_R6] = saved_usp;
+    }
+}
+
+void cpu_reset(uint16_t pc)
+{
+    // 条件标志清零, 设置 Z(zero) 标志
+    reg[R_COND] = FL_ZRO;
+    reg[R_PC] = pc;
+    block_start = pc;
+}
+
+void cpu_save(struct cpu_state *state)
+{
+    memcpy(state->reg, reg, sizeof(reg));
+    state->priority = cpu_priority;
+    state->saved_ssp = saved_ssp;
+    state->saved_usp = saved_usp;
+    state->icount = icount;
+    state->block_start = block_start;
+}
+
+void cpu_load(const struct cpu_state *state)
+{
+    memcpy(reg, state->reg, sizeof(reg));
+    cpu_priority = state->priority;
+    saved_ssp = state->saved_ssp;
+    saved_usp = state->saved_usp;
+    icount = state->icount;
+    block_start = state->block_start;
+}
+
+// 执行一条指令, 返回 0 表示已停机
+static inline int cpu_step()
+{
+    int running = 1;
+
+    // FETCH 取指令, 不经过设备和观察点
+    uint16_t instr_pc = reg[R_PC]++;
+    uint16_t instr = mem_get(instr_pc);
+    uint16_t insn = lc3_decode(instr); /* 按 bit15-9 和 bit5 查表, 取指令变体 */
+
+    switch (insn) {
+        // BR 的每种条件一个分支, 条件位是常量: NOP 不跳转, BRnzp 总是跳转
+#define BR_HANDLER(id, name, match, mask, fmt, flags) \
+        case INSN_##id: \
+            if (LC3_BR_NZP(match) == 0x7 || (reg[R_COND] & LC3_BR_NZP(match))) { \
+                reg[R_PC] += sign_extend(instr & 0x1FF, 9); \
+                PERF_COUNT(perf_branches); \
+            } \
+            block_end(instr_pc); \
+            break;
+        LC3_BR_INSNS(BR_HANDLER)
+#undef BR_HANDLER
+
+        // 两个变量相加（+）
+        // ADD DR,SR1,SR2
+        case INSN_ADD:
+            {
+                // 目的寄存器 (DR)
+                uint16_t r0 = (instr >> 9) & 0x7;
+                // 源寄存器1 (SR1)
+                uint16_t r1 = (instr >> 6) & 0x7;
+                uint16_t r2 = instr & 0x7;
+                reg[r0] = reg[r1] + reg[r2];
+                update_flags(r0);
+            }
+            break;
+        // ADD DR,SR1,imm
+        case INSN_ADDI:
+            {
+                uint16_t r0 = (instr >> 9) & 0x7;
+                uint16_t r1 = (instr >> 6) & 0x7;
+                uint16_t imm5 = sign_extend(instr & 0x1F, 5);
+                reg[r0] = reg[r1] + imm5;
+                update_flags(r0);
+            }
+            break;
+        case INSN_AND:
+            {
+                uint16_t r0 = (instr >> 9) & 0x7;
+                uint16_t r1 = (instr >> 6) & 0x7;
+                uint16_t r2 = instr & 0x7;
+                reg[r0] = reg[r1] & reg[r2];
+                update_flags(r0);
+            }
+            break;
+        case INSN_ANDI:
+            {
+                uint16_t r0 = (instr >> 9) & 0x7;
+                uint16_t r1 = (instr >> 6) & 0x7;
+                uint16_t imm5 = sign_extend(instr & 0x1F, 5);
+                reg[r0] = reg[r1] & imm5;
+                update_flags(r0);
+            }
+            break;
+        case INSN_NOT:
+            {
+                uint16_t r0 = (instr >> 9) & 0x7;
+                uint16_t r1 = (instr >> 6) & 0x7;
+
+                reg[r0] = ~reg[r1];
+                update_flags(r0);
+            }
+            break;
+        case INSN_JMP:
+            {
+                uint16_t r1 = (instr >> 6) & 0x7;
+                reg[R_PC] = reg[r1];
+                PERF_COUNT(perf_branches);
+                block_end(instr_pc);
+            }
+            break;
+        case INSN_JSR:
+            {
+                reg[R_R7] = reg[R_PC];
+                uint16_t long_pc_offset = sign_extend(instr & 0x7FF, 11);
+                reg[R_PC] += long_pc_offset;  /* JSR 直接跳转 */
+                PERF_COUNT(perf_branches);
+                block_end(instr_pc);
+            }
+            break;
+        case INSN_JSRR:
+            {
+                uint16_t tmp = reg[(instr >> 6) & 0x7];
+                reg[R_R7] = reg[R_PC];
+                reg[R_PC] = tmp; /* JSRR 寄存器间接跳转 */
+                PERF_COUNT(perf_branches);
+                block_end(instr_pc);
+            }
+            break;
+        case INSN_LD:
+            {
+                uint16_t r0 = (instr >> 9) & 0x7;
+                uint16_t pc_offset = sign_extend(instr & 0x1FF, 9);
+                reg[r0] = mem_read(reg[R_PC] + pc_offset);
+                update_flags(r0);
+            }
+            break;
+        case INSN_LDI:
+            {
+                // 目的寄存器 (DR)
+                uint16_t r0 = (instr >> 9) & 0x7;
+                // PC偏移 9bit
+                uint16_t pc_offset = sign_extend(instr & 0x1FF, 9);
+                // 将 pc_offset 加到 PC 上, 然后查看该内存位置获取最终地址
+                reg[r0] = mem_read(mem_read(reg[R_PC] + pc_offset));
+                update_flags(r0);
+            }
+            break;
+        case INSN_LDR:
+            {
+                uint16_t r0 = (instr >> 9) & 0x7;
+                uint16_t r1 = (instr >> 6) & 0x7;
+                uint16_t offset = sign_extend(instr & 0x3F, 6);
+                reg[r0] = mem_read(reg[r1] + offset);
+                update_flags(r0);
+            }
+            break;
+        case INSN_LEA:
+            {
+                uint16_t r0 = (instr >> 9) & 0x7;
+                uint16_t pc_offset = sign_extend(instr & 0x1FF, 9);
+                reg[r0] = reg[R_PC] + pc_offset;
+                update_flags(r0);
+            }
+            break;
+        case INSN_ST:
+            {
+                uint16_t r0 = (instr >> 9) & 0x7;
+                uint16_t pc_offset = sign_extend(instr & 0x1FF, 9);
+                mem_write(reg[R_PC] + pc_offset, reg[r0]);
+            }
+            break;
+        case INSN_STI:
+            {
+                uint16_t r0 = (instr >> 9) & 0x7;
+                uint16_t pc_offset = sign_extend(instr & 0x1FF, 9);
+                mem_write(mem_read(reg[R_PC] + pc_offset), reg[r0]);
+            }
+            break;
+        case INSN_STR:
+            {
+                uint16_t r0 = (instr >> 9) & 0x7;
+                uint16_t r1 = (instr >> 6) & 0x7;
+                uint16_t offset = sign_extend(instr & 0x3F, 6);
+                mem_write(reg[r1] + offset, reg[r0]);
+            }
+            break;
+        case INSN_TRAP:
+            reg[R_R7] = reg[R_PC];
+            running = cpu_trap(instr & 0xFF);
+            block_end(instr_pc);
+            break;
+        case INSN_RTI:
+            cpu_rti();
+            block_end(instr_pc);
+            break;
+        case INSN_RES:
+            cpu_fault(CPU_FAULT_RES); /* RES 未使用 */
+            break;
+        default:
+            printf("error: bad op code\n");
+            break;
+    }
+    return running;
+}
+
+void cpu_run()
+{
+    do {
+        if (gdb_trace) {
+            gdb_check(reg[R_PC]);
+        }
+    } while (cpu_step());
+}
+
+// 解释执行到停机, 或者基本块结束后 PC 落在 entry 标记的地址上.
+// 返回 0 表示已停机
+int cpu_run_until(const uint8_t *entry)
+{
+    while (cpu_step()) {
+        if (reg[R_PC] == block_start && entry[reg[R_PC]]) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// 最多执行 budget 条指令. 返回 0 表示已停机, CPU_YIELD 表示客户机在等待通道
+int cpu_run_budget(uint64_t budget)
+{
+    cpu_yield = 0;
+    while (budget--) {
+        if (!cpu_step()) {
+            return 0;
+        }
+        if (cpu_yield) {
+            cpu_yield = 0;
+            return CPU_YIELD;
+        }
+    }
+    return 1;
+}
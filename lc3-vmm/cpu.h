@@ -0,0 +1,72 @@
+#ifndef _CPU_H_
+#define _CPU_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <setjmp.h>
+
+#include "lc3.h"
+
+// Processor Status Register
+// bit15 为 1 表示用户态, bit10-8 为当前优先级, bit2-0 为条件标志.
+// 中断从用户态进入时切换到监督栈 (x0200 − x2FFF, 从 x3000 向下增长).
+#define PSR_USER 0X8000
+
+// 除内存和设备以外的 CPU 状态, 用于快照
+struct cpu_state {
+    uint16_t reg[R_COUNT];
+    int priority;
+    uint16_t saved_ssp;
+    uint16_t saved_usp;
+    uint64_t icount;
+    uint16_t block_start;
+};
+
+extern __thread uint16_t reg[R_COUNT];
+extern __thread uint64_t icount;
+extern __thread uint16_t block_start;
+extern __thread int cpu_yield;
+extern void (*cpu_store_hook)(uint16_t address, uint16_t val);
+
+// 嵌入 (lc3vm.h) 时的回调, 未设置时为 NULL.
+// cpu_trap_hook 返回 0 停机, 大于 0 继续, 小于 0 交给内置的实现.
+// [cpu_io_start, cpu_io_start + cpu_io_size) 内的访存先交给 io 回调, 返回 0 表示已处理,
+// 否则按普通内存和内置设备处理. 区间为空时不调用 io 回调.
+extern int (*cpu_trap_hook)(uint16_t trap);
+extern int (*cpu_io_read_hook)(uint16_t address, uint16_t *val);
+extern int (*cpu_io_write_hook)(uint16_t address, uint16_t val);
+extern uint16_t cpu_io_start;
+extern uint32_t cpu_io_size;
+
+// 非法指令时 longjmp 到这里, 值为 CPU_FAULT_*; 为 NULL 时 abort()
+enum {
+    CPU_FAULT_RES = 1,  /* 执行了保留的操作码 */
+    CPU_FAULT_RTI,      /* 用户态执行 RTI */
+};
+extern jmp_buf *cpu_fault_jmp;
+
+uint16_t sign_extend(uint16_t x, int bit_count);
+void update_flags(uint16_t r);
+uint64_t cpu_icount();
+
+// 带设备语义的访存: 键盘寄存器, 中断标志和定时器寄存器
+uint16_t mem_read(uint16_t address);
+void mem_write(uint16_t address, uint16_t val);
+
+void disable_input_buffering();
+void restore_input_buffering();
+
+void block_end(uint16_t instr_pc);
+int cpu_trap(uint16_t trap);
+void cpu_rti();
+
+void cpu_reset(uint16_t pc);
+void cpu_save(struct cpu_state *state);
+void cpu_load(const struct cpu_state *state);
+void cpu_run();
+int cpu_run_until(const uint8_t *entry);
+// 返回 0 停机, 1 执行完 budget 条指令, CPU_YIELD 客户机在等待通道 (见 chan.h)
+#define CPU_YIELD 2
+int cpu_run_budget(uint64_t budget);
+
+#endif
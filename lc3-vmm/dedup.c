@@ -0,0 +1,313 @@
+#include <string.h>
+#include <signal.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+
+#include "mem.h"
+#include "dedup.h"
+
+static int dedup_fd = -1;
+static struct dedup_header *dedup_hdr;
+static const uint8_t *dedup_data;    /* 池中的页, 只读 */
+static uint8_t dedup_skip[MEM_PAGES];
+static volatile uint8_t dedup_shared[MEM_PAGES];
+static uint64_t dedup_last[MEM_PAGES];  /* 上次扫描时的哈希 */
+static volatile int dedup_lock;
+
+static pthread_t dedup_thread;
+static volatile int dedup_stop;
+static int dedup_running;
+
+static struct {
+    uint64_t merges;
+    uint64_t cows;
+    uint64_t scans;
+    uint32_t inserts;
+} dedup_stats;
+
+// 信号处理函数中也要用, 只能自旋
+static void dedup_acquire()
+{
+    while (__atomic_exchange_n(&dedup_lock, 1, __ATOMIC_ACQUIRE))
+        ;
+}
+
+static void dedup_release()
+{
+    __atomic_store_n(&dedup_lock, 0, __ATOMIC_RELEASE);
+}
+
+static uint8_t *dedup_page_addr(int page)
+{
+    return (uint8_t *)(mem_addr() + (page << MEM_PAGE_SHIFT));
+}
+
+static uint64_t dedup_hash(const uint8_t *p)
+{
+    const uint64_t *w = (const uint64_t *)p;
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    size_t i;
+
+    for (i = 0; i < DEDUP_PAGE_BYTES / sizeof(uint64_t); i++) {
+        hash = (hash ^ w[i]) * 0x100000001B3ULL;
+    }
+    return hash | 1;
+}
+
+// 把共享页的内容放回 memfd, 换回可写的映射. 调用者持有 dedup_lock
+static int dedup_copy(int page)
+{
+    uint8_t *p = dedup_page_addr(page);
+    off_t off = (off_t)page * DEDUP_PAGE_BYTES;
+
+    if (pwrite(mem_fd(), p, DEDUP_PAGE_BYTES, off) != DEDUP_PAGE_BYTES ||
+            mmap(p, DEDUP_PAGE_BYTES, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_FIXED, mem_fd(), off) == MAP_FAILED)
+        return -1;
+    dedup_shared[page] = 0;
+    dedup_last[page] = 0;
+    __atomic_add_fetch(&dedup_stats.cows, 1, __ATOMIC_RELAXED);
+    return 0;
+}
+
+// 写共享页: 写时复制后重新执行写操作. 多个线程同时写同一页时只复制一次
+static void dedup_fault(int sig, siginfo_t *info, void *ctx)
+{
+    uint8_t *base = (uint8_t *)mem_addr();
+    uint8_t *addr = info->si_addr;
+    int page;
+
+    if (!base || addr < base || addr >= base + MEMORY_MAX * sizeof(uint16_t)) {
+        signal(SIGSEGV, SIG_DFL);
+        return;
+    }
+    page = (addr - base) / DEDUP_PAGE_BYTES;
+
+    // 页不是共享的: 扫描线程刚把它恢复为可写, 重新执行即可
+    dedup_acquire();
+    if (dedup_shared[page] && dedup_copy(page) < 0) {
+        dedup_release();
+        signal(SIGSEGV, SIG_DFL);
+        return;
+    }
+    dedup_release();
+}
+
+// 在索引中查找内容与 p 相同的页, insert 时没有就加入池中. 返回槽号, 没有为 -1.
+// 调用者持有池文件的 flock
+static int dedup_find(const uint8_t *p, uint64_t hash, int insert)
+{
+    struct dedup_entry *e;
+    uint32_t i, n, slot;
+
+    for (i = hash & (DEDUP_INDEX - 1), n = 0; n < DEDUP_INDEX; i = (i + 1) & (DEDUP_INDEX - 1), n++) {
+        e = &dedup_hdr->index[i];
+        if (!e->hash)
+            break;
+        if (e->hash == hash &&
+                !memcmp(dedup_data + (size_t)e->slot * DEDUP_PAGE_BYTES, p, DEDUP_PAGE_BYTES))
+            return e->slot;
+    }
+    if (!insert || n == DEDUP_INDEX || dedup_hdr->used >= dedup_hdr->pages)
+        return -1;
+
+    slot = dedup_hdr->used;
+    if (pwrite(dedup_fd, p, DEDUP_PAGE_BYTES, DEDUP_HDR_BYTES + (off_t)slot * DEDUP_PAGE_BYTES)
+            != DEDUP_PAGE_BYTES)
+        return -1;
+    e->slot = slot;
+    e->hash = hash;
+    dedup_hdr->used++;
+    dedup_stats.inserts++;
+    return slot;
+}
+
+// 把一页换成池中的只读页. 先去掉写权限再比较, 比较之后客户机不会再改动它
+static void dedup_merge(int page, uint64_t hash)
+{
+    uint8_t *addr = dedup_page_addr(page);
+    off_t off = (off_t)page * DEDUP_PAGE_BYTES;
+    int slot;
+
+    dedup_acquire();
+    if (mprotect(addr, DEDUP_PAGE_BYTES, PROT_READ) < 0) {
+        dedup_release();
+        return;
+    }
+    if (dedup_hash(addr) == hash && (slot = dedup_find(addr, hash, 1)) >= 0 &&
+            mmap(addr, DEDUP_PAGE_BYTES, PROT_READ, MAP_SHARED | MAP_FIXED,
+                dedup_fd, DEDUP_HDR_BYTES + (off_t)slot * DEDUP_PAGE_BYTES) != MAP_FAILED) {
+        // 内容已在池中, memfd 中的页可以释放
+        fallocate(mem_fd(), FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, off, DEDUP_PAGE_BYTES);
+        dedup_shared[page] = 1;
+        dedup_stats.merges++;
+    } else {
+        mprotect(addr, DEDUP_PAGE_BYTES, PROT_READ | PROT_WRITE);
+    }
+    dedup_release();
+}
+
+// stable: 只合并两次扫描之间没有变化的页
+static void dedup_scan(int stable)
+{
+    uint64_t hash;
+    int page;
+
+    if (flock(dedup_fd, LOCK_EX) < 0)
+        return;
+    for (page = 0; page < MEM_PAGES; page++) {
+        if (dedup_skip[page] || dedup_shared[page])
+            continue;
+        hash = dedup_hash(dedup_page_addr(page));
+        if (!stable || hash == dedup_last[page])
+            dedup_merge(page, hash);
+        dedup_last[page] = hash;
+    }
+    flock(dedup_fd, LOCK_UN);
+    dedup_stats.scans++;
+}
+
+static void *dedup_worker(void *arg)
+{
+    struct timespec ts = { 0, DEDUP_SCAN_MS * 1000000L };
+
+    while (!dedup_stop) {
+        nanosleep(&ts, NULL);
+        if (!dedup_stop)
+            dedup_scan(1);
+    }
+    return NULL;
+}
+
+void dedup_exclude(uint16_t address, uint32_t words)
+{
+    uint32_t page;
+
+    for (page = address >> MEM_PAGE_SHIFT;
+         page <= (address + words - 1) >> MEM_PAGE_SHIFT && page < MEM_PAGES; page++) {
+        dedup_skip[page] = 1;
+    }
+}
+
+int dedup_unshare(uint16_t address, uint32_t words)
+{
+    uint32_t page;
+    int ret = 0;
+
+    if (dedup_fd < 0 || !words)
+        return 0;
+    dedup_acquire();
+    for (page = address >> MEM_PAGE_SHIFT;
+         page <= (address + words - 1) >> MEM_PAGE_SHIFT && page < MEM_PAGES; page++) {
+        if (dedup_shared[page] && dedup_copy(page) < 0) {
+            ret = -1;
+            break;
+        }
+    }
+    dedup_release();
+    return ret;
+}
+
+// 多个进程同时创建时只由一个初始化
+static int dedup_open(const char *path)
+{
+    off_t size = DEDUP_HDR_BYTES + (off_t)DEDUP_POOL_PAGES * DEDUP_PAGE_BYTES;
+    struct stat st;
+    void *p;
+    int ret = -1;
+
+    dedup_fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (dedup_fd < 0)
+        return -1;
+    if (flock(dedup_fd, LOCK_EX) < 0 || fstat(dedup_fd, &st) < 0)
+        goto out;
+    if (st.st_size < size && ftruncate(dedup_fd, size) < 0)
+        goto out;
+
+    p = mmap(NULL, DEDUP_HDR_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, dedup_fd, 0);
+    if (p == MAP_FAILED)
+        goto out;
+    dedup_hdr = p;
+    p = mmap(NULL, (size_t)DEDUP_POOL_PAGES * DEDUP_PAGE_BYTES, PROT_READ, MAP_SHARED,
+            dedup_fd, DEDUP_HDR_BYTES);
+    if (p == MAP_FAILED)
+        goto out;
+    dedup_data = p;
+
+    // 新建的文件全是零, 不用清空索引 (清空会分配整个头)
+    if (dedup_hdr->magic != DEDUP_MAGIC) {
+        if (st.st_size)
+            memset(dedup_hdr, 0, sizeof(*dedup_hdr));
+        dedup_hdr->pages = DEDUP_POOL_PAGES;
+        dedup_hdr->magic = DEDUP_MAGIC;
+    }
+    ret = 0;
+
+out:
+    flock(dedup_fd, LOCK_UN);
+    return ret;
+}
+
+int dedup_init(const char *path)
+{
+    struct sigaction sa;
+    int page;
+
+    if (!mem_addr() || mem_fd() < 0 || dedup_fd >= 0)
+        return -1;
+    if (dedup_open(path) < 0)
+        goto fail;
+
+    // 设备页由主机频繁直接写入, 不值得共享
+    for (page = 0; page < MEM_PAGES; page++) {
+        if (mem_device_page(page))
+            dedup_skip[page] = 1;
+    }
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_sigaction = dedup_fault;
+    sa.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(SIGSEGV, &sa, NULL) < 0)
+        goto fail;
+
+    dedup_scan(0);
+
+    dedup_stop = 0;
+    if (pthread_create(&dedup_thread, NULL, dedup_worker, NULL) == 0)
+        dedup_running = 1;
+    return 0;
+
+fail:
+    if (dedup_fd >= 0)
+        close(dedup_fd);
+    dedup_fd = -1;
+    return -1;
+}
+
+void dedup_destroy()
+{
+    if (dedup_running) {
+        dedup_stop = 1;
+        pthread_join(dedup_thread, NULL);
+        dedup_running = 0;
+    }
+}
+
+void dedup_report()
+{
+    int page, shared = 0;
+
+    if (!getenv("LC3_DEDUP_STATS") || dedup_fd < 0)
+        return;
+    for (page = 0; page < MEM_PAGES; page++) {
+        shared += dedup_shared[page];
+    }
+    fprintf(stderr, ">>> dedup: %d of %d pages shared, %llu merged, %llu copied on write, "
+            "%u added to pool (%u of %u used), %llu scans\n",
+            shared, MEM_PAGES, (unsigned long long)dedup_stats.merges,
+            (unsigned long long)dedup_stats.cows, dedup_stats.inserts,
+            dedup_hdr->used, dedup_hdr->pages, (unsigned long long)dedup_stats.scans);
+}
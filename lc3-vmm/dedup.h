@@ -0,0 +1,62 @@
+#ifndef _DEDUP_H_
+#define _DEDUP_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "mem.h"
+
+// 跨虚拟机的页去重: 同一主机上运行同一镜像的多个 lc3-vmm 共用一个页池文件
+// (例如 /dev/shm 下的文件). 内容相同的客户机页 (4KB, 正好一个主机页) 只在池中存一份,
+// 以只读的 MAP_SHARED | MAP_FIXED 映射到各自的客户机内存中, 原来 memfd 中的页打洞释放.
+//
+// 装入镜像后立即扫描全部页; 之后后台线程每 DEDUP_SCAN_MS 扫描一次, 两次扫描之间
+// 内容没有变化的页才合并, 正在被写的页不会反复合并和复制.
+// 第一次写共享页时触发 SIGSEGV, 处理函数把页的内容写回 memfd 并换回可写的映射
+// (写时复制), 然后重新执行写操作. 解释器, AOT 代码和主机端的 memcpy (virtio 等) 都一样处理,
+// 访存路径上没有额外的判断. 但内核写只读页时返回 EFAULT 而不是产生 SIGSEGV,
+// 主机端用 read/pread/readv 等系统调用直接写客户机内存前要先调用 dedup_unshare.
+//
+// 池文件布局: DEDUP_HDR_BYTES 的头 (魔数, 已用页数, 以哈希为键的开放寻址索引),
+// 之后是 DEDUP_POOL_PAGES 个页. 池中的页写入后不再改变, 也不回收; 删除文件即可清空.
+// 多个进程修改索引时用 flock 互斥.
+//
+// 每个客户机占用的内存约为它写过的页数, 加上共用的池. vhost 后端直接映射 memfd,
+// 看不到池中的页, 不能同时使用.
+#define DEDUP_MAGIC      0X4C334450
+#define DEDUP_POOL_PAGES 8192
+#define DEDUP_INDEX      16384  /* 索引项数, 2 的幂 */
+#define DEDUP_SCAN_MS    100
+#define DEDUP_PAGE_BYTES (MEM_PAGE_WORDS * sizeof(uint16_t))
+
+struct dedup_entry {
+    uint64_t hash;  /* 0 表示空 */
+    uint32_t slot;
+    uint32_t reserved;
+};
+
+struct dedup_header {
+    uint32_t magic;
+    uint32_t pages;
+    uint32_t used;
+    uint32_t reserved;
+    struct dedup_entry index[DEDUP_INDEX];
+};
+
+#define DEDUP_HDR_BYTES \
+    ((sizeof(struct dedup_header) + DEDUP_PAGE_BYTES - 1) / DEDUP_PAGE_BYTES * DEDUP_PAGE_BYTES)
+
+// [address, address + words) 不参与去重, 例如映射了别的文件的窗口. 在 dedup_init 之前调用
+void dedup_exclude(uint16_t address, uint32_t words);
+// 把 [address, address + words) 中的共享页换回可写的映射. 未启用去重时什么也不做.
+// 返回 -1 表示失败
+int dedup_unshare(uint16_t address, uint32_t words);
+// 打开 (不存在时创建) 页池, 合并当前内存中的页并启动扫描线程. 返回 -1 表示失败
+int dedup_init(const char *path);
+// 停止扫描线程. 已共享的页保持映射, 随客户机内存一起释放
+void dedup_destroy();
+// LC3_DEDUP_STATS 时在 stderr 打印共享页数和写时复制次数
+void dedup_report();
+
+#endif
@@ -0,0 +1,645 @@
+#include <string.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "lc3.h"
+#include "cpu.h"
+#include "mem.h"
+#include "batch.h"
+#include "opcodes.h"
+#include "difftest.h"
+
+#define DT_WINDOW_END (DIFFTEST_DATA + DIFFTEST_DATA_WORDS)
+#define DT_MEM_BYTES  (MEMORY_MAX * sizeof(uint16_t))
+#define DT_WRITES     256  /* 一个块内记录的写入地址, 超出时比较整个内存 */
+
+struct dt_lane {
+    uint16_t reg[8];  /* R0 − R7, PC 从 DIFFTEST_CODE 开始 */
+    uint16_t data[DIFFTEST_DATA_WORDS];
+};
+
+struct dt_case {
+    int ncode;
+    int nlanes;
+    uint16_t code[DIFFTEST_CODE_MAX];
+    struct dt_lane lanes[BATCH_LANES];
+};
+
+// 第一处不一致
+struct dt_diff {
+    int lane;
+    uint64_t block;  /* 第几个块 (按组计) */
+    uint16_t pc;     /* 通道在这个块开始时的 PC */
+    char what[128];
+};
+
+// 一次执行的状态, 参考解释器的寄存器在两个块之间保存在 ref 中
+struct dt_run {
+    struct batch *b;
+    struct cpu_state ref[BATCH_LANES];
+    uint64_t done[BATCH_LANES];  /* 参考解释器执行的指令数 */
+    uint32_t live;               /* 仍在比较的通道 */
+    uint64_t block;
+};
+
+static const char *dt_reg_names[R_COUNT] = {
+    "R0", "R1", "R2", "R3", "R4", "R5", "R6", "R7", "PC", "COND"
+};
+
+// 每个通道两份内存: 参考解释器和批量解释器
+static uint16_t *dt_ref[BATCH_LANES];
+static uint16_t *dt_alt[BATCH_LANES];
+
+static struct {
+    uint64_t cases;
+    uint64_t blocks;
+    uint64_t insns;
+    uint64_t stopped;
+    uint64_t diverged;
+} dt_stats;
+
+static int dt_counting;  /* 化简时的重复执行不计入统计 */
+
+static uint16_t dt_writes[DT_WRITES];
+static int dt_nwrites;
+
+static uint32_t dt_seed;
+
+static void dt_store(uint16_t address, uint16_t val)
+{
+    if (dt_nwrites < DT_WRITES)
+        dt_writes[dt_nwrites] = address;
+    dt_nwrites++;
+}
+
+// xorshift32
+static uint32_t dt_rand()
+{
+    dt_seed ^= dt_seed << 13;
+    dt_seed ^= dt_seed >> 17;
+    dt_seed ^= dt_seed << 5;
+    return dt_seed;
+}
+
+static uint16_t dt_pick(uint32_t n)
+{
+    return dt_rand() % n;
+}
+
+// 每个用例单独的种子, 语料文件以它命名
+static uint32_t dt_case_seed(unsigned seed, unsigned i)
+{
+    uint32_t s = (seed + i) * 2654435761u ^ 0X9E3779B9;
+
+    return s ? s : 1;
+}
+
+// pc 处的指令到 target 的偏移, 超出范围时截断
+static uint16_t dt_offset(uint16_t pc, uint16_t target, int bits)
+{
+    int off = (int)target - (int)pc - 1;
+    int max = 1 << (bits - 1);
+
+    if (off >= max)
+        off = max - 1;
+    if (off < -max)
+        off = -max;
+    return off & ((1 << bits) - 1);
+}
+
+// 访存集中在代码和数据区, 跳转集中在代码区, 自修改代码也能经常出现
+static uint16_t dt_instr(uint16_t pc, int ncode)
+{
+    uint16_t dr = dt_pick(8) << 9;
+    uint16_t sr = dt_pick(8) << 6;
+    uint16_t code = DIFFTEST_CODE + dt_pick(ncode);
+    uint16_t addr = DIFFTEST_CODE + dt_pick(DT_WINDOW_END - DIFFTEST_CODE);
+    uint16_t src2 = dt_rand() & 1 ? 0x20 | dt_pick(32) : dt_pick(8);
+    uint32_t k = dt_pick(100);
+
+    if (k < 16)
+        return (OP_ADD << 12) | dr | sr | src2;
+    if (k < 26)
+        return (OP_AND << 12) | dr | sr | src2;
+    if (k < 30)
+        return (OP_NOT << 12) | dr | sr | 0x3F;
+    if (k < 34)
+        return (OP_LEA << 12) | dr | dt_offset(pc, addr, 9);
+    if (k < 42)
+        return (OP_LD << 12) | dr | dt_offset(pc, addr, 9);
+    if (k < 46)
+        return (OP_LDI << 12) | dr | dt_offset(pc, addr, 9);
+    if (k < 54)
+        return (OP_LDR << 12) | dr | sr | dt_pick(64);
+    if (k < 60)
+        return (OP_ST << 12) | dr | dt_offset(pc, addr, 9);
+    if (k < 63)
+        return (OP_STI << 12) | dr | dt_offset(pc, addr, 9);
+    if (k < 70)
+        return (OP_STR << 12) | dr | sr | dt_pick(64);
+    if (k < 84)
+        return (OP_BR << 12) | dr | dt_offset(pc, code, 9);
+    if (k < 88)
+        return (OP_JSR << 12) | 0x800 | dt_offset(pc, code, 11);
+    if (k < 91)
+        return (OP_JSR << 12) | sr;
+    if (k < 96)
+        return (OP_JMP << 12) | (dt_rand() & 1 ? 7 << 6 : sr);
+    return (OP_TRAP << 12) | TRAP_HALT;
+}
+
+// 寄存器和数据: 多数是数据区或代码区的地址, 其余是小整数和任意值
+static uint16_t dt_word()
+{
+    switch (dt_pick(8)) {
+        case 0:
+        case 1:
+        case 2:
+            return DIFFTEST_DATA + dt_pick(DIFFTEST_DATA_WORDS);
+        case 3:
+            return DIFFTEST_CODE + dt_pick(DIFFTEST_CODE_MAX);
+        case 4:
+        case 5:
+            return dt_pick(32) - 16;
+        default:
+            return dt_rand();
+    }
+}
+
+static void dt_generate(struct dt_case *c)
+{
+    int i, l;
+
+    memset(c, 0, sizeof(*c));
+    c->ncode = 16 + dt_pick(DIFFTEST_CODE_MAX - 16);
+    for (i = 0; i < c->ncode - 1; i++)
+        c->code[i] = dt_instr(DIFFTEST_CODE + i, c->ncode);
+    c->code[c->ncode - 1] = (OP_TRAP << 12) | TRAP_HALT;
+
+    c->nlanes = BATCH_LANES;
+    for (l = 0; l < c->nlanes; l++) {
+        for (i = 0; i < 8; i++)
+            c->lanes[l].reg[i] = dt_word();
+        for (i = 0; i < DIFFTEST_DATA_WORDS; i++)
+            c->lanes[l].data[i] = dt_word();
+    }
+}
+
+// 批量解释器不支持的地址: 中断向量, 设备寄存器和键盘寄存器
+static int dt_special(uint16_t addr)
+{
+    return (addr >= INTERRUPT_START && addr <= INTERRUPT_END) ||
+        (addr >= DEVICE_START && addr < DEVICE_VIRTIO + 0x100) ||
+        addr == MR_KBSR || addr == MR_KBDR;
+}
+
+// 参考解释器的下一条指令在两个解释器中是否有相同的语义
+static int dt_supported()
+{
+    uint16_t instr = mem_get(reg[R_PC]);
+    uint16_t addr = reg[R_PC] + 1 + sign_extend(instr & 0x1FF, 9);
+    uint16_t base = reg[(instr >> 6) & 0x7] + sign_extend(instr & 0x3F, 6);
+
+    switch (instr >> 12) {
+        case OP_RTI:
+        case OP_RES:
+            return 0;
+        case OP_TRAP:
+            return (instr & 0xFF) == TRAP_HALT;
+        case OP_LD:
+        case OP_ST:
+            return !dt_special(addr);
+        case OP_LDI:
+        case OP_STI:
+            return !dt_special(addr) && !dt_special(mem_get(addr));
+        case OP_LDR:
+        case OP_STR:
+            return !dt_special(base);
+        default:
+            return 1;
+    }
+}
+
+static int dt_alloc()
+{
+    int i;
+
+    for (i = 0; i < BATCH_LANES; i++) {
+        dt_ref[i] = mmap(NULL, DT_MEM_BYTES, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        dt_alt[i] = mmap(NULL, DT_MEM_BYTES, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (dt_ref[i] == MAP_FAILED || dt_alt[i] == MAP_FAILED)
+            return -1;
+    }
+    return 0;
+}
+
+static void dt_free()
+{
+    int i;
+
+    for (i = 0; i < BATCH_LANES; i++) {
+        if (dt_ref[i] && dt_ref[i] != MAP_FAILED)
+            munmap(dt_ref[i], DT_MEM_BYTES);
+        if (dt_alt[i] && dt_alt[i] != MAP_FAILED)
+            munmap(dt_alt[i], DT_MEM_BYTES);
+        dt_ref[i] = dt_alt[i] = NULL;
+    }
+}
+
+// 丢弃上一个用例的页, 只有写过的页需要重新清零
+static void dt_load(const struct dt_case *c, int lane, uint16_t *mem)
+{
+    madvise(mem, DT_MEM_BYTES, MADV_DONTNEED);
+    memcpy(mem + DIFFTEST_CODE, c->code, c->ncode * sizeof(uint16_t));
+    memcpy(mem + DIFFTEST_DATA, c->lanes[lane].data, sizeof(c->lanes[lane].data));
+}
+
+static int dt_cmp_word(int lane, uint16_t addr, struct dt_diff *d)
+{
+    if (dt_ref[lane][addr] == dt_alt[lane][addr])
+        return 0;
+    snprintf(d->what, sizeof(d->what), "memory x%04X: reference x%04X, batch x%04X",
+            addr, dt_ref[lane][addr], dt_alt[lane][addr]);
+    return 1;
+}
+
+static int dt_cmp_mem(int lane, uint32_t from, uint32_t to, struct dt_diff *d)
+{
+    uint32_t a;
+
+    if (!memcmp(dt_ref[lane] + from, dt_alt[lane] + from, (to - from) * sizeof(uint16_t)))
+        return 0;
+    for (a = from; a < to; a++) {
+        if (dt_cmp_word(lane, a, d))
+            return 1;
+    }
+    return 0;
+}
+
+// 参考解释器把通道执行到与批量解释器相同的指令数, 然后比较. 返回 1 表示不一致
+static int dt_lane(struct dt_run *t, int lane, struct dt_diff *d)
+{
+    uint16_t alt[R_COUNT];
+    uint64_t alt_icount;
+    uint32_t bit = 1u << lane;
+    int halted = 0, alt_halted, i;
+
+    batch_lane(t->b, lane, alt, &alt_icount);
+    alt_halted = !(batch_active(t->b) & bit);
+
+    mem_switch(dt_ref[lane], -1);
+    cpu_load(&t->ref[lane]);
+    d->pc = reg[R_PC];
+    dt_nwrites = 0;
+
+    while (t->done[lane] < alt_icount) {
+        if (!dt_supported()) {
+            cpu_save(&t->ref[lane]);
+            batch_stop(t->b, lane);
+            t->live &= ~bit;
+            if (dt_counting)
+                dt_stats.stopped++;
+            return 0;
+        }
+        t->done[lane]++;
+        if (!cpu_run_budget(1)) {
+            halted = 1;
+            break;
+        }
+    }
+    cpu_save(&t->ref[lane]);
+
+    if (t->done[lane] != alt_icount) {
+        snprintf(d->what, sizeof(d->what), "reference halted after %llu instructions, batch ran %llu",
+                (unsigned long long)t->done[lane], (unsigned long long)alt_icount);
+        return 1;
+    }
+    if (halted != alt_halted) {
+        snprintf(d->what, sizeof(d->what), halted ? "reference halted, batch still running" :
+                "batch stopped the lane, reference still running");
+        return 1;
+    }
+    for (i = 0; i < R_COUNT; i++) {
+        if (reg[i] != alt[i]) {
+            snprintf(d->what, sizeof(d->what), "%s: reference x%04X, batch x%04X",
+                    dt_reg_names[i], reg[i], alt[i]);
+            return 1;
+        }
+    }
+
+    // 停机时比较整个内存, 否则只比较代码和数据区以及参考解释器写过的地址
+    if (halted || dt_nwrites > DT_WRITES) {
+        if (dt_cmp_mem(lane, 0, MEMORY_MAX, d))
+            return 1;
+    } else {
+        if (dt_cmp_mem(lane, DIFFTEST_CODE, DT_WINDOW_END, d))
+            return 1;
+        for (i = 0; i < dt_nwrites; i++) {
+            if (dt_cmp_word(lane, dt_writes[i], d))
+                return 1;
+        }
+    }
+    if (halted)
+        t->live &= ~bit;
+    return 0;
+}
+
+// 返回 1 表示不一致, 第一处不一致写入 d; -1 表示出错
+static int dt_exec(const struct dt_case *c, struct dt_diff *d)
+{
+    static struct dt_run t;
+    uint16_t init[BATCH_LANES][R_COUNT];
+    const uint16_t *regs[BATCH_LANES];
+    uint32_t mask;
+    int lane, ret = 0;
+
+    memset(&t, 0, sizeof(t));
+    for (lane = 0; lane < c->nlanes; lane++) {
+        dt_load(c, lane, dt_ref[lane]);
+        dt_load(c, lane, dt_alt[lane]);
+        memcpy(init[lane], c->lanes[lane].reg, sizeof(c->lanes[lane].reg));
+        init[lane][R_PC] = DIFFTEST_CODE;
+        init[lane][R_COND] = FL_ZRO;
+        regs[lane] = init[lane];
+
+        memcpy(t.ref[lane].reg, init[lane], sizeof(init[lane]));
+        t.ref[lane].saved_ssp = 0x3000;
+        t.ref[lane].block_start = DIFFTEST_CODE;
+    }
+    t.live = (1u << c->nlanes) - 1;
+
+    t.b = batch_new(dt_alt, regs, c->nlanes);
+    if (!t.b)
+        return -1;
+
+    for (t.block = 0; t.block < DIFFTEST_BLOCKS && t.live; t.block++) {
+        mask = batch_next(t.b) & t.live;
+        if (!mask)
+            break;
+        for (lane = 0; lane < c->nlanes; lane++) {
+            if ((mask >> lane) & 1 && dt_lane(&t, lane, d)) {
+                ret = 1;
+                goto out;
+            }
+        }
+    }
+
+    // 块数用完时还在运行的通道
+    for (lane = 0; lane < c->nlanes; lane++) {
+        if ((t.live >> lane) & 1 && dt_cmp_mem(lane, 0, MEMORY_MAX, d)) {
+            d->pc = t.ref[lane].reg[R_PC];
+            ret = 1;
+            goto out;
+        }
+    }
+
+out:
+    if (ret) {
+        d->lane = lane;
+        d->block = t.block;
+    }
+    if (dt_counting) {
+        dt_stats.blocks += t.block;
+        for (lane = 0; lane < c->nlanes; lane++)
+            dt_stats.insns += t.done[lane];
+    }
+    batch_free(t.b);
+    return ret;
+}
+
+static int dt_fails(const struct dt_case *c)
+{
+    struct dt_diff d;
+
+    return dt_exec(c, &d) > 0;
+}
+
+// 逐项简化, 仍然不一致才保留
+static void dt_minimize(struct dt_case *c)
+{
+    static struct dt_case t;
+    int i, l;
+
+    for (l = c->nlanes - 1; l >= 0 && c->nlanes > 1; l--) {
+        t = *c;
+        memmove(&t.lanes[l], &t.lanes[l + 1], (t.nlanes - l - 1) * sizeof(t.lanes[0]));
+        t.nlanes--;
+        if (dt_fails(&t))
+            *c = t;
+    }
+
+    // 去掉末尾的指令 (内存为 0, 相当于 NOP), 其余的换成 NOP
+    while (c->ncode > 1) {
+        t = *c;
+        t.code[--t.ncode] = 0;
+        if (!dt_fails(&t))
+            break;
+        *c = t;
+    }
+    for (i = 0; i < c->ncode; i++) {
+        if (!c->code[i])
+            continue;
+        t = *c;
+        t.code[i] = 0;
+        if (dt_fails(&t))
+            *c = t;
+    }
+
+    for (l = 0; l < c->nlanes; l++) {
+        for (i = 0; i < 8; i++) {
+            if (!c->lanes[l].reg[i])
+                continue;
+            t = *c;
+            t.lanes[l].reg[i] = 0;
+            if (dt_fails(&t))
+                *c = t;
+        }
+        for (i = 0; i < DIFFTEST_DATA_WORDS; i++) {
+            if (!c->lanes[l].data[i])
+                continue;
+            t = *c;
+            t.lanes[l].data[i] = 0;
+            if (dt_fails(&t))
+                *c = t;
+        }
+    }
+}
+
+static int dt_save(const char *dir, const char *name, const struct dt_case *c,
+        const struct dt_diff *d)
+{
+    char path[4096], text[64];
+    FILE *f;
+    int i, l;
+
+    if (mkdir(dir, 0755) < 0 && errno != EEXIST)
+        return -1;
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    f = fopen(path, "w");
+    if (!f)
+        return -1;
+
+    fprintf(f, "# lc3-vmm --difftest %s\n", path);
+    fprintf(f, "# lane %d, block %llu at x%04X: %s\n", d->lane, (unsigned long long)d->block,
+            d->pc, d->what);
+    for (i = 0; i < c->ncode; i++) {
+        lc3_disasm(DIFFTEST_CODE + i, c->code[i], text, sizeof(text));
+        fprintf(f, "code %04x  # x%04X %s\n", c->code[i], DIFFTEST_CODE + i, text);
+    }
+    for (l = 0; l < c->nlanes; l++) {
+        fprintf(f, "lane");
+        for (i = 0; i < 8; i++)
+            fprintf(f, " %04x", c->lanes[l].reg[i]);
+        fprintf(f, "\n");
+        for (i = 0; i < DIFFTEST_DATA_WORDS; i++) {
+            if (c->lanes[l].data[i])
+                fprintf(f, "data %02x %04x\n", i, c->lanes[l].data[i]);
+        }
+    }
+    fclose(f);
+    printf("difftest: minimized case written to %s\n", path);
+    return 0;
+}
+
+// 读入 n 个十六进制数, 返回读到的个数
+static int dt_parse_words(char *p, unsigned long *v, int n)
+{
+    char *end;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        v[i] = strtoul(p, &end, 16);
+        if (end == p || v[i] > 0xFFFF)
+            break;
+        p = end;
+    }
+    return i;
+}
+
+static int dt_parse(const char *path, struct dt_case *c)
+{
+    FILE *f = fopen(path, "r");
+    char line[1024], *p;
+    unsigned long v[DIFFTEST_CODE_MAX];
+    int lineno = 0, n, i;
+
+    if (!f) {
+        printf("difftest: failed to open %s\n", path);
+        return -1;
+    }
+    memset(c, 0, sizeof(*c));
+
+    while (fgets(line, sizeof(line), f)) {
+        lineno++;
+        for (p = line; *p == ' ' || *p == '\t'; p++)
+            ;
+        if (*p == '#' || *p == '\n' || *p == '\0')
+            continue;
+
+        if (!strncmp(p, "code ", 5)) {
+            n = dt_parse_words(p + 5, v, DIFFTEST_CODE_MAX);
+            if (c->ncode + n > DIFFTEST_CODE_MAX)
+                goto bad;
+            for (i = 0; i < n; i++)
+                c->code[c->ncode++] = v[i];
+        } else if (!strncmp(p, "lane ", 5)) {
+            if (c->nlanes >= BATCH_LANES || dt_parse_words(p + 5, v, 8) != 8)
+                goto bad;
+            for (i = 0; i < 8; i++)
+                c->lanes[c->nlanes].reg[i] = v[i];
+            c->nlanes++;
+        } else if (!strncmp(p, "data ", 5)) {
+            if (!c->nlanes || dt_parse_words(p + 5, v, 2) != 2 || v[0] >= DIFFTEST_DATA_WORDS)
+                goto bad;
+            c->lanes[c->nlanes - 1].data[v[0]] = v[1];
+        } else {
+            goto bad;
+        }
+    }
+    fclose(f);
+    if (!c->ncode || !c->nlanes) {
+        printf("difftest: %s: no code or no lanes\n", path);
+        return -1;
+    }
+    return 0;
+
+bad:
+    printf("difftest: %s:%d: bad line\n", path, lineno);
+    fclose(f);
+    return -1;
+}
+
+int difftest_run(const char *cases[], int ncases, unsigned count, unsigned seed,
+        const char *corpus)
+{
+    static struct dt_case c;
+    void (*store_hook)(uint16_t, uint16_t) = cpu_store_hook;
+    struct dt_diff d;
+    char name[64];
+    unsigned i, n = ncases ? (unsigned)ncases : count;
+    uint32_t s = 0;
+    int ret = 0;
+
+    if (dt_alloc() < 0) {
+        printf("difftest: out of memory\n");
+        dt_free();
+        return -1;
+    }
+    cpu_store_hook = dt_store;
+
+    for (i = 0; i < n; i++) {
+        if (ncases) {
+            if (dt_parse(cases[i], &c) < 0) {
+                ret = -1;
+                break;
+            }
+        } else {
+            s = dt_seed = dt_case_seed(seed, i);
+            dt_generate(&c);
+        }
+
+        dt_counting = 1;
+        ret = dt_exec(&c, &d);
+        dt_counting = 0;
+        dt_stats.cases++;
+        if (ret <= 0) {
+            if (ret < 0) {
+                printf("difftest: failed to set up lanes\n");
+                break;
+            }
+            continue;
+        }
+
+        dt_stats.diverged++;
+        if (ncases)
+            printf("difftest: %s: ", cases[i]);
+        else
+            printf("difftest: case %u (x%08x): ", i, s);
+        printf("lane %d, block %llu at x%04X: %s\n", d.lane, (unsigned long long)d.block,
+                d.pc, d.what);
+
+        // 重放的语料已经化简过
+        if (!ncases) {
+            dt_minimize(&c);
+            dt_exec(&c, &d);
+            printf("difftest: minimized to %d instructions, %d lanes: lane %d, block %llu at x%04X: %s\n",
+                    c.ncode, c.nlanes, d.lane, (unsigned long long)d.block, d.pc, d.what);
+            snprintf(name, sizeof(name), "case-%08x.txt", s);
+            if (corpus && dt_save(corpus, name, &c, &d) < 0)
+                printf("difftest: failed to write %s/%s\n", corpus, name);
+        }
+        ret = 0;
+    }
+
+    cpu_store_hook = store_hook;
+    dt_free();
+    fprintf(stderr, ">>> difftest: %llu cases, %llu blocks, %llu instructions compared, "
+            "%llu lanes stopped early, %llu diverged\n",
+            (unsigned long long)dt_stats.cases, (unsigned long long)dt_stats.blocks,
+            (unsigned long long)dt_stats.insns, (unsigned long long)dt_stats.stopped,
+            (unsigned long long)dt_stats.diverged);
+    return ret < 0 ? -1 : (int)dt_stats.diverged;
+}
@@ -0,0 +1,34 @@
+#ifndef _DIFFTEST_H_
+#define _DIFFTEST_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// 差分测试: 随机生成 LC-3 程序和初始状态, 同时在参考解释器 (cpu.c) 和批量解释器 (batch.c)
+// 上执行. 批量解释器每执行完一个基本块, 参考解释器把这组通道各执行同样多的指令,
+// 然后比较 R0 − R7, PC, R_COND, 是否停机和内存, 报告第一处不一致.
+//
+// 一个用例是 DIFFTEST_CODE 起的一段代码和至多 BATCH_LANES 个通道, 每个通道有自己的初始寄存器
+// 和 DIFFTEST_DATA 起的数据, 其余内存为 0. 同一段代码在各通道上走不同的路径, 覆盖分组和重新汇合.
+// 通道将要访问中断向量或设备, 执行 RTI/RES 或 HALT 以外的 TRAP 时停止比较, 不算不一致.
+//
+// 不一致的用例经过化简 (只留一个通道, 指令换成 NOP, 数据和寄存器清零) 后写入语料目录,
+// 文本格式, # 开头为注释, 数字为十六进制:
+//   code <指令> ...        按顺序追加到代码
+//   lane <R0> ... <R7>     新增一个通道
+//   data <偏移> <值>       当前通道的数据
+#define DIFFTEST_CODE       0X3000
+#define DIFFTEST_CODE_MAX   128
+#define DIFFTEST_DATA       0X3080
+#define DIFFTEST_DATA_WORDS 256
+#define DIFFTEST_BLOCKS     4096  /* 每个用例最多执行的块数 (按组计) */
+#define DIFFTEST_CASES      1000
+#define DIFFTEST_CORPUS     "difftest-corpus"
+
+// ncases 为 0 时从 seed 开始随机生成 count 个用例, 否则重放给出的语料文件.
+// corpus 不为 NULL 时化简后的用例写入该目录. 返回不一致的用例数, -1 表示出错
+int difftest_run(const char *cases[], int ncases, unsigned count, unsigned seed,
+        const char *corpus);
+
+#endif
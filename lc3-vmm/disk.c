@@ -0,0 +1,532 @@
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+#include "disk.h"
+
+enum {
+    PAGE_EMPTY,
+    PAGE_LOADING,  /* 正在读文件, 其他线程等待 cond */
+    PAGE_VALID,
+};
+
+// 预读队列长度, 队列满时新的预读请求被丢弃
+#define DISK_QUEUE 64
+// 一次 pwritev 合并的最大页数
+#define DISK_IOV_MAX 64
+
+struct disk_page {
+    uint32_t page;
+    int state;
+    int ra;              /* 由预读加载, 还没有被访问过 */
+    uint16_t dirty_lo;   /* 脏区间 [dirty_lo, dirty_hi), 相等表示干净 */
+    uint16_t dirty_hi;
+    uint64_t used;       /* LRU 时间戳 */
+    uint16_t *data;
+};
+
+static struct {
+    int fd;
+    struct disk_page *pages;
+    int npages;
+    uint64_t tick;
+    uint32_t size;       /* 文件页数, 预读不超过文件末尾 */
+
+    pthread_mutex_t lock;
+    pthread_cond_t cond;  /* 页加载完成 */
+    pthread_cond_t work;  /* 预读队列非空, 或要求退出 */
+    pthread_t workers[DISK_WORKERS];
+    int nworkers;
+    int stop;
+
+    uint32_t queue[DISK_QUEUE];
+    unsigned qhead, qtail;
+
+    // 顺序读检测
+    uint32_t next_pos;   /* 上一次读请求的结束位置 */
+    int seq;
+    uint32_t ra_next;    /* 下一个要预读的页 */
+    int ra_window;
+
+    int writeback_ms;
+    int ndirty;
+    int werrno;          /* 最近一次回写失败的原因 */
+    struct timespec last_flush;
+
+    struct disk_stats stats;
+} disk = { .fd = -1 };
+
+static int disk_pread(uint32_t page, uint16_t *data)
+{
+    off_t off = (off_t)page * DISK_PAGE_BYTES;
+    size_t done = 0;
+    ssize_t n;
+
+    while (done < DISK_PAGE_BYTES) {
+        n = pread(disk.fd, (char *)data + done, DISK_PAGE_BYTES - done, off + done);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0)
+            return -1;
+        if (n == 0)
+            break;
+        done += n;
+    }
+    memset((char *)data + done, 0, DISK_PAGE_BYTES - done);
+    return 0;
+}
+
+static struct disk_page *disk_lookup(uint32_t page)
+{
+    int i;
+
+    for (i = 0; i < disk.npages; i++) {
+        if (disk.pages[i].state != PAGE_EMPTY && disk.pages[i].page == page)
+            return &disk.pages[i];
+    }
+    return NULL;
+}
+
+static int disk_page_cmp(const void *a, const void *b)
+{
+    const struct disk_page *pa = *(struct disk_page * const *)a;
+    const struct disk_page *pb = *(struct disk_page * const *)b;
+
+    return pa->page < pb->page ? -1 : pa->page > pb->page;
+}
+
+// 把 pages[0..n) 中的脏区间写回, 页号连续且脏区间首尾相接的合并成一次 pwritev.
+// 只有完整写入的页才清除脏区间, 失败的页留到下次回写时重试, 返回 -1. 持有锁调用
+static int disk_writeback(struct disk_page **pages, int n)
+{
+    struct iovec iov[DISK_IOV_MAX], *v;
+    struct disk_page *p;
+    off_t off;
+    ssize_t w;
+    int i, j, k, cnt, ret = 0;
+
+    qsort(pages, n, sizeof(pages[0]), disk_page_cmp);
+
+    for (i = 0; i < n; i = j) {
+        p = pages[i];
+        off = (off_t)p->page * DISK_PAGE_BYTES + p->dirty_lo * sizeof(uint16_t);
+        iov[0].iov_base = p->data + p->dirty_lo;
+        iov[0].iov_len = (p->dirty_hi - p->dirty_lo) * sizeof(uint16_t);
+
+        for (j = i + 1; j < n && j - i < DISK_IOV_MAX; j++) {
+            if (pages[j]->page != pages[j - 1]->page + 1 ||
+                pages[j - 1]->dirty_hi != DISK_PAGE_WORDS || pages[j]->dirty_lo != 0)
+                break;
+            iov[j - i].iov_base = pages[j]->data;
+            iov[j - i].iov_len = pages[j]->dirty_hi * sizeof(uint16_t);
+        }
+
+        // 部分写入时从写到的位置继续
+        v = iov;
+        cnt = j - i;
+        while (cnt > 0) {
+            w = pwritev(disk.fd, v, cnt, off);
+            if (w < 0 && errno == EINTR)
+                continue;
+            if (w <= 0) {
+                disk.werrno = w < 0 ? errno : EIO;
+                break;
+            }
+            off += w;
+            while (cnt > 0 && (size_t)w >= v->iov_len) {
+                w -= v->iov_len;
+                v++;
+                cnt--;
+            }
+            if (cnt > 0) {
+                v->iov_base = (char *)v->iov_base + w;
+                v->iov_len -= w;
+            }
+        }
+        disk.stats.flushes++;
+        if (cnt > 0) {
+            disk.stats.errors++;
+            ret = -1;
+            continue;
+        }
+
+        for (k = i; k < j; k++) {
+            p = pages[k];
+            disk.stats.flushed += p->dirty_hi - p->dirty_lo;
+            p->dirty_lo = p->dirty_hi = 0;
+            disk.ndirty--;
+        }
+    }
+
+    return ret;
+}
+
+static int disk_flush_locked()
+{
+    struct disk_page *dirty[disk.npages];
+    int i, n = 0;
+
+    for (i = 0; i < disk.npages; i++) {
+        if (disk.pages[i].dirty_hi != disk.pages[i].dirty_lo)
+            dirty[n++] = &disk.pages[i];
+    }
+    clock_gettime(CLOCK_REALTIME, &disk.last_flush);
+    if (n == 0)
+        return 0;
+    return disk_writeback(dirty, n);
+}
+
+// 选一个空闲或最久没有用过的页, 脏页先写回. 所有页都在加载中时返回 NULL;
+// 脏页写回失败时也返回 NULL 并设置 failed, 页的内容不丢弃
+static struct disk_page *disk_evict(int *failed)
+{
+    struct disk_page *victim = NULL, *p;
+    int i;
+
+    *failed = 0;
+    for (i = 0; i < disk.npages; i++) {
+        p = &disk.pages[i];
+        if (p->state == PAGE_EMPTY)
+            return p;
+        if (p->state == PAGE_VALID && (!victim || p->used < victim->used))
+            victim = p;
+    }
+
+    if (victim && victim->dirty_hi != victim->dirty_lo && disk_writeback(&victim, 1) < 0) {
+        *failed = 1;
+        return NULL;
+    }
+    if (victim)
+        victim->state = PAGE_EMPTY;
+    return victim;
+}
+
+// 取得 page 对应的缓存页, 不在缓存中时同步读文件 (fill 为 0 表示整页将被覆盖, 不用读). 持有锁调用
+static struct disk_page *disk_get_page(uint32_t page, int fill)
+{
+    struct disk_page *p;
+    int ret = 0, failed;
+
+    while (1) {
+        p = disk_lookup(page);
+        if (p && p->state == PAGE_LOADING) {
+            pthread_cond_wait(&disk.cond, &disk.lock);
+            continue;
+        }
+        if (p) {
+            disk.stats.hits++;
+            if (p->ra) {
+                p->ra = 0;
+                disk.stats.ra_hits++;
+                if (disk.ra_window < DISK_RA_MAX)
+                    disk.ra_window *= 2;
+            }
+            p->used = ++disk.tick;
+            return p;
+        }
+
+        p = disk_evict(&failed);
+        if (p)
+            break;
+        if (failed)
+            return NULL;
+        pthread_cond_wait(&disk.cond, &disk.lock);
+    }
+
+    disk.stats.misses++;
+    p->page = page;
+    p->ra = 0;
+    p->used = ++disk.tick;
+    if (fill) {
+        p->state = PAGE_LOADING;
+        pthread_mutex_unlock(&disk.lock);
+        ret = disk_pread(page, p->data);
+        pthread_mutex_lock(&disk.lock);
+        pthread_cond_broadcast(&disk.cond);
+    } else {
+        memset(p->data, 0, DISK_PAGE_BYTES);
+    }
+
+    if (ret < 0) {
+        p->state = PAGE_EMPTY;
+        return NULL;
+    }
+    p->state = PAGE_VALID;
+    return p;
+}
+
+// 顺序读时把 [last + 1, last + ra_window] 中还没有预读过的页放进队列
+static void disk_readahead(uint32_t pos, uint32_t len)
+{
+    uint32_t last = (pos + len - 1) >> DISK_PAGE_SHIFT;
+    uint32_t pg, end;
+
+    if (pos == disk.next_pos) {
+        disk.seq++;
+    } else {
+        disk.seq = 0;
+        disk.ra_window = DISK_RA_MIN;
+        disk.ra_next = 0;
+    }
+    disk.next_pos = pos + len;
+
+    if (disk.seq == 0 || disk.size == 0)
+        return;
+
+    pg = disk.ra_next > last + 1 ? disk.ra_next : last + 1;
+    end = last + disk.ra_window;
+    if (end >= disk.size)
+        end = disk.size - 1;
+
+    for (; pg <= end && disk.qtail - disk.qhead < DISK_QUEUE; pg++) {
+        if (!disk_lookup(pg))
+            disk.queue[disk.qtail++ % DISK_QUEUE] = pg;
+    }
+    if (pg > disk.ra_next)
+        disk.ra_next = pg;
+    pthread_cond_signal(&disk.work);
+}
+
+static int disk_wait_work()
+{
+    struct timespec ts;
+    long ms;
+
+    if (disk.writeback_ms <= 0)
+        return pthread_cond_wait(&disk.work, &disk.lock);
+
+    ms = disk.writeback_ms;
+    ts = disk.last_flush;
+    ts.tv_sec += ms / 1000;
+    ts.tv_nsec += (ms % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    return pthread_cond_timedwait(&disk.work, &disk.lock, &ts);
+}
+
+// 后台线程: 处理预读队列, 并按 writeback_ms 定时回写脏页
+static void *disk_worker(void *arg)
+{
+    struct disk_page *p;
+    uint32_t pg;
+    int ret, failed;
+
+    pthread_mutex_lock(&disk.lock);
+    while (!disk.stop) {
+        if (disk.qhead == disk.qtail) {
+            if (disk_wait_work() == ETIMEDOUT)
+                disk_flush_locked();
+            continue;
+        }
+
+        pg = disk.queue[disk.qhead++ % DISK_QUEUE];
+        if (disk_lookup(pg) || !(p = disk_evict(&failed)))
+            continue;
+
+        p->page = pg;
+        p->state = PAGE_LOADING;
+        p->ra = 1;
+        p->used = ++disk.tick;
+        pthread_mutex_unlock(&disk.lock);
+        ret = disk_pread(pg, p->data);
+        pthread_mutex_lock(&disk.lock);
+        p->state = ret < 0 ? PAGE_EMPTY : PAGE_VALID;
+        disk.stats.ra_pages++;
+        pthread_cond_broadcast(&disk.cond);
+    }
+    pthread_mutex_unlock(&disk.lock);
+
+    return NULL;
+}
+
+int disk_open(const char *path, int cache_pages, int writeback_ms)
+{
+    struct stat st;
+    int i;
+
+    if (disk.fd >= 0)
+        return -1;
+
+    disk.fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (disk.fd < 0 || fstat(disk.fd, &st) < 0)
+        goto fail;
+
+    disk.npages = cache_pages > 0 ? cache_pages : DISK_CACHE_PAGES;
+    disk.writeback_ms = writeback_ms >= 0 ? writeback_ms : DISK_WRITEBACK_MS;
+    disk.size = (st.st_size + DISK_PAGE_BYTES - 1) / DISK_PAGE_BYTES;
+    disk.pages = calloc(disk.npages, sizeof(struct disk_page));
+    if (!disk.pages)
+        goto fail;
+    for (i = 0; i < disk.npages; i++) {
+        disk.pages[i].data = malloc(DISK_PAGE_BYTES);
+        if (!disk.pages[i].data)
+            goto fail;
+    }
+
+    disk.next_pos = UINT32_MAX;
+    disk.ra_window = DISK_RA_MIN;
+    disk.stop = 0;
+    disk.qhead = disk.qtail = 0;
+    memset(&disk.stats, 0, sizeof(disk.stats));
+    clock_gettime(CLOCK_REALTIME, &disk.last_flush);
+
+    pthread_mutex_init(&disk.lock, NULL);
+    pthread_cond_init(&disk.cond, NULL);
+    pthread_cond_init(&disk.work, NULL);
+    for (disk.nworkers = 0; disk.nworkers < DISK_WORKERS; disk.nworkers++) {
+        if (pthread_create(&disk.workers[disk.nworkers], NULL, disk_worker, NULL))
+            break;
+    }
+
+    printf(">>> disk: %s  %u pages of %d words, cache %d pages\n", path,
+            disk.size, DISK_PAGE_WORDS, disk.npages);
+    return 0;
+
+fail:
+    if (disk.pages) {
+        for (i = 0; i < disk.npages; i++)
+            free(disk.pages[i].data);
+        free(disk.pages);
+        disk.pages = NULL;
+    }
+    if (disk.fd >= 0)
+        close(disk.fd);
+    disk.fd = -1;
+    return -1;
+}
+
+int disk_active()
+{
+    return disk.fd >= 0;
+}
+
+int disk_read(uint32_t pos, uint16_t *buf, uint32_t len)
+{
+    struct disk_page *p;
+    uint32_t off, n;
+
+    if (len == 0)
+        return 0;
+
+    pthread_mutex_lock(&disk.lock);
+    disk.stats.reads++;
+    disk_readahead(pos, len);
+
+    while (len > 0) {
+        off = pos & (DISK_PAGE_WORDS - 1);
+        n = DISK_PAGE_WORDS - off < len ? DISK_PAGE_WORDS - off : len;
+        p = disk_get_page(pos >> DISK_PAGE_SHIFT, 1);
+        if (!p) {
+            pthread_mutex_unlock(&disk.lock);
+            return -1;
+        }
+        memcpy(buf, p->data + off, n * sizeof(uint16_t));
+        buf += n;
+        pos += n;
+        len -= n;
+    }
+
+    pthread_mutex_unlock(&disk.lock);
+    return 0;
+}
+
+int disk_write(uint32_t pos, const uint16_t *buf, uint32_t len)
+{
+    struct disk_page *p;
+    uint32_t off, n;
+    int ret = 0;
+
+    if (len == 0)
+        return 0;
+
+    pthread_mutex_lock(&disk.lock);
+    disk.stats.writes++;
+
+    while (len > 0) {
+        off = pos & (DISK_PAGE_WORDS - 1);
+        n = DISK_PAGE_WORDS - off < len ? DISK_PAGE_WORDS - off : len;
+        // 页内已有脏区间时, 新的区间与它合并; 中间夹着的字在缓存页中也是最新的
+        p = disk_get_page(pos >> DISK_PAGE_SHIFT, n < DISK_PAGE_WORDS);
+        if (!p) {
+            ret = -1;
+            break;
+        }
+        memcpy(p->data + off, buf, n * sizeof(uint16_t));
+        if (p->dirty_hi == p->dirty_lo) {
+            p->dirty_lo = off;
+            p->dirty_hi = off + n;
+            disk.ndirty++;
+        } else {
+            if (off < p->dirty_lo)
+                p->dirty_lo = off;
+            if (off + n > p->dirty_hi)
+                p->dirty_hi = off + n;
+        }
+        if ((pos >> DISK_PAGE_SHIFT) >= disk.size)
+            disk.size = (pos >> DISK_PAGE_SHIFT) + 1;
+        buf += n;
+        pos += n;
+        len -= n;
+    }
+
+    if (disk.writeback_ms == 0 && disk_flush_locked() < 0)
+        ret = -1;
+
+    pthread_mutex_unlock(&disk.lock);
+    return ret;
+}
+
+int disk_flush()
+{
+    int ret;
+
+    if (disk.fd < 0)
+        return 0;
+
+    pthread_mutex_lock(&disk.lock);
+    ret = disk_flush_locked();
+    pthread_mutex_unlock(&disk.lock);
+    return ret;
+}
+
+void disk_close()
+{
+    struct disk_stats *s = &disk.stats;
+    int i;
+
+    if (disk.fd < 0)
+        return;
+
+    pthread_mutex_lock(&disk.lock);
+    disk.stop = 1;
+    pthread_cond_broadcast(&disk.work);
+    pthread_mutex_unlock(&disk.lock);
+    for (i = 0; i < disk.nworkers; i++)
+        pthread_join(disk.workers[i], NULL);
+
+    if (disk_flush() < 0)
+        fprintf(stderr, ">>> disk: failed to write back dirty pages: %s\n", strerror(disk.werrno));
+
+    if (getenv("LC3_DISK_STATS")) {
+        fprintf(stderr, ">>> disk: %llu reads, %llu writes, %llu hits, %llu misses, "
+                "%llu readahead (%llu used), %llu flushes (%llu words, %llu failed)\n",
+                (unsigned long long)s->reads, (unsigned long long)s->writes,
+                (unsigned long long)s->hits, (unsigned long long)s->misses,
+                (unsigned long long)s->ra_pages, (unsigned long long)s->ra_hits,
+                (unsigned long long)s->flushes, (unsigned long long)s->flushed,
+                (unsigned long long)s->errors);
+    }
+
+    for (i = 0; i < disk.npages; i++)
+        free(disk.pages[i].data);
+    free(disk.pages);
+    disk.pages = NULL;
+    close(disk.fd);
+    disk.fd = -1;
+}
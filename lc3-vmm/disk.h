@@ -0,0 +1,52 @@
+#ifndef _DISK_H_
+#define _DISK_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+// virtio 块设备的主机端存储: 一个普通文件, 每个字按主机字节序占两个字节, pos/len 以字为单位.
+//
+// 客户机的请求很小 (几十个字) 且大多是顺序的, 所以在文件前面加一层页缓存:
+//   - 缓存页为 DISK_PAGE_WORDS 个字, 按 LRU 替换;
+//   - 连续两次读请求首尾相接时认为是顺序读, 由后台线程异步预读后面的页,
+//     预读的页被命中后窗口加倍, 直到 DISK_RA_MAX;
+//   - 写请求只改缓存页并记录脏区间, 相邻的脏页合并成一次 pwritev,
+//     由后台线程每 writeback_ms 毫秒回写一次 (0 表示每次写请求后立即回写), 退出时全部回写.
+// 设置 LC3_DISK_STATS 环境变量时退出时打印命中率等统计.
+#define DISK_PAGE_SHIFT   8
+#define DISK_PAGE_WORDS   (1 << DISK_PAGE_SHIFT)
+#define DISK_PAGE_BYTES   (DISK_PAGE_WORDS * sizeof(uint16_t))
+#define DISK_CACHE_PAGES  64
+#define DISK_RA_MIN       2
+#define DISK_RA_MAX       32
+#define DISK_WORKERS      2
+#define DISK_WRITEBACK_MS 100
+
+struct disk_stats {
+    uint64_t reads;
+    uint64_t writes;
+    uint64_t hits;        /* 请求涉及的页已在缓存中 */
+    uint64_t misses;      /* 需要同步读文件 */
+    uint64_t ra_pages;    /* 预读的页数 */
+    uint64_t ra_hits;     /* 预读后被访问的页数 */
+    uint64_t flushes;     /* pwritev 次数 */
+    uint64_t flushed;     /* 回写的字数 */
+    uint64_t errors;      /* 没有完整写入的 pwritev, 其中的页保持脏 */
+};
+
+// cache_pages 为 0 时使用 DISK_CACHE_PAGES; writeback_ms 小于 0 时使用 DISK_WRITEBACK_MS.
+// 返回 -1 表示失败
+int disk_open(const char *path, int cache_pages, int writeback_ms);
+int disk_active();
+// 文件末尾之后读到 0, 写入时扩展文件
+int disk_read(uint32_t pos, uint16_t *buf, uint32_t len);
+int disk_write(uint32_t pos, const uint16_t *buf, uint32_t len);
+// 回写所有脏页, 有页没有写入时返回 -1
+int disk_flush();
+// 回写所有脏页, 停止后台线程并关闭文件
+void disk_close();
+
+#endif
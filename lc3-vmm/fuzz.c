@@ -0,0 +1,175 @@
+#include <string.h>
+#include <stdio_ext.h>
+#include <time.h>
+#include <signal.h>
+#include <sys/shm.h>
+#include <sys/wait.h>
+
+#include "mem.h"
+#include "cpu.h"
+#include "timer.h"
+#include "interrupt.h"
+#include "perf.h"
+#include "fuzz.h"
+
+uint8_t *fuzz_map;
+uint16_t fuzz_prev;
+
+static uint16_t *snapshot;
+static struct cpu_state snapshot_cpu;
+
+static void fuzz_restore(int full)
+{
+    uint16_t *memory = mem_addr();
+    int page;
+
+    for (page = 0; page < MEM_PAGES; page++) {
+        if (full || mem_dirty[page] || mem_device_page(page)) {
+            memcpy(memory + (page << MEM_PAGE_SHIFT), snapshot + (page << MEM_PAGE_SHIFT),
+                    MEM_PAGE_WORDS * sizeof(uint16_t));
+        }
+        mem_dirty[page] = 0;
+    }
+}
+
+// 从快照开始执行一次, 输入从 stdin 读取
+static void fuzz_exec(int full)
+{
+    fuzz_restore(full);
+    timer_init();
+    perf_init();
+    int_reset();
+    cpu_load(&snapshot_cpu);
+    fuzz_prev = 0;
+
+    // fseek 在目标位置落在缓冲区内时不会重新读文件, 这里直接丢弃缓冲区
+    lseek(STDIN_FILENO, 0, SEEK_SET);
+    __fpurge(stdin);
+    clearerr(stdin);
+
+    cpu_run();
+    fflush(stdout);
+}
+
+// afl-fuzz 的 fork server 协议. 子进程停止 (SIGSTOP) 表示一次执行结束,
+// 下次直接 SIGCONT 继续, 子进程退出或被杀死后才重新 fork.
+// 返回 1 表示当前是子进程, 返回 0 表示不在 fork server 下运行.
+static int fuzz_server()
+{
+    uint32_t hello = 0, was_killed;
+    int status, child_stopped = 0;
+    pid_t child = -1;
+
+    if (write(FUZZ_FORKSRV_FD + 1, &hello, 4) != 4)
+        return 0;
+
+    while (1) {
+        if (read(FUZZ_FORKSRV_FD, &was_killed, 4) != 4)
+            _exit(0);
+
+        if (child_stopped && was_killed) {
+            child_stopped = 0;
+            if (waitpid(child, &status, 0) < 0)
+                _exit(1);
+        }
+
+        if (!child_stopped) {
+            child = fork();
+            if (child < 0)
+                _exit(1);
+            if (child == 0) {
+                close(FUZZ_FORKSRV_FD);
+                close(FUZZ_FORKSRV_FD + 1);
+                return 1;
+            }
+        } else {
+            kill(child, SIGCONT);
+            child_stopped = 0;
+        }
+
+        if (write(FUZZ_FORKSRV_FD + 1, &child, 4) != 4)
+            _exit(1);
+        if (waitpid(child, &status, WUNTRACED) < 0)
+            _exit(1);
+        if (WIFSTOPPED(status))
+            child_stopped = 1;
+        if (write(FUZZ_FORKSRV_FD + 1, &status, 4) != 4)
+            _exit(1);
+    }
+}
+
+static int fuzz_afl(const char *shm_id)
+{
+    int i;
+
+    fuzz_map = (uint8_t *)shmat(atoi(shm_id), NULL, 0);
+    if (fuzz_map == (void *)-1) {
+        fuzz_map = NULL;
+        printf("fuzz: failed to attach shm %s\n", shm_id);
+        return -1;
+    }
+
+    if (!fuzz_server()) {
+        fuzz_exec(0);
+        return 0;
+    }
+
+    // 持久模式: 同一个子进程连续执行多个输入. 新 fork 的子进程继承的脏页标记
+    // 不包括上一个子进程的写入, 第一次要完整恢复
+    for (i = 0; ; i++) {
+        fuzz_exec(i == 0);
+        if (i + 1 >= FUZZ_PERSIST_MAX)
+            break;
+        raise(SIGSTOP);
+    }
+    exit(0);
+}
+
+static double fuzz_now()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int fuzz_run(const char *inputs[], int ninputs)
+{
+    const char *shm_id = getenv("__AFL_SHM_ID");
+    double start, elapsed;
+    int i, fd, edges = 0;
+
+    snapshot = (uint16_t *)malloc(MEMORY_MAX * sizeof(uint16_t));
+    if (!snapshot)
+        return -1;
+    memcpy(snapshot, mem_addr(), MEMORY_MAX * sizeof(uint16_t));
+    memset(mem_dirty, 0, sizeof(mem_dirty));
+    cpu_reset(0x3000);
+    cpu_save(&snapshot_cpu);
+
+    if (shm_id)
+        return fuzz_afl(shm_id);
+
+    fuzz_map = (uint8_t *)calloc(FUZZ_MAP_SIZE, 1);
+    if (!fuzz_map)
+        return -1;
+
+    start = fuzz_now();
+    for (i = 0; i < ninputs; i++) {
+        fd = open(inputs[i], O_RDONLY);
+        if (fd < 0 || dup2(fd, STDIN_FILENO) < 0) {
+            printf("fuzz: failed to open %s\n", inputs[i]);
+            return -1;
+        }
+        close(fd);
+        fuzz_exec(0);
+    }
+    elapsed = fuzz_now() - start;
+
+    for (i = 0; i < FUZZ_MAP_SIZE; i++) {
+        edges += fuzz_map[i] != 0;
+    }
+    fprintf(stderr, ">>> fuzz: %d execs in %.3fs (%.0f execs/s), %d edges\n",
+            ninputs, elapsed, elapsed > 0 ? ninputs / elapsed : 0.0, edges);
+    return 0;
+}
@@ -0,0 +1,30 @@
+#ifndef _FUZZ_H_
+#define _FUZZ_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// 模糊测试模式: 镜像只装入一次, 初始化后做快照, 每个输入之间只恢复写过的页.
+// 在 afl-fuzz 下运行时使用 fork server 加持久模式, 覆盖率写入 AFL 的共享内存;
+// 单独运行时依次执行命令行给出的输入文件, 统计覆盖的边和执行速度.
+#define FUZZ_MAP_SIZE     (1 << 16)
+#define FUZZ_FORKSRV_FD   198         /* afl-fuzz 约定的控制管道, 状态管道为 +1 */
+#define FUZZ_PERSIST_MAX  10000       /* 每个子进程执行的输入数 */
+
+extern uint8_t *fuzz_map;
+extern uint16_t fuzz_prev;
+
+// 边覆盖: 与 AFL 相同, 以 (上一块 >> 1) ^ 当前块作为下标
+static inline void fuzz_edge(uint16_t pc)
+{
+    uint16_t cur = (uint16_t)(pc * 40503u);
+
+    fuzz_map[cur ^ fuzz_prev]++;
+    fuzz_prev = cur >> 1;
+}
+
+// 从当前内存和 0x3000 开始做快照并执行输入
+int fuzz_run(const char *inputs[], int ninputs);
+
+#endif
@@ -0,0 +1,583 @@
+#include <string.h>
+#include <ctype.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include "lc3.h"
+#include "mem.h"
+#include "cpu.h"
+#include "gdb.h"
+
+int gdb_attached;
+int gdb_trace;
+
+static int gdb_fd = -1;
+static int gdb_noack;
+
+static uint8_t gdb_bp[MEMORY_MAX / 8];
+static uint16_t gdb_bp_page[MEM_PAGES];  /* 每页的断点数 */
+static int gdb_nbreak;
+
+enum { GDB_WATCH_WRITE = 2, GDB_WATCH_READ = 3, GDB_WATCH_ACCESS = 4 };
+
+struct gdb_watch {
+    int type;        /* 0 表示未使用 */
+    uint16_t addr;
+    uint16_t len;    /* 字数 */
+};
+
+static struct gdb_watch gdb_watch[GDB_MAX_WATCH];
+
+static int gdb_skip;        /* 连接后的第一条指令不检查 */
+static int gdb_step;
+static int gdb_interrupt;
+static int gdb_poll_count;
+static struct gdb_watch *gdb_watch_hit;
+static uint16_t gdb_watch_addr;
+
+static char gdb_rbuf[GDB_PACKET_MAX];
+static int gdb_rlen, gdb_rpos;
+
+static const char hexchars[] = "0123456789abcdef";
+
+static int gdb_getc()
+{
+    ssize_t n;
+
+    if (gdb_rpos == gdb_rlen) {
+        n = recv(gdb_fd, gdb_rbuf, sizeof(gdb_rbuf), 0);
+        if (n <= 0)
+            return -1;
+        gdb_rlen = n;
+        gdb_rpos = 0;
+    }
+    return (unsigned char)gdb_rbuf[gdb_rpos++];
+}
+
+static int gdb_send(const char *data)
+{
+    char buf[GDB_PACKET_MAX + 4];
+    uint8_t sum = 0;
+    size_t i, len = strlen(data);
+    int c;
+
+    if (len > GDB_PACKET_MAX)
+        len = GDB_PACKET_MAX;
+    buf[0] = '$';
+    for (i = 0; i < len; i++) {
+        buf[i + 1] = data[i];
+        sum += (uint8_t)data[i];
+    }
+    buf[len + 1] = '#';
+    buf[len + 2] = hexchars[sum >> 4];
+    buf[len + 3] = hexchars[sum & 0xF];
+
+    do {
+        if (send(gdb_fd, buf, len + 4, MSG_NOSIGNAL) != (ssize_t)(len + 4))
+            return -1;
+        if (gdb_noack)
+            return 0;
+        c = gdb_getc();
+    } while (c == '-');
+    return c == '+' ? 0 : -1;
+}
+
+// 读一个完整的包到 buf, 返回长度. 包外的 0x03 (Ctrl-C) 在停止状态下忽略
+static int gdb_recv(char *buf)
+{
+    int c, len;
+    uint8_t sum;
+    char ck[3];
+
+    while (1) {
+        do {
+            c = gdb_getc();
+            if (c < 0)
+                return -1;
+        } while (c != '$');
+
+        len = 0;
+        sum = 0;
+        while ((c = gdb_getc()) >= 0 && c != '#') {
+            if (len < GDB_PACKET_MAX - 1)
+                buf[len++] = c;
+            sum += c;
+        }
+        if (c < 0 || (c = gdb_getc()) < 0)
+            return -1;
+        ck[0] = c;
+        if ((c = gdb_getc()) < 0)
+            return -1;
+        ck[1] = c;
+        ck[2] = '\0';
+        buf[len] = '\0';
+
+        if (gdb_noack)
+            return len;
+        if (strtoul(ck, NULL, 16) == sum) {
+            send(gdb_fd, "+", 1, MSG_NOSIGNAL);
+            return len;
+        }
+        send(gdb_fd, "-", 1, MSG_NOSIGNAL);
+    }
+}
+
+static char *gdb_put16(char *p, uint16_t v)
+{
+    *p++ = hexchars[(v >> 4) & 0xF];
+    *p++ = hexchars[v & 0xF];
+    *p++ = hexchars[(v >> 12) & 0xF];
+    *p++ = hexchars[(v >> 8) & 0xF];
+    return p;
+}
+
+static int gdb_hex(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    c = tolower(c);
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    return -1;
+}
+
+static const char *gdb_get16(const char *p, uint16_t *v)
+{
+    int i, d[4];
+
+    for (i = 0; i < 4; i++) {
+        if ((d[i] = gdb_hex(p[i])) < 0)
+            return NULL;
+    }
+    *v = (d[0] << 4) | d[1] | (d[2] << 12) | (d[3] << 8);
+    return p + 4;
+}
+
+static uint16_t gdb_psr(const struct cpu_state *st)
+{
+    return (st->priority ? 0 : PSR_USER) | (st->priority << 8) | st->reg[R_COND];
+}
+
+static void gdb_read_regs(char *out)
+{
+    struct cpu_state st;
+    int i;
+
+    cpu_save(&st);
+    for (i = 0; i < R_COND; i++) {
+        out = gdb_put16(out, st.reg[i]);
+    }
+    out = gdb_put16(out, gdb_psr(&st));
+    *out = '\0';
+}
+
+static int gdb_write_reg(int n, uint16_t v)
+{
+    struct cpu_state st;
+
+    if (n < 0 || n > R_COND)
+        return -1;
+
+    cpu_save(&st);
+    if (n == R_COND) {
+        st.reg[R_COND] = v & 0x7;
+        st.priority = (v >> 8) & 0x7;
+    } else {
+        st.reg[n] = v;
+        if (n == R_PC)
+            st.block_start = v;
+    }
+    cpu_load(&st);
+    return 0;
+}
+
+static void gdb_bp_set(uint16_t addr, int on)
+{
+    int set = (gdb_bp[addr >> 3] >> (addr & 7)) & 1;
+
+    if (set == on)
+        return;
+    gdb_bp[addr >> 3] ^= 1 << (addr & 7);
+    gdb_bp_page[addr >> MEM_PAGE_SHIFT] += on ? 1 : -1;
+    gdb_nbreak += on ? 1 : -1;
+}
+
+static void gdb_watch_pages()
+{
+    int i;
+    uint32_t a;
+
+    memset(mem_watch, 0, sizeof(mem_watch));
+    for (i = 0; i < GDB_MAX_WATCH; i++) {
+        if (!gdb_watch[i].type)
+            continue;
+        for (a = gdb_watch[i].addr; a < (uint32_t)gdb_watch[i].addr + gdb_watch[i].len && a < MEMORY_MAX; a++) {
+            mem_watch[a >> MEM_PAGE_SHIFT] = 1;
+        }
+    }
+}
+
+static int gdb_watch_set(int type, uint16_t addr, uint16_t len, int on)
+{
+    int i, slot = -1;
+
+    for (i = 0; i < GDB_MAX_WATCH; i++) {
+        if (gdb_watch[i].type == type && gdb_watch[i].addr == addr && gdb_watch[i].len == len) {
+            if (!on)
+                gdb_watch[i].type = 0;
+            gdb_watch_pages();
+            return 0;
+        }
+        if (!gdb_watch[i].type && slot < 0)
+            slot = i;
+    }
+    if (!on)
+        return 0;
+    if (slot < 0)
+        return -1;
+
+    gdb_watch[slot].type = type;
+    gdb_watch[slot].addr = addr;
+    gdb_watch[slot].len = len ? len : 1;
+    gdb_watch_pages();
+    return 0;
+}
+
+static void gdb_close()
+{
+    if (gdb_fd >= 0)
+        close(gdb_fd);
+    gdb_fd = -1;
+    gdb_attached = 0;
+    gdb_trace = 0;
+    memset(gdb_bp, 0, sizeof(gdb_bp));
+    memset(gdb_bp_page, 0, sizeof(gdb_bp_page));
+    gdb_nbreak = 0;
+    memset(gdb_watch, 0, sizeof(gdb_watch));
+    memset(mem_watch, 0, sizeof(mem_watch));
+}
+
+// Z/z 包: type,addr,kind
+static int gdb_breakpoint(const char *p, int on)
+{
+    char *end;
+    int type = strtol(p, &end, 16);
+    uint16_t addr, len;
+
+    if (*end != ',')
+        return -1;
+    addr = strtoul(end + 1, &end, 16);
+    len = *end == ',' ? strtoul(end + 1, NULL, 16) : 1;
+
+    switch (type) {
+        case 0:
+        case 1:
+            gdb_bp_set(addr, on);
+            return 0;
+        case GDB_WATCH_WRITE:
+        case GDB_WATCH_READ:
+        case GDB_WATCH_ACCESS:
+            return gdb_watch_set(type, addr, (len + 1) / 2, on);
+    }
+    return 1;
+}
+
+static void gdb_mem_read(const char *p, char *out)
+{
+    char *end;
+    uint16_t addr = strtoul(p, &end, 16);
+    uint32_t len = *end == ',' ? strtoul(end + 1, NULL, 16) / 2 : 0;
+
+    if (len > GDB_PACKET_MAX / 4 - 1)
+        len = GDB_PACKET_MAX / 4 - 1;
+    while (len--) {
+        out = gdb_put16(out, mem_get(addr++));
+    }
+    *out = '\0';
+}
+
+static int gdb_mem_write(const char *p)
+{
+    char *end;
+    uint16_t addr = strtoul(p, &end, 16);
+    uint32_t len;
+    uint16_t v;
+
+    if (*end != ',')
+        return -1;
+    len = strtoul(end + 1, &end, 16) / 2;
+    if (*end != ':')
+        return -1;
+    p = end + 1;
+    while (len--) {
+        if (!(p = gdb_get16(p, &v)))
+            return -1;
+        mem_set(addr++, v);
+    }
+    return 0;
+}
+
+// 停止并处理调试器的命令, 直到继续或单步. reply 为 NULL 表示刚连接, 不发送停止原因
+static void gdb_stop(const char *reply)
+{
+    static char last[64] = "S05";
+    char buf[GDB_PACKET_MAX], out[GDB_PACKET_MAX];
+    const char *p;
+    uint16_t v;
+    int n;
+
+    if (reply) {
+        snprintf(last, sizeof(last), "%s", reply);
+        if (gdb_send(last) < 0)
+            goto lost;
+    }
+
+    while (1) {
+        if (gdb_recv(buf) < 0)
+            goto lost;
+
+        out[0] = '\0';
+        switch (buf[0]) {
+            case '?':
+                snprintf(out, sizeof(out), "%s", last);
+                break;
+            case 'g':
+                gdb_read_regs(out);
+                break;
+            case 'G':
+                p = buf + 1;
+                for (n = 0; n <= R_COND && p; n++) {
+                    if ((p = gdb_get16(p, &v)))
+                        gdb_write_reg(n, v);
+                }
+                strcpy(out, "OK");
+                break;
+            case 'p':
+                n = strtol(buf + 1, NULL, 16);
+                if (n >= 0 && n <= R_COND) {
+                    gdb_read_regs(buf);
+                    memcpy(out, buf + n * 4, 4);
+                    out[4] = '\0';
+                } else {
+                    strcpy(out, "E01");
+                }
+                break;
+            case 'P':
+                n = strtol(buf + 1, (char **)&p, 16);
+                if (*p == '=' && gdb_get16(p + 1, &v) && gdb_write_reg(n, v) == 0) {
+                    strcpy(out, "OK");
+                } else {
+                    strcpy(out, "E01");
+                }
+                break;
+            case 'm':
+                gdb_mem_read(buf + 1, out);
+                break;
+            case 'M':
+                strcpy(out, gdb_mem_write(buf + 1) == 0 ? "OK" : "E01");
+                break;
+            case 'c':
+            case 's':
+                if (buf[1]) {
+                    gdb_write_reg(R_PC, strtoul(buf + 1, NULL, 16));
+                }
+                // 从 gdb_check 返回后直接执行当前指令, 不会再次命中同一个断点
+                gdb_step = buf[0] == 's';
+                gdb_trace = 1;
+                return;
+            case 'Z':
+            case 'z':
+                n = gdb_breakpoint(buf + 1, buf[0] == 'Z');
+                strcpy(out, n == 0 ? "OK" : (n < 0 ? "E01" : ""));
+                break;
+            case 'k':
+                gdb_close();
+                restore_input_buffering();
+                exit(0);
+            case 'D':
+                gdb_send("OK");
+                gdb_close();
+                return;
+            case 'H':
+                strcpy(out, "OK");
+                break;
+            case 'q':
+                if (!strncmp(buf, "qSupported", 10)) {
+                    snprintf(out, sizeof(out), "PacketSize=%x;QStartNoAckMode+;swbreak+", GDB_PACKET_MAX);
+                } else if (!strcmp(buf, "qAttached")) {
+                    strcpy(out, "1");
+                } else if (!strcmp(buf, "qC")) {
+                    strcpy(out, "QC1");
+                } else if (!strcmp(buf, "qfThreadInfo")) {
+                    strcpy(out, "m1");
+                } else if (!strcmp(buf, "qsThreadInfo")) {
+                    strcpy(out, "l");
+                }
+                break;
+            case 'Q':
+                if (!strcmp(buf, "QStartNoAckMode")) {
+                    gdb_send("OK");
+                    gdb_noack = 1;
+                    continue;
+                }
+                break;
+        }
+        if (gdb_send(out) < 0)
+            goto lost;
+    }
+
+lost:
+    printf(">>> gdb: connection lost, continuing\n");
+    gdb_close();
+}
+
+int gdb_init(const char *spec)
+{
+    struct sockaddr_un un;
+    struct sockaddr_in in;
+    struct sockaddr *addr;
+    socklen_t addrlen;
+    int fd, one = 1;
+    const char *c;
+
+    for (c = spec; *c && isdigit((unsigned char)*c); c++)
+        ;
+
+    if (!*c) {
+        memset(&in, 0, sizeof(in));
+        in.sin_family = AF_INET;
+        in.sin_port = htons(atoi(spec));
+        in.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr = (struct sockaddr *)&in;
+        addrlen = sizeof(in);
+        fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd >= 0)
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    } else {
+        memset(&un, 0, sizeof(un));
+        un.sun_family = AF_UNIX;
+        if (strlen(spec) >= sizeof(un.sun_path))
+            return -1;
+        strcpy(un.sun_path, spec);
+        unlink(spec);
+        addr = (struct sockaddr *)&un;
+        addrlen = sizeof(un);
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    }
+    if (fd < 0)
+        return -1;
+
+    if (bind(fd, addr, addrlen) < 0 || listen(fd, 1) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    printf(">>> gdb: waiting for connection on %s\n", spec);
+    fflush(stdout);
+    gdb_fd = accept(fd, NULL, NULL);
+    close(fd);
+    if (*c)
+        unlink(spec);
+    if (gdb_fd < 0)
+        return -1;
+
+    gdb_attached = 1;
+    // 在第一条指令前停下, 等待调试器的命令
+    gdb_stop(NULL);
+    gdb_skip = 1;
+    return 0;
+}
+
+// 运行中每隔一段时间检查调试器是否发来了 Ctrl-C
+static void gdb_poll()
+{
+    struct pollfd pfd;
+    char c;
+
+    pfd.fd = gdb_fd;
+    pfd.events = POLLIN;
+    if (poll(&pfd, 1, 0) > 0 && recv(gdb_fd, &c, 1, 0) == 1 && c == 0x03) {
+        gdb_interrupt = 1;
+        gdb_trace = 1;
+    }
+}
+
+void gdb_block(uint16_t pc)
+{
+    int page = pc >> MEM_PAGE_SHIFT;
+
+    if (++gdb_poll_count >= GDB_POLL_BLOCKS) {
+        gdb_poll_count = 0;
+        gdb_poll();
+    }
+
+    // 块可能跨到下一页, 两页都没有断点时整块不用逐条检查
+    if (gdb_step || gdb_interrupt || gdb_watch_hit || gdb_skip) {
+        gdb_trace = 1;
+    } else {
+        gdb_trace = gdb_nbreak && (gdb_bp_page[page] || gdb_bp_page[(page + 1) % MEM_PAGES]);
+    }
+}
+
+void gdb_check(uint16_t pc)
+{
+    char reply[64];
+
+    if (gdb_skip) {
+        gdb_skip = 0;
+        return;
+    }
+
+    if (gdb_watch_hit) {
+        snprintf(reply, sizeof(reply), "T05%s:%x;",
+                gdb_watch_hit->type == GDB_WATCH_WRITE ? "watch" :
+                (gdb_watch_hit->type == GDB_WATCH_READ ? "rwatch" : "awatch"), gdb_watch_addr);
+        gdb_watch_hit = NULL;
+        gdb_step = 0;
+        gdb_stop(reply);
+    } else if (gdb_step) {
+        gdb_step = 0;
+        gdb_stop("S05");
+    } else if (gdb_interrupt) {
+        gdb_interrupt = 0;
+        gdb_stop("S02");
+    } else if ((gdb_bp[pc >> 3] >> (pc & 7)) & 1) {
+        gdb_stop("T05swbreak:;");
+    }
+}
+
+void gdb_access(uint16_t address, int write)
+{
+    int i;
+
+    if (!gdb_attached || gdb_watch_hit)
+        return;
+
+    for (i = 0; i < GDB_MAX_WATCH; i++) {
+        struct gdb_watch *w = &gdb_watch[i];
+
+        if (!w->type || address < w->addr || address >= (uint32_t)w->addr + w->len)
+            continue;
+        if ((w->type == GDB_WATCH_WRITE && !write) || (w->type == GDB_WATCH_READ && write))
+            continue;
+        // 访问所在的指令执行完后再停下
+        gdb_watch_hit = w;
+        gdb_watch_addr = address;
+        gdb_trace = 1;
+        return;
+    }
+}
+
+void gdb_exit(int status)
+{
+    char reply[8];
+
+    if (!gdb_attached)
+        return;
+    snprintf(reply, sizeof(reply), "W%02x", status & 0xFF);
+    gdb_send(reply);
+    gdb_close();
+}
@@ -0,0 +1,31 @@
+#ifndef _GDB_H_
+#define _GDB_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// GDB 远程串行协议 (RSP) 调试桩.
+//
+// 寄存器 0-7 为 R0-R7, 8 为 PC, 9 为 PSR. 地址都是 LC-3 的字地址,
+// m/M 的长度按字节计, 每个字按小端 16 位传输.
+//
+// 软件断点放在按地址的位图里, 只在基本块入口检查块所在的页是否有断点,
+// 有才逐条指令检查; 观察点复用按页的访问表 mem_watch, 页内没有观察点时
+// 访存不进入调试桩. 没有断点和观察点时几乎没有额外开销.
+#define GDB_MAX_WATCH    8
+#define GDB_POLL_BLOCKS  4096   /* 每隔多少个基本块检查一次 Ctrl-C */
+#define GDB_PACKET_MAX   4096
+
+extern int gdb_attached;  /* 有调试器连接, 块入口需要检查 */
+extern int gdb_trace;     /* 执行下一条指令前需要检查 */
+
+// spec 为端口号时监听 127.0.0.1:port, 否则为 Unix socket 路径. 等待调试器连接
+int gdb_init(const char *spec);
+void gdb_block(uint16_t pc);
+void gdb_check(uint16_t pc);
+void gdb_access(uint16_t address, int write);
+// 客户机停机, 通知调试器并断开
+void gdb_exit(int status);
+
+#endif
@@ -0,0 +1,465 @@
+#include <errno.h>
+#include <string.h>
+#include <limits.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include "mem.h"
+#include "image.h"
+
+static uint16_t image_origin;
+static uint32_t image_words;
+
+int is_little_endian(void) {
+	union {
+		char c;
+		int i;
+	} un;
+
+	un.i = 1;
+
+    // 如果是小端则返回 1，如果是大端则返回 0
+	return un.c;
+}
+
+// LC-3 程序是大端程序, 如果是小端程序则需要交换高低字节
+uint16_t swap16(uint16_t x)
+{
+    return (x << 8) | (x >> 8);
+}
+
+// 读取 .obj, 返回装入的字数
+static size_t read_image_file(FILE* file, uint16_t* origin_out)
+{
+    uint16_t origin;
+    if (fread(&origin, sizeof(origin), 1, file) != 1) {
+        return 0;
+    }
+    if (is_little_endian()) {
+        origin = swap16(origin);
+    }
+
+    uint16_t max_read = MEMORY_MAX - origin;
+    uint16_t* p = mem_addr() + origin;
+    size_t read = fread(p, sizeof(uint16_t), max_read, file);
+    size_t n = read;
+
+    if (is_little_endian()) {
+        while (n-- > 0) {
+            *p = swap16(*p);
+            ++p;
+        }
+    }
+
+    *origin_out = origin;
+    image_origin = origin;
+    image_words = read;
+    return read;
+}
+
+static const char *image_ext(const char *path)
+{
+    const char *ext = strrchr(path, '.');
+    return ext ? ext : "";
+}
+
+static int read_image_obj(const char* image_path)
+{
+    char sym_path[PATH_MAX];
+    uint16_t origin;
+    FILE* file = fopen(image_path, "rb");
+    if (!file) {
+        return 0;
+    }
+
+    read_image_file(file, &origin);
+    fclose(file);
+
+    // 同名的 .sym 文件存在时一并加载
+    if (strlen(image_path) < sizeof(sym_path)) {
+        strcpy(sym_path, image_path);
+        if (!strcmp(image_ext(sym_path), ".obj")) {
+            strcpy(strrchr(sym_path, '.'), ".sym");
+            sym_clear();
+            sym_load(sym_path);
+        }
+    }
+    return 1;
+}
+
+static const char *image_lcc_path()
+{
+    const char *path = getenv("LCC_PATH");
+    return path ? path : IMAGE_LCC_PATH;
+}
+
+/* FNV-1a 64 */
+static uint64_t image_hash_update(uint64_t hash, const void *data, size_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    while (len--) {
+        hash ^= *p++;
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+static int image_hash_file(uint64_t *hash, const char *path)
+{
+    char buf[4096];
+    size_t n;
+    FILE *file = fopen(path, "rb");
+
+    if (!file)
+        return -1;
+    while ((n = fread(buf, 1, sizeof(buf), file)) > 0) {
+        *hash = image_hash_update(*hash, buf, n);
+    }
+    fclose(file);
+    return 0;
+}
+
+// 源文件所在的目录作为头文件搜索路径: inc = "-I<dir>"
+static void image_include(const char *abs, char *inc, size_t len)
+{
+    snprintf(inc, len, "-I%s", abs);
+    *strrchr(inc, '/') = '\0';
+}
+
+// 在子进程中运行 lcc 工具链, stdout 重定向到 out. 返回 pid
+static pid_t image_exec(const char *dir, int out, char *const argv[])
+{
+    char path_env[PATH_MAX * 2];
+    const char *old_path = getenv("PATH");
+    pid_t pid = fork();
+
+    if (pid != 0)
+        return pid;
+
+    snprintf(path_env, sizeof(path_env), "%s:%s", image_lcc_path(), old_path ? old_path : "/usr/bin:/bin");
+    setenv("PATH", path_env, 1);
+    if (out >= 0)
+        dup2(out, STDOUT_FILENO);
+    if (dir && chdir(dir) < 0)
+        _exit(127);
+    execvp(argv[0], argv);
+    _exit(127);
+}
+
+// C 源文件哈希 lcc -E 的输出, 源文件目录中被包含的头文件变化时也会重新编译
+static int image_hash_cpp(uint64_t *hash, const char *src)
+{
+    char abs[PATH_MAX], inc[PATH_MAX + 2], buf[4096];
+    char *argv[] = { "lcc", "-E", "-w", inc, abs, NULL };
+    int fds[2], status;
+    ssize_t n;
+    pid_t pid;
+
+    if (!realpath(src, abs))
+        return -1;
+    image_include(abs, inc, sizeof(inc));
+
+    if (pipe(fds) < 0)
+        return -1;
+    pid = image_exec(NULL, fds[1], argv);
+    close(fds[1]);
+    if (pid < 0) {
+        close(fds[0]);
+        return -1;
+    }
+    while ((n = read(fds[0], buf, sizeof(buf))) > 0 || (n < 0 && errno == EINTR)) {
+        if (n > 0)
+            *hash = image_hash_update(*hash, buf, n);
+    }
+    close(fds[0]);
+
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        return -1;
+    return 0;
+}
+
+// 缓存键: 预处理后的源文件 + 工具链路径 + lc3lib 内容, 任何一个变化都会重新编译.
+// lc3pp 从 lc3lib 复制的汇编不在预处理输出中, 所以 lc3lib 仍然整体参与哈希
+static int image_hash(const char *src, uint64_t *out)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    uint32_t version = IMAGE_VERSION;
+    char lib[PATH_MAX], file[PATH_MAX * 2];
+    struct dirent **names;
+    int i, n;
+
+    hash = image_hash_update(hash, &version, sizeof(version));
+    hash = image_hash_update(hash, image_ext(src), strlen(image_ext(src)));
+    if (!strcmp(image_ext(src), ".c")) {
+        if (image_hash_cpp(&hash, src) < 0)
+            return -1;
+    } else if (image_hash_file(&hash, src) < 0) {
+        return -1;
+    }
+
+    hash = image_hash_update(hash, image_lcc_path(), strlen(image_lcc_path()));
+    snprintf(lib, sizeof(lib), "%s/../lc3lib", image_lcc_path());
+    n = scandir(lib, &names, NULL, alphasort);
+    for (i = 0; i < n; i++) {
+        if (names[i]->d_name[0] != '.') {
+            snprintf(file, sizeof(file), "%s/%s", lib, names[i]->d_name);
+            hash = image_hash_update(hash, names[i]->d_name, strlen(names[i]->d_name));
+            image_hash_file(&hash, file);
+        }
+        free(names[i]);
+    }
+    if (n >= 0)
+        free(names);
+
+    *out = hash;
+    return 0;
+}
+
+static int mkdir_p(const char *path)
+{
+    char tmp[PATH_MAX];
+    char *p;
+
+    if (strlen(path) >= sizeof(tmp))
+        return -1;
+    strcpy(tmp, path);
+    for (p = tmp + 1; *p; p++) {
+        if (*p == '/') {
+            *p = '\0';
+            mkdir(tmp, 0755);
+            *p = '/';
+        }
+    }
+    return (mkdir(tmp, 0755) == 0 || errno == EEXIST) ? 0 : -1;
+}
+
+static int image_cache_dir(char *dir, size_t len)
+{
+    const char *env;
+
+    if ((env = getenv("LC3_CACHE_DIR"))) {
+        snprintf(dir, len, "%s", env);
+    } else if ((env = getenv("XDG_CACHE_HOME"))) {
+        snprintf(dir, len, "%s/lc3-vmm", env);
+    } else if ((env = getenv("HOME"))) {
+        snprintf(dir, len, "%s/.cache/lc3-vmm", env);
+    } else {
+        snprintf(dir, len, "/tmp/lc3-vmm-cache");
+    }
+    return mkdir_p(dir);
+}
+
+// 热启动: mmap 缓存镜像, 校验后直接拷贝进客户机内存, 不需要字节交换
+static int image_load_cached(const char *path)
+{
+    struct image_header *hdr;
+    const struct symbol *syms;
+    struct stat st;
+    uint32_t i;
+    void *p;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0)
+        return -1;
+    if (fstat(fd, &st) < 0 || st.st_size < (off_t)sizeof(*hdr)) {
+        close(fd);
+        return -1;
+    }
+
+    p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED)
+        return -1;
+
+    hdr = (struct image_header *)p;
+    if (hdr->magic != IMAGE_MAGIC || hdr->version != IMAGE_VERSION ||
+            hdr->origin + hdr->words > MEMORY_MAX ||
+            sizeof(*hdr) + hdr->words * sizeof(uint16_t) +
+            hdr->nsyms * sizeof(struct symbol) != (size_t)st.st_size) {
+        munmap(p, st.st_size);
+        return -1;
+    }
+
+    memcpy(mem_addr() + hdr->origin, (uint16_t *)(hdr + 1), hdr->words * sizeof(uint16_t));
+    image_origin = hdr->origin;
+    image_words = hdr->words;
+
+    syms = (const struct symbol *)((uint16_t *)(hdr + 1) + hdr->words);
+    sym_clear();
+    for (i = 0; i < hdr->nsyms; i++) {
+        sym_add(syms[i].name, syms[i].addr);
+    }
+
+    munmap(p, st.st_size);
+    return 0;
+}
+
+// 先写临时文件再改名, 多个 VMM 同时编译同一个源文件也不会读到半个镜像
+static int image_store(const char *path, uint16_t origin, uint32_t words)
+{
+    struct image_header hdr;
+    char tmp[PATH_MAX + 16];
+    FILE *file;
+    int ok;
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = IMAGE_MAGIC;
+    hdr.version = IMAGE_VERSION;
+    hdr.origin = origin;
+    hdr.words = words;
+    hdr.nsyms = sym_count();
+
+    snprintf(tmp, sizeof(tmp), "%s.%d", path, (int)getpid());
+    file = fopen(tmp, "wb");
+    if (!file)
+        return -1;
+
+    ok = fwrite(&hdr, sizeof(hdr), 1, file) == 1 &&
+        fwrite(mem_addr() + origin, sizeof(uint16_t), words, file) == words &&
+        fwrite(sym_table(), sizeof(struct symbol), hdr.nsyms, file) == hdr.nsyms;
+    ok = (fclose(file) == 0) && ok;
+
+    if (!ok || rename(tmp, path) < 0) {
+        unlink(tmp);
+        return -1;
+    }
+    return 0;
+}
+
+static int image_copy(const char *from, const char *to)
+{
+    char buf[4096];
+    size_t n;
+    FILE *in = fopen(from, "rb");
+    FILE *out = in ? fopen(to, "wb") : NULL;
+    int ret = 0;
+
+    if (!out) {
+        if (in)
+            fclose(in);
+        return -1;
+    }
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0) {
+        if (fwrite(buf, 1, n, out) != n)
+            ret = -1;
+    }
+    fclose(in);
+    if (fclose(out) != 0)
+        ret = -1;
+    return ret;
+}
+
+// 在 dir 中调用 lcc 或 lc3as, 生成 image.obj 和 image.sym.
+// lcc 会用源文件名生成标号, 所以先把源文件拷贝为 dir/image.c, 原目录作为头文件搜索路径.
+static int image_compile(const char *src, const char *dir)
+{
+    char abs[PATH_MAX], inc[PATH_MAX + 2], copy[PATH_MAX];
+    char *lcc_argv[] = { "lcc", "-w", inc, "image.c", "-o", "image.obj", NULL };
+    char *as_argv[] = { "lc3as", "image.asm", NULL };
+    int is_asm = !strcmp(image_ext(src), ".asm");
+    int status, devnull;
+    pid_t pid;
+
+    if (!realpath(src, abs))
+        return -1;
+    image_include(abs, inc, sizeof(inc));
+
+    snprintf(copy, sizeof(copy), "%s/image%s", dir, is_asm ? ".asm" : ".c");
+    if (image_copy(abs, copy) < 0)
+        return -1;
+
+    fprintf(stderr, ">>> compiling %s\n", src);
+    devnull = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    pid = image_exec(dir, devnull, is_asm ? as_argv : lcc_argv);
+    if (devnull >= 0)
+        close(devnull);
+    if (pid < 0)
+        return -1;
+
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        return -1;
+    return 0;
+}
+
+static void image_rmdir(const char *dir)
+{
+    char file[PATH_MAX * 2];
+    struct dirent *de;
+    DIR *d = opendir(dir);
+
+    if (d) {
+        while ((de = readdir(d))) {
+            if (strcmp(de->d_name, ".") && strcmp(de->d_name, "..")) {
+                snprintf(file, sizeof(file), "%s/%s", dir, de->d_name);
+                unlink(file);
+            }
+        }
+        closedir(d);
+    }
+    rmdir(dir);
+}
+
+static int read_image_source(const char *src)
+{
+    char cache_dir[PATH_MAX], cache[PATH_MAX + 32];
+    char tmp[] = "/tmp/lc3-vmm.XXXXXX";
+    char obj[sizeof(tmp) + 16], sym[sizeof(tmp) + 16];
+    uint16_t origin;
+    size_t words;
+    uint64_t hash;
+    FILE *file;
+    int cached;
+
+    if (image_hash(src, &hash) < 0)
+        return 0;
+
+    cached = image_cache_dir(cache_dir, sizeof(cache_dir)) == 0;
+    snprintf(cache, sizeof(cache), "%s/%016llx.img", cache_dir, (unsigned long long)hash);
+    if (cached && image_load_cached(cache) == 0)
+        return 1;
+
+    if (!mkdtemp(tmp))
+        return 0;
+
+    if (image_compile(src, tmp) < 0) {
+        image_rmdir(tmp);
+        return 0;
+    }
+
+    snprintf(obj, sizeof(obj), "%s/image.obj", tmp);
+    snprintf(sym, sizeof(sym), "%s/image.sym", tmp);
+
+    file = fopen(obj, "rb");
+    if (!file) {
+        image_rmdir(tmp);
+        return 0;
+    }
+    words = read_image_file(file, &origin);
+    fclose(file);
+
+    sym_clear();
+    sym_load(sym);
+    image_rmdir(tmp);
+
+    if (cached && image_store(cache, origin, words) < 0) {
+        fprintf(stderr, ">>> failed to store image cache: %s\n", cache);
+    }
+    return 1;
+}
+
+int read_image(const char* image_path)
+{
+    const char *ext = image_ext(image_path);
+
+    if (!strcmp(ext, ".c") || !strcmp(ext, ".asm")) {
+        return read_image_source(image_path);
+    }
+    return read_image_obj(image_path);
+}
+
+void image_extent(uint16_t *origin, uint32_t *words)
+{
+    *origin = image_origin;
+    *words = image_words;
+}
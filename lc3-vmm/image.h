@@ -0,0 +1,37 @@
+#ifndef _IMAGE_H_
+#define _IMAGE_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "sym.h"
+
+// 编译缓存中的镜像文件格式:
+// image_header | uint16_t words[words] (主机字节序) | struct symbol syms[nsyms]
+// 以源文件内容和工具链的哈希命名, 热启动时 mmap 后直接拷贝进客户机内存.
+#define IMAGE_MAGIC   0X4933434C  /* "LC3I" */
+#define IMAGE_VERSION 1
+
+struct image_header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t origin;
+    uint32_t words;
+    uint32_t nsyms;
+    uint32_t reserved;
+};
+
+// 默认的 lcc 安装目录, 可以用 LCC_PATH 环境变量覆盖
+#define IMAGE_LCC_PATH "/usr/local/bin/lcc-1.3/install"
+
+int is_little_endian(void);
+uint16_t swap16(uint16_t x);
+
+// 支持 .obj (同名 .sym 存在时一并加载), 以及 .c / .asm 源文件
+int read_image(const char* image_path);
+// 最近一次装入的镜像所占的地址范围
+void image_extent(uint16_t *origin, uint32_t *words);
+
+#endif
@@ -1,6 +1,11 @@
 #include "mem.h"
 #include "interrupt.h"
 #include "virtio.h"
+#include "vhost.h"
+
+// 待处理的中断属于执行它的 vCPU
+static __thread uint16_t int_vector;
+static __thread int int_priority;  /* 0 表示没有待处理的中断 */
 
 void int_handler(uint16_t entry)
 {
@@ -10,10 +15,65 @@ void int_handler(uint16_t entry)
     printf(">>> int entry: 0x%x \n", entry);
 
     if (entry == INTERRUPT_VIRTIO) {
+        if (vhost_active()) {
+            vhost_kick(entry);
+            return;
+        }
+
         flags = memory[entry];
         if (!virtio_handler(flags)) {
             virtio_replay();
         }
+    } else if (entry == INTERRUPT_VCONSOLE) {
+        flags = memory[entry];
+        if (!vconsole_handler(flags)) {
+            vconsole_replay();
+        }
+    }
+}
+
+void int_poll(uint16_t entry)
+{
+    if (entry == INTERRUPT_VIRTIO && vhost_active()) {
+        vhost_poll(entry);
+    } else if (entry == INTERRUPT_VCONSOLE) {
+        vconsole_poll();
     }
 }
 
+void int_raise(uint16_t vector, int priority)
+{
+    if (priority > int_priority) {
+        int_vector = vector;
+        int_priority = priority;
+    }
+}
+
+int int_pending()
+{
+    return int_priority;
+}
+
+uint16_t int_ack()
+{
+    int_priority = 0;
+    return int_vector;
+}
+
+void int_reset()
+{
+    int_vector = 0;
+    int_priority = 0;
+}
+
+void int_save(struct int_state *state)
+{
+    state->vector = int_vector;
+    state->priority = int_priority;
+}
+
+void int_load(const struct int_state *state)
+{
+    int_vector = state->vector;
+    int_priority = state->priority;
+}
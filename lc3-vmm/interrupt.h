@@ -6,6 +6,21 @@
 #include <stdlib.h>
 #include <unistd.h>
 
+struct int_state {
+    uint16_t vector;
+    int priority;
+};
+
 void int_handler(uint16_t entry);
+void int_poll(uint16_t entry);
+
+// 设备向 CPU 发起中断, vector 为中断向量表中的地址
+void int_raise(uint16_t vector, int priority);
+int int_pending();
+uint16_t int_ack();
+// 丢弃待处理的中断
+void int_reset();
+void int_save(struct int_state *state);
+void int_load(const struct int_state *state);
 
 #endif
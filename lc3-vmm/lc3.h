@@ -0,0 +1,80 @@
+#ifndef _LC3_H_
+#define _LC3_H_
+
+#include <stdint.h>
+
+// Registers
+// LC-3 共有 10 个寄存器, 每个都是 16 位, 大部分是通用寄存器.
+// - 8 个通用寄存器(R0-R7)
+// - 1 个程序计数器 (PC) 寄存器
+// - 1 个条件标志 (COND) 寄存器
+enum
+{
+    R_R0 = 0,
+    R_R1,
+    R_R2,
+    R_R3,
+    R_R4,
+    R_R5,
+    R_R6,
+    R_R7,
+    R_PC, /* program counter */
+    R_COND,
+    R_COUNT
+};
+
+// LC-3 有两个内存映射寄存器需要实现. 它们是键盘状态寄存器 (KBSR)
+// 和键盘数据寄存器 (KBDR). 键盘状态寄存器（KBSR）指示是否有按键被按下,
+// 键盘数据寄存器（KBDR）则识别被按下的按键。
+enum
+{
+    MR_KBSR = 0xFE00, /* keyboard status */
+    MR_KBDR = 0xFE02  /* keyboard data */
+};
+
+// TRAP 定义
+enum
+{
+    TRAP_GETC  = 0x20,  /* get character from keyboard, not echoed onto the terminal */
+    TRAP_OUT   = 0x21,  /* output a character */
+    TRAP_PUTS  = 0x22,  /* output a word string */
+    TRAP_IN    = 0x23,  /* get character from keyboard, echoed onto the terminal */
+    TRAP_PUTSP = 0x24,  /* output a byte string */
+    TRAP_HALT  = 0x25,  /* halt the program */
+    TRAP_GETS  = 0x26   /* read a line into a word buffer, echoed onto the terminal */
+};
+
+// Instruction set
+// LC-3 中只有 16 条指令, 每条指令长 16 位.
+// 左侧 4 位存储操作码, 其余位用于存储参数.
+enum
+{
+    OP_BR = 0, /* 0000 branch */
+    OP_ADD,    /* 0001 add  */
+    OP_LD,     /* 0010 load */
+    OP_ST,     /* 0011 store */
+    OP_JSR,    /* 0100 jump register */
+    OP_AND,    /* 0101 bitwise and */
+    OP_LDR,    /* 0110 load register */
+    OP_STR,    /* 0111 store register */
+    OP_RTI,    /* 1000 return from interrupt */
+    OP_NOT,    /* 1001 bitwise not */
+    OP_LDI,    /* 1010 load indirect */
+    OP_STI,    /* 1011 store indirect */
+    OP_JMP,    /* 1100 jump */
+    OP_RES,    /* 1101 reserved (unused) */
+    OP_LEA,    /* 1110 load effective address */
+    OP_TRAP    /* 1111 execute trap */
+};
+
+// Condition flags
+// R_COND 寄存器存储条件标志, 提供最近执行结果的信息.
+// 这样程序就可以执行逻辑/循环语句, 如 if (x > 0) { ... }.
+enum
+{
+    FL_POS = 1 << 0, /* P: positive (greater than zero) */
+    FL_ZRO = 1 << 1, /* Z: zero */
+    FL_NEG = 1 << 2, /* N: negative (smaller than zero) */
+};
+
+#endif
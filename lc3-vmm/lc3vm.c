@@ -0,0 +1,296 @@
+#include <string.h>
+#include <setjmp.h>
+
+#include "lc3.h"
+#include "cpu.h"
+#include "mem.h"
+#include "timer.h"
+#include "interrupt.h"
+#include "image.h"
+#include "chan.h"
+#include "perf.h"
+#include "lc3vm.h"
+
+#define LC3VM_MEMORY_BYTES (MEMORY_MAX * sizeof(uint16_t))
+
+struct lc3vm {
+    uint16_t *memory;
+    struct cpu_state cpu;
+    struct timer_state timer;
+    struct int_state intr;
+    struct perf_state perf;
+    struct lc3vm_ops ops;
+    void *opaque;
+    uint16_t io_start;
+    uint32_t io_size;
+    int fault;
+};
+
+// 换进全局状态的 VM, 以及换进之前的全局状态 (例如 lc3-vmm 自己的客户机)
+static lc3vm_t *lc3vm_current;
+
+static struct {
+    uint16_t *memory;
+    int fd;
+    struct cpu_state cpu;
+    struct timer_state timer;
+    struct int_state intr;
+    struct perf_state perf;
+    int (*trap_hook)(uint16_t trap);
+    int (*io_read_hook)(uint16_t address, uint16_t *val);
+    int (*io_write_hook)(uint16_t address, uint16_t val);
+    uint16_t io_start;
+    uint32_t io_size;
+    jmp_buf *fault_jmp;
+    int chan_nowait;
+} lc3vm_saved;
+
+static int lc3vm_trap_hook(uint16_t trap)
+{
+    lc3vm_t *vm = lc3vm_current;
+
+    return vm->ops.trap(vm, trap, vm->opaque);
+}
+
+static int lc3vm_io_read_hook(uint16_t address, uint16_t *val)
+{
+    lc3vm_t *vm = lc3vm_current;
+
+    return vm->ops.io_read ? vm->ops.io_read(vm, address, val, vm->opaque) : -1;
+}
+
+static int lc3vm_io_write_hook(uint16_t address, uint16_t val)
+{
+    lc3vm_t *vm = lc3vm_current;
+
+    return vm->ops.io_write ? vm->ops.io_write(vm, address, val, vm->opaque) : -1;
+}
+
+static void lc3vm_enter(lc3vm_t *vm)
+{
+    lc3vm_saved.memory = mem_addr();
+    lc3vm_saved.fd = mem_fd();
+    cpu_save(&lc3vm_saved.cpu);
+    timer_save(&lc3vm_saved.timer);
+    int_save(&lc3vm_saved.intr);
+    perf_save(&lc3vm_saved.perf);
+    lc3vm_saved.trap_hook = cpu_trap_hook;
+    lc3vm_saved.io_read_hook = cpu_io_read_hook;
+    lc3vm_saved.io_write_hook = cpu_io_write_hook;
+    lc3vm_saved.io_start = cpu_io_start;
+    lc3vm_saved.io_size = cpu_io_size;
+    lc3vm_saved.fault_jmp = cpu_fault_jmp;
+    lc3vm_saved.chan_nowait = chan_nowait;
+
+    mem_switch(vm->memory, -1);
+    cpu_load(&vm->cpu);
+    timer_load(&vm->timer);
+    int_load(&vm->intr);
+    perf_load(&vm->perf);
+    cpu_trap_hook = vm->ops.trap ? lc3vm_trap_hook : NULL;
+    cpu_io_read_hook = lc3vm_io_read_hook;
+    cpu_io_write_hook = lc3vm_io_write_hook;
+    cpu_io_start = vm->io_start;
+    cpu_io_size = vm->io_size;
+    chan_nowait = 1;
+    lc3vm_current = vm;
+}
+
+static void lc3vm_leave(lc3vm_t *vm)
+{
+    cpu_save(&vm->cpu);
+    timer_save(&vm->timer);
+    int_save(&vm->intr);
+    perf_save(&vm->perf);
+
+    mem_switch(lc3vm_saved.memory, lc3vm_saved.fd);
+    cpu_load(&lc3vm_saved.cpu);
+    timer_load(&lc3vm_saved.timer);
+    int_load(&lc3vm_saved.intr);
+    perf_load(&lc3vm_saved.perf);
+    cpu_trap_hook = lc3vm_saved.trap_hook;
+    cpu_io_read_hook = lc3vm_saved.io_read_hook;
+    cpu_io_write_hook = lc3vm_saved.io_write_hook;
+    cpu_io_start = lc3vm_saved.io_start;
+    cpu_io_size = lc3vm_saved.io_size;
+    cpu_fault_jmp = lc3vm_saved.fault_jmp;
+    chan_nowait = lc3vm_saved.chan_nowait;
+    lc3vm_current = NULL;
+}
+
+lc3vm_t *lc3vm_create(const struct lc3vm_ops *ops, void *opaque)
+{
+    lc3vm_t *vm = calloc(1, sizeof(*vm));
+
+    if (!vm)
+        return NULL;
+
+    // 匿名映射按需分配物理页, 只装入小程序的 VM 不会占满 128KB
+    vm->memory = mmap(NULL, LC3VM_MEMORY_BYTES, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (vm->memory == MAP_FAILED) {
+        free(vm);
+        return NULL;
+    }
+    if (ops)
+        vm->ops = *ops;
+    vm->opaque = opaque;
+
+    lc3vm_reset(vm, 0x3000);
+    return vm;
+}
+
+void lc3vm_destroy(lc3vm_t *vm)
+{
+    if (!vm || vm == lc3vm_current)
+        return;
+    munmap(vm->memory, LC3VM_MEMORY_BYTES);
+    free(vm);
+}
+
+uint32_t lc3vm_load(lc3vm_t *vm, const void *buf, size_t len)
+{
+    const uint8_t *p = buf;
+    uint16_t origin;
+    uint32_t words, i;
+
+    if (len < 2)
+        return 0;
+
+    origin = (p[0] << 8) | p[1];
+    words = (len - 2) / 2;
+    if (words > MEMORY_MAX - origin)
+        words = MEMORY_MAX - origin;
+
+    p += 2;
+    for (i = 0; i < words; i++) {
+        vm->memory[origin + i] = (p[2 * i] << 8) | p[2 * i + 1];
+    }
+    return words;
+}
+
+uint32_t lc3vm_load_file(lc3vm_t *vm, const char *path)
+{
+    uint16_t origin = 0;
+    uint32_t words = 0;
+
+    lc3vm_enter(vm);
+    if (read_image(path))
+        image_extent(&origin, &words);
+    lc3vm_leave(vm);
+    return words;
+}
+
+void lc3vm_reset(lc3vm_t *vm, uint16_t pc)
+{
+    struct cpu_state state;
+
+    memset(&state, 0, sizeof(state));
+    state.saved_ssp = 0x3000;
+
+    lc3vm_enter(vm);
+    cpu_load(&state);
+    cpu_reset(pc);
+    timer_init();
+    int_reset();
+    lc3vm_leave(vm);
+    vm->fault = 0;
+}
+
+int lc3vm_run(lc3vm_t *vm, uint64_t budget)
+{
+    jmp_buf fault_jmp;
+    int ret, fault;
+
+    if (lc3vm_current)
+        return LC3VM_FAULT;  /* 在回调中不能再运行 VM */
+
+    lc3vm_enter(vm);
+    cpu_fault_jmp = &fault_jmp;
+    fault = setjmp(fault_jmp);
+    if (fault) {
+        vm->fault = fault;
+        ret = LC3VM_FAULT;
+    } else {
+        switch (cpu_run_budget(budget)) {
+            case 0:
+                ret = LC3VM_HALT;
+                break;
+            case CPU_YIELD:
+                ret = LC3VM_WAIT;
+                break;
+            default:
+                ret = LC3VM_BUDGET;
+                break;
+        }
+    }
+    lc3vm_leave(vm);
+    return ret;
+}
+
+int lc3vm_fault(lc3vm_t *vm)
+{
+    return vm->fault;
+}
+
+uint64_t lc3vm_icount(lc3vm_t *vm)
+{
+    if (vm == lc3vm_current)
+        return cpu_icount();
+    return vm->cpu.icount + (uint16_t)(vm->cpu.reg[R_PC] - vm->cpu.block_start);
+}
+
+// 运行期间寄存器在全局的 reg 中
+uint16_t lc3vm_get_reg(lc3vm_t *vm, int r)
+{
+    if (r < 0 || r >= R_COUNT)
+        return 0;
+    return vm == lc3vm_current ? reg[r] : vm->cpu.reg[r];
+}
+
+void lc3vm_set_reg(lc3vm_t *vm, int r, uint16_t val)
+{
+    if (r < 0 || r >= R_COUNT)
+        return;
+    if (vm == lc3vm_current)
+        reg[r] = val;
+    else
+        vm->cpu.reg[r] = val;
+}
+
+uint16_t lc3vm_read(lc3vm_t *vm, uint16_t address)
+{
+    return vm->memory[address];
+}
+
+void lc3vm_write(lc3vm_t *vm, uint16_t address, uint16_t val)
+{
+    vm->memory[address] = val;
+}
+
+uint16_t *lc3vm_memory(lc3vm_t *vm)
+{
+    return vm->memory;
+}
+
+void lc3vm_map_io(lc3vm_t *vm, uint16_t start, uint32_t size)
+{
+    if (size > MEMORY_MAX - start)
+        size = MEMORY_MAX - start;
+    vm->io_start = start;
+    vm->io_size = size;
+    if (vm == lc3vm_current) {
+        cpu_io_start = start;
+        cpu_io_size = size;
+    }
+}
+
+int lc3vm_attach_chan(lc3vm_t *vm, const char *path)
+{
+    return chan_attach(vm->memory, path);
+}
+
+void *lc3vm_opaque(lc3vm_t *vm)
+{
+    return vm->opaque;
+}
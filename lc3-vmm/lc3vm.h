@@ -0,0 +1,76 @@
+#ifndef _LC3VM_H_
+#define _LC3VM_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "lc3.h"
+
+// liblc3vm: 在宿主进程内创建和运行 LC-3 虚拟机, 不需要 fork/exec lc3-vmm.
+//
+//   lc3vm_t *vm = lc3vm_create(&ops, ctx);
+//   lc3vm_load(vm, obj, len);
+//   lc3vm_reset(vm, 0x3000);
+//   while (lc3vm_run(vm, 100000) == LC3VM_BUDGET) { ... }
+//   lc3vm_destroy(vm);
+//
+// 每个 VM 有自己的内存, 寄存器, 定时器和中断状态. 解释器使用全局状态, lc3vm_run 期间
+// 把 VM 的状态换进去, 返回时换出, 所以可以创建任意多个 VM 交替运行,
+// 但同一时刻只能有一个 VM 在运行 (不能在多个线程中同时调用 lc3vm_run).
+//
+// 内置的设备中只有定时器, 中断和通道可用; vconsole, vhost, 扩展内存和调试桩属于 lc3-vmm 进程本身.
+// 没有设置回调时 TRAP 的输入输出使用宿主进程的 stdin/stdout.
+
+typedef struct lc3vm lc3vm_t;
+
+enum lc3vm_stop {
+    LC3VM_HALT,    /* 执行了 HALT, 或 trap 回调返回 0 */
+    LC3VM_BUDGET,  /* 执行完 budget 条指令 */
+    LC3VM_FAULT,   /* 保留的操作码或用户态 RTI, 原因见 lc3vm_fault */
+    LC3VM_WAIT,    /* 客户机在等待通道, 应先运行通道另一端的 VM */
+};
+
+struct lc3vm_ops {
+    // TRAP 指令, R7 已保存返回地址. 返回 0 停机, 大于 0 继续, 小于 0 交给内置的实现
+    int (*trap)(lc3vm_t *vm, uint16_t trap, void *opaque);
+    // lc3vm_map_io 区间内的读写. 返回 0 表示已处理, 否则按普通内存和内置设备处理
+    int (*io_read)(lc3vm_t *vm, uint16_t address, uint16_t *val, void *opaque);
+    int (*io_write)(lc3vm_t *vm, uint16_t address, uint16_t val, void *opaque);
+};
+
+// ops 会被复制, 可以为 NULL. 返回 NULL 表示失败
+lc3vm_t *lc3vm_create(const struct lc3vm_ops *ops, void *opaque);
+void lc3vm_destroy(lc3vm_t *vm);
+
+// 装入 .obj 格式的镜像 (大端, 第一个字为起始地址), 返回装入的字数, 0 表示失败
+uint32_t lc3vm_load(lc3vm_t *vm, const void *buf, size_t len);
+// 从文件装入, 同 lc3-vmm: .obj, 或经编译缓存的 .c / .asm
+uint32_t lc3vm_load_file(lc3vm_t *vm, const char *path);
+
+// 寄存器回到初始状态, PC 为 pc; 丢弃待处理的中断, 停止定时器. 内存不变
+void lc3vm_reset(lc3vm_t *vm, uint16_t pc);
+// 最多执行 budget 条指令, 返回 LC3VM_*. 停机后再次调用从 HALT 的下一条指令继续
+int lc3vm_run(lc3vm_t *vm, uint64_t budget);
+// 最近一次 LC3VM_FAULT 的原因, CPU_FAULT_* (cpu.h)
+int lc3vm_fault(lc3vm_t *vm);
+uint64_t lc3vm_icount(lc3vm_t *vm);
+
+// 直接访问寄存器 (R_R0 .. R_COND) 和内存, 不经过设备. 可以在回调中使用
+uint16_t lc3vm_get_reg(lc3vm_t *vm, int r);
+void lc3vm_set_reg(lc3vm_t *vm, int r, uint16_t val);
+uint16_t lc3vm_read(lc3vm_t *vm, uint16_t address);
+void lc3vm_write(lc3vm_t *vm, uint16_t address, uint16_t val);
+// MEMORY_MAX 个字
+uint16_t *lc3vm_memory(lc3vm_t *vm);
+
+// [start, start + size) 内的访存交给 io_read/io_write 回调, size 为 0 时取消
+void lc3vm_map_io(lc3vm_t *vm, uint16_t start, uint32_t size);
+
+// 把通道文件映射到 VM 的 xF000 − xF7FF (见 chan.h), 映射同一文件的 VM 可以通过其中的队列通信.
+// 同一进程内等待通道时不睡眠, lc3vm_run 返回 LC3VM_WAIT. 返回 -1 表示失败
+int lc3vm_attach_chan(lc3vm_t *vm, const char *path);
+
+void *lc3vm_opaque(lc3vm_t *vm);
+
+#endif
@@ -9,233 +9,333 @@
 #include <sys/types.h>
 #include <sys/termios.h>
 #include <sys/mman.h>
+#include <string.h>
 
+#include "lc3.h"
+#include "cpu.h"
 #include "mem.h"
 #include "virtio.h"
+#include "vhost.h"
 #include "interrupt.h"
+#include "timer.h"
+#include "bank.h"
+#include "disk.h"
+#include "image.h"
+#include "batch.h"
+#include "fuzz.h"
+#include "difftest.h"
+#include "gdb.h"
+#include "memprof.h"
+#include "sample.h"
+#include "dedup.h"
+#include "smp.h"
+#include "chan.h"
+#include "migrate.h"
 
-// Registers
-// LC-3 共有 10 个寄存器, 每个都是 16 位, 大部分是通用寄存器.
-// - 8 个通用寄存器(R0-R7)
-// - 1 个程序计数器 (PC) 寄存器
-// - 1 个条件标志 (COND) 寄存器
-enum
-{
-    R_R0 = 0,
-    R_R1,
-    R_R2,
-    R_R3,
-    R_R4,
-    R_R5,
-    R_R6,
-    R_R7,
-    R_PC, /* program counter */
-    R_COND,
-    R_COUNT
-};
-
-// LC-3 有两个内存映射寄存器需要实现. 它们是键盘状态寄存器 (KBSR)
-// 和键盘数据寄存器 (KBDR). 键盘状态寄存器（KBSR）指示是否有按键被按下,
-// 键盘数据寄存器（KBDR）则识别被按下的按键。
-enum
+void handle_interrupt(int signal)
 {
-    MR_KBSR = 0xFE00, /* keyboard status */
-    MR_KBDR = 0xFE02  /* keyboard data */
-};
+    restore_input_buffering();
+    printf("\n");
+    exit(-2);
+}
 
-// TRAP 定义
-enum
-{
-    TRAP_GETC  = 0x20,  /* get character from keyboard, not echoed onto the terminal */
-    TRAP_OUT   = 0x21,  /* output a character */
-    TRAP_PUTS  = 0x22,  /* output a word string */
-    TRAP_IN    = 0x23,  /* get character from keyboard, echoed onto the terminal */
-    TRAP_PUTSP = 0x24,  /* output a byte string */
-    TRAP_HALT  = 0x25   /* halt the program */
-};
-
-// Register Storage
-uint16_t reg[R_COUNT];
-
-// Instruction set
-// LC-3 中只有 16 条指令, 每条指令长 16 位.
-// 左侧 4 位存储操作码, 其余位用于存储参数.
-enum
+void handle_migrate(int signal)
 {
-    OP_BR = 0, /* 0000 branch */
-    OP_ADD,    /* 0001 add  */
-    OP_LD,     /* 0010 load */
-    OP_ST,     /* 0011 store */
-    OP_JSR,    /* 0100 jump register */
-    OP_AND,    /* 0101 bitwise and */
-    OP_LDR,    /* 0110 load register */
-    OP_STR,    /* 0111 store register */
-    OP_RTI,    /* 1000 unused */
-    OP_NOT,    /* 1001 bitwise not */
-    OP_LDI,    /* 1010 load indirect */
-    OP_STI,    /* 1011 store indirect */
-    OP_JMP,    /* 1100 jump */
-    OP_RES,    /* 1101 reserved (unused) */
-    OP_LEA,    /* 1110 load effective address */
-    OP_TRAP    /* 1111 execute trap */
-};
-
-// Condition flags
-// R_COND 寄存器存储条件标志, 提供最近执行结果的信息.
-// 这样程序就可以执行逻辑/循环语句, 如 if (x > 0) { ... }.
-enum
-{
-    FL_POS = 1 << 0, /* P: positive (greater than zero) */
-    FL_ZRO = 1 << 1, /* Z: zero */
-    FL_NEG = 1 << 2, /* N: negative (smaller than zero) */
-};
-
-// 带符号的数值扩展
-// 最高位正数填充0, 负数填充1, 以便保留原始值
-uint16_t sign_extend(uint16_t x, int bit_count)
+    migrate_request();
+}
+
+void usage()
 {
-    if ((x >> (bit_count - 1)) & 1) {
-        x |= (0xFFFF << bit_count);
-    }
-    return x;
+    printf("Using: main.out [options] [image-file1] ...\n");
+    printf("  image-file may be an .obj, or a .c / .asm source compiled through the image cache\n");
+    printf("  --vhost <socket>          use an out-of-process virtio backend\n");
+    printf("  --vhost-backend <socket>  run as virtio backend, serving VMMs on socket\n");
+    printf("  --console <socket|fifo>   host side of the virtio console device\n");
+    printf("  --gdb <port|socket>       wait for a GDB remote protocol client before running\n");
+    printf("  --banks <n>               n banks of extended memory behind the xC000-xDFFF window\n");
+    printf("  --bank-file <file>        back the extended memory with file (sized by --banks or the file)\n");
+    printf("  --disk <file>             back the virtio block device with file\n");
+    printf("  --disk-cache <pages>      host page cache size for --disk, %d words per page (default %d)\n",
+            DISK_PAGE_WORDS, DISK_CACHE_PAGES);
+    printf("  --disk-writeback <ms>     write-back interval for --disk, 0 for write-through (default %d)\n",
+            DISK_WRITEBACK_MS);
+    printf("  --memprof <prefix>        count data accesses per address and per PC, write <prefix>.csv,\n");
+    printf("                            <prefix>.pc.csv and a <prefix>.ppm heatmap at exit\n");
+    printf("  --memprof-cache <w,l,a>   also simulate a cache of w words, l-word lines, a ways (default %d,%d,%d)\n",
+            MEMPROF_CACHE_WORDS, MEMPROF_CACHE_LINE, MEMPROF_CACHE_WAYS);
+    printf("  --sample <prefix>         sample the guest PC and call stack, write <prefix>.txt and\n");
+    printf("                            <prefix>.folded (flame graph input) at exit\n");
+    printf("  --sample-us <n>           sampling interval in microseconds (default %d)\n",
+            SAMPLE_US);
+    printf("  --smp <n>                 n virtual CPUs (up to %d) sharing memory, one host thread each\n", SMP_MAX);
+    printf("  --chan <file>             map the shared channel page in file at xF000-xF7FF (created if missing)\n");
+    printf("  --dedup <file>            share identical pages with other VMs through the page pool in file\n");
+    printf("  --migrate-to <socket|fifo> live-migrate the running guest on SIGUSR1 or --migrate-at\n");
+    printf("  --migrate-at <n>          start migrating after n instructions\n");
+    printf("  --migrate-from <socket|fifo> receive a migrated guest instead of loading an image\n");
+    printf("  --batch <input1> ...      run one guest per input file in lockstep, output to <input>.out\n");
+    printf("  --fuzz [input1] ...       snapshot after load and run each input from it, with edge coverage;\n");
+    printf("                            under afl-fuzz acts as a persistent fork server\n");
+    printf("  --difftest [case1] ...    compare the reference and batch interpreters on random programs,\n");
+    printf("                            or replay saved cases; no image file\n");
+    printf("  --difftest-cases <n>      number of random cases (default %d)\n", DIFFTEST_CASES);
+    printf("  --difftest-seed <n>       seed for the random cases (default 1)\n");
+    printf("  --difftest-corpus <dir>   where minimized failing cases are written (default %s)\n",
+            DIFFTEST_CORPUS);
 }
 
-int is_little_endian(void) {
-	union {
-		char c;
-		int i;
-	} un;
+int main(int argc, const char* argv[])
+{
+    int ret = 0;
+    int i;
+    const char *image = NULL;
+    const char *vhost_path = NULL;
+    const char *vhost_backend_path = NULL;
+    const char *console_path = NULL;
+    const char *gdb_spec = NULL;
+    const char *bank_path = NULL;
+    unsigned nbanks = 0;
+    const char *disk_path = NULL;
+    int disk_pages = 0, disk_writeback = -1;
+    const char *memprof_path = NULL;
+    const char *memprof_cache = NULL;
+    const char *sample_path = NULL;
+    unsigned sample_us = 0;
+    int ncpus = 1;
+    const char *chan_path = NULL;
+    const char *dedup_path = NULL;
+    const char *migrate_to = NULL, *migrate_from = NULL;
+    uint64_t migrate_at = 0;
+    const char **inputs = NULL;
+    int batch = 0, fuzz = 0, ninputs = 0;
+    int difftest = 0;
+    unsigned difftest_cases = DIFFTEST_CASES, difftest_seed = 1;
+    const char *difftest_corpus = DIFFTEST_CORPUS;
 
-	un.i = 1;
+    // Load Arguments
+    for (i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--vhost") && i + 1 < argc) {
+            vhost_path = argv[++i];
+        } else if (!strcmp(argv[i], "--vhost-backend") && i + 1 < argc) {
+            vhost_backend_path = argv[++i];
+        } else if (!strcmp(argv[i], "--console") && i + 1 < argc) {
+            console_path = argv[++i];
+        } else if (!strcmp(argv[i], "--gdb") && i + 1 < argc) {
+            gdb_spec = argv[++i];
+        } else if (!strcmp(argv[i], "--banks") && i + 1 < argc) {
+            nbanks = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--bank-file") && i + 1 < argc) {
+            bank_path = argv[++i];
+        } else if (!strcmp(argv[i], "--disk") && i + 1 < argc) {
+            disk_path = argv[++i];
+        } else if (!strcmp(argv[i], "--disk-cache") && i + 1 < argc) {
+            disk_pages = strtol(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--disk-writeback") && i + 1 < argc) {
+            disk_writeback = strtol(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--memprof") && i + 1 < argc) {
+            memprof_path = argv[++i];
+        } else if (!strcmp(argv[i], "--memprof-cache") && i + 1 < argc) {
+            memprof_cache = argv[++i];
+        } else if (!strcmp(argv[i], "--sample") && i + 1 < argc) {
+            sample_path = argv[++i];
+        } else if (!strcmp(argv[i], "--sample-us") && i + 1 < argc) {
+            sample_us = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--smp") && i + 1 < argc) {
+            ncpus = strtol(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--chan") && i + 1 < argc) {
+            chan_path = argv[++i];
+        } else if (!strcmp(argv[i], "--dedup") && i + 1 < argc) {
+            dedup_path = argv[++i];
+        } else if (!strcmp(argv[i], "--migrate-to") && i + 1 < argc) {
+            migrate_to = argv[++i];
+        } else if (!strcmp(argv[i], "--migrate-at") && i + 1 < argc) {
+            migrate_at = strtoull(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--migrate-from") && i + 1 < argc) {
+            migrate_from = argv[++i];
+        } else if (!strcmp(argv[i], "--batch")) {
+            batch = 1;
+        } else if (!strcmp(argv[i], "--fuzz")) {
+            fuzz = 1;
+        } else if (!strcmp(argv[i], "--difftest")) {
+            difftest = 1;
+        } else if (!strcmp(argv[i], "--difftest-cases") && i + 1 < argc) {
+            difftest_cases = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--difftest-seed") && i + 1 < argc) {
+            difftest_seed = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--difftest-corpus") && i + 1 < argc) {
+            difftest_corpus = argv[++i];
+        } else if (argv[i][0] == '-' && argv[i][1] == '-') {
+            usage();
+            return 2;
+        } else if (!image && !difftest) {
+            image = argv[i];
+        } else if (batch || fuzz || difftest) {
+            if (!inputs)
+                inputs = calloc(argc, sizeof(char *));
+            inputs[ninputs++] = argv[i];
+        }
+    }
 
-    // 如果是小端则返回 1，如果是大端则返回 0
-	return un.c;
-}
+    if (vhost_backend_path) {
+        // 后端进程处理块请求, 磁盘由它打开
+        if (disk_path && disk_open(disk_path, disk_pages, disk_writeback) < 0) {
+            printf("failed to open disk: %s\n", disk_path);
+            return 1;
+        }
+        ret = vhost_backend_run(vhost_backend_path);
+        disk_close();
+        if (ret < 0) {
+            printf("failed to start vhost backend: %s\n", vhost_backend_path);
+            return 1;
+        }
+        return 0;
+    }
 
-// LC-3 程序是大端程序, 如果是小端程序则需要交换高低字节
-uint16_t swap16(uint16_t x)
-{
-    return (x << 8) | (x >> 8);
-}
+    // 差分测试不装入镜像, 用例自带代码和数据
+    if (difftest) {
+        ret = difftest_run(inputs, ninputs, difftest_cases, difftest_seed, difftest_corpus);
+        return ret ? 1 : 0;
+    }
 
-void update_flags(uint16_t r)
-{
-    if (reg[r] == 0) {
-        reg[R_COND] = FL_ZRO;
-    } else if (reg[r] >> 15) { // 最左边的位为 1 表示负数
-        reg[R_COND] = FL_NEG;
-    } else {
-        reg[R_COND] = FL_POS;
+    // 迁移的目的端不装入镜像, 内存从源端接收
+    if (!image && !migrate_from) {
+        /* show usage string */
+        usage();
+        ret = 2;
+        goto exit;
     }
-}
 
-void mem_write(uint16_t address, uint16_t val)
-{
-    mem_set(address, val);
+    // 迁移只传送客户机内存和单个 CPU 的状态
+    if ((migrate_to || migrate_from) &&
+            (ncpus > 1 || nbanks || bank_path || chan_path || vhost_path || gdb_spec)) {
+        printf("--migrate-to/--migrate-from cannot be used with --smp, --banks, --chan, --vhost or --gdb\n");
+        ret = 1;
+        goto exit;
+    }
 
-    if (address >= INTERRUPT_START && address <= INTERRUPT_END) {
-        int_handler(address);
+    // 后端直接映射 memfd, 看不到池中的页
+    if (dedup_path && vhost_path) {
+        printf("--dedup cannot be used with --vhost\n");
+        ret = 1;
+        goto exit;
     }
 
-}
+    mem_init();
+    // 目的端的 virtio 队列随内存一起接收
+    if (!migrate_from)
+        virtio_init();
+    timer_init();
+    mem_sync();
 
-struct termios original_tio;
+    if ((nbanks || bank_path) && bank_init(bank_path, nbanks) < 0) {
+        printf("failed to set up extended memory: %s\n", bank_path ? bank_path : "memfd");
+        ret = 1;
+        goto exit;
+    }
 
-void disable_input_buffering()
-{
-    tcgetattr(STDIN_FILENO, &original_tio);
-    struct termios new_tio = original_tio;
-    new_tio.c_lflag &= ~ICANON & ~ECHO;
-    tcsetattr(STDIN_FILENO, TCSANOW, &new_tio);
-}
+    if (disk_path && disk_open(disk_path, disk_pages, disk_writeback) < 0) {
+        printf("failed to open disk: %s\n", disk_path);
+        ret = 1;
+        goto exit;
+    }
 
-void restore_input_buffering()
-{
-    tcsetattr(STDIN_FILENO, TCSANOW, &original_tio);
-}
+    if (chan_path && chan_attach(mem_addr(), chan_path) < 0) {
+        printf("failed to map channel: %s\n", chan_path);
+        ret = 1;
+        goto exit;
+    }
 
-uint16_t check_key()
-{
-    fd_set readfds;
-    FD_ZERO(&readfds);
-    FD_SET(STDIN_FILENO, &readfds);
-
-    struct timeval timeout;
-    timeout.tv_sec = 0;
-    timeout.tv_usec = 0;
-    return select(1, &readfds, NULL, NULL, &timeout) != 0;
-}
+    if (vconsole_init(console_path) < 0) {
+        printf("failed to open console: %s\n", console_path);
+        ret = 1;
+        goto exit;
+    }
 
-uint16_t mem_read(uint16_t address)
-{
-    if (address == MR_KBSR) {
-        if (check_key()) {
-            mem_set(MR_KBSR, 1 << 15);
-            mem_set(MR_KBDR, getchar());
-        } else {
-            mem_set(MR_KBDR, 0);
-        }
+    if (vhost_path && vhost_connect(vhost_path) < 0) {
+        printf("failed to connect vhost backend: %s\n", vhost_path);
+        ret = 1;
+        goto exit;
     }
-    return mem_get(address);
-}
 
-void read_image_file(FILE* file)
-{
-    uint16_t origin;
-    fread(&origin, sizeof(origin), 1, file);
-    if (is_little_endian()) {
-        origin = swap16(origin);
+    if (!migrate_from && !read_image(image)) {
+        printf("failed to load image: %s\n", image);
+        ret = 1;
+        goto exit;
     }
 
-    uint16_t max_read = MEMORY_MAX - origin;
-    uint16_t* p = mem_addr() + origin;
-    size_t read = fread(p, sizeof(uint16_t), max_read, file);
+    // 批量模式: 每个输入文件一个客户机, 不进入下面的单机循环
+    if (batch) {
+        if (ninputs == 0 || batch_run(inputs, ninputs) < 0) {
+            ret = 1;
+        }
+        goto exit;
+    }
 
-    if (is_little_endian()) {
-        while (read-- > 0) {
-            *p = swap16(*p);
-            ++p;
+    if (fuzz) {
+        if (fuzz_run(inputs, ninputs) < 0) {
+            ret = 1;
         }
+        goto exit;
     }
-}
 
-int read_image(const char* image_path)
-{
-    FILE* file = fopen(image_path, "rb");
-    if (!file) {
-        return 0;
+    // 设置 PC 起始位置 0x3000
+    enum { PC_START = 0x3000 };
+    cpu_reset(PC_START);
+
+    if (migrate_from) {
+        ret = migrate_receive(migrate_from);
+        if (ret < 0) {
+            printf("failed to receive guest from %s\n", migrate_from);
+            ret = 1;
+            goto exit;
+        }
+        // 源端在预拷贝期间已执行完客户机
+        if (ret > 0) {
+            ret = 0;
+            goto exit;
+        }
     }
 
-    read_image_file(file);
-    fclose(file);
-    return 1;
-}
+    if (dedup_path) {
+        // 映射了别的文件的窗口
+        if (nbanks || bank_path)
+            dedup_exclude(BANK_WINDOW_START, BANK_WINDOW_WORDS);
+        if (chan_path)
+            dedup_exclude(CHAN_WINDOW, CHAN_WORDS);
+        if (dedup_init(dedup_path) < 0) {
+            printf("failed to open page pool: %s\n", dedup_path);
+            ret = 1;
+            goto exit;
+        }
+    }
 
+    if (memprof_path && memprof_init(memprof_path, memprof_cache) < 0) {
+        printf("bad --memprof-cache: %s\n", memprof_cache);
+        ret = 1;
+        goto exit;
+    }
 
-void handle_interrupt(int signal)
-{
-    restore_input_buffering();
-    printf("\n");
-    exit(-2);
-}
+    if (sample_path && sample_init(sample_path, sample_us) < 0) {
+        printf("failed to start the sampling timer\n");
+        ret = 1;
+        goto exit;
+    }
 
-int main(int argc, const char* argv[])
-{
-    int ret = 0;
-    // Load Arguments
-    if (argc < 2) {
-        /* show usage string */
-        printf("Using: main.out [image-file1] ...\n");
-        ret = 2;
+    // 调试桩只跟踪 CPU 0
+    if (ncpus > 1 && gdb_spec) {
+        printf("--smp cannot be used with --gdb\n");
+        ret = 1;
         goto exit;
     }
 
-    mem_init();
-    virtio_init();
-    mem_sync();
+    if (smp_init(ncpus) < 0) {
+        printf("bad --smp: %d (1 - %d)\n", ncpus, SMP_MAX);
+        ret = 1;
+        goto exit;
+    }
 
-    if (!read_image(argv[1])) {
-        printf("failed to load image: %s\n", argv[1]);
+    if (gdb_spec && gdb_init(gdb_spec) < 0) {
+        printf("failed to listen for gdb on %s\n", gdb_spec);
         ret = 1;
         goto exit;
     }
@@ -243,227 +343,31 @@ int main(int argc, const char* argv[])
     signal(SIGINT, handle_interrupt);
     disable_input_buffering();
 
-
-    // 条件标志清零, 设置 Z(zero) 标志
-    reg[R_COND] = FL_ZRO;
-
-    // 设置 PC 起始位置 0x3000
-    enum { PC_START = 0x3000 };
-    reg[R_PC] = PC_START;
-
-    int running = 1;
-    while (running) {
-        // FETCH 取指令
-        uint16_t instr = mem_read(reg[R_PC]++);
-        uint16_t op = instr >> 12; /* 左移12位, 取操作码 */
-
-        // printf(">>> op: 0x%x\n", op);
-        switch (op) {
-            // 两个变量相加（+）
-            // ADD DR,SR1,SR2 或者 ADD DR,SR1,imm
-            case OP_ADD:
-                {
-                    // 目的寄存器 (DR)
-                    uint16_t r0 = (instr >> 9) & 0x7;
-                    // 源寄存器1 (SR1)
-                    uint16_t r1 = (instr >> 6) & 0x7;
-                    // 立即数标志
-                    uint16_t imm_flag = (instr >> 5) & 0x1;
-
-                    if (imm_flag == 0) {
-                        uint16_t r2 = instr & 0x7;
-                        reg[r0] = reg[r1] + reg[r2];
-                    } else {
-                        uint16_t imm5 = sign_extend(instr & 0x1F, 5);
-                        reg[r0] = reg[r1] + imm5;
-                    }
-                    update_flags(r0);
-                }
-                break;
-            case OP_AND:
-                {
-                    uint16_t r0 = (instr >> 9) & 0x7;
-                    uint16_t r1 = (instr >> 6) & 0x7;
-                    uint16_t imm_flag = (instr >> 5) & 0x1;
-
-                    if (imm_flag) {
-                        uint16_t imm5 = sign_extend(instr & 0x1F, 5);
-                        reg[r0] = reg[r1] & imm5;
-                    } else {
-                        uint16_t r2 = instr & 0x7;
-                        reg[r0] = reg[r1] & reg[r2];
-                    }
-                    update_flags(r0);
-                }
-                break;
-            case OP_NOT:
-                {
-                    uint16_t r0 = (instr >> 9) & 0x7;
-                    uint16_t r1 = (instr >> 6) & 0x7;
-
-                    reg[r0] = ~reg[r1];
-                    update_flags(r0);
-                }
-                break;
-            case OP_BR:
-                {
-                    uint16_t n_flag = (instr >> 11) & 0x1;
-                    uint16_t z_flag = (instr >> 10) & 0x1;
-                    uint16_t p_flag = (instr >> 9) & 0x1;
-                    uint16_t pc_offset = sign_extend(instr & 0x1FF, 9);
-
-                    if ((n_flag && (reg[R_COND] & FL_NEG)) ||
-                            (z_flag && (reg[R_COND] & FL_ZRO)) ||
-                            (p_flag && (reg[R_COND] & FL_POS))) {
-                        reg[R_PC] += pc_offset;
-                    }
-                }
-                break;
-            case OP_JMP:
-                {
-                    uint16_t r1 = (instr >> 6) & 0x7;
-                    reg[R_PC] = reg[r1];
-                }
-                break;
-            case OP_JSR:
-                {
-                    uint16_t long_flag = (instr >> 11) & 1;
-                    if (long_flag) {
-                        reg[R_R7] = reg[R_PC];
-                        uint16_t long_pc_offset = sign_extend(instr & 0x7FF, 11);
-                        reg[R_PC] += long_pc_offset;  /* JSR 直接跳转 */
-                    } else {
-                        uint16_t tmp = reg[(instr >> 6) & 0x7];
-                        reg[R_R7] = reg[R_PC];
-                        reg[R_PC] = tmp; /* JSRR 寄存器间接跳转 */
-                    }
-                }
-                break;
-            case OP_LD:
-                {
-                    uint16_t r0 = (instr >> 9) & 0x7;
-                    uint16_t pc_offset = sign_extend(instr & 0x1FF, 9);
-                    reg[r0] = mem_read(reg[R_PC] + pc_offset);
-                    update_flags(r0);
-                }
-                break;
-            case OP_LDI:
-                {
-                    // 目的寄存器 (DR)
-                    uint16_t r0 = (instr >> 9) & 0x7;
-                    // PC偏移 9bit
-                    uint16_t pc_offset = sign_extend(instr & 0x1FF, 9);
-                    // 将 pc_offset 加到 PC 上, 然后查看该内存位置获取最终地址
-                    reg[r0] = mem_read(mem_read(reg[R_PC] + pc_offset));
-                    update_flags(r0);
-                }
-                break;
-            case OP_LDR:
-                {
-                    uint16_t r0 = (instr >> 9) & 0x7;
-                    uint16_t r1 = (instr >> 6) & 0x7;
-                    uint16_t offset = sign_extend(instr & 0x3F, 6);
-                    reg[r0] = mem_read(reg[r1] + offset);
-                    update_flags(r0);
-                }
-                break;
-            case OP_LEA:
-                {
-                    uint16_t r0 = (instr >> 9) & 0x7;
-                    uint16_t pc_offset = sign_extend(instr & 0x1FF, 9);
-                    reg[r0] = reg[R_PC] + pc_offset;
-                    update_flags(r0);
-                }
-                break;
-            case OP_ST:
-                {
-                    uint16_t r0 = (instr >> 9) & 0x7;
-                    uint16_t pc_offset = sign_extend(instr & 0x1FF, 9);
-                    mem_write(reg[R_PC] + pc_offset, reg[r0]);
-                }
-                break;
-            case OP_STI:
-                {
-                    uint16_t r0 = (instr >> 9) & 0x7;
-                    uint16_t pc_offset = sign_extend(instr & 0x1FF, 9);
-                    mem_write(mem_read(reg[R_PC] + pc_offset), reg[r0]);
-                }
-                break;
-            case OP_STR:
-                {
-                    uint16_t r0 = (instr >> 9) & 0x7;
-                    uint16_t r1 = (instr >> 6) & 0x7;
-                    uint16_t offset = sign_extend(instr & 0x3F, 6);
-                    mem_write(reg[r1] + offset, reg[r0]);
-                }
-                break;
-            case OP_TRAP:
-                reg[R_R7] = reg[R_PC];
-
-                // printf(">>> trap: 0x%x \n", instr & 0xff);
-                switch (instr & 0xFF)
-                {
-                    case TRAP_GETC:
-                        reg[R_R0] = (uint16_t)getchar();
-                        update_flags(R_R0);
-                        break;
-                    case TRAP_OUT:
-                        putc((char)reg[R_R0], stdout);
-                        fflush(stdout);
-                        break;
-                    case TRAP_PUTS:
-                        {
-                            // 16 bit 表示一个字符
-                            uint16_t* c = mem_addr() + reg[R_R0];
-                            while (*c) {
-                                putc((char)*c, stdout);
-                                ++c;
-                            }
-                            fflush(stdout);
-                        }
-                        break;
-                    case TRAP_IN:
-                        {
-                            char c = getchar();
-                            putc(c, stdout);
-                            fflush(stdout);
-                            reg[R_R0] = (uint16_t)c;
-                            update_flags(R_R0);
-                        }
-                        break;
-                    case TRAP_PUTSP:
-                        {
-                            uint16_t* c = mem_addr() + reg[R_R0];
-                            while (*c) {
-                                char char1 = (*c) & 0xFF;
-                                putc(char1, stdout);
-                                char char2 = (*c) >> 8;
-                                if (char2) {
-                                    putc(char2, stdout);
-                                }
-                                ++c;
-                            }
-                            fflush(stdout);
-                        }
-                        break;
-                    case TRAP_HALT:
-                        fflush(stdout);
-                        running = 0;
-                        break;
-                }
-                break;
-            case OP_RTI:
-            case OP_RES:
-                abort(); /* RTI RES 未使用 */
-            default:
-                printf("error: bad op code\n");
-                break;
-        }
+    if (migrate_to) {
+        signal(SIGUSR1, handle_migrate);
+        signal(SIGPIPE, SIG_IGN);
+        migrate_run(migrate_to, migrate_at);
+    } else {
+        cpu_run();
     }
+    gdb_exit(0);
+    smp_destroy();
+    dedup_destroy();
+
     restore_input_buffering();
+    memprof_report();
+    sample_report();
+    chan_report();
+    migrate_report();
+    dedup_report();
 
 exit:
+    vhost_disconnect();
+    vconsole_destroy();
+    bank_destroy();
+    disk_close();
     mem_destroy();
+    free(inputs);
 
     return ret;
 }
@@ -1,24 +1,69 @@
 #include "mem.h"
 
 static uint16_t *memory = NULL;  /* 65536 locations */
+static int memory_fd = -1;
 
+#define MEMORY_BYTES (MEMORY_MAX * sizeof(uint16_t))
+
+uint8_t mem_dirty[MEM_PAGES];
+uint8_t mem_watch[MEM_PAGES];
+
+// 客户机内存放在 memfd 中, 以 MAP_SHARED 方式映射,
+// 这样外部设备后端进程 (vhost) 可以通过 fd 直接访问同一块内存.
 void mem_init()
 {
     if (memory)
         return;
 
-    memory = (uint16_t *)malloc(MEMORY_MAX * sizeof(uint16_t));
+    memory_fd = memfd_create("lc3-mem", MFD_CLOEXEC);
+    if (memory_fd >= 0 && ftruncate(memory_fd, MEMORY_BYTES) == 0) {
+        memory = (uint16_t *)mmap(NULL, MEMORY_BYTES, PROT_READ | PROT_WRITE,
+                MAP_SHARED, memory_fd, 0);
+        if (memory != MAP_FAILED)
+            return;
+    }
+
+    /* memfd 不可用时退回匿名内存, 此时无法共享给后端进程 */
+    if (memory_fd >= 0)
+        close(memory_fd);
+    memory_fd = -1;
+    memory = (uint16_t *)mmap(NULL, MEMORY_BYTES, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+        memory = NULL;
+}
+
+int mem_attach(int fd)
+{
+    void *p;
+
+    if (memory)
+        return -1;
+
+    p = mmap(NULL, MEMORY_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED)
+        return -1;
+
+    memory = (uint16_t *)p;
+    memory_fd = fd;
+    return 0;
 }
 
 void mem_destroy()
 {
     if (memory) {
-        free(memory);
+        munmap(memory, MEMORY_BYTES);
+        memory = NULL;
+    }
+    if (memory_fd >= 0) {
+        close(memory_fd);
+        memory_fd = -1;
     }
 }
 
 void mem_set(uint16_t address, uint16_t val)
 {
+    mem_dirty[address >> MEM_PAGE_SHIFT] = 1;
     memory[address] = val;
 }
 
@@ -32,9 +77,20 @@ uint16_t *mem_addr()
     return memory;
 }
 
+int mem_fd()
+{
+    return memory_fd;
+}
+
 int mem_sync()
 {
     if (!memory)
         return -1;
     return msync((void *)memory, ((int)MEMORY_MAX) * 2, MS_SYNC | MS_INVALIDATE);
 }
+
+void mem_switch(uint16_t *mem, int fd)
+{
+    memory = mem;
+    memory_fd = fd;
+}
@@ -21,22 +21,78 @@
 // x0000 − x00FF Trap Vector Table
 // x0100 − x01FF Interrupt Vector Table
 // x0200 − x2FFF OS and Supervisor Stack
-// x3000 − xFDFF User Program Area
-// xFE00 − xFFFF Device Register Addresses
+//               (x0200 − x0282 是 lcc 运行库 getchar/scanf 的输入缓冲区, 见 lc3lib/stdio.asm)
+//               (x0300 − x043F 是 lc3lib/fs.h 的状态和缓冲区)
+// x3000 − xFFFF User Program Area, 其中以下区域不是普通内存:
+//   x7E00 − x7E83 vconsole 队列      (DEVICE_VCONSOLE, 见 virtio.h)
+//   x7F00 − x7F05 定时器             (DEVICE_TIMER, 见 timer.h)
+//   x7F10 − x7F11 内存分组           (DEVICE_BANK, 见 bank.h)
+//   x7F20 − x7F2B SMP               (DEVICE_SMP, 见 smp.h)
+//   x7F30 − x7F32 通道               (DEVICE_CHAN, 见 chan.h)
+//   x7F40 − x7F5B 性能计数器         (DEVICE_PERF, 见 perf.h)
+//   x7FFF − x802B virtio vring       (DEVICE_VIRTIO, 见 virtio.h)
+//   xC000 − xDFFF 内存分组窗口       (BANK_WINDOW_START, 启用 --banks 时按 DEVICE_BANK 切换)
+//   xF000 − xF7FF 通道共享窗口       (CHAN_WINDOW, 启用 --chan 时映射共享内存)
+// x7E00 − x7FFF 之间未列出的字目前仍是普通内存, 但保留给设备使用
 #define INTERRUPT_START  0X0100
 #define INTERRUPT_VIRTIO 0X0100
+#define INTERRUPT_VCONSOLE 0X0101
+#define INTERRUPT_TIMER  0X0181  /* 中断向量, 存放客户机中断处理程序地址 */
+#define INTERRUPT_IPI    0X0182
 #define INTERRUPT_END    0X01FF
 
-#define DEVICE_START  0X7FFF
+#define DEVICE_START  0X7E00
 #define DEVICE_VIRTIO 0X7FFF
+#define DEVICE_VCONSOLE 0X7E00
+#define DEVICE_TIMER  0X7F00
+#define DEVICE_BANK   0X7F10
+#define DEVICE_SMP    0X7F20
+#define DEVICE_CHAN   0X7F30
+#define DEVICE_PERF   0X7F40
 #define DEVICE_END    0XFFFF
 
+// 按页跟踪被写过的内存, 用于快照恢复时只拷贝改动过的页.
+// 一页 2048 字 (4KB), 共 32 页
+#define MEM_PAGE_SHIFT 11
+#define MEM_PAGE_WORDS (1 << MEM_PAGE_SHIFT)
+#define MEM_PAGES      (MEMORY_MAX >> MEM_PAGE_SHIFT)
+
+extern uint8_t mem_dirty[MEM_PAGES];
+// 有观察点的页, 访存时需要交给调试桩检查
+extern uint8_t mem_watch[MEM_PAGES];
+
+// 主机端不经过 mem_set 直接写的页: 中断标志和设备寄存器.
+// 快照恢复和迁移时总是当作脏页
+static inline int mem_device_page(int page)
+{
+    return page == (INTERRUPT_START >> MEM_PAGE_SHIFT) ||
+        (page >= (DEVICE_START >> MEM_PAGE_SHIFT) &&
+         page <= ((DEVICE_VIRTIO + 0x100) >> MEM_PAGE_SHIFT));
+}
+
+// 主机端直接写了 [address, address + words) 之后调用, 标记脏页
+static inline void mem_touch(uint32_t address, uint32_t words)
+{
+    uint32_t page;
+
+    if (!words)
+        return;
+    for (page = address >> MEM_PAGE_SHIFT;
+         page <= (address + words - 1) >> MEM_PAGE_SHIFT && page < MEM_PAGES; page++) {
+        mem_dirty[page] = 1;
+    }
+}
+
 void mem_init();
 void mem_destroy();
 void mem_set(uint16_t address, uint16_t val);
 uint16_t mem_get(uint16_t address);
 uint16_t *mem_addr();
+int mem_fd();
+int mem_attach(int fd);
 int mem_sync();
+// 换上另一块客户机内存, 原来的内存不会释放 (见 lc3vm.c). 没有 fd 时 fd 为 -1
+void mem_switch(uint16_t *mem, int fd);
 
 #endif
 
@@ -0,0 +1,279 @@
+#include <string.h>
+
+#include "lc3.h"
+#include "cpu.h"
+#include "sym.h"
+#include "memprof.h"
+
+int memprof_enabled;
+
+static const char *memprof_prefix;
+
+// 按地址统计
+static uint32_t *addr_reads;
+static uint32_t *addr_writes;
+static uint32_t *addr_misses;
+
+// 按访存指令的地址统计
+static uint32_t *pc_loads;
+static uint32_t *pc_stores;
+static uint32_t *pc_misses;
+static uint32_t (*pc_regions)[MEMPROF_REGIONS];
+
+// 组相联缓存, 写分配, LRU 替换. tags 为行号, 0 表示空 (行号存为 line + 1)
+static struct {
+    int enabled;
+    uint32_t words, line, ways, sets;
+    int line_shift;
+    uint32_t *tags;
+    uint64_t *stamps;
+    uint64_t tick;
+    uint64_t accesses;
+    uint64_t misses;
+    uint64_t write_misses;
+} cache;
+
+static int memprof_log2(uint32_t x)
+{
+    int n = 0;
+
+    if (x == 0 || (x & (x - 1)))
+        return -1;
+    while ((1U << n) != x)
+        n++;
+    return n;
+}
+
+static int memprof_cache_init(const char *spec)
+{
+    cache.words = MEMPROF_CACHE_WORDS;
+    cache.line = MEMPROF_CACHE_LINE;
+    cache.ways = MEMPROF_CACHE_WAYS;
+    if (*spec && sscanf(spec, "%u,%u,%u", &cache.words, &cache.line, &cache.ways) < 1)
+        return -1;
+
+    cache.line_shift = memprof_log2(cache.line);
+    if (cache.line_shift < 0 || memprof_log2(cache.words) < 0 || memprof_log2(cache.ways) < 0 ||
+            cache.words < cache.line * cache.ways)
+        return -1;
+    cache.sets = cache.words / cache.line / cache.ways;
+
+    cache.tags = calloc(cache.sets * cache.ways, sizeof(uint32_t));
+    cache.stamps = calloc(cache.sets * cache.ways, sizeof(uint64_t));
+    if (!cache.tags || !cache.stamps)
+        return -1;
+    cache.enabled = 1;
+    return 0;
+}
+
+// 返回 1 表示缺失
+static int memprof_cache_access(uint16_t address)
+{
+    uint32_t line = address >> cache.line_shift;
+    uint32_t set = line & (cache.sets - 1);
+    uint32_t *tags = cache.tags + set * cache.ways;
+    uint64_t *stamps = cache.stamps + set * cache.ways;
+    uint32_t i, victim = 0;
+
+    cache.accesses++;
+    cache.tick++;
+    for (i = 0; i < cache.ways; i++) {
+        if (tags[i] == line + 1) {
+            stamps[i] = cache.tick;
+            return 0;
+        }
+        if (stamps[i] < stamps[victim])
+            victim = i;
+    }
+
+    cache.misses++;
+    tags[victim] = line + 1;
+    stamps[victim] = cache.tick;
+    return 1;
+}
+
+int memprof_init(const char *prefix, const char *spec)
+{
+    memprof_prefix = prefix;
+
+    addr_reads = calloc(MEMORY_MAX, sizeof(uint32_t));
+    addr_writes = calloc(MEMORY_MAX, sizeof(uint32_t));
+    addr_misses = calloc(MEMORY_MAX, sizeof(uint32_t));
+    pc_loads = calloc(MEMORY_MAX, sizeof(uint32_t));
+    pc_stores = calloc(MEMORY_MAX, sizeof(uint32_t));
+    pc_misses = calloc(MEMORY_MAX, sizeof(uint32_t));
+    pc_regions = calloc(MEMORY_MAX, sizeof(pc_regions[0]));
+    if (!addr_reads || !addr_writes || !addr_misses || !pc_loads || !pc_stores ||
+            !pc_misses || !pc_regions)
+        return -1;
+
+    if (spec && memprof_cache_init(spec) < 0)
+        return -1;
+
+    memprof_enabled = 1;
+    return 0;
+}
+
+void memprof_access(uint16_t address, int write)
+{
+    // 执行期间 PC 已经指向下一条指令
+    uint16_t pc = reg[R_PC] - 1;
+
+    if (write) {
+        addr_writes[address]++;
+        pc_stores[pc]++;
+    } else {
+        addr_reads[address]++;
+        pc_loads[pc]++;
+    }
+    pc_regions[pc][address >> MEMPROF_REGION_SHIFT]++;
+
+    if (cache.enabled && memprof_cache_access(address)) {
+        addr_misses[address]++;
+        pc_misses[pc]++;
+        if (write)
+            cache.write_misses++;
+    }
+}
+
+static FILE *memprof_open(const char *suffix)
+{
+    char path[4096];
+
+    snprintf(path, sizeof(path), "%s%s", memprof_prefix, suffix);
+    return fopen(path, "w");
+}
+
+static int memprof_write_addr()
+{
+    FILE *f = memprof_open(".csv");
+    uint32_t i;
+
+    if (!f)
+        return -1;
+    fprintf(f, "address,reads,writes,misses\n");
+    for (i = 0; i < MEMORY_MAX; i++) {
+        if (addr_reads[i] || addr_writes[i])
+            fprintf(f, "0x%04x,%u,%u,%u\n", i, addr_reads[i], addr_writes[i], addr_misses[i]);
+    }
+    fclose(f);
+    return 0;
+}
+
+static int memprof_write_pc()
+{
+    FILE *f = memprof_open(".pc.csv");
+    const struct symbol *sym;
+    uint32_t i, r;
+
+    if (!f)
+        return -1;
+    fprintf(f, "pc,symbol,loads,stores,misses");
+    for (r = 0; r < MEMPROF_REGIONS; r++)
+        fprintf(f, ",0x%04x", r << MEMPROF_REGION_SHIFT);
+    fprintf(f, "\n");
+
+    for (i = 0; i < MEMORY_MAX; i++) {
+        if (!pc_loads[i] && !pc_stores[i])
+            continue;
+        sym = sym_lookup(i);
+        if (sym)
+            fprintf(f, "0x%04x,%s+%d,%u,%u,%u", i, sym->name, i - sym->addr,
+                    pc_loads[i], pc_stores[i], pc_misses[i]);
+        else
+            fprintf(f, "0x%04x,,%u,%u,%u", i, pc_loads[i], pc_stores[i], pc_misses[i]);
+        for (r = 0; r < MEMPROF_REGIONS; r++)
+            fprintf(f, ",%u", pc_regions[i][r]);
+        fprintf(f, "\n");
+    }
+    fclose(f);
+    return 0;
+}
+
+// 次数的对数 (二进制位数), 0 次为 0
+static int memprof_bits(uint32_t count)
+{
+    return count ? 32 - __builtin_clz(count) : 0;
+}
+
+static uint8_t memprof_scale(uint32_t count, int max)
+{
+    if (!count)
+        return 0;
+    // 访问过的地址至少有 32 的亮度, 只访问一次的也能看见
+    return 32 + 223 * memprof_bits(count) / max;
+}
+
+static int memprof_write_ppm()
+{
+    FILE *f = memprof_open(".ppm");
+    uint32_t i, max_reads = 0, max_writes = 0;
+    int lr, lw;
+    uint8_t px[3];
+
+    if (!f)
+        return -1;
+    for (i = 0; i < MEMORY_MAX; i++) {
+        if (addr_reads[i] > max_reads)
+            max_reads = addr_reads[i];
+        if (addr_writes[i] > max_writes)
+            max_writes = addr_writes[i];
+    }
+    lr = memprof_bits(max_reads);
+    lw = memprof_bits(max_writes);
+
+    fprintf(f, "P6\n256 256\n255\n");
+    for (i = 0; i < MEMORY_MAX; i++) {
+        px[0] = memprof_scale(addr_writes[i], lw);
+        px[1] = memprof_scale(addr_reads[i], lr);
+        px[2] = 0;
+        fwrite(px, 1, sizeof(px), f);
+    }
+    fclose(f);
+    return 0;
+}
+
+int memprof_report()
+{
+    uint64_t reads = 0, writes = 0;
+    uint32_t i, touched = 0;
+    int ret = 0;
+
+    if (!memprof_enabled)
+        return 0;
+    memprof_enabled = 0;
+
+    for (i = 0; i < MEMORY_MAX; i++) {
+        reads += addr_reads[i];
+        writes += addr_writes[i];
+        if (addr_reads[i] || addr_writes[i])
+            touched++;
+    }
+
+    if (memprof_write_addr() < 0 || memprof_write_pc() < 0 || memprof_write_ppm() < 0) {
+        fprintf(stderr, ">>> memprof: failed to write %s.*\n", memprof_prefix);
+        ret = -1;
+    }
+
+    fprintf(stderr, ">>> memprof: %llu reads, %llu writes, %u words touched\n",
+            (unsigned long long)reads, (unsigned long long)writes, touched);
+    if (cache.enabled) {
+        fprintf(stderr, ">>> memprof: cache %u words, %u-word lines, %u-way: "
+                "%llu misses (%llu on writes), miss rate %.2f%%\n",
+                cache.words, cache.line, cache.ways,
+                (unsigned long long)cache.misses, (unsigned long long)cache.write_misses,
+                cache.accesses ? 100.0 * cache.misses / cache.accesses : 0.0);
+    }
+
+    free(addr_reads);
+    free(addr_writes);
+    free(addr_misses);
+    free(pc_loads);
+    free(pc_stores);
+    free(pc_misses);
+    free(pc_regions);
+    free(cache.tags);
+    free(cache.stamps);
+    memset(&cache, 0, sizeof(cache));
+    return ret;
+}
@@ -0,0 +1,35 @@
+#ifndef _MEMPROF_H_
+#define _MEMPROF_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "mem.h"
+
+// 访存剖析: 统计客户机每个地址的读写次数, 每条访存指令 (PC) 访问的地址分布,
+// 并可以模拟一个组相联缓存统计缺失. 只统计经过 mem_read/mem_write 的数据访问,
+// 取指和 TRAP 直接读内存不计入. 未启用时访存路径上只多一次标志判断.
+//
+// 结束时输出:
+//   <prefix>.csv     address,reads,writes,misses (只列出访问过的地址)
+//   <prefix>.pc.csv  pc,symbol,loads,stores,misses 以及按 4K 字分成 16 个区域的访问次数
+//   <prefix>.ppm     256x256 热力图, 一个像素一个字, 第 n 行为 xNN00 − xNNFF;
+//                    红色为写, 绿色为读, 亮度按次数取对数
+#define MEMPROF_REGION_SHIFT 12
+#define MEMPROF_REGIONS      (MEMORY_MAX >> MEMPROF_REGION_SHIFT)
+
+// 默认的缓存参数 (以字为单位): 总大小, 行大小, 相联度
+#define MEMPROF_CACHE_WORDS 1024
+#define MEMPROF_CACHE_LINE  8
+#define MEMPROF_CACHE_WAYS  2
+
+extern int memprof_enabled;
+
+// cache 为 "words,line,ways" (均为 2 的幂), NULL 时不模拟缓存. 返回 -1 表示参数错误
+int memprof_init(const char *prefix, const char *cache);
+void memprof_access(uint16_t address, int write);
+// 写出结果文件并在 stderr 打印汇总, 然后释放统计数组
+int memprof_report();
+
+#endif
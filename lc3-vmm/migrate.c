@@ -0,0 +1,333 @@
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "mem.h"
+#include "cpu.h"
+#include "timer.h"
+#include "interrupt.h"
+#include "disk.h"
+#include "perf.h"
+#include "migrate.h"
+
+struct migrate_state {
+    struct cpu_state cpu;
+    struct int_state intr;
+    struct timer_state timer;
+    struct perf_state perf;
+};
+
+static volatile sig_atomic_t migrate_pending;
+
+static struct {
+    int rounds;
+    int precopy_pages;
+    int final_pages;
+    double downtime;
+    int received;
+} migrate_stats;
+
+void migrate_request()
+{
+    migrate_pending = 1;
+}
+
+static double migrate_now()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int migrate_sockaddr(const char *path, struct sockaddr_un *addr)
+{
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr->sun_path))
+        return -1;
+    strcpy(addr->sun_path, path);
+    return 0;
+}
+
+static int migrate_write(int fd, const void *buf, size_t len)
+{
+    const char *p = buf;
+    ssize_t n;
+
+    while (len > 0) {
+        n = send(fd, p, len, MSG_NOSIGNAL);
+        if (n < 0 && errno == ENOTSOCK)
+            n = write(fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        p += n;
+        len -= n;
+    }
+    return 0;
+}
+
+static int migrate_read(int fd, void *buf, size_t len)
+{
+    char *p = buf;
+    ssize_t n;
+
+    while (len > 0) {
+        n = read(fd, p, len);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return -1;
+        p += n;
+        len -= n;
+    }
+    return 0;
+}
+
+static int migrate_send_rec(int fd, uint16_t type, uint16_t page)
+{
+    struct migrate_rec rec = { MIGRATE_MAGIC, type, page };
+
+    return migrate_write(fd, &rec, sizeof(rec));
+}
+
+// 先清除脏页标记再拷贝, 发送期间客户机的写入会重新标记
+static int migrate_send_page(int fd, int page)
+{
+    mem_dirty[page] = 0;
+    if (migrate_send_rec(fd, MIGRATE_PAGE, page) < 0)
+        return -1;
+    return migrate_write(fd, mem_addr() + (page << MEM_PAGE_SHIFT),
+            MEM_PAGE_WORDS * sizeof(uint16_t));
+}
+
+// socket 的对端会回应, *ack 置 1
+static int migrate_connect(const char *path, int *ack)
+{
+    struct sockaddr_un addr;
+    struct stat st;
+    int fd;
+
+    *ack = 0;
+    if (stat(path, &st) < 0)
+        return -1;
+    if (!S_ISSOCK(st.st_mode))
+        return open(path, O_WRONLY | O_CLOEXEC);
+
+    if (migrate_sockaddr(path, &addr) < 0)
+        return -1;
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return -1;
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    *ack = 1;
+    return fd;
+}
+
+// 返回值同 migrate_run, -1 表示迁移失败
+static int migrate_out(const char *path)
+{
+    struct migrate_state state;
+    double start;
+    int fd, ack, page, dirty, sent, ret;
+    char reply;
+
+    fd = migrate_connect(path, &ack);
+    if (fd < 0)
+        return -1;
+
+    // 预拷贝, 第 0 轮发送全部页
+    memset(mem_dirty, 1, sizeof(mem_dirty));
+    for (migrate_stats.rounds = 0; ; migrate_stats.rounds++) {
+        dirty = 0;
+        for (page = 0; page < MEM_PAGES; page++) {
+            dirty += mem_dirty[page] && !mem_device_page(page);
+        }
+        if (migrate_stats.rounds > 0 &&
+                (dirty <= MIGRATE_FINAL_PAGES || migrate_stats.rounds >= MIGRATE_ROUNDS))
+            break;
+
+        sent = 0;
+        for (page = 0; page < MEM_PAGES; page++) {
+            if (!mem_dirty[page])
+                continue;
+            if (migrate_send_page(fd, page) < 0)
+                goto err;
+            sent++;
+        }
+        migrate_stats.precopy_pages += sent;
+
+        ret = cpu_run_budget((uint64_t)sent * MIGRATE_PAGE_INSNS);
+        if (ret == 0) {
+            migrate_send_rec(fd, MIGRATE_ABORT, 0);
+            close(fd);
+            return 0;
+        }
+    }
+
+    // 停机拷贝: 剩余脏页和设备页, 磁盘缓存先写回, 目的端打开同一个文件
+    start = migrate_now();
+    fflush(stdout);
+    if (disk_active() && disk_flush() < 0)
+        goto err;
+    for (page = 0; page < MEM_PAGES; page++) {
+        if (!mem_dirty[page] && !mem_device_page(page))
+            continue;
+        if (migrate_send_page(fd, page) < 0)
+            goto err;
+        migrate_stats.final_pages++;
+    }
+
+    cpu_save(&state.cpu);
+    int_save(&state.intr);
+    timer_save(&state.timer);
+    perf_save(&state.perf);
+    if (migrate_send_rec(fd, MIGRATE_STATE, 0) < 0 ||
+            migrate_write(fd, &state, sizeof(state)) < 0 ||
+            migrate_send_rec(fd, MIGRATE_DONE, 0) < 0)
+        goto err;
+    if (ack && migrate_read(fd, &reply, 1) < 0)
+        goto err;
+    migrate_stats.downtime = migrate_now() - start;
+
+    close(fd);
+    return 1;
+
+err:
+    close(fd);
+    return -1;
+}
+
+int migrate_run(const char *path, uint64_t at)
+{
+    uint64_t budget, now;
+    int ret;
+
+    while (1) {
+        budget = MIGRATE_SLICE;
+        if (at && !migrate_pending) {
+            now = cpu_icount();
+            if (now >= at)
+                migrate_pending = 1;
+            else if (at - now < budget)
+                budget = at - now;
+        }
+
+        if (migrate_pending) {
+            migrate_pending = 0;
+            at = 0;
+            ret = migrate_out(path);
+            if (ret >= 0)
+                return ret;
+            fprintf(stderr, ">>> migrate: failed to migrate to %s, continuing\n", path);
+            memset(&migrate_stats, 0, sizeof(migrate_stats));
+            continue;
+        }
+
+        if (!cpu_run_budget(budget))
+            return 0;
+    }
+}
+
+// 先在临时名字上监听再改名, socket 文件出现时源端就能连接
+static int migrate_accept(const char *path)
+{
+    struct sockaddr_un addr;
+    struct stat st;
+    char tmp[sizeof(addr.sun_path)];
+    int sock, fd;
+
+    if (stat(path, &st) == 0 && S_ISFIFO(st.st_mode))
+        return open(path, O_RDONLY | O_CLOEXEC);
+
+    if (snprintf(tmp, sizeof(tmp), "%s.%d", path, getpid()) >= (int)sizeof(tmp) ||
+            migrate_sockaddr(tmp, &addr) < 0)
+        return -1;
+    sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (sock < 0)
+        return -1;
+
+    unlink(tmp);
+    if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(sock, 1) < 0 ||
+            rename(tmp, path) < 0) {
+        unlink(tmp);
+        close(sock);
+        return -1;
+    }
+    fd = accept4(sock, NULL, NULL, SOCK_CLOEXEC);
+    close(sock);
+    unlink(path);
+    return fd;
+}
+
+int migrate_receive(const char *path)
+{
+    struct migrate_rec rec;
+    struct migrate_state state;
+    int fd, loaded = 0;
+    char reply = 0;
+
+    fd = migrate_accept(path);
+    if (fd < 0)
+        return -1;
+
+    while (migrate_read(fd, &rec, sizeof(rec)) == 0 && rec.magic == MIGRATE_MAGIC) {
+        switch (rec.type) {
+            case MIGRATE_PAGE:
+                if (rec.page >= MEM_PAGES ||
+                        migrate_read(fd, mem_addr() + (rec.page << MEM_PAGE_SHIFT),
+                            MEM_PAGE_WORDS * sizeof(uint16_t)) < 0)
+                    goto err;
+                migrate_stats.received++;
+                break;
+            case MIGRATE_STATE:
+                if (migrate_read(fd, &state, sizeof(state)) < 0)
+                    goto err;
+                loaded = 1;
+                break;
+            case MIGRATE_DONE:
+                if (!loaded)
+                    goto err;
+                cpu_load(&state.cpu);
+                int_load(&state.intr);
+                timer_load(&state.timer);
+                perf_load(&state.perf);
+                // FIFO 上写不了回应, 忽略错误
+                migrate_write(fd, &reply, 1);
+                close(fd);
+                return 0;
+            case MIGRATE_ABORT:
+                close(fd);
+                return 1;
+            default:
+                goto err;
+        }
+    }
+
+err:
+    close(fd);
+    return -1;
+}
+
+void migrate_report()
+{
+    if (!getenv("LC3_MIGRATE_STATS"))
+        return;
+    if (migrate_stats.received) {
+        fprintf(stderr, ">>> migrate: received %d pages\n", migrate_stats.received);
+    } else if (migrate_stats.rounds) {
+        fprintf(stderr, ">>> migrate: %d pre-copy rounds, %d pages pre-copied, "
+                "%d pages stop-and-copy, downtime %.3fms\n",
+                migrate_stats.rounds, migrate_stats.precopy_pages,
+                migrate_stats.final_pages, migrate_stats.downtime * 1e3);
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef _MIGRATE_H_
+#define _MIGRATE_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// 热迁移: 把运行中的客户机从一个 lc3-vmm 进程搬到另一个.
+// 源端 (--migrate-to) 收到 SIGUSR1 或执行到 --migrate-at 条指令后开始迁移:
+//   1. 预拷贝: 第 0 轮发送全部页, 之后每轮发送上一轮期间 mem_dirty 标记的页.
+//      发送一页的同时客户机继续执行 MIGRATE_PAGE_INSNS 条指令 (单线程模拟边传输边运行)
+//   2. 脏页不超过 MIGRATE_FINAL_PAGES 或到达 MIGRATE_ROUNDS 轮后停机拷贝:
+//      客户机暂停, 发送剩余脏页, 设备页 (virtio 队列, 中断标志) 和 CPU, 中断, 定时器状态
+//   3. 目的端 (--migrate-from) 装入后回应一个字节, 源端退出, 目的端从断点继续执行
+// 停机时间只取决于最后一轮的脏页数. 迁移失败时客户机在源端继续运行.
+//
+// 通道是 Unix socket (目的端监听) 或 FIFO (没有回应, 源端写完即退出).
+// 两端需要相同的 --disk, 不支持 --smp, --banks, --chan, --vhost 和 --gdb.
+//
+// 记录格式: struct migrate_rec, PAGE 后跟 MEM_PAGE_WORDS 个字, STATE 后跟 struct migrate_state
+#define MIGRATE_MAGIC       0X4D33434C  /* "LC3M" */
+#define MIGRATE_ROUNDS      8
+#define MIGRATE_FINAL_PAGES 2
+#define MIGRATE_PAGE_INSNS  256
+#define MIGRATE_SLICE       4096        /* 源端检查迁移请求的间隔 (指令) */
+
+enum {
+    MIGRATE_PAGE = 1,
+    MIGRATE_STATE,
+    MIGRATE_DONE,
+    MIGRATE_ABORT,  /* 预拷贝期间客户机已停机, 由源端执行完 */
+};
+
+struct migrate_rec {
+    uint32_t magic;
+    uint16_t type;
+    uint16_t page;
+};
+
+// 源端: 可以在信号处理函数中调用
+void migrate_request();
+// 代替 cpu_run: 运行客户机, at 不为 0 时执行到 at 条指令自动迁移.
+// 返回 0 客户机已停机, 1 已迁出
+int migrate_run(const char *path, uint64_t at);
+
+// 目的端: 在 cpu_reset 之后调用, 接收内存和状态.
+// 返回 0 可以继续执行, 1 源端已执行完客户机, -1 出错
+int migrate_receive(const char *path);
+
+// LC3_MIGRATE_STATS 时在 stderr 打印迁移统计
+void migrate_report();
+
+#endif
@@ -0,0 +1,68 @@
+#include <string.h>
+
+#include "opcodes.h"
+
+#define INSN_INFO(id, name, match, mask, fmt, flags) { name, match, mask, fmt, flags },
+const struct lc3_insn lc3_insns[INSN_COUNT] = {
+    LC3_INSNS(INSN_INFO)
+};
+#undef INSN_INFO
+
+uint8_t lc3_decode_table[256];
+
+// 每个下标取第一个匹配的变体. 表里的编码互不重叠, 每个下标都有匹配
+__attribute__((constructor))
+static void lc3_decode_init()
+{
+    uint16_t instr;
+    int key, i;
+
+    for (key = 0; key < 256; key++) {
+        instr = ((key >> 1) << 9) | ((key & 1) << 5);
+        for (i = 0; i < INSN_COUNT; i++) {
+            if ((instr & lc3_insns[i].mask) == lc3_insns[i].match)
+                break;
+        }
+        lc3_decode_table[key] = i;
+    }
+}
+
+static int sext(uint16_t x, int bit_count)
+{
+    return (int16_t)(x << (16 - bit_count)) >> (16 - bit_count);
+}
+
+int lc3_disasm(uint16_t pc, uint16_t instr, char *buf, size_t size)
+{
+    const struct lc3_insn *insn = &lc3_insns[lc3_decode(instr)];
+    uint16_t dr = (instr >> 9) & 0x7;
+    uint16_t sr = (instr >> 6) & 0x7;
+    uint16_t next = pc + 1;
+
+    switch (insn->format) {
+        case FMT_RRR:
+            return snprintf(buf, size, "%s R%d, R%d, R%d", insn->name, dr, sr, instr & 0x7);
+        case FMT_RRI5:
+            return snprintf(buf, size, "%s R%d, R%d, #%d", insn->name, dr, sr, sext(instr & 0x1F, 5));
+        case FMT_RR:
+            return snprintf(buf, size, "%s R%d, R%d", insn->name, dr, sr);
+        case FMT_RPC9:
+            return snprintf(buf, size, "%s R%d, x%04X", insn->name, dr,
+                    (uint16_t)(next + sext(instr & 0x1FF, 9)));
+        case FMT_RRI6:
+            return snprintf(buf, size, "%s R%d, R%d, #%d", insn->name, dr, sr, sext(instr & 0x3F, 6));
+        case FMT_PC9:
+            return snprintf(buf, size, "%s x%04X", insn->name, (uint16_t)(next + sext(instr & 0x1FF, 9)));
+        case FMT_PC11:
+            return snprintf(buf, size, "%s x%04X", insn->name, (uint16_t)(next + sext(instr & 0x7FF, 11)));
+        case FMT_R:
+            // JMP R7 即 RET
+            if (lc3_decode(instr) == INSN_JMP && sr == R_R7)
+                return snprintf(buf, size, "RET");
+            return snprintf(buf, size, "%s R%d", insn->name, sr);
+        case FMT_TRAP:
+            return snprintf(buf, size, "%s x%02X", insn->name, instr & 0xFF);
+        default:
+            return snprintf(buf, size, "%s", insn->name);
+    }
+}
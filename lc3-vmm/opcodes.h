@@ -0,0 +1,100 @@
+#ifndef _OPCODES_H_
+#define _OPCODES_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "lc3.h"
+
+// 指令表: 每个编码变体一行, 解码表, 各解释器的处理函数和反汇编都从这里展开,
+// 处理函数里不再检查 imm_flag, long_flag 和 N/Z/P 位.
+// X(名字, 助记符, 匹配值, 掩码, 操作数格式, 标志)
+// 掩码只用到 bit15-9 和 bit5, 解码时以这 8 位为下标查表.
+//
+// BR 的 8 种条件单独成表, 条件位 (match >> 9) & 7 在编译时已知
+#define LC3_BR_INSNS(X) \
+    X(NOP,   "NOP",   0X0000, 0XFE00, FMT_NONE, INSN_END) \
+    X(BRP,   "BRp",   0X0200, 0XFE00, FMT_PC9,  INSN_END) \
+    X(BRZ,   "BRz",   0X0400, 0XFE00, FMT_PC9,  INSN_END) \
+    X(BRZP,  "BRzp",  0X0600, 0XFE00, FMT_PC9,  INSN_END) \
+    X(BRN,   "BRn",   0X0800, 0XFE00, FMT_PC9,  INSN_END) \
+    X(BRNP,  "BRnp",  0X0A00, 0XFE00, FMT_PC9,  INSN_END) \
+    X(BRNZ,  "BRnz",  0X0C00, 0XFE00, FMT_PC9,  INSN_END) \
+    X(BRNZP, "BRnzp", 0X0E00, 0XFE00, FMT_PC9,  INSN_END)
+
+#define LC3_BR_NZP(match) (((match) >> 9) & 0x7)
+
+#define LC3_INSNS(X) \
+    LC3_BR_INSNS(X) \
+    X(ADD,   "ADD",   0X1000, 0XF020, FMT_RRR,  0) \
+    X(ADDI,  "ADD",   0X1020, 0XF020, FMT_RRI5, 0) \
+    X(LD,    "LD",    0X2000, 0XF000, FMT_RPC9, 0) \
+    X(ST,    "ST",    0X3000, 0XF000, FMT_RPC9, 0) \
+    X(JSR,   "JSR",   0X4800, 0XF800, FMT_PC11, INSN_END) \
+    X(JSRR,  "JSRR",  0X4000, 0XF800, FMT_R,    INSN_END) \
+    X(AND,   "AND",   0X5000, 0XF020, FMT_RRR,  0) \
+    X(ANDI,  "AND",   0X5020, 0XF020, FMT_RRI5, 0) \
+    X(LDR,   "LDR",   0X6000, 0XF000, FMT_RRI6, 0) \
+    X(STR,   "STR",   0X7000, 0XF000, FMT_RRI6, 0) \
+    X(RTI,   "RTI",   0X8000, 0XF000, FMT_NONE, INSN_END) \
+    X(NOT,   "NOT",   0X9000, 0XF000, FMT_RR,   0) \
+    X(LDI,   "LDI",   0XA000, 0XF000, FMT_RPC9, 0) \
+    X(STI,   "STI",   0XB000, 0XF000, FMT_RPC9, 0) \
+    X(JMP,   "JMP",   0XC000, 0XF000, FMT_R,    INSN_END) \
+    X(RES,   "RES",   0XD000, 0XF000, FMT_NONE, INSN_END) \
+    X(LEA,   "LEA",   0XE000, 0XF000, FMT_RPC9, 0) \
+    X(TRAP,  "TRAP",  0XF000, 0XF000, FMT_TRAP, INSN_END)
+
+#define INSN_ENUM(id, name, match, mask, fmt, flags) INSN_##id,
+enum {
+    LC3_INSNS(INSN_ENUM)
+    INSN_COUNT
+};
+#undef INSN_ENUM
+
+// 操作数格式, 用于反汇编
+enum {
+    FMT_NONE,  /* RTI, RES, NOP */
+    FMT_RRR,   /* DR, SR1, SR2 */
+    FMT_RRI5,  /* DR, SR1, imm5 */
+    FMT_RR,    /* DR, SR */
+    FMT_RPC9,  /* DR, PC + off9 */
+    FMT_RRI6,  /* DR, BaseR, off6 */
+    FMT_PC9,   /* PC + off9 */
+    FMT_PC11,  /* PC + off11 */
+    FMT_R,     /* BaseR */
+    FMT_TRAP,  /* trapvect8 */
+};
+
+// 标志
+#define INSN_END 1  /* 控制转移, 结束基本块 */
+
+struct lc3_insn {
+    const char *name;
+    uint16_t match;
+    uint16_t mask;
+    uint8_t format;
+    uint8_t flags;
+};
+
+extern const struct lc3_insn lc3_insns[INSN_COUNT];
+extern uint8_t lc3_decode_table[256];
+
+// bit15-9 和 bit5
+#define LC3_DECODE_KEY(instr) ((((instr) >> 8) & 0XFE) | (((instr) >> 5) & 1))
+
+static inline int lc3_decode(uint16_t instr)
+{
+    return lc3_decode_table[LC3_DECODE_KEY(instr)];
+}
+
+static inline int lc3_insn_end(uint16_t instr)
+{
+    return lc3_insns[lc3_decode(instr)].flags & INSN_END;
+}
+
+// 把 pc 处的指令反汇编到 buf, 跳转和访存目标写成绝对地址. 返回写入的长度
+int lc3_disasm(uint16_t pc, uint16_t instr, char *buf, size_t size);
+
+#endif
@@ -0,0 +1,115 @@
+#include <string.h>
+#include <time.h>
+
+#include "mem.h"
+#include "perf.h"
+
+__thread uint64_t perf_loads;
+__thread uint64_t perf_stores;
+__thread uint64_t perf_branches;
+__thread uint64_t perf_traps;
+
+static __thread uint64_t perf_total[PERF_COUNTERS];
+static __thread uint64_t perf_start[PERF_COUNTERS];
+static __thread uint64_t perf_latch;
+__thread int perf_running;
+
+static uint64_t perf_now_us()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+// 当前的原始计数
+static void perf_raw(uint64_t raw[PERF_COUNTERS], uint64_t icount)
+{
+    raw[PERF_INSNS] = icount;
+    raw[PERF_LOADS] = perf_loads;
+    raw[PERF_STORES] = perf_stores;
+    raw[PERF_BRANCHES] = perf_branches;
+    raw[PERF_TRAPS] = perf_traps;
+    raw[PERF_USEC] = perf_now_us();
+}
+
+void perf_init()
+{
+    perf_loads = perf_stores = perf_branches = perf_traps = 0;
+    memset(perf_total, 0, sizeof(perf_total));
+    memset(perf_start, 0, sizeof(perf_start));
+    perf_latch = 0;
+    perf_running = 0;
+}
+
+void perf_write(uint16_t address, uint16_t val, uint64_t icount)
+{
+    uint64_t raw[PERF_COUNTERS];
+    int i;
+
+    if (address != PERF_CTRL)
+        return;
+
+    perf_raw(raw, icount);
+    if ((val & PERF_STOP) && perf_running) {
+        for (i = 0; i < PERF_COUNTERS; i++) {
+            perf_total[i] += raw[i] - perf_start[i];
+        }
+        perf_running = 0;
+    }
+    if (val & PERF_RESET) {
+        memset(perf_total, 0, sizeof(perf_total));
+    }
+    // 清零时正在计数的区间也从现在开始
+    if ((val & PERF_START) || ((val & PERF_RESET) && perf_running)) {
+        memcpy(perf_start, raw, sizeof(raw));
+        perf_running = 1;
+    }
+}
+
+uint16_t perf_read(uint16_t address, uint64_t icount)
+{
+    uint64_t raw[PERF_COUNTERS];
+    int n, word;
+
+    if (address == PERF_CTRL)
+        return perf_running ? PERF_RUNNING : 0;
+    // CTRL 后面的 3 个字没有用到
+    if (address < PERF_COUNTER || address >= PERF_END)
+        return 0;
+
+    n = (address - PERF_COUNTER) / 4;
+    word = (address - PERF_COUNTER) % 4;
+    if (word == 0) {
+        perf_latch = perf_total[n];
+        if (perf_running) {
+            perf_raw(raw, icount);
+            perf_latch += raw[n] - perf_start[n];
+        }
+    }
+    return (perf_latch >> (word * 16)) & 0xFFFF;
+}
+
+void perf_save(struct perf_state *state)
+{
+    state->loads = perf_loads;
+    state->stores = perf_stores;
+    state->branches = perf_branches;
+    state->traps = perf_traps;
+    memcpy(state->total, perf_total, sizeof(perf_total));
+    memcpy(state->start, perf_start, sizeof(perf_start));
+    state->latch = perf_latch;
+    state->running = perf_running;
+}
+
+void perf_load(const struct perf_state *state)
+{
+    perf_loads = state->loads;
+    perf_stores = state->stores;
+    perf_branches = state->branches;
+    perf_traps = state->traps;
+    memcpy(perf_total, state->total, sizeof(perf_total));
+    memcpy(perf_start, state->start, sizeof(perf_start));
+    perf_latch = state->latch;
+    perf_running = state->running;
+}
@@ -0,0 +1,72 @@
+#ifndef _PERF_H_
+#define _PERF_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "mem.h"
+
+// 性能计数器: 客户机自己测量一段代码. 每个 vCPU 一组 (线程局部), 寄存器不经过共用的内存.
+//
+// 寄存器 (DEVICE_PERF 起始):
+// CTRL: 写 bit0 开始计数, bit1 停止, bit2 清零 (可以同时写, 先清零后开始);
+//       读 bit0 为 1 表示正在计数
+// 计数器 n 占 PERF_COUNTER + n * 4 起的 4 个字, 64 位值按低位在前分成 16 位.
+//       读第 0 个字时锁存整个值, 其余 3 个字返回锁存值的高位, 读出的 64 位是一致的
+//
+// 计数器:
+// INSNS:    执行的指令数
+// LOADS:    数据读 (LD/LDR 一次, LDI 两次, RTI 和中断进出时的栈访问也算)
+// STORES:   数据写
+// BRANCHES: 发生的跳转: 条件成立的 BR 和 JMP/JSR/JSRR (lcc 的循环回边是 JMP), 不含 TRAP/RTI
+// TRAPS:    TRAP 指令
+// USEC:     主机经过的微秒数
+#define PERF_CTRL    (DEVICE_PERF + 0)
+#define PERF_COUNTER (DEVICE_PERF + 4)
+#define PERF_END     (PERF_COUNTER + PERF_COUNTERS * 4)
+
+#define PERF_START 0X0001
+#define PERF_STOP  0X0002
+#define PERF_RESET 0X0004
+
+#define PERF_RUNNING 0X0001
+
+enum {
+    PERF_INSNS,
+    PERF_LOADS,
+    PERF_STORES,
+    PERF_BRANCHES,
+    PERF_TRAPS,
+    PERF_USEC,
+    PERF_COUNTERS
+};
+
+// 解释器和 AOT 代码直接累加的原始计数, 只在计数期间累加; 设备按开始/停止时的差值计算.
+// 客户机没有打开计数器时, 访存和跳转路径上只多一次判断
+extern __thread uint64_t perf_loads;
+extern __thread uint64_t perf_stores;
+extern __thread uint64_t perf_branches;
+extern __thread uint64_t perf_traps;
+extern __thread int perf_running;
+
+#define PERF_COUNT(counter) do { if (perf_running) (counter)++; } while (0)
+
+struct perf_state {
+    uint64_t loads;
+    uint64_t stores;
+    uint64_t branches;
+    uint64_t traps;
+    uint64_t total[PERF_COUNTERS];     /* 已停止的区间累计 */
+    uint64_t start[PERF_COUNTERS];     /* 开始计数时的原始值 */
+    uint64_t latch;
+    int running;
+};
+
+void perf_init();
+void perf_write(uint16_t address, uint16_t val, uint64_t icount);
+uint16_t perf_read(uint16_t address, uint64_t icount);
+void perf_save(struct perf_state *state);
+void perf_load(const struct perf_state *state);
+
+#endif
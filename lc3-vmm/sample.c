@@ -0,0 +1,378 @@
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "lc3.h"
+#include "cpu.h"
+#include "mem.h"
+#include "sym.h"
+#include "opcodes.h"
+#include "sample.h"
+
+// glibc 2.35 之前没有定义这个名字
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+__thread volatile sig_atomic_t sample_pending;
+
+struct sample_stack {
+    uint64_t key;       /* 0 表示空表项 */
+    uint32_t count;
+    uint16_t pc;
+    uint16_t depth;
+    uint16_t ret[SAMPLE_DEPTH];  /* ret[0] 为最内层的返回地址 */
+};
+
+static const char *sample_prefix;
+static unsigned sample_interval;
+static __thread timer_t sample_timer;
+static __thread int sample_timing;
+static int sample_enabled;
+static struct sample_stack *sample_stacks;
+static uint32_t sample_dropped;
+static uint8_t *sample_entry;   /* 函数入口, 此时帧还没有建立 */
+
+static void sample_signal(int sig)
+{
+    sample_pending = 1;
+}
+
+int sample_init(const char *prefix, unsigned interval_us)
+{
+    const struct symbol *syms = sym_table();
+    struct sigaction sa;
+    int i;
+
+    sample_prefix = prefix;
+    sample_interval = interval_us ? interval_us : SAMPLE_US;
+    sample_stacks = calloc(SAMPLE_STACKS, sizeof(struct sample_stack));
+    sample_entry = calloc(MEMORY_MAX, 1);
+    if (!sample_stacks || !sample_entry)
+        return -1;
+    for (i = 0; i < sym_count(); i++) {
+        if (!sym_local(syms[i].name))
+            sample_entry[syms[i].addr] = 1;
+    }
+
+    // SA_RESTART: 客户机在 GETC 等处阻塞时不会因为采样信号而读失败
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = sample_signal;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(SIGPROF, &sa, NULL) < 0)
+        return -1;
+
+    sample_enabled = 1;
+    if (sample_thread() < 0) {
+        sample_enabled = 0;
+        return -1;
+    }
+    return 0;
+}
+
+// 进程和线程的 CPU 时间定时器只在调度时钟中断时检查, 精度只有几毫秒,
+// 所以用 CLOCK_MONOTONIC, 信号直接发给创建定时器的线程
+int sample_thread()
+{
+    struct sigevent sev;
+    struct itimerspec its;
+
+    if (!sample_enabled)
+        return 0;
+
+    memset(&sev, 0, sizeof(sev));
+    sev.sigev_notify = SIGEV_THREAD_ID;
+    sev.sigev_signo = SIGPROF;
+    sev.sigev_notify_thread_id = gettid();
+    if (timer_create(CLOCK_MONOTONIC, &sev, &sample_timer) < 0)
+        return -1;
+
+    its.it_interval.tv_sec = sample_interval / 1000000;
+    its.it_interval.tv_nsec = (sample_interval % 1000000) * 1000;
+    its.it_value = its.it_interval;
+    if (timer_settime(sample_timer, 0, &its, NULL) < 0) {
+        timer_delete(sample_timer);
+        return -1;
+    }
+    sample_timing = 1;
+    return 0;
+}
+
+void sample_thread_exit()
+{
+    if (sample_timing) {
+        timer_delete(sample_timer);
+        sample_timing = 0;
+    }
+}
+
+static uint64_t sample_hash(const struct sample_stack *s)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    int i;
+
+    hash = (hash ^ s->pc) * 0x100000001B3ULL;
+    for (i = 0; i < s->depth; i++) {
+        hash = (hash ^ s->ret[i]) * 0x100000001B3ULL;
+    }
+    return hash | 1;
+}
+
+void sample_take()
+{
+    const uint16_t *memory = mem_addr();
+    struct sample_stack s;
+    struct sample_stack *e;
+    uint64_t key, old;
+    uint16_t fp, next, ret;
+    uint32_t i, n;
+
+    sample_pending = 0;
+    if (!sample_enabled)
+        return;
+
+    s.pc = reg[R_PC];
+    s.depth = 0;
+    if (sample_entry[s.pc])
+        s.ret[s.depth++] = reg[R_R7];
+    fp = reg[R_R5];
+    while (s.depth < SAMPLE_DEPTH && fp != 0 && fp < 0xFFFD) {
+        // INIT_CODE 建立的最外层帧之上没有返回地址
+        ret = memory[fp + 2];
+        if (!ret)
+            break;
+        s.ret[s.depth++] = ret;
+        next = memory[fp + 1];
+        // 栈向低地址增长, 调用者的帧一定在更高的地址
+        if (next <= fp)
+            break;
+        fp = next;
+    }
+
+    // 线性探测, 用 CAS 占用空表项; 计数在占用之后才增加, 报告时所有线程已停止
+    key = sample_hash(&s);
+    for (i = key & (SAMPLE_STACKS - 1), n = 0; n < SAMPLE_STACKS; i = (i + 1) & (SAMPLE_STACKS - 1), n++) {
+        e = &sample_stacks[i];
+        old = __atomic_load_n(&e->key, __ATOMIC_ACQUIRE);
+        if (old == 0) {
+            if (__atomic_compare_exchange_n(&e->key, &old, key, 0,
+                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                e->pc = s.pc;
+                e->depth = s.depth;
+                memcpy(e->ret, s.ret, sizeof(s.ret));
+                __atomic_fetch_add(&e->count, 1, __ATOMIC_RELAXED);
+                return;
+            }
+        }
+        if (old == key) {
+            __atomic_fetch_add(&e->count, 1, __ATOMIC_RELAXED);
+            return;
+        }
+    }
+    __atomic_fetch_add(&sample_dropped, 1, __ATOMIC_RELAXED);
+}
+
+static const char *sample_name(uint16_t addr, char *buf, size_t size)
+{
+    const struct symbol *sym = sym_lookup_func(addr);
+
+    if (sym)
+        return sym->name;
+    snprintf(buf, size, "x%04X", addr);
+    return buf;
+}
+
+// 符号表中的下标, 没有符号时为 sym_count()
+static int sample_func(uint16_t addr)
+{
+    const struct symbol *sym = sym_lookup_func(addr);
+
+    return sym ? sym - sym_table() : sym_count();
+}
+
+static FILE *sample_open(const char *suffix)
+{
+    char path[4096];
+
+    snprintf(path, sizeof(path), "%s%s", sample_prefix, suffix);
+    return fopen(path, "w");
+}
+
+static int sample_cmp_line(const void *a, const void *b)
+{
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+// 调用栈的帧按从外到内排列. 每个调用点取返回地址的前一条指令
+static int sample_write_folded()
+{
+    FILE *f = sample_open(".folded");
+    char **lines, buf[16], *p;
+    size_t len;
+    uint32_t i, n = 0, count;
+    int d;
+
+    if (!f)
+        return -1;
+    lines = calloc(SAMPLE_STACKS, sizeof(char *));
+    if (!lines) {
+        fclose(f);
+        return -1;
+    }
+
+    // 行尾的 '\t' 之后是次数, 排序后合并函数序列相同的行
+    for (i = 0; i < SAMPLE_STACKS; i++) {
+        struct sample_stack *e = &sample_stacks[i];
+
+        if (!e->key)
+            continue;
+        len = (e->depth + 1) * (SYM_NAME_MAX + 1) + 16;
+        p = malloc(len);
+        if (!p)
+            break;
+        lines[n++] = p;
+        p[0] = '\0';
+        for (d = e->depth - 1; d >= 0; d--) {
+            strcat(p, sample_name(e->ret[d] - 1, buf, sizeof(buf)));
+            strcat(p, ";");
+        }
+        strcat(p, sample_name(e->pc, buf, sizeof(buf)));
+        snprintf(p + strlen(p), 16, "\t%u", e->count);
+    }
+    qsort(lines, n, sizeof(char *), sample_cmp_line);
+
+    for (i = 0; i < n; ) {
+        uint32_t j = i;
+
+        count = 0;
+        len = strchr(lines[i], '\t') - lines[i];
+        while (j < n && !strncmp(lines[j], lines[i], len + 1)) {
+            count += strtoul(lines[j] + len + 1, NULL, 10);
+            j++;
+        }
+        fprintf(f, "%.*s %u\n", (int)len, lines[i], count);
+        while (i < j)
+            free(lines[i++]);
+    }
+
+    free(lines);
+    return fclose(f) ? -1 : 0;
+}
+
+static int sample_cmp_count(const void *a, const void *b, void *counts)
+{
+    uint32_t ca = ((uint32_t *)counts)[*(const int *)a];
+    uint32_t cb = ((uint32_t *)counts)[*(const int *)b];
+
+    return ca < cb ? 1 : (ca > cb ? -1 : *(const int *)a - *(const int *)b);
+}
+
+static int sample_write_txt(uint32_t total)
+{
+    FILE *f = sample_open(".txt");
+    const struct symbol *syms = sym_table();
+    int nfunc = sym_count() + 1;
+    uint32_t *self, *incl, *seen, *pcs;
+    int *order, i, d, fn;
+    uint32_t k;
+    char text[64];
+
+    if (!f)
+        return -1;
+    self = calloc(nfunc, sizeof(uint32_t));
+    incl = calloc(nfunc, sizeof(uint32_t));
+    seen = calloc(nfunc, sizeof(uint32_t));
+    pcs = calloc(MEMORY_MAX, sizeof(uint32_t));
+    order = calloc(nfunc > MEMORY_MAX ? nfunc : MEMORY_MAX, sizeof(int));
+    if (!self || !incl || !seen || !pcs || !order) {
+        fclose(f);
+        return -1;
+    }
+
+    // 递归调用时同一个函数在一个样本中只算一次 total
+    for (k = 0; k < SAMPLE_STACKS; k++) {
+        struct sample_stack *e = &sample_stacks[k];
+
+        if (!e->key)
+            continue;
+        fn = sample_func(e->pc);
+        self[fn] += e->count;
+        pcs[e->pc] += e->count;
+        incl[fn] += e->count;
+        seen[fn] = k + 1;
+        for (d = 0; d < e->depth; d++) {
+            fn = sample_func(e->ret[d] - 1);
+            if (seen[fn] != k + 1) {
+                incl[fn] += e->count;
+                seen[fn] = k + 1;
+            }
+        }
+    }
+
+    fprintf(f, "# %u samples every %uus, %u dropped\n",
+            total, sample_interval, sample_dropped);
+    fprintf(f, "# call stacks keep the innermost %d frames\n", SAMPLE_DEPTH);
+    fprintf(f, "#   self   total  function\n");
+    for (i = 0; i < nfunc; i++)
+        order[i] = i;
+    qsort_r(order, nfunc, sizeof(int), sample_cmp_count, incl);
+    for (i = 0; i < nfunc && incl[order[i]]; i++) {
+        fn = order[i];
+        fprintf(f, "%7.2f%% %6.2f%%  %s\n", 100.0 * self[fn] / total, 100.0 * incl[fn] / total,
+                fn < nfunc - 1 ? syms[fn].name : "?");
+    }
+
+    fprintf(f, "\n# hottest PCs\n");
+    for (i = 0; i < MEMORY_MAX; i++)
+        order[i] = i;
+    qsort_r(order, MEMORY_MAX, sizeof(int), sample_cmp_count, pcs);
+    for (i = 0; i < SAMPLE_TOP && pcs[order[i]]; i++) {
+        const struct symbol *sym = sym_lookup_func(order[i]);
+
+        lc3_disasm(order[i], mem_get(order[i]), text, sizeof(text));
+        if (sym)
+            fprintf(f, "%7.2f%%  x%04X  %s+%d  %s\n", 100.0 * pcs[order[i]] / total, order[i],
+                    sym->name, order[i] - sym->addr, text);
+        else
+            fprintf(f, "%7.2f%%  x%04X  %s\n", 100.0 * pcs[order[i]] / total, order[i], text);
+    }
+
+    free(self);
+    free(incl);
+    free(seen);
+    free(pcs);
+    free(order);
+    return fclose(f) ? -1 : 0;
+}
+
+int sample_report()
+{
+    uint32_t i, total = 0, stacks = 0;
+    int ret = 0;
+
+    if (!sample_enabled)
+        return 0;
+    sample_thread_exit();
+    sample_enabled = 0;
+
+    for (i = 0; i < SAMPLE_STACKS; i++) {
+        if (sample_stacks[i].key) {
+            total += sample_stacks[i].count;
+            stacks++;
+        }
+    }
+
+    if (total && (sample_write_txt(total) < 0 || sample_write_folded() < 0)) {
+        fprintf(stderr, ">>> sample: failed to write %s.*\n", sample_prefix);
+        ret = -1;
+    }
+    fprintf(stderr, ">>> sample: %u samples, %u distinct stacks, %u dropped\n",
+            total, stacks, sample_dropped);
+
+    free(sample_stacks);
+    free(sample_entry);
+    sample_stacks = NULL;
+    sample_entry = NULL;
+    return ret;
+}
@@ -0,0 +1,41 @@
+#ifndef _SAMPLE_H_
+#define _SAMPLE_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <signal.h>
+
+// 采样剖析: 每个 vCPU 线程一个定时器 (timer_create + SIGPROF), 每 N 微秒采一次样.
+// 信号处理函数只设置该线程的 sample_pending, 下一个基本块结束时 (block_end)
+// 记录 PC 和调用栈. 未启用时每个基本块只多一次标志判断. 客户机阻塞在 GETC
+// 等处的时间不会被采到, 恢复执行时最多补一个样本.
+//
+// 调用栈沿 lcc 的帧指针 R5 回溯, JSR/RET 时不需要维护影子栈: 函数序言之后
+// M[R5 + 1] 为调用者的 R5, M[R5 + 2] 为返回地址. 刚跳到函数入口时帧还没有建立,
+// 返回地址在 R7. 不按 lcc 约定使用 R5 的汇编代码只有 PC 是准确的.
+//
+// 相同的 (PC, 调用栈) 合并计数, 放在无锁的散列表中 (各 vCPU 线程用 CAS 占用表项),
+// 内存占用固定, 可以一直开着. 表满后新的调用栈只计入丢弃数.
+//
+// 结束时按 .sym 中的函数 (跳过 lcc 的局部标号) 汇总, 写出:
+//   <prefix>.txt     每个函数的 self (PC 在函数内) 和 total (在调用栈上) 样本比例, 以及最热的 PC
+//   <prefix>.folded  每行一个调用栈 "main;foo;bar 次数", 可以直接交给 flamegraph.pl
+#define SAMPLE_US     1000
+#define SAMPLE_DEPTH  16
+#define SAMPLE_STACKS 4096  /* 散列表大小, 2 的幂 */
+#define SAMPLE_TOP    10    /* 报告中列出的热点 PC 数 */
+
+extern __thread volatile sig_atomic_t sample_pending;
+
+// 开始采样, 当前线程作为 CPU 0. interval_us 为 0 时用 SAMPLE_US. 返回 -1 表示无法创建定时器
+int sample_init(const char *prefix, unsigned interval_us);
+// 其它 vCPU 线程启动和退出时调用, 未启用采样时什么也不做
+int sample_thread();
+void sample_thread_exit();
+// 在 block_end 中调用, 记录当前 CPU 的一个样本
+void sample_take();
+// 停止采样, 写出结果文件并在 stderr 打印汇总
+int sample_report();
+
+#endif
@@ -0,0 +1,208 @@
+#include <string.h>
+
+#include "lc3.h"
+#include "cpu.h"
+#include "mem.h"
+#include "interrupt.h"
+#include "smp.h"
+#include "sample.h"
+
+__thread int smp_id;
+int smp_active;
+volatile uint8_t smp_ipi[SMP_MAX];
+pthread_mutex_t smp_dev_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// 原子操作和启动参数的锁存器
+static __thread uint16_t smp_addr, smp_old, smp_new;
+static __thread uint16_t smp_boot_pc, smp_boot_sp;
+
+static int smp_ncpus = 1;
+static volatile int smp_stop;
+static volatile uint16_t smp_running = 1;  /* CPU 0 一直在运行 */
+
+struct smp_cpu {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int boot;                /* 有待执行的启动请求 */
+    struct cpu_state state;  /* 启动时的寄存器 */
+};
+
+static struct smp_cpu smp_cpus[SMP_MAX];
+
+static void *smp_thread(void *arg)
+{
+    struct smp_cpu *cpu = arg;
+
+    smp_id = cpu - smp_cpus;
+    sample_thread();
+
+    pthread_mutex_lock(&cpu->lock);
+    while (1) {
+        while (!cpu->boot && !smp_stop)
+            pthread_cond_wait(&cpu->cond, &cpu->lock);
+        if (smp_stop)
+            break;
+        cpu->boot = 0;
+        pthread_mutex_unlock(&cpu->lock);
+
+        int_reset();
+        smp_ipi[smp_id] = 0;
+        cpu_load(&cpu->state);
+        while (!smp_stop && cpu_run_budget(SMP_SLICE))
+            ;
+
+        pthread_mutex_lock(&cpu->lock);
+        __atomic_and_fetch(&smp_running, ~(1 << smp_id), __ATOMIC_SEQ_CST);
+    }
+    pthread_mutex_unlock(&cpu->lock);
+    sample_thread_exit();
+
+    return NULL;
+}
+
+int smp_init(int n)
+{
+    int i;
+
+    if (n < 1 || n > SMP_MAX)
+        return -1;
+
+    smp_ncpus = n;
+    smp_stop = 0;
+    mem_set(SMP_HALT_STUB, 0XF000 | TRAP_HALT);
+    if (n == 1)
+        return 0;
+
+    for (i = 1; i < n; i++) {
+        pthread_mutex_init(&smp_cpus[i].lock, NULL);
+        pthread_cond_init(&smp_cpus[i].cond, NULL);
+        smp_cpus[i].boot = 0;
+        if (pthread_create(&smp_cpus[i].thread, NULL, smp_thread, &smp_cpus[i])) {
+            smp_ncpus = i;
+            break;
+        }
+    }
+    smp_active = 1;
+    printf(">>> smp: %d cpus\n", smp_ncpus);
+    return 0;
+}
+
+static void smp_boot(int id)
+{
+    struct smp_cpu *cpu = &smp_cpus[id];
+    struct cpu_state *st = &cpu->state;
+
+    if (id <= 0 || id >= smp_ncpus)
+        return;
+
+    pthread_mutex_lock(&cpu->lock);
+    if (!(smp_running & (1 << id))) {
+        cpu_save(st);
+        st->reg[R_PC] = smp_boot_pc;
+        st->reg[R_R5] = smp_boot_sp;
+        st->reg[R_R6] = smp_boot_sp;
+        st->reg[R_R7] = SMP_HALT_STUB;
+        st->reg[R_COND] = FL_ZRO;
+        st->priority = 0;
+        st->saved_ssp = 0x3000 - id * SMP_SSP_WORDS;
+        st->icount = 0;
+        st->block_start = smp_boot_pc;
+        cpu->boot = 1;
+        __atomic_or_fetch(&smp_running, 1 << id, __ATOMIC_SEQ_CST);
+        pthread_cond_signal(&cpu->cond);
+    }
+    pthread_mutex_unlock(&cpu->lock);
+}
+
+uint16_t smp_read(uint16_t address)
+{
+    uint16_t *memory = mem_addr();
+    uint16_t old;
+
+    switch (address) {
+        case SMP_CPUID:
+            return smp_id;
+        case SMP_NCPUS:
+            return smp_ncpus;
+        case SMP_ADDR:
+            return smp_addr;
+        case SMP_OLD:
+            return smp_old;
+        case SMP_NEW:
+            return smp_new;
+        case SMP_CAS:
+            old = smp_old;
+            __atomic_compare_exchange_n(&memory[smp_addr], &old, smp_new, 0,
+                    __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+            mem_dirty[smp_addr >> MEM_PAGE_SHIFT] = 1;
+            return old;
+        case SMP_TAS:
+            old = __atomic_exchange_n(&memory[smp_addr], 1, __ATOMIC_SEQ_CST);
+            mem_dirty[smp_addr >> MEM_PAGE_SHIFT] = 1;
+            return old;
+        case SMP_BOOT_PC:
+            return smp_boot_pc;
+        case SMP_BOOT_SP:
+            return smp_boot_sp;
+        case SMP_STATUS:
+            return smp_running;
+        default:
+            return 0;
+    }
+}
+
+void smp_write(uint16_t address, uint16_t val)
+{
+    switch (address) {
+        case SMP_IPI:
+            if (val < smp_ncpus)
+                __atomic_store_n(&smp_ipi[val], 1, __ATOMIC_SEQ_CST);
+            break;
+        case SMP_ADDR:
+            smp_addr = val;
+            break;
+        case SMP_OLD:
+            smp_old = val;
+            break;
+        case SMP_NEW:
+            smp_new = val;
+            break;
+        case SMP_BOOT_PC:
+            smp_boot_pc = val;
+            break;
+        case SMP_BOOT_SP:
+            smp_boot_sp = val;
+            break;
+        case SMP_BOOT:
+            smp_boot(val);
+            break;
+        default:
+            break;
+    }
+}
+
+void smp_ipi_ack()
+{
+    smp_ipi[smp_id] = 0;
+    int_raise(INTERRUPT_IPI, SMP_IPI_PRIORITY);
+}
+
+void smp_destroy()
+{
+    int i;
+
+    if (!smp_active)
+        return;
+
+    smp_stop = 1;
+    for (i = 1; i < smp_ncpus; i++) {
+        pthread_mutex_lock(&smp_cpus[i].lock);
+        pthread_cond_signal(&smp_cpus[i].cond);
+        pthread_mutex_unlock(&smp_cpus[i].lock);
+    }
+    for (i = 1; i < smp_ncpus; i++)
+        pthread_join(smp_cpus[i].thread, NULL);
+    smp_active = 0;
+    smp_ncpus = 1;
+}
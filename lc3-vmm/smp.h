@@ -0,0 +1,80 @@
+#ifndef _SMP_H_
+#define _SMP_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "mem.h"
+
+// 多处理器: --smp n 时有 n 个 vCPU 共用客户机内存, 每个 vCPU 一个主机线程.
+// CPU 0 在主线程上从 x3000 开始执行, 其他 CPU 停在启动前, 由客户机写 SMP_BOOT 启动.
+// 寄存器, 优先级, 定时器和待处理的中断都是每个 CPU 各自的 (线程局部变量),
+// 其他设备 (virtio, vconsole, 扩展内存) 共用, 访问时由一把锁串行化.
+// CPU 0 停机时整个虚拟机结束, 其他 CPU 在下一个时间片边界停下.
+//
+// 寄存器 (DEVICE_SMP 起始), 锁存器每个 CPU 各一份:
+// CPUID:   只读, 当前 CPU 的编号
+// NCPUS:   只读, CPU 个数
+// IPI:     写入目标 CPU 编号, 在目标 CPU 上产生 INTERRUPT_IPI 中断
+// ADDR:    原子操作的地址 (锁存)
+// OLD/NEW: CAS 的期望值和新值 (锁存)
+// CAS:     读: 若 M[ADDR] == OLD 则写入 NEW, 返回 M[ADDR] 原来的值
+// TAS:     读: 把 M[ADDR] 置 1, 返回原来的值
+// BOOT_PC/BOOT_SP: 启动参数 (锁存)
+// BOOT:    写入 CPU 编号, 该 CPU 以启动者寄存器的副本开始执行 BOOT_PC,
+//          R5 = R6 = BOOT_SP, R7 = SMP_HALT_STUB (函数返回时停机). 目标 CPU 正在运行时忽略
+// STATUS:  只读, 第 n 位为 1 表示 CPU n 正在运行
+#define SMP_CPUID   (DEVICE_SMP + 0)
+#define SMP_NCPUS   (DEVICE_SMP + 1)
+#define SMP_IPI     (DEVICE_SMP + 2)
+#define SMP_ADDR    (DEVICE_SMP + 3)
+#define SMP_OLD     (DEVICE_SMP + 4)
+#define SMP_NEW     (DEVICE_SMP + 5)
+#define SMP_CAS     (DEVICE_SMP + 6)
+#define SMP_TAS     (DEVICE_SMP + 7)
+#define SMP_BOOT_PC (DEVICE_SMP + 8)
+#define SMP_BOOT_SP (DEVICE_SMP + 9)
+#define SMP_BOOT    (DEVICE_SMP + 10)
+#define SMP_STATUS  (DEVICE_SMP + 11)
+#define SMP_END     (DEVICE_SMP + 12)
+
+// 存放一条 HALT 指令, 启动的 CPU 从入口函数返回时执行它
+#define SMP_HALT_STUB (DEVICE_SMP + 15)
+
+#define SMP_MAX 8
+#define SMP_IPI_PRIORITY 5
+// 每个 CPU 的监督栈 (中断时使用), CPU n 从 x3000 - n * SMP_SSP_WORDS 向下增长
+#define SMP_SSP_WORDS 0X400
+// 其他 CPU 每执行这么多条指令检查一次是否要结束
+#define SMP_SLICE 4096
+
+extern __thread int smp_id;
+extern int smp_active;
+extern volatile uint8_t smp_ipi[SMP_MAX];
+extern pthread_mutex_t smp_dev_lock;
+
+// 共用设备的锁, 只有一个 CPU 时不加锁
+static inline void smp_lock()
+{
+    if (smp_active)
+        pthread_mutex_lock(&smp_dev_lock);
+}
+
+static inline void smp_unlock()
+{
+    if (smp_active)
+        pthread_mutex_unlock(&smp_dev_lock);
+}
+
+// 创建 CPU 1 .. n-1 的线程, 在 cpu_reset 之后调用. 返回 -1 表示失败
+int smp_init(int n);
+uint16_t smp_read(uint16_t address);
+void smp_write(uint16_t address, uint16_t val);
+// 在基本块结束时由 block_end 调用: 把发给本 CPU 的 IPI 转成中断
+void smp_ipi_ack();
+// 结束其他 CPU 并等待线程退出
+void smp_destroy();
+
+#endif
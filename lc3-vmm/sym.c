@@ -0,0 +1,118 @@
+#include <string.h>
+
+#include "sym.h"
+
+static struct symbol *symbols = NULL;
+static int nsyms = 0;
+static int capacity = 0;
+static int sorted = 1;
+
+void sym_add(const char *name, uint16_t addr)
+{
+    if (nsyms == capacity) {
+        capacity = capacity ? capacity * 2 : 64;
+        symbols = (struct symbol *)realloc(symbols, capacity * sizeof(struct symbol));
+    }
+
+    symbols[nsyms].addr = addr;
+    strncpy(symbols[nsyms].name, name, SYM_NAME_MAX - 1);
+    symbols[nsyms].name[SYM_NAME_MAX - 1] = '\0';
+    nsyms++;
+    sorted = 0;
+}
+
+void sym_clear()
+{
+    free(symbols);
+    symbols = NULL;
+    nsyms = capacity = 0;
+    sorted = 1;
+}
+
+// 格式:
+// //	Symbol Name       Page Address
+// //	----------------  ------------
+// //	INIT_CODE         3000
+int sym_load(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    char line[256], name[SYM_NAME_MAX];
+    unsigned int addr;
+    int n = 0;
+
+    if (!file) {
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), file)) {
+        if (strncmp(line, "//\t", 3) != 0)
+            continue;
+        if (sscanf(line + 3, "%31s %x", name, &addr) != 2)
+            continue;
+        if (addr > 0xFFFF)
+            continue;
+        sym_add(name, addr);
+        n++;
+    }
+
+    fclose(file);
+    return n;
+}
+
+int sym_count()
+{
+    return nsyms;
+}
+
+static int sym_cmp(const void *a, const void *b)
+{
+    return (int)((const struct symbol *)a)->addr - (int)((const struct symbol *)b)->addr;
+}
+
+const struct symbol *sym_table()
+{
+    if (!sorted) {
+        qsort(symbols, nsyms, sizeof(struct symbol), sym_cmp);
+        sorted = 1;
+    }
+    return symbols;
+}
+
+const struct symbol *sym_lookup(uint16_t addr)
+{
+    const struct symbol *table = sym_table();
+    int lo = 0, hi = nsyms - 1, mid;
+    const struct symbol *found = NULL;
+
+    while (lo <= hi) {
+        mid = (lo + hi) / 2;
+        if (table[mid].addr <= addr) {
+            found = &table[mid];
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return found;
+}
+
+int sym_local(const char *name)
+{
+    const char *p = strncmp(name, "lc3_", 4) ? name : name + 4;
+
+    if (*p++ != 'L' || *p < '0' || *p > '9')
+        return 0;
+    while (*p >= '0' && *p <= '9')
+        p++;
+    return *p == '\0' || *p == '_';
+}
+
+const struct symbol *sym_lookup_func(uint16_t addr)
+{
+    const struct symbol *table = sym_table();
+    const struct symbol *s = sym_lookup(addr);
+
+    while (s && sym_local(s->name))
+        s = s > table ? s - 1 : NULL;
+    return s;
+}
@@ -0,0 +1,28 @@
+#ifndef _SYM_H_
+#define _SYM_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// lcc/lc3as 生成的 .sym 符号表
+#define SYM_NAME_MAX 32
+
+struct symbol {
+    uint16_t addr;
+    char name[SYM_NAME_MAX];
+};
+
+int sym_load(const char *path);
+void sym_add(const char *name, uint16_t addr);
+void sym_clear();
+int sym_count();
+const struct symbol *sym_table();
+// 返回地址不大于 addr 的最近符号, 没有时返回 NULL
+const struct symbol *sym_lookup(uint16_t addr);
+// lcc 生成的局部标号 (L12, L2_main, lc3_L3_main), 不是函数入口
+int sym_local(const char *name);
+// 同 sym_lookup, 但跳过局部标号, 即 addr 所在的函数
+const struct symbol *sym_lookup_func(uint16_t addr);
+
+#endif
@@ -0,0 +1,118 @@
+#include <time.h>
+
+#include "mem.h"
+#include "timer.h"
+#include "interrupt.h"
+
+// 每个 vCPU 有自己的定时器状态, 寄存器是共用的
+__thread uint64_t timer_deadline = UINT64_MAX;
+
+static __thread uint16_t timer_ctrl;
+static __thread uint32_t timer_period;
+static __thread uint64_t timer_expire;  /* 到期时的指令数或主机微秒数 */
+
+static uint64_t timer_now_us()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void timer_arm(uint64_t icount, uint64_t base)
+{
+    if (!(timer_ctrl & TIMER_EN) || !timer_period) {
+        timer_deadline = UINT64_MAX;
+        return;
+    }
+
+    timer_expire = base + timer_period;
+    if (timer_ctrl & TIMER_USEC) {
+        timer_deadline = icount + TIMER_USEC_POLL;
+    } else {
+        timer_deadline = timer_expire;
+    }
+}
+
+void timer_init()
+{
+    int i;
+
+    for (i = DEVICE_TIMER; i < TIMER_END; i++) {
+        mem_set(i, 0);
+    }
+    timer_ctrl = 0;
+    timer_period = 0;
+    timer_deadline = UINT64_MAX;
+}
+
+void timer_write(uint16_t address, uint16_t val, uint64_t icount)
+{
+    switch (address) {
+        case TIMER_CTRL:
+            timer_ctrl = val;
+            timer_period = ((uint32_t)mem_get(TIMER_PERIOD_H) << 16) | mem_get(TIMER_PERIOD_L);
+            timer_arm(icount, (val & TIMER_USEC) ? timer_now_us() : icount);
+            break;
+        default:
+            break;
+    }
+}
+
+void timer_read(uint16_t address, uint64_t icount)
+{
+    uint64_t now, remain = 0;
+
+    if (address != TIMER_COUNT_L && address != TIMER_COUNT_H)
+        return;
+
+    if (timer_ctrl & TIMER_EN) {
+        now = (timer_ctrl & TIMER_USEC) ? timer_now_us() : icount;
+        remain = timer_expire > now ? timer_expire - now : 0;
+    }
+    mem_set(TIMER_COUNT_L, remain & 0xFFFF);
+    mem_set(TIMER_COUNT_H, (remain >> 16) & 0xFFFF);
+}
+
+void timer_tick(uint64_t icount)
+{
+    uint64_t now = icount;
+
+    if (timer_ctrl & TIMER_USEC) {
+        now = timer_now_us();
+        if (now < timer_expire) {
+            timer_deadline = icount + TIMER_USEC_POLL;
+            return;
+        }
+    }
+
+    mem_set(TIMER_STATUS, mem_get(TIMER_STATUS) | TIMER_EXPIRED);
+    if (timer_ctrl & TIMER_IRQ) {
+        int_raise(INTERRUPT_TIMER, TIMER_PRIORITY);
+    }
+
+    if (timer_ctrl & TIMER_PERIODIC) {
+        // 从上一次到期点续算, 避免周期漂移; 落后太多时从当前时刻重新开始
+        timer_arm(icount, timer_expire + timer_period > now ? timer_expire : now);
+    } else {
+        timer_ctrl &= ~TIMER_EN;
+        mem_set(TIMER_CTRL, timer_ctrl);
+        timer_deadline = UINT64_MAX;
+    }
+}
+
+void timer_save(struct timer_state *state)
+{
+    state->ctrl = timer_ctrl;
+    state->period = timer_period;
+    state->expire = timer_expire;
+    state->deadline = timer_deadline;
+}
+
+void timer_load(const struct timer_state *state)
+{
+    timer_ctrl = state->ctrl;
+    timer_period = state->period;
+    timer_expire = state->expire;
+    timer_deadline = state->deadline;
+}
@@ -0,0 +1,54 @@
+#ifndef _TIMER_H_
+#define _TIMER_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "mem.h"
+
+// 定时器寄存器 (DEVICE_TIMER 起始)
+// CTRL:   bit0 使能, bit1 微秒模式 (否则按指令数), bit2 周期模式, bit3 产生中断
+// STATUS: bit0 已到期, 客户机写 0 清除
+// PERIOD: 32 位周期, 写 CTRL 时生效
+// COUNT:  32 位剩余计数, 只读
+#define TIMER_CTRL     (DEVICE_TIMER + 0)
+#define TIMER_STATUS   (DEVICE_TIMER + 1)
+#define TIMER_PERIOD_L (DEVICE_TIMER + 2)
+#define TIMER_PERIOD_H (DEVICE_TIMER + 3)
+#define TIMER_COUNT_L  (DEVICE_TIMER + 4)
+#define TIMER_COUNT_H  (DEVICE_TIMER + 5)
+#define TIMER_END      (DEVICE_TIMER + 6)
+
+#define TIMER_EN       0X0001
+#define TIMER_USEC     0X0002
+#define TIMER_PERIODIC 0X0004
+#define TIMER_IRQ      0X0008
+
+#define TIMER_EXPIRED  0X0001
+
+#define TIMER_PRIORITY 4
+
+// 微秒模式下每执行这么多指令才读一次主机时钟
+#define TIMER_USEC_POLL 1024
+
+// 解释器在基本块结束时比较指令计数和 timer_deadline, 到达后调用 timer_tick
+extern __thread uint64_t timer_deadline;
+
+// 定时器的内部状态, 寄存器本身在客户机内存中
+struct timer_state {
+    uint16_t ctrl;
+    uint32_t period;
+    uint64_t expire;
+    uint64_t deadline;
+};
+
+void timer_init();
+void timer_write(uint16_t address, uint16_t val, uint64_t icount);
+void timer_read(uint16_t address, uint64_t icount);
+void timer_tick(uint64_t icount);
+void timer_save(struct timer_state *state);
+void timer_load(const struct timer_state *state);
+
+#endif
@@ -0,0 +1,204 @@
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/uio.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "virtio.h"
+#include "mem.h"
+#include "dedup.h"
+
+#define VCONSOLE_IDX DEVICE_VCONSOLE
+
+static int vcons_in = -1;   /* host -> guest (rx) */
+static int vcons_out = -1;  /* guest -> host (tx) */
+
+static struct vconsole *vconsole_ring()
+{
+    return (struct vconsole *)&(mem_addr()[VCONSOLE_IDX]);
+}
+
+// 主机端可以是 Unix socket, 也可以是 FIFO/普通文件; 未指定时 tx 输出到 stdout
+int vconsole_init(const char *path)
+{
+    struct vconsole *vc = vconsole_ring();
+    struct sockaddr_un addr;
+    struct stat st;
+    int fd;
+
+    memset(vc, 0, sizeof(*vc));
+
+    vcons_in = -1;
+    vcons_out = STDOUT_FILENO;
+    if (!path)
+        return 0;
+
+    if (stat(path, &st) == 0 && S_ISSOCK(st.st_mode)) {
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        if (strlen(path) >= sizeof(addr.sun_path))
+            return -1;
+        strcpy(addr.sun_path, path);
+
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0)
+            return -1;
+        if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+            close(fd);
+            return -1;
+        }
+    } else {
+        fd = open(path, O_RDWR | O_CLOEXEC);
+        if (fd < 0)
+            return -1;
+    }
+
+    vcons_in = vcons_out = fd;
+    printf(">>> vconsole: %s  addr: 0x%x\n", path, VCONSOLE_IDX);
+    return 0;
+}
+
+void vconsole_destroy()
+{
+    if (vcons_in >= 0 && vcons_in != STDIN_FILENO)
+        close(vcons_in);
+    if (vcons_out >= 0 && vcons_out != vcons_in && vcons_out != STDOUT_FILENO)
+        close(vcons_out);
+    vcons_in = vcons_out = -1;
+}
+
+// 把 [used_idx, avail_idx) 之间的描述符直接映射为 iovec, 不做拷贝.
+// 缓冲区的打包格式 (低字节在前) 与小端主机的内存布局一致.
+static int vconsole_iov(struct vconsole_queue *q, struct iovec *iov)
+{
+    uint16_t idx = q->used_idx;
+    uint16_t *memory = mem_addr();
+    struct vring_desc *desc;
+    size_t len, max;
+    int n = 0;
+
+    while (idx != q->avail_idx && n < VCONSOLE_QUEUE_SIZE) {
+        desc = &q->desc[idx % VCONSOLE_QUEUE_SIZE];
+        len = desc->len;
+        max = (MEMORY_MAX - desc->addr) * sizeof(uint16_t);
+        iov[n].iov_base = (void *)&memory[desc->addr];
+        iov[n].iov_len = len < max ? len : max;
+        n++;
+        idx++;
+    }
+    return n;
+}
+
+static void vconsole_tx(struct vconsole_queue *q)
+{
+    struct iovec iov[VCONSOLE_QUEUE_SIZE];
+    struct iovec *p = iov;
+    int n = vconsole_iov(q, iov);
+    ssize_t ret;
+
+    if (!n)
+        return;
+
+    if (vcons_out == STDOUT_FILENO)
+        fflush(stdout);
+
+    // 一次 writev 提交所有待发送的描述符, 仅在部分写入时重试剩余部分
+    while (n > 0 && vcons_out >= 0) {
+        ret = writev(vcons_out, p, n);
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        while (n > 0 && (size_t)ret >= p->iov_len) {
+            ret -= p->iov_len;
+            p++;
+            n--;
+        }
+        if (n > 0) {
+            p->iov_base = (char *)p->iov_base + ret;
+            p->iov_len -= ret;
+        }
+    }
+
+    q->used_idx = q->avail_idx;
+}
+
+static void vconsole_rx(struct vconsole_queue *q)
+{
+    struct iovec iov[VCONSOLE_QUEUE_SIZE], *p;
+    struct pollfd pfd;
+    struct vring_desc *desc;
+    int i, n;
+    ssize_t ret;
+
+    if (vcons_in < 0)
+        return;
+
+    n = vconsole_iov(q, iov);
+    if (!n)
+        return;
+
+    pfd.fd = vcons_in;
+    pfd.events = POLLIN;
+    if (poll(&pfd, 1, 0) <= 0)
+        return;
+
+    // 内核写共享的只读页会返回 EFAULT, 先换回可写的映射
+    for (p = iov; p < iov + n; p++) {
+        if (dedup_unshare((uint16_t *)p->iov_base - mem_addr(), (p->iov_len + 1) / 2) < 0)
+            return;
+    }
+
+    ret = readv(vcons_in, iov, n);
+    if (ret <= 0) {
+        if (ret == 0 || errno != EINTR) {
+            /* 对端关闭, 不再接收 */
+            vcons_in = -1;
+        }
+        return;
+    }
+
+    // 按填充顺序回写每个描述符的实际长度, 未用到的描述符保留给下一次
+    for (i = 0; i < n && ret > 0; i++) {
+        desc = &q->desc[q->used_idx % VCONSOLE_QUEUE_SIZE];
+        if ((size_t)ret < iov[i].iov_len) {
+            desc->len = ret;
+            ret = 0;
+        } else {
+            desc->len = iov[i].iov_len;
+            ret -= iov[i].iov_len;
+        }
+        mem_touch(desc->addr, (desc->len + 1) / 2);
+        q->used_idx++;
+    }
+}
+
+int vconsole_handler(uint16_t flags)
+{
+    struct vconsole *vc = vconsole_ring();
+
+    if (!(flags & (VCONSOLE_KICK_TX | VCONSOLE_KICK_RX)))
+        return -1;
+
+    if (flags & VCONSOLE_KICK_TX) {
+        vconsole_tx(&vc->tx);
+    }
+    if (flags & VCONSOLE_KICK_RX) {
+        vconsole_rx(&vc->rx);
+    }
+    return 0;
+}
+
+// 客户机轮询中断标志时尝试接收, 不阻塞
+void vconsole_poll()
+{
+    vconsole_rx(&vconsole_ring()->rx);
+}
+
+void vconsole_replay()
+{
+    mem_set(INTERRUPT_VCONSOLE, VCONSOLE_REPLAY);
+}
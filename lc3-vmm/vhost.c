@@ -0,0 +1,301 @@
+#include <string.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/eventfd.h>
+
+#include "mem.h"
+#include "virtio.h"
+#include "disk.h"
+#include "vhost.h"
+
+static int vhost_sock = -1;
+static int vhost_kick_fd = -1;
+static int vhost_call_fd = -1;
+
+static int vhost_send(int sock, uint32_t request, uint64_t payload, int fd)
+{
+    struct vhost_user_msg msg;
+    struct iovec iov;
+    struct msghdr mh;
+    char control[CMSG_SPACE(sizeof(int))];
+
+    memset(&msg, 0, sizeof(msg));
+    msg.request = request;
+    msg.payload = payload;
+
+    iov.iov_base = &msg;
+    iov.iov_len = sizeof(msg);
+
+    memset(&mh, 0, sizeof(mh));
+    mh.msg_iov = &iov;
+    mh.msg_iovlen = 1;
+
+    if (fd >= 0) {
+        struct cmsghdr *cmsg;
+
+        memset(control, 0, sizeof(control));
+        mh.msg_control = control;
+        mh.msg_controllen = sizeof(control);
+        cmsg = CMSG_FIRSTHDR(&mh);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    }
+
+    return sendmsg(sock, &mh, MSG_NOSIGNAL) == sizeof(msg) ? 0 : -1;
+}
+
+// 返回值: 1 收到消息, 0 对端关闭, -1 出错
+static int vhost_recv(int sock, struct vhost_user_msg *msg, int *fd)
+{
+    struct iovec iov;
+    struct msghdr mh;
+    struct cmsghdr *cmsg;
+    char control[CMSG_SPACE(sizeof(int))];
+    ssize_t n;
+
+    *fd = -1;
+    iov.iov_base = msg;
+    iov.iov_len = sizeof(*msg);
+
+    memset(&mh, 0, sizeof(mh));
+    mh.msg_iov = &iov;
+    mh.msg_iovlen = 1;
+    mh.msg_control = control;
+    mh.msg_controllen = sizeof(control);
+
+    n = recvmsg(sock, &mh, MSG_CMSG_CLOEXEC);
+    if (n == 0)
+        return 0;
+    if (n != sizeof(*msg))
+        return -1;
+
+    for (cmsg = CMSG_FIRSTHDR(&mh); cmsg; cmsg = CMSG_NXTHDR(&mh, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+            memcpy(fd, CMSG_DATA(cmsg), sizeof(int));
+        }
+    }
+    return 1;
+}
+
+static int vhost_sockaddr(const char *path, struct sockaddr_un *addr)
+{
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr->sun_path))
+        return -1;
+    strcpy(addr->sun_path, path);
+    return 0;
+}
+
+int vhost_connect(const char *path)
+{
+    struct sockaddr_un addr;
+
+    if (mem_fd() < 0 || vhost_sockaddr(path, &addr) < 0)
+        return -1;
+
+    vhost_sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (vhost_sock < 0)
+        return -1;
+    if (connect(vhost_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+        goto err;
+
+    vhost_kick_fd = eventfd(0, EFD_CLOEXEC);
+    vhost_call_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (vhost_kick_fd < 0 || vhost_call_fd < 0)
+        goto err;
+
+    if (vhost_send(vhost_sock, VHOST_USER_SET_MEM_TABLE,
+                MEMORY_MAX * sizeof(uint16_t), mem_fd()) < 0 ||
+            vhost_send(vhost_sock, VHOST_USER_SET_VRING_ADDR, DEVICE_VIRTIO, -1) < 0 ||
+            vhost_send(vhost_sock, VHOST_USER_SET_VRING_KICK, 0, vhost_kick_fd) < 0 ||
+            vhost_send(vhost_sock, VHOST_USER_SET_VRING_CALL, 0, vhost_call_fd) < 0)
+        goto err;
+
+    printf(">>> vhost connected: %s\n", path);
+    return 0;
+
+err:
+    vhost_disconnect();
+    return -1;
+}
+
+int vhost_active()
+{
+    return vhost_sock >= 0;
+}
+
+void vhost_disconnect()
+{
+    if (vhost_sock >= 0)
+        close(vhost_sock);
+    if (vhost_kick_fd >= 0)
+        close(vhost_kick_fd);
+    if (vhost_call_fd >= 0)
+        close(vhost_call_fd);
+    vhost_sock = vhost_kick_fd = vhost_call_fd = -1;
+}
+
+// 后端进程退出后, 由 VMM 内置的 virtio 设备接管, 客户机不受影响
+static void vhost_lost(uint16_t entry)
+{
+    uint16_t flags;
+
+    printf(">>> vhost backend lost, fallback to builtin virtio\n");
+    vhost_disconnect();
+
+    flags = mem_get(entry);
+    if (flags == 0x01 && !virtio_handler(flags)) {
+        virtio_replay();
+    }
+}
+
+void vhost_kick(uint16_t entry)
+{
+    uint64_t one = 1;
+
+    if (write(vhost_kick_fd, &one, sizeof(one)) != sizeof(one)) {
+        vhost_lost(entry);
+    }
+}
+
+// 客户机轮询 INTERRUPT_VIRTIO 时调用, 一次 poll 同时检查 call 通知和后端存活
+void vhost_poll(uint16_t entry)
+{
+    struct pollfd pfd[2];
+    uint64_t val;
+
+    pfd[0].fd = vhost_call_fd;
+    pfd[0].events = POLLIN;
+    pfd[1].fd = vhost_sock;
+    pfd[1].events = POLLIN | POLLRDHUP;
+
+    if (poll(pfd, 2, 0) <= 0)
+        return;
+
+    if (pfd[0].revents & POLLIN) {
+        if (read(vhost_call_fd, &val, sizeof(val)) == sizeof(val)) {
+            virtio_replay();
+        }
+        return;
+    }
+
+    if (pfd[1].revents) {
+        vhost_lost(entry);
+    }
+}
+
+static void vhost_backend_serve(int conn)
+{
+    struct vhost_user_msg msg;
+    struct pollfd pfd[2];
+    int kick_fd = -1, call_fd = -1;
+    int fd, ret, nfds;
+    uint64_t val;
+
+    while (1) {
+        pfd[0].fd = conn;
+        pfd[0].events = POLLIN;
+        pfd[1].fd = kick_fd;
+        pfd[1].events = POLLIN;
+        nfds = (kick_fd >= 0 && mem_addr()) ? 2 : 1;
+
+        if (poll(pfd, nfds, -1) < 0)
+            break;
+
+        if (nfds == 2 && (pfd[1].revents & POLLIN)) {
+            if (read(kick_fd, &val, sizeof(val)) == sizeof(val)) {
+                if (!virtio_handler(mem_get(INTERRUPT_VIRTIO)) && call_fd >= 0) {
+                    val = 1;
+                    if (write(call_fd, &val, sizeof(val)) != sizeof(val))
+                        break;
+                }
+                fflush(stdout);
+            }
+        }
+
+        if (!pfd[0].revents)
+            continue;
+
+        ret = vhost_recv(conn, &msg, &fd);
+        if (ret <= 0)
+            break;
+
+        switch (msg.request) {
+            case VHOST_USER_SET_MEM_TABLE:
+                if (fd < 0 || msg.payload != MEMORY_MAX * sizeof(uint16_t) ||
+                        mem_attach(fd) < 0) {
+                    printf(">>> vhost: bad mem table\n");
+                    if (fd >= 0)
+                        close(fd);
+                }
+                break;
+            case VHOST_USER_SET_VRING_ADDR:
+                if (msg.payload != DEVICE_VIRTIO) {
+                    printf(">>> vhost: unsupported vring addr 0x%x\n", (unsigned)msg.payload);
+                }
+                break;
+            case VHOST_USER_SET_VRING_KICK:
+                if (kick_fd >= 0)
+                    close(kick_fd);
+                kick_fd = fd;
+                break;
+            case VHOST_USER_SET_VRING_CALL:
+                if (call_fd >= 0)
+                    close(call_fd);
+                call_fd = fd;
+                break;
+            default:
+                printf(">>> vhost: unknown request %u\n", msg.request);
+                if (fd >= 0)
+                    close(fd);
+                break;
+        }
+    }
+
+    if (kick_fd >= 0)
+        close(kick_fd);
+    if (call_fd >= 0)
+        close(call_fd);
+    mem_destroy();
+}
+
+int vhost_backend_run(const char *path)
+{
+    struct sockaddr_un addr;
+    int sock, conn;
+
+    if (vhost_sockaddr(path, &addr) < 0)
+        return -1;
+
+    sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (sock < 0)
+        return -1;
+
+    unlink(path);
+    if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(sock, 1) < 0) {
+        close(sock);
+        return -1;
+    }
+
+    printf(">>> vhost backend listening: %s\n", path);
+    fflush(stdout);
+
+    // 一次服务一个 VMM, 断开后继续等待下一个
+    while ((conn = accept4(sock, NULL, NULL, SOCK_CLOEXEC)) >= 0) {
+        vhost_backend_serve(conn);
+        close(conn);
+        // 前端断开时把磁盘的脏页写回, 下一个 VMM 打开同一个文件也能看到
+        if (disk_flush() < 0)
+            printf(">>> vhost: disk writeback failed\n");
+        printf(">>> vhost frontend disconnected\n");
+        fflush(stdout);
+    }
+
+    close(sock);
+    unlink(path);
+    return 0;
+}
@@ -0,0 +1,38 @@
+#ifndef _VHOST_H_
+#define _VHOST_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// vhost-user 风格的进程外设备后端
+// VMM 通过 Unix socket 把客户机内存 (memfd) 以及 kick/call 两个 eventfd
+// 传给后端进程, 后端直接在共享内存上处理 vring:
+// - kick: VMM -> 后端, 客户机写 INTERRUPT_VIRTIO 时触发
+// - call: 后端 -> VMM, 请求处理完成, VMM 据此设置 replay 标志
+enum
+{
+    VHOST_USER_NONE = 0,
+    VHOST_USER_SET_MEM_TABLE,   /* fd: guest memory, payload: size in bytes */
+    VHOST_USER_SET_VRING_ADDR,  /* payload: vring address in guest words */
+    VHOST_USER_SET_VRING_KICK,  /* fd: eventfd, vmm -> backend */
+    VHOST_USER_SET_VRING_CALL,  /* fd: eventfd, backend -> vmm */
+    VHOST_USER_MAX
+};
+
+struct vhost_user_msg {
+    uint32_t request;
+    uint32_t flags;
+    uint64_t payload;
+};
+
+int vhost_connect(const char *path);
+int vhost_active();
+void vhost_kick(uint16_t entry);
+void vhost_poll(uint16_t entry);
+void vhost_disconnect();
+
+int vhost_backend_run(const char *path);
+
+#endif
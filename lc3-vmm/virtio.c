@@ -1,5 +1,6 @@
 #include "virtio.h"
 #include "mem.h"
+#include "disk.h"
 
 #define VIRTIO_IDX DEVICE_VIRTIO
 
@@ -29,14 +30,39 @@ void virtio_init()
     printf(">>> vring size:%d  addr: 0x%x\n", sizeof(struct vring), (uint16_t *)virt_ring - memory);
 }
 
+// 请求的数据不能超出描述符的缓冲区
+static uint16_t virtio_blk_len(struct vring_desc *desc, struct virtio_blk *vb)
+{
+    uint16_t max = desc->len > sizeof(struct virtio_blk) / 2 ? desc->len - sizeof(struct virtio_blk) / 2 : 0;
+
+    return (uint16_t)vb->len < max ? (uint16_t)vb->len : max;
+}
+
+// 数据缓冲区: 紧跟在请求头后面, 或者在链上的下一个描述符中 (不超过内存末尾)
+static uint16_t *virtio_blk_data(struct vring *virt_ring, uint16_t idx, uint16_t flags,
+        struct virtio_blk *vb, uint16_t *len)
+{
+    struct vring_desc *next;
+    uint32_t max;
+
+    if (!(flags & VIRTIO_DESC_NEXT)) {
+        *len = virtio_blk_len(&virt_ring->desc[idx], vb);
+        return vb->buf;
+    }
+    next = &virt_ring->desc[virt_ring->desc[idx].next % VRING_SIZE];
+    max = next->len < MEMORY_MAX - next->addr ? next->len : MEMORY_MAX - next->addr;
+    *len = (uint16_t)vb->len < max ? (uint16_t)vb->len : max;
+    return mem_addr() + next->addr;
+}
+
 int virtio_handler(uint16_t flags)
 {
     uint16_t *memory = mem_addr();
     uint16_t *virtio_memory = (uint16_t *)(&(memory[VIRTIO_IDX]));
     struct vring *virt_ring = (struct vring *)virtio_memory;
 
-    uint16_t avail_idx, i;
-    uint16_t *buf16 = NULL;
+    uint16_t avail_idx, i, dflags, len;
+    uint16_t *data;
     struct virtio_blk *vb;
 
     printf(">>> virtio handler: 0x%x \n", flags);
@@ -47,17 +73,27 @@ int virtio_handler(uint16_t flags)
 
             avail_idx = virt_ring->avail.idx;
 
-            if (virt_ring->desc[avail_idx].flags & 0x01) {
+            dflags = virt_ring->desc[avail_idx].flags;
+            if (dflags & 0x01) {
                 virt_ring->desc[avail_idx].flags = 0;
 
                 vb = (struct virtio_blk *)&(memory[virt_ring->desc[avail_idx].addr]);
+                data = virtio_blk_data(virt_ring, avail_idx, dflags, vb, &len);
                 if (vb->flag == VIRTIO_BLK_R) {
                     vb->flag = 0;
 
                     printf(">>> read pos: %d len: %d \n", vb->pos, vb->len);
-                    for (i = 0; i < vb->len; i++) {
-                        vb->buf[i] = '0' + vb->pos + i;
+                    if (disk_active()) {
+                        if (disk_read((uint16_t)vb->pos, data, len) < 0)
+                            printf(">>> disk read error\n");
+                    } else {
+                        // 没有 --disk 时返回固定的测试数据
+                        for (i = 0; i < len; i++) {
+                            data[i] = '0' + vb->pos + i;
+                        }
                     }
+                    // 主机直接写入的缓冲区, 迁移时要重新发送
+                    mem_touch(data - memory, len);
 
                     virt_ring->used.flags = 0x01;
                     virt_ring->used.idx = avail_idx;
@@ -67,9 +103,14 @@ int virtio_handler(uint16_t flags)
                     vb->flag = 0;
 
                     printf(">>> write pos:%d len:%d \n", vb->pos, vb->len);
+                    if (disk_active()) {
+                        if (disk_write((uint16_t)vb->pos, data, len) < 0)
+                            printf(">>> disk write error\n");
+                        return 0;
+                    }
                     printf(">>> buf: ");
-                    for (i = 0; i < vb->len; i++) {
-                        printf("%c", vb->buf[i]);
+                    for (i = 0; i < len; i++) {
+                        printf("%c", data[i]);
                     }
                 }
             }
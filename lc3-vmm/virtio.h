@@ -48,6 +48,10 @@ struct vring {
 #define VIRTIO_BLK_R 0X0001
 #define VIRTIO_BLK_W 0X0002
 
+// 描述符 flags: bit0 表示请求已提交. 带 VIRTIO_DESC_NEXT 时描述符只放请求头,
+// 数据在 desc[next] 指向的缓冲区中, 客户机可以直接读写到自己的数组里
+#define VIRTIO_DESC_NEXT 0X0002
+
 struct virtio_blk {
     int16_t flag;
     int16_t pos;
@@ -55,8 +59,34 @@ struct virtio_blk {
     uint16_t buf[0]; // only for vmm
 };
 
+// virtio console: 字节流设备, rx/tx 两个队列
+// avail_idx 由客户机递增, used_idx 由主机递增, 均为自由计数, 取模得到描述符下标.
+// 缓冲区中每个字存放两个字节 (低字节在前, 同 PUTSP), len 以字节为单位.
+enum { VCONSOLE_QUEUE_SIZE = 16 };
+
+#define VCONSOLE_KICK_TX 0X0001
+#define VCONSOLE_REPLAY  0X0002
+#define VCONSOLE_KICK_RX 0X0004
+
+struct vconsole_queue {
+    __virtio16 avail_idx;
+    __virtio16 used_idx;
+    struct vring_desc desc[VCONSOLE_QUEUE_SIZE];
+};
+
+struct vconsole {
+    struct vconsole_queue rx;
+    struct vconsole_queue tx;
+};
+
 void virtio_init();
 int virtio_handler(uint16_t flags);
 int virtio_replay();
 
+int vconsole_init(const char *path);
+int vconsole_handler(uint16_t flags);
+void vconsole_poll();
+void vconsole_replay();
+void vconsole_destroy();
+
 #endif
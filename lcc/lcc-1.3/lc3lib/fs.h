@@ -0,0 +1,44 @@
+// lc3fs 只读文件系统 (格式见 lc3-fs/fs.h), 需要 lc3-vmm --disk 启动, 镜像由 lc3-mkfs 生成
+//   fs_mount();
+//   fd = fs_open("hello.txt");
+//   n = fs_read(fd, buf, 100);  /* 每个字一个字节 */
+//   fs_seek(fd, 0);
+//   fs_close(fd);
+// 函数在 lc3lib/stdio.asm 中. 读请求用两个链起来的 virtio 描述符, 请求头在 FS_HDR,
+// 数据描述符直接指向目标数组: 要读的字数盖住当前区段的剩余部分时, 整段一次读进
+// 调用者的 buf; 小块读一次取到块末尾放进 FS_DATA, 之后顺序读从那里取.
+#define FS_MAGIC    0x4C46
+#define FS_BLOCK    256
+#define FS_NAME_MAX 20
+#define FS_EXTENTS  5
+#define FS_ENTRY    32
+#define FS_SIZE     20    /* 目录项中的字偏移: 名字, 大小, 区段数, 区段 */
+#define FS_NEXT     21
+#define FS_EXT      22
+#define FS_FILES    4     /* 同时打开的文件数 */
+
+// 库的状态在固定地址 (监督栈下面, 同 getchar 的输入缓冲区), 不占程序空间
+#define FS_HDR      ((int *)0x0300)  /* 请求头 flag, pos, len */
+#define FS_DATA     ((int *)0x0340)  /* FS_BLOCK 个字, 目录项和小块读的缓冲区 */
+
+// vring 的字偏移 (lc3-vmm/virtio.h): num, desc[10] 每项 addr/len/flags/next, avail, used
+#define FS_VRING      ((int *)0x7FFF)
+#define FS_KICK       ((int *)0x0100)
+#define FS_DESCS      10
+#define FS_AVAIL      41
+#define FS_USED       43
+
+// 从磁盘的 pos 字处读 len 个字到 buf, 返回 len, 失败时返回 -1. pos 按无符号传给设备
+extern int fs_blk_read(int pos, int len, int *buf);
+// 把第 i 个目录项读到 FS_DATA, 返回 FS_DATA, 失败时返回 0
+extern int *fs_entry(int i);
+// 返回文件数, 不是 lc3fs 磁盘时返回 -1
+extern int fs_mount();
+// 第 i 个文件的名字复制到 name, 返回文件大小, 没有这个文件时返回 -1
+extern int fs_list(int i, char *name);
+extern int fs_open(char *name);
+extern int fs_close(int fd);
+extern int fs_length(int fd);
+extern int fs_seek(int fd, int pos);
+// 最多读 n 个字, 返回读到的字数, 文件末尾返回 0
+extern int fs_read(int fd, int *buf, int n);
@@ -2,12 +2,60 @@
 ; char getchar(void)
 LC3_GFLAG getchar LC3_GFLAG .FILL lc3_getchar
 
+;the input buffer shared with scanf, see SCANF_GETC. -1 at end of input
+GETCHAR_STDIN .FILL x0200
+GETCHAR_IN .FILL x0202
+GETCHAR_IN_MAX .FILL #128
+
+GETCHAR_ZERO		;a NUL in the input, or the 0 after the line
+STR R1, R6, #-4
+LDR R0, R7, #0
+LDR R1, R7, #1
+NOT R1, R1
+ADD R1, R1, #1
+ADD R1, R0, R1
+BRp GETCHAR_READ
+AND R0, R0, #0
+BRnzp GETCHAR_FILLED
+GETCHAR_FILL
+STR R1, R6, #-4
+GETCHAR_READ
+LD R0, GETCHAR_IN
+LD R1, GETCHAR_IN_MAX
+TRAP x26
+ADD R1, R0, #0
+BRz GETCHAR_EOF
+LD R0, GETCHAR_IN
+ADD R1, R1, R0
+LD R7, GETCHAR_STDIN
+STR R1, R7, #1
+ADD R0, R0, #1
+STR R0, R7, #0
+AND R0, R0, #0
+STR R0, R1, #0
+LD R0, GETCHAR_IN
+LDR R0, R0, #0
+BRnzp GETCHAR_FILLED
+GETCHAR_EOF		;R0 = 0, the next read asks the host again
+LD R7, GETCHAR_STDIN
+STR R0, R7, #0
+ADD R0, R0, #-1
+GETCHAR_FILLED
+LDR R1, R6, #-4
+BRnzp GETCHAR_RET
+
 lc3_getchar
 
 STR R7, R6, #-3
 STR R0, R6, #-2
-GETC
-OUT
+LD R7, GETCHAR_STDIN
+LDR R0, R7, #0
+BRz GETCHAR_FILL
+ADD R0, R0, #1
+STR R0, R7, #0
+LDR R0, R0, #-1
+BRz GETCHAR_ZERO
+GETCHAR_RET
 STR R0, R6, #-1
 LDR R0, R6, #-2
 LDR R7, R6, #-3
@@ -0,0 +1,26 @@
+// 性能计数器, 需要 lc3-vmm (寄存器说明见 lc3-vmm/perf.h). perf_read/perf_print 在 lc3lib/stdio.asm 中
+//   perf_reset(); perf_start();
+//   ... 要测量的代码 ...
+//   perf_stop(); perf_print(PERF_INSNS);
+#define PERF_CTRL    ((int *)0x7F40)
+#define PERF_COUNTER ((int *)0x7F44)
+
+#define PERF_START 1
+#define PERF_STOP  2
+#define PERF_RESET 4
+
+#define PERF_INSNS    0
+#define PERF_LOADS    1
+#define PERF_STORES   2
+#define PERF_BRANCHES 3
+#define PERF_TRAPS    4
+#define PERF_USEC     5
+
+#define perf_start() (*PERF_CTRL = PERF_START)
+#define perf_stop()  (*PERF_CTRL = PERF_STOP)
+#define perf_reset() (*PERF_CTRL = PERF_RESET)
+
+// 计数器 n 的 64 位值, v[0] 为低 16 位. 先读 v[0] 锁存, 4 个字是同一时刻的值
+extern void perf_read(int n, int v[4]);
+// 以十进制打印计数器 n
+extern void perf_print(int n);
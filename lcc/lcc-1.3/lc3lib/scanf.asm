@@ -12,6 +12,82 @@ SCANF_0 .FILL -48
 SCANF_9 .FILL -57  
 SCANF_MINUS .FILL -45  
 SCANF_BUF .BLKW 6
+
+;next input char in R0 (-1 at end of input), only R0 and the flags change.
+;getchar and scanf share the input buffer at x0200: address of the next char
+;(0 before the first read), end address, then up to 128 chars followed by a 0.
+;when it is used up, TRAP x26 reads the next line into it and echoes it.
+SCANF_STDIN .FILL x0200
+SCANF_IN .FILL x0202
+SCANF_IN_MAX .FILL #128
+SCANF_R0 .BLKW 1
+SCANF_R1 .BLKW 1
+SCANF_R7 .BLKW 1
+
+SCANF_GETC
+ST R7, SCANF_R7
+LD R7, SCANF_STDIN
+LDR R0, R7, #0
+BRz SCANF_FILL
+ADD R0, R0, #1
+STR R0, R7, #0
+LDR R0, R0, #-1
+BRz SCANF_ZERO		;a NUL in the input, or the 0 after the line
+SCANF_GETC_RET
+LD R7, SCANF_R7
+ADD R0, R0, #0
+JMP R7			;same as RET, lc3pp ends a function at its first RET
+
+SCANF_ZERO
+ST R1, SCANF_R1
+LDR R0, R7, #0
+LDR R1, R7, #1
+NOT R1, R1
+ADD R1, R1, #1
+ADD R1, R0, R1
+BRp SCANF_READ
+AND R0, R0, #0
+BRnzp SCANF_FILLED
+SCANF_FILL
+ST R1, SCANF_R1
+SCANF_READ
+LD R0, SCANF_IN
+LD R1, SCANF_IN_MAX
+TRAP x26
+ADD R1, R0, #0
+BRz SCANF_EOF
+LD R0, SCANF_IN
+ADD R1, R1, R0
+LD R7, SCANF_STDIN
+STR R1, R7, #1
+ADD R0, R0, #1
+STR R0, R7, #0
+AND R0, R0, #0
+STR R0, R1, #0
+LD R0, SCANF_IN
+LDR R0, R0, #0
+BRnzp SCANF_FILLED
+SCANF_EOF		;R0 = 0, the next read asks the host again
+LD R7, SCANF_STDIN
+STR R0, R7, #0
+ADD R0, R0, #-1
+SCANF_FILLED
+LD R1, SCANF_R1
+BRnzp SCANF_GETC_RET
+
+;push back the char just read by SCANF_GETC
+SCANF_UNGETC
+ST R0, SCANF_R0
+ST R7, SCANF_R7
+LD R7, SCANF_STDIN
+LDR R0, R7, #0
+BRz SCANF_UNGETC_RET
+ADD R0, R0, #-1
+STR R0, R7, #0
+SCANF_UNGETC_RET
+LD R0, SCANF_R0
+LD R7, SCANF_R7
+JMP R7
  
 lc3_scanf 
 ADD R6, R6, #-2 
@@ -30,7 +106,7 @@ LDR R4, R5, #0		;got addr of format string
 
  
 
-SCANF_LOOP	;outer loop, R0=tmp register for use with GETC 
+SCANF_LOOP	;outer loop, R0=tmp register for use with SCANF_GETC 
 			;R2 holds either cur letter of format string or 
 			;current addr to store a char, dec, or string 
  
@@ -59,8 +135,8 @@ BRnp SCANF_CHECKD
 ADD R5, R5, #1 
 LDR R2, R5, #0		;R2 has addr for char to be read into 
 
-GETC 
-OUT
+JSR SCANF_GETC
+BRn SCANF_DONE
 STR R0, R2, #0 
  
 ADD R4, R4, #1 
@@ -89,8 +165,8 @@ LD R1, SCANF_9
  
 SCANF_SCANNUM 
  
-GETC 
-OUT
+JSR SCANF_GETC
+BRn SCANF_NUMEOF
 STR R0, R4, #0		;Reading and storing typed char 
  
 ADD R0, R2, R0 
@@ -107,8 +183,8 @@ ADD R0, R0, #1
 ADD R0, R4, R0 
 BRz SCANF_SCANNUM	  ;buffer is empty and wrong char, go to error?
  
-ADD R4, R4, #-1 		;fixme: need to save this char
-BRnzp SCANF_NUMDONE 
+ADD R4, R4, #-1
+BRnzp SCANF_NUMEND
  
  
 SCANF_CHECKEDLOWER 
@@ -123,8 +199,8 @@ ADD R0, R0, #1
 ADD R0, R4, R0 
 BRz SCANF_SCANNUM	  ;buffer is empty and wrong char, go to error?
  
-ADD R4, R4, #-1 		;fixme: need to save this char
-BRnzp SCANF_NUMDONE 
+ADD R4, R4, #-1
+BRnzp SCANF_NUMEND
  
 SCANF_CHECKEDUPPER 
  
@@ -138,7 +214,25 @@ BRz SCANF_NUMDONE	  ;buffer is full
  
 ADD R4, R4, #1 
 BRnzp SCANF_SCANNUM 
- 
+
+SCANF_NUMEOF		;end of input, finish the number if there is one
+LEA R0, SCANF_BUF 
+NOT R0, R0 
+ADD R0, R0, #1 
+ADD R0, R4, R0 
+BRz SCANF_NUMNONE
+ADD R4, R4, #-1
+BRnzp SCANF_NUMDONE
+SCANF_NUMNONE
+ADD R6, R6, #1		;drop the saved format pointer
+BRnzp SCANF_DONE
+ 
+SCANF_NUMEND		;leave the char after the number for the next read, except a newline
+LDR R0, R4, #1
+ADD R0, R0, #-10
+BRz SCANF_NUMDONE
+JSR SCANF_UNGETC
+
 SCANF_NUMDONE 
 		 ;R4 points to last char entered in (ones digit) 
  
@@ -221,14 +315,18 @@ ADD R5, R5, #1		;getting starting addr of space for string to be read in
 LDR R4, R5, #0 
  
 SCANSTRLOOP 
-GETC 
-OUT
+JSR SCANF_GETC
+BRn SCANSTREOF
 STR R0, R4, #0		;Reading and storing typed char 
 ADD R4, R4, #1 
  
 ADD R0, R0, #-10	;End of string? Looking for CR (0x000A) 
 BRnp SCANSTRLOOP   
  
+BRnzp SCANSTRDONE
+SCANSTREOF
+ADD R4, R4, #1
+
 SCANSTRDONE  
 AND R0, R0, #0		;null terminate string 
 STR R0, R4, #-1 
@@ -242,12 +340,12 @@ BRnzp SCANF_LOOP
  
 SCANF_MATCHCHAR 
 ADD R4, R4, #1
-GETC 
-OUT
+JSR SCANF_GETC
 NOT R0, R0
 ADD R0, R0, #1
 ADD R0, R0, R2 
 BRz SCANF_LOOP
+JSR SCANF_UNGETC
  
 SCANF_ERROR
 SCANF_DONE
@@ -254,6 +254,82 @@ SCANF_0 .FILL -48
 SCANF_9 .FILL -57  
 SCANF_MINUS .FILL -45  
 SCANF_BUF .BLKW 6
+
+;next input char in R0 (-1 at end of input), only R0 and the flags change.
+;getchar and scanf share the input buffer at x0200: address of the next char
+;(0 before the first read), end address, then up to 128 chars followed by a 0.
+;when it is used up, TRAP x26 reads the next line into it and echoes it.
+SCANF_STDIN .FILL x0200
+SCANF_IN .FILL x0202
+SCANF_IN_MAX .FILL #128
+SCANF_R0 .BLKW 1
+SCANF_R1 .BLKW 1
+SCANF_R7 .BLKW 1
+
+SCANF_GETC
+ST R7, SCANF_R7
+LD R7, SCANF_STDIN
+LDR R0, R7, #0
+BRz SCANF_FILL
+ADD R0, R0, #1
+STR R0, R7, #0
+LDR R0, R0, #-1
+BRz SCANF_ZERO		;a NUL in the input, or the 0 after the line
+SCANF_GETC_RET
+LD R7, SCANF_R7
+ADD R0, R0, #0
+JMP R7			;same as RET, lc3pp ends a function at its first RET
+
+SCANF_ZERO
+ST R1, SCANF_R1
+LDR R0, R7, #0
+LDR R1, R7, #1
+NOT R1, R1
+ADD R1, R1, #1
+ADD R1, R0, R1
+BRp SCANF_READ
+AND R0, R0, #0
+BRnzp SCANF_FILLED
+SCANF_FILL
+ST R1, SCANF_R1
+SCANF_READ
+LD R0, SCANF_IN
+LD R1, SCANF_IN_MAX
+TRAP x26
+ADD R1, R0, #0
+BRz SCANF_EOF
+LD R0, SCANF_IN
+ADD R1, R1, R0
+LD R7, SCANF_STDIN
+STR R1, R7, #1
+ADD R0, R0, #1
+STR R0, R7, #0
+AND R0, R0, #0
+STR R0, R1, #0
+LD R0, SCANF_IN
+LDR R0, R0, #0
+BRnzp SCANF_FILLED
+SCANF_EOF		;R0 = 0, the next read asks the host again
+LD R7, SCANF_STDIN
+STR R0, R7, #0
+ADD R0, R0, #-1
+SCANF_FILLED
+LD R1, SCANF_R1
+BRnzp SCANF_GETC_RET
+
+;push back the char just read by SCANF_GETC
+SCANF_UNGETC
+ST R0, SCANF_R0
+ST R7, SCANF_R7
+LD R7, SCANF_STDIN
+LDR R0, R7, #0
+BRz SCANF_UNGETC_RET
+ADD R0, R0, #-1
+STR R0, R7, #0
+SCANF_UNGETC_RET
+LD R0, SCANF_R0
+LD R7, SCANF_R7
+JMP R7
  
 lc3_scanf 
 ADD R6, R6, #-2 
@@ -272,7 +348,7 @@ LDR R4, R5, #0		;got addr of format string
 
  
 
-SCANF_LOOP	;outer loop, R0=tmp register for use with GETC 
+SCANF_LOOP	;outer loop, R0=tmp register for use with SCANF_GETC 
 			;R2 holds either cur letter of format string or 
 			;current addr to store a char, dec, or string 
  
@@ -301,8 +377,8 @@ BRnp SCANF_CHECKD
 ADD R5, R5, #1 
 LDR R2, R5, #0		;R2 has addr for char to be read into 
 
-GETC 
-OUT
+JSR SCANF_GETC
+BRn SCANF_DONE
 STR R0, R2, #0 
  
 ADD R4, R4, #1 
@@ -331,8 +407,8 @@ LD R1, SCANF_9
  
 SCANF_SCANNUM 
  
-GETC 
-OUT
+JSR SCANF_GETC
+BRn SCANF_NUMEOF
 STR R0, R4, #0		;Reading and storing typed char 
  
 ADD R0, R2, R0 
@@ -349,8 +425,8 @@ ADD R0, R0, #1
 ADD R0, R4, R0 
 BRz SCANF_SCANNUM	  ;buffer is empty and wrong char, go to error?
  
-ADD R4, R4, #-1 		;fixme: need to save this char
-BRnzp SCANF_NUMDONE 
+ADD R4, R4, #-1
+BRnzp SCANF_NUMEND
  
  
 SCANF_CHECKEDLOWER 
@@ -365,8 +441,8 @@ ADD R0, R0, #1
 ADD R0, R4, R0 
 BRz SCANF_SCANNUM	  ;buffer is empty and wrong char, go to error?
  
-ADD R4, R4, #-1 		;fixme: need to save this char
-BRnzp SCANF_NUMDONE 
+ADD R4, R4, #-1
+BRnzp SCANF_NUMEND
  
 SCANF_CHECKEDUPPER 
  
@@ -380,7 +456,25 @@ BRz SCANF_NUMDONE	  ;buffer is full
  
 ADD R4, R4, #1 
 BRnzp SCANF_SCANNUM 
- 
+
+SCANF_NUMEOF		;end of input, finish the number if there is one
+LEA R0, SCANF_BUF 
+NOT R0, R0 
+ADD R0, R0, #1 
+ADD R0, R4, R0 
+BRz SCANF_NUMNONE
+ADD R4, R4, #-1
+BRnzp SCANF_NUMDONE
+SCANF_NUMNONE
+ADD R6, R6, #1		;drop the saved format pointer
+BRnzp SCANF_DONE
+ 
+SCANF_NUMEND		;leave the char after the number for the next read, except a newline
+LDR R0, R4, #1
+ADD R0, R0, #-10
+BRz SCANF_NUMDONE
+JSR SCANF_UNGETC
+
 SCANF_NUMDONE 
 		 ;R4 points to last char entered in (ones digit) 
  
@@ -463,14 +557,18 @@ ADD R5, R5, #1		;getting starting addr of space for string to be read in
 LDR R4, R5, #0 
  
 SCANSTRLOOP 
-GETC 
-OUT
+JSR SCANF_GETC
+BRn SCANSTREOF
 STR R0, R4, #0		;Reading and storing typed char 
 ADD R4, R4, #1 
  
 ADD R0, R0, #-10	;End of string? Looking for CR (0x000A) 
 BRnp SCANSTRLOOP   
  
+BRnzp SCANSTRDONE
+SCANSTREOF
+ADD R4, R4, #1
+
 SCANSTRDONE  
 AND R0, R0, #0		;null terminate string 
 STR R0, R4, #-1 
@@ -484,12 +582,12 @@ BRnzp SCANF_LOOP
  
 SCANF_MATCHCHAR 
 ADD R4, R4, #1
-GETC 
-OUT
+JSR SCANF_GETC
 NOT R0, R0
 ADD R0, R0, #1
 ADD R0, R0, R2 
 BRz SCANF_LOOP
+JSR SCANF_UNGETC
  
 SCANF_ERROR
 SCANF_DONE
@@ -509,12 +607,60 @@ RET
 ; char getchar(void)
 LC3_GFLAG getchar LC3_GFLAG .FILL lc3_getchar
 
+;the input buffer shared with scanf, see SCANF_GETC. -1 at end of input
+GETCHAR_STDIN .FILL x0200
+GETCHAR_IN .FILL x0202
+GETCHAR_IN_MAX .FILL #128
+
+GETCHAR_ZERO		;a NUL in the input, or the 0 after the line
+STR R1, R6, #-4
+LDR R0, R7, #0
+LDR R1, R7, #1
+NOT R1, R1
+ADD R1, R1, #1
+ADD R1, R0, R1
+BRp GETCHAR_READ
+AND R0, R0, #0
+BRnzp GETCHAR_FILLED
+GETCHAR_FILL
+STR R1, R6, #-4
+GETCHAR_READ
+LD R0, GETCHAR_IN
+LD R1, GETCHAR_IN_MAX
+TRAP x26
+ADD R1, R0, #0
+BRz GETCHAR_EOF
+LD R0, GETCHAR_IN
+ADD R1, R1, R0
+LD R7, GETCHAR_STDIN
+STR R1, R7, #1
+ADD R0, R0, #1
+STR R0, R7, #0
+AND R0, R0, #0
+STR R0, R1, #0
+LD R0, GETCHAR_IN
+LDR R0, R0, #0
+BRnzp GETCHAR_FILLED
+GETCHAR_EOF		;R0 = 0, the next read asks the host again
+LD R7, GETCHAR_STDIN
+STR R0, R7, #0
+ADD R0, R0, #-1
+GETCHAR_FILLED
+LDR R1, R6, #-4
+BRnzp GETCHAR_RET
+
 lc3_getchar
 
 STR R7, R6, #-3
 STR R0, R6, #-2
-GETC
-OUT
+LD R7, GETCHAR_STDIN
+LDR R0, R7, #0
+BRz GETCHAR_FILL
+ADD R0, R0, #1
+STR R0, R7, #0
+LDR R0, R0, #-1
+BRz GETCHAR_ZERO
+GETCHAR_RET
 STR R0, R6, #-1
 LDR R0, R6, #-2
 LDR R7, R6, #-3
@@ -538,4 +684,1007 @@ LDR R7, R6, #-3
 ADD R6, R6, #-1
 RET
 
+.global perf_read
+; void perf_read(int n, int v[4])
+;counter n of the lc3-vmm perf device, v[0] is the low word.
+;reading the first word latches the value, so the 4 words agree
+LC3_GFLAG perf_read LC3_GFLAG .FILL lc3_perf_read
+
+PERF_READ_COUNTER .FILL x7F44
+
+lc3_perf_read
+
+STR R7, R6, #-3
+STR R0, R6, #-2
+STR R1, R6, #-4
+STR R2, R6, #-5
+
+LDR R0, R6, #0
+ADD R0, R0, R0
+ADD R0, R0, R0
+LD R1, PERF_READ_COUNTER
+ADD R1, R1, R0		;R1 = counter n
+LDR R2, R6, #1		;R2 = v
+LDR R0, R1, #0
+STR R0, R2, #0
+LDR R0, R1, #1
+STR R0, R2, #1
+LDR R0, R1, #2
+STR R0, R2, #2
+LDR R0, R1, #3
+STR R0, R2, #3
+
+LDR R2, R6, #-5
+LDR R1, R6, #-4
+LDR R0, R6, #-2
+LDR R7, R6, #-3
+ADD R6, R6, #-1
+RET
+
+.global perf_print
+; void perf_print(int n)
+;counter n in decimal. the 64-bit value w0..w3 sits at R6-8..R6-11 and is
+;divided by 10 one bit at a time, the digits go to R6-12 downwards
+LC3_GFLAG perf_print LC3_GFLAG .FILL lc3_perf_print
+
+PERF_PRINT_COUNTER .FILL x7F44
+PERF_PRINT_BITS .FILL #64
+PERF_PRINT_ASCII .FILL x0030
+
+lc3_perf_print
+
+STR R7, R6, #-3
+STR R0, R6, #-2
+STR R1, R6, #-4
+STR R2, R6, #-5
+STR R3, R6, #-6
+STR R5, R6, #-7
+
+LDR R0, R6, #0
+ADD R0, R0, R0
+ADD R0, R0, R0
+LD R1, PERF_PRINT_COUNTER
+ADD R1, R1, R0
+LDR R0, R1, #0
+STR R0, R6, #-8
+LDR R0, R1, #1
+STR R0, R6, #-9
+LDR R0, R1, #2
+STR R0, R6, #-10
+LDR R0, R1, #3
+STR R0, R6, #-11
+ADD R5, R6, #-12	;R5 = next digit
+
+PERF_PRINT_DIGIT
+AND R1, R1, #0		;R1 = remainder
+LD R2, PERF_PRINT_BITS
+PERF_PRINT_BIT		;shift w left, the top bit goes into the remainder
+ADD R1, R1, R1
+LDR R0, R6, #-11
+BRzp PERF_PRINT_W3
+ADD R1, R1, #1
+PERF_PRINT_W3
+ADD R0, R0, R0
+LDR R3, R6, #-10
+BRzp PERF_PRINT_W2
+ADD R0, R0, #1
+PERF_PRINT_W2
+STR R0, R6, #-11
+ADD R3, R3, R3
+LDR R0, R6, #-9
+BRzp PERF_PRINT_W1
+ADD R3, R3, #1
+PERF_PRINT_W1
+STR R3, R6, #-10
+ADD R0, R0, R0
+LDR R3, R6, #-8
+BRzp PERF_PRINT_W0
+ADD R0, R0, #1
+PERF_PRINT_W0
+STR R0, R6, #-9
+ADD R3, R3, R3
+ADD R0, R1, #-10
+BRn PERF_PRINT_NEXT
+ADD R1, R0, #0		;quotient bit 1
+ADD R3, R3, #1
+PERF_PRINT_NEXT
+STR R3, R6, #-8
+ADD R2, R2, #-1
+BRp PERF_PRINT_BIT
+
+STR R1, R5, #0
+ADD R5, R5, #-1
+LDR R0, R6, #-8
+BRnp PERF_PRINT_DIGIT
+LDR R0, R6, #-9
+BRnp PERF_PRINT_DIGIT
+LDR R0, R6, #-10
+BRnp PERF_PRINT_DIGIT
+LDR R0, R6, #-11
+BRnp PERF_PRINT_DIGIT
+
+LD R1, PERF_PRINT_ASCII
+ADD R3, R6, #-12
+PERF_PRINT_OUT
+ADD R5, R5, #1
+LDR R0, R5, #0
+ADD R0, R0, R1
+OUT
+NOT R0, R5
+ADD R0, R0, #1
+ADD R0, R0, R3
+BRp PERF_PRINT_OUT
+
+LDR R5, R6, #-7
+LDR R3, R6, #-6
+LDR R2, R6, #-5
+LDR R1, R6, #-4
+LDR R0, R6, #-2
+LDR R7, R6, #-3
+ADD R6, R6, #-1
+RET
+
+.global fs_blk_read
+; int fs_blk_read(int pos, int len, int *buf)
+;reads len words at word pos of the disk into buf, returns len or -1.
+;borrows two free descriptors of the vring at x7FFF: the first holds the
+;request header at x0300 and chains (flags bit 1) to the second, which points
+;at buf, so the data goes straight into the caller's array. both are put
+;back when the request is done.
+;locals: R5-8/-9 header/data descriptor, -10/-11 their indexes,
+;-12..-14 saved header addr/len/next, -15/-16 saved data addr/len
+LC3_GFLAG fs_blk_read LC3_GFLAG .FILL lc3_fs_blk_read
+
+FS_BLK_HDR .FILL x0300
+FS_BLK_DESC .FILL x8000		;desc[0] of the vring
+FS_BLK_AVAIL .FILL x8028
+FS_BLK_USED .FILL x802A
+FS_BLK_KICK .FILL x0100
+
+lc3_fs_blk_read
+
+STR R7, R6, #-3
+STR R0, R6, #-2
+STR R1, R6, #-4
+STR R2, R6, #-5
+STR R3, R6, #-6
+STR R5, R6, #-7
+ADD R5, R6, #0
+ADD R6, R6, #-16
+
+LD R1, FS_BLK_DESC
+AND R2, R2, #0
+STR R2, R5, #-8
+FS_BLK_FIND
+LDR R0, R1, #2
+BRnp FS_BLK_BUSY
+LDR R0, R5, #-8
+BRnp FS_BLK_DATA
+STR R1, R5, #-8
+STR R2, R5, #-10
+BRnzp FS_BLK_BUSY
+FS_BLK_DATA
+STR R1, R5, #-9
+STR R2, R5, #-11
+BRnzp FS_BLK_FOUND
+FS_BLK_BUSY
+ADD R1, R1, #4
+ADD R2, R2, #1
+ADD R0, R2, #-10
+BRn FS_BLK_FIND
+AND R0, R0, #0
+ADD R0, R0, #-1
+BRnzp FS_BLK_RET
+
+FS_BLK_FOUND
+LDR R1, R5, #-8		;header descriptor -> x0300, 3 words, next = data
+LDR R0, R1, #0
+STR R0, R5, #-12
+LDR R0, R1, #1
+STR R0, R5, #-13
+LDR R0, R1, #3
+STR R0, R5, #-14
+LD R0, FS_BLK_HDR
+STR R0, R1, #0
+AND R0, R0, #0
+ADD R0, R0, #3
+STR R0, R1, #1
+STR R0, R1, #2		;flags = submitted | next
+LDR R0, R5, #-11
+STR R0, R1, #3
+LDR R1, R5, #-9		;data descriptor -> buf, len words
+LDR R0, R1, #0
+STR R0, R5, #-15
+LDR R0, R1, #1
+STR R0, R5, #-16
+LDR R0, R5, #2
+STR R0, R1, #0
+LDR R0, R5, #1
+STR R0, R1, #1
+AND R0, R0, #0
+ADD R0, R0, #1
+STR R0, R1, #2		;in use
+
+LD R1, FS_BLK_HDR	;header: read, pos, len
+STR R0, R1, #0
+LDR R2, R5, #0
+STR R2, R1, #1
+LDR R2, R5, #1
+STR R2, R1, #2
+LD R1, FS_BLK_AVAIL
+LDR R2, R5, #-10
+STR R2, R1, #1
+STR R0, R1, #0
+LD R1, FS_BLK_KICK
+STR R0, R1, #0
+FS_BLK_WAIT
+LDR R0, R1, #0
+ADD R0, R0, #-2
+BRnp FS_BLK_WAIT
+
+LD R1, FS_BLK_USED
+LDR R2, R1, #0		;R2 = 1 when the request was served
+AND R0, R0, #0
+STR R0, R1, #0
+LDR R1, R5, #-8
+LDR R3, R5, #-12
+STR R3, R1, #0
+LDR R3, R5, #-13
+STR R3, R1, #1
+STR R0, R1, #2
+LDR R3, R5, #-14
+STR R3, R1, #3
+LDR R1, R5, #-9
+LDR R3, R5, #-15
+STR R3, R1, #0
+LDR R3, R5, #-16
+STR R3, R1, #1
+STR R0, R1, #2
+
+LDR R0, R5, #1
+ADD R2, R2, #-1
+BRz FS_BLK_RET
+AND R0, R0, #0
+ADD R0, R0, #-1
+FS_BLK_RET
+STR R0, R5, #-1
+ADD R6, R5, #0
+LDR R5, R6, #-7
+LDR R3, R6, #-6
+LDR R2, R6, #-5
+LDR R1, R6, #-4
+LDR R0, R6, #-2
+LDR R7, R6, #-3
+ADD R6, R6, #-1
+RET
+
+.global fs_mount
+; int fs_mount(void)
+;checks the superblock at word 0 of the disk, returns the number of files or -1.
+;the library state is at x0300-x043F, see fs.h
+LC3_GFLAG fs_mount LC3_GFLAG .FILL lc3_fs_mount
+
+FS_MOUNT_STATE .FILL x0300
+FS_MOUNT_BUF .FILL x0340
+FS_MOUNT_BLK .FILL lc3_fs_blk_read
+FS_MOUNT_MAGIC .FILL -19526	;-x4C46
+FS_MOUNT_BLOCK .FILL -256
+
+lc3_fs_mount
+
+STR R7, R6, #-3
+STR R0, R6, #-2
+STR R1, R6, #-4
+STR R2, R6, #-5
+STR R3, R6, #-6
+STR R5, R6, #-7
+ADD R5, R6, #0
+ADD R6, R6, #-7
+
+LD R1, FS_MOUNT_STATE
+AND R0, R0, #0
+STR R0, R1, #7		;nothing in the buffer
+STR R0, R1, #8		;no open files
+STR R0, R1, #9
+STR R0, R1, #10
+STR R0, R1, #11
+ADD R0, R0, #-1
+STR R0, R1, #5
+
+AND R1, R1, #0
+ADD R2, R1, #8
+ADD R2, R2, #8
+LD R3, FS_MOUNT_BUF
+ADD R6, R6, #-3
+STR R1, R6, #0
+STR R2, R6, #1
+STR R3, R6, #2
+LD R0, FS_MOUNT_BLK
+JSRR R0
+LDR R0, R6, #0
+ADD R6, R6, #4
+ADD R0, R0, #0
+BRn FS_MOUNT_FAIL
+LD R1, FS_MOUNT_BUF
+LDR R0, R1, #0
+LD R2, FS_MOUNT_MAGIC
+ADD R0, R0, R2
+BRnp FS_MOUNT_FAIL
+LDR R0, R1, #2
+LD R2, FS_MOUNT_BLOCK
+ADD R0, R0, R2
+BRnp FS_MOUNT_FAIL
+LD R2, FS_MOUNT_STATE
+LDR R0, R1, #4
+STR R0, R2, #3		;first directory block
+LDR R0, R1, #6
+STR R0, R2, #4		;number of files
+BRnzp FS_MOUNT_RET
+FS_MOUNT_FAIL
+AND R0, R0, #0
+ADD R0, R0, #-1
+FS_MOUNT_RET
+STR R0, R5, #-1
+ADD R6, R5, #0
+LDR R5, R6, #-7
+LDR R3, R6, #-6
+LDR R2, R6, #-5
+LDR R1, R6, #-4
+LDR R0, R6, #-2
+LDR R7, R6, #-3
+ADD R6, R6, #-1
+RET
+
+.global fs_entry
+; int *fs_entry(int i)
+;reads directory entry i into the buffer at x0340 and returns x0340, 0 on error.
+;8 entries of 32 words per block, so it is at word (dir_start * 8 + i) * 32
+LC3_GFLAG fs_entry LC3_GFLAG .FILL lc3_fs_entry
+
+FS_ENTRY_STATE .FILL x0300
+FS_ENTRY_BUF .FILL x0340
+FS_ENTRY_BLK .FILL lc3_fs_blk_read
+FS_ENTRY_LEN .FILL 32
+
+lc3_fs_entry
+
+STR R7, R6, #-3
+STR R0, R6, #-2
+STR R1, R6, #-4
+STR R2, R6, #-5
+STR R3, R6, #-6
+STR R5, R6, #-7
+ADD R5, R6, #0
+ADD R6, R6, #-7
+
+LD R2, FS_ENTRY_STATE
+AND R0, R0, #0
+STR R0, R2, #7		;the buffered file data is overwritten
+LDR R1, R2, #3
+ADD R1, R1, R1
+ADD R1, R1, R1
+ADD R1, R1, R1
+LDR R0, R5, #0
+ADD R1, R1, R0
+ADD R1, R1, R1
+ADD R1, R1, R1
+ADD R1, R1, R1
+ADD R1, R1, R1
+ADD R1, R1, R1
+LD R2, FS_ENTRY_LEN
+LD R3, FS_ENTRY_BUF
+ADD R6, R6, #-3
+STR R1, R6, #0
+STR R2, R6, #1
+STR R3, R6, #2
+LD R0, FS_ENTRY_BLK
+JSRR R0
+LDR R0, R6, #0
+ADD R6, R6, #4
+ADD R0, R0, #0
+BRn FS_ENTRY_FAIL
+LD R0, FS_ENTRY_BUF
+BRnzp FS_ENTRY_RET
+FS_ENTRY_FAIL
+AND R0, R0, #0
+FS_ENTRY_RET
+STR R0, R5, #-1
+ADD R6, R5, #0
+LDR R5, R6, #-7
+LDR R3, R6, #-6
+LDR R2, R6, #-5
+LDR R1, R6, #-4
+LDR R0, R6, #-2
+LDR R7, R6, #-3
+ADD R6, R6, #-1
+RET
+
+.global fs_list
+; int fs_list(int i, char *name)
+;copies the name of file i to name, returns its size or -1 when there is no file i
+LC3_GFLAG fs_list LC3_GFLAG .FILL lc3_fs_list
+
+FS_LIST_STATE .FILL x0300
+FS_LIST_ENTRY .FILL lc3_fs_entry
+
+lc3_fs_list
+
+STR R7, R6, #-3
+STR R0, R6, #-2
+STR R1, R6, #-4
+STR R2, R6, #-5
+STR R3, R6, #-6
+STR R5, R6, #-7
+ADD R5, R6, #0
+ADD R6, R6, #-7
+
+LD R1, FS_LIST_STATE
+LDR R0, R5, #0
+BRn FS_LIST_FAIL
+LDR R1, R1, #4
+NOT R1, R1
+ADD R1, R1, #1
+ADD R1, R0, R1
+BRzp FS_LIST_FAIL
+ADD R6, R6, #-1
+STR R0, R6, #0
+LD R0, FS_LIST_ENTRY
+JSRR R0
+LDR R1, R6, #0
+ADD R6, R6, #2
+ADD R1, R1, #0
+BRz FS_LIST_FAIL
+LDR R2, R5, #1
+AND R3, R3, #0
+ADD R3, R3, #10
+ADD R3, R3, #10		;FS_NAME_MAX
+FS_LIST_NAME
+LDR R0, R1, #0
+STR R0, R2, #0
+ADD R1, R1, #1
+ADD R2, R2, #1
+ADD R3, R3, #-1
+BRp FS_LIST_NAME
+LDR R0, R1, #0		;the size follows the name
+BRnzp FS_LIST_RET
+FS_LIST_FAIL
+AND R0, R0, #0
+ADD R0, R0, #-1
+FS_LIST_RET
+STR R0, R5, #-1
+ADD R6, R5, #0
+LDR R5, R6, #-7
+LDR R3, R6, #-6
+LDR R2, R6, #-5
+LDR R1, R6, #-4
+LDR R0, R6, #-2
+LDR R7, R6, #-3
+ADD R6, R6, #-1
+RET
+
+.global fs_open
+; int fs_open(char *name)
+;returns a free fd for the file called name, or -1.
+;locals: R5-8 fd, R5-9 directory entry
+LC3_GFLAG fs_open LC3_GFLAG .FILL lc3_fs_open
+
+FS_OPEN_STATE .FILL x0300
+FS_OPEN_BUF .FILL x0340
+FS_OPEN_ENTRY .FILL lc3_fs_entry
+
+lc3_fs_open
+
+STR R7, R6, #-3
+STR R0, R6, #-2
+STR R1, R6, #-4
+STR R2, R6, #-5
+STR R3, R6, #-6
+STR R5, R6, #-7
+ADD R5, R6, #0
+ADD R6, R6, #-9
+
+LD R1, FS_OPEN_STATE
+AND R0, R0, #0
+FS_OPEN_FREE
+LDR R2, R1, #8
+BRz FS_OPEN_GOT
+ADD R1, R1, #1
+ADD R0, R0, #1
+ADD R2, R0, #-4		;FS_FILES
+BRn FS_OPEN_FREE
+BRnzp FS_OPEN_FAIL
+FS_OPEN_GOT
+STR R0, R5, #-8
+AND R0, R0, #0
+STR R0, R5, #-9
+
+FS_OPEN_NEXT
+LD R1, FS_OPEN_STATE
+LDR R1, R1, #4
+NOT R1, R1
+ADD R1, R1, #1
+LDR R0, R5, #-9
+ADD R1, R0, R1
+BRzp FS_OPEN_FAIL
+ADD R6, R6, #-1
+STR R0, R6, #0
+LD R0, FS_OPEN_ENTRY
+JSRR R0
+LDR R1, R6, #0
+ADD R6, R6, #2
+ADD R1, R1, #0
+BRz FS_OPEN_FAIL
+LDR R2, R5, #0
+AND R3, R3, #0
+ADD R3, R3, #10
+ADD R3, R3, #10		;FS_NAME_MAX
+FS_OPEN_CMP
+LDR R0, R2, #0
+LDR R7, R1, #0
+NOT R7, R7
+ADD R7, R7, #1
+ADD R7, R0, R7
+BRnp FS_OPEN_SKIP
+ADD R0, R0, #0
+BRz FS_OPEN_MATCH
+ADD R1, R1, #1
+ADD R2, R2, #1
+ADD R3, R3, #-1
+BRp FS_OPEN_CMP
+FS_OPEN_SKIP
+LDR R0, R5, #-9
+ADD R0, R0, #1
+STR R0, R5, #-9
+BRnzp FS_OPEN_NEXT
+
+FS_OPEN_MATCH		;used, size, next extent, position 0, then the extents
+LD R1, FS_OPEN_BUF
+LD R2, FS_OPEN_STATE
+LDR R0, R5, #-8
+ADD R2, R2, R0
+AND R3, R3, #0
+ADD R3, R3, #1
+STR R3, R2, #8
+LDR R3, R1, #20
+STR R3, R2, #12
+LDR R3, R1, #21
+STR R3, R2, #20
+AND R3, R3, #0
+STR R3, R2, #16
+LD R2, FS_OPEN_STATE
+ADD R2, R2, #12
+ADD R2, R2, #12
+ADD R3, R0, R0
+ADD R2, R2, R3
+ADD R3, R3, R3
+ADD R3, R3, R3
+ADD R2, R2, R3		;x0318 + fd * 10
+ADD R1, R1, #11
+ADD R1, R1, #11
+AND R3, R3, #0
+ADD R3, R3, #10		;FS_EXTENTS * 2
+FS_OPEN_EXT
+LDR R7, R1, #0
+STR R7, R2, #0
+ADD R1, R1, #1
+ADD R2, R2, #1
+ADD R3, R3, #-1
+BRp FS_OPEN_EXT
+BRnzp FS_OPEN_RET
+FS_OPEN_FAIL
+AND R0, R0, #0
+ADD R0, R0, #-1
+FS_OPEN_RET
+STR R0, R5, #-1
+ADD R6, R5, #0
+LDR R5, R6, #-7
+LDR R3, R6, #-6
+LDR R2, R6, #-5
+LDR R1, R6, #-4
+LDR R0, R6, #-2
+LDR R7, R6, #-3
+ADD R6, R6, #-1
+RET
+
+.global fs_close
+; int fs_close(int fd)
+LC3_GFLAG fs_close LC3_GFLAG .FILL lc3_fs_close
+
+FS_CLOSE_STATE .FILL x0300
+
+lc3_fs_close
+
+STR R7, R6, #-3
+STR R0, R6, #-2
+STR R1, R6, #-4
+STR R2, R6, #-5
+STR R3, R6, #-6
+STR R5, R6, #-7
+ADD R5, R6, #0
+ADD R6, R6, #-7
+
+LDR R0, R5, #0
+BRn FS_CLOSE_FAIL
+ADD R1, R0, #-4
+BRzp FS_CLOSE_FAIL
+LD R1, FS_CLOSE_STATE
+ADD R2, R1, R0
+LDR R3, R2, #8
+BRz FS_CLOSE_FAIL
+AND R3, R3, #0
+STR R3, R2, #8
+LDR R3, R1, #5
+NOT R3, R3
+ADD R3, R3, #1
+ADD R3, R3, R0
+BRnp FS_CLOSE_OK
+ADD R3, R3, #-1
+STR R3, R1, #5		;the buffer no longer belongs to a file
+FS_CLOSE_OK
+AND R0, R0, #0
+BRnzp FS_CLOSE_RET
+FS_CLOSE_FAIL
+AND R0, R0, #0
+ADD R0, R0, #-1
+FS_CLOSE_RET
+STR R0, R5, #-1
+ADD R6, R5, #0
+LDR R5, R6, #-7
+LDR R3, R6, #-6
+LDR R2, R6, #-5
+LDR R1, R6, #-4
+LDR R0, R6, #-2
+LDR R7, R6, #-3
+ADD R6, R6, #-1
+RET
+
+.global fs_length
+; int fs_length(int fd)
+LC3_GFLAG fs_length LC3_GFLAG .FILL lc3_fs_length
+
+FS_LENGTH_STATE .FILL x0300
+
+lc3_fs_length
+
+STR R7, R6, #-3
+STR R0, R6, #-2
+STR R1, R6, #-4
+
+LD R1, FS_LENGTH_STATE
+LDR R0, R6, #0
+ADD R1, R1, R0
+LDR R0, R1, #12
+STR R0, R6, #-1
+
+LDR R1, R6, #-4
+LDR R0, R6, #-2
+LDR R7, R6, #-3
+ADD R6, R6, #-1
+RET
+
+.global fs_seek
+; int fs_seek(int fd, int pos)
+;moves to pos, clamped to [0, size], and returns it
+LC3_GFLAG fs_seek LC3_GFLAG .FILL lc3_fs_seek
+
+FS_SEEK_STATE .FILL x0300
+
+lc3_fs_seek
+
+STR R7, R6, #-3
+STR R0, R6, #-2
+STR R1, R6, #-4
+STR R2, R6, #-5
+STR R3, R6, #-6
+
+LDR R0, R6, #1
+BRzp FS_SEEK_POS
+AND R0, R0, #0
+FS_SEEK_POS
+LD R1, FS_SEEK_STATE
+LDR R2, R6, #0
+ADD R1, R1, R2
+LDR R2, R1, #12
+NOT R3, R2
+ADD R3, R3, #1
+ADD R3, R0, R3
+BRnz FS_SEEK_SET
+ADD R0, R2, #0
+FS_SEEK_SET
+STR R0, R1, #16
+STR R0, R6, #-1
+
+LDR R3, R6, #-6
+LDR R2, R6, #-5
+LDR R1, R6, #-4
+LDR R0, R6, #-2
+LDR R7, R6, #-3
+ADD R6, R6, #-1
+RET
+
+.global fs_read
+; int fs_read(int fd, int *buf, int n)
+;reads up to n words, returns the count, 0 at the end of the file, -1 for a bad fd.
+;when the words still wanted cover the rest of the current extent, the whole
+;run goes straight into buf with one request. shorter reads fetch the rest of
+;the block into the buffer at x0340 and are served from there until used up.
+;locals: R5-8 done, -9 pos, -10 words left in the file, -11 block of pos,
+;-12 offset in the block, -13 disk pos, -15 n - done,
+;-16 blocks before the extent, -17 extent, -18 extents left
+LC3_GFLAG fs_read LC3_GFLAG .FILL lc3_fs_read
+
+FS_READ_STATE .FILL x0300
+FS_READ_BUF .FILL x0340
+FS_READ_BLK .FILL lc3_fs_blk_read
+FS_READ_HIGH .FILL xFF00
+FS_READ_LOW .FILL x00FF
+FS_READ_BLOCK .FILL 256
+FS_READ_RUN_MAX .FILL -128	;128 blocks would overflow the word count
+
+lc3_fs_read
+
+STR R7, R6, #-3
+STR R0, R6, #-2
+STR R1, R6, #-4
+STR R2, R6, #-5
+STR R3, R6, #-6
+STR R5, R6, #-7
+ADD R5, R6, #0
+ADD R6, R6, #-16
+ADD R6, R6, #-2
+
+LDR R0, R5, #0
+BRn FS_READ_BAD
+ADD R1, R0, #-4
+BRzp FS_READ_BAD
+LD R1, FS_READ_STATE
+ADD R1, R1, R0
+LDR R1, R1, #8
+BRz FS_READ_BAD
+AND R0, R0, #0
+STR R0, R5, #-8
+
+FS_READ_LOOP
+LDR R0, R5, #-8
+NOT R0, R0
+ADD R0, R0, #1
+LDR R1, R5, #2
+ADD R0, R1, R0
+BRnz FS_READ_DONE
+STR R0, R5, #-15
+LD R1, FS_READ_STATE
+LDR R2, R5, #0
+ADD R1, R1, R2
+LDR R0, R1, #16
+STR R0, R5, #-9
+NOT R0, R0
+ADD R0, R0, #1
+LDR R2, R1, #12
+ADD R0, R2, R0
+BRnz FS_READ_DONE
+STR R0, R5, #-10
+
+LD R1, FS_READ_STATE	;already in the buffer?
+LDR R0, R1, #5
+LDR R2, R5, #0
+NOT R2, R2
+ADD R2, R2, #1
+ADD R0, R0, R2
+BRnp FS_READ_FIND
+LDR R0, R1, #6
+NOT R0, R0
+ADD R0, R0, #1
+LDR R2, R5, #-9
+ADD R2, R2, R0		;R2 = offset in the buffer
+BRn FS_READ_FIND
+LDR R0, R1, #7
+NOT R3, R2
+ADD R3, R3, #1
+ADD R0, R0, R3		;R0 = words there
+BRp FS_READ_COPY
+
+FS_READ_FIND
+LDR R0, R5, #-9
+LD R1, FS_READ_LOW
+AND R1, R0, R1
+STR R1, R5, #-12
+LD R1, FS_READ_HIGH
+AND R0, R0, R1
+AND R1, R1, #0
+ADD R1, R1, #8
+FS_READ_SHIFT		;rotate the high byte down
+ADD R0, R0, #0
+BRzp FS_READ_SHIFT0
+ADD R0, R0, R0
+ADD R0, R0, #1
+BRnzp FS_READ_SHIFT1
+FS_READ_SHIFT0
+ADD R0, R0, R0
+FS_READ_SHIFT1
+ADD R1, R1, #-1
+BRp FS_READ_SHIFT
+STR R0, R5, #-11
+
+LD R1, FS_READ_STATE	;find the extent holding the block
+LDR R0, R5, #0
+ADD R2, R1, R0
+LDR R2, R2, #20
+STR R2, R5, #-18
+ADD R1, R1, #12
+ADD R1, R1, #12
+ADD R0, R0, R0
+ADD R1, R1, R0
+ADD R0, R0, R0
+ADD R0, R0, R0
+ADD R1, R1, R0
+STR R1, R5, #-17
+AND R0, R0, #0
+STR R0, R5, #-16
+FS_READ_EXT
+LDR R0, R5, #-18
+BRnz FS_READ_DONE
+LDR R1, R5, #-17
+LDR R0, R1, #1
+LDR R2, R5, #-16
+ADD R2, R2, R0
+LDR R3, R5, #-11
+NOT R3, R3
+ADD R3, R3, #1
+ADD R3, R2, R3		;R3 = blocks from pos to the extent end
+BRp FS_READ_HIT
+STR R2, R5, #-16
+ADD R1, R1, #2
+STR R1, R5, #-17
+LDR R0, R5, #-18
+ADD R0, R0, #-1
+STR R0, R5, #-18
+BRnzp FS_READ_EXT
+
+FS_READ_HIT		;disk pos = (start + block - base) * 256 + offset
+LDR R0, R1, #0
+LDR R2, R5, #-11
+ADD R0, R0, R2
+LDR R2, R5, #-16
+NOT R2, R2
+ADD R2, R2, #1
+ADD R0, R0, R2
+AND R2, R2, #0
+ADD R2, R2, #8
+FS_READ_POS
+ADD R0, R0, R0
+ADD R2, R2, #-1
+BRp FS_READ_POS
+LDR R2, R5, #-12
+ADD R0, R0, R2
+STR R0, R5, #-13
+
+LDR R0, R5, #-10	;R0 = words to the extent end, at most the rest of the file
+LD R2, FS_READ_RUN_MAX
+ADD R2, R3, R2
+BRzp FS_READ_RUN
+AND R2, R2, #0
+ADD R2, R2, #8
+FS_READ_BLOCKS
+ADD R3, R3, R3
+ADD R2, R2, #-1
+BRp FS_READ_BLOCKS
+LDR R2, R5, #-12
+NOT R2, R2
+ADD R2, R2, #1
+ADD R3, R3, R2
+NOT R2, R0
+ADD R2, R2, #1
+ADD R2, R3, R2
+BRzp FS_READ_RUN
+ADD R0, R3, #0
+FS_READ_RUN
+
+LDR R1, R5, #-15
+NOT R2, R0
+ADD R2, R2, #1
+ADD R2, R1, R2
+BRn FS_READ_FILL
+LDR R1, R5, #-13	;the whole run, straight into buf + done
+LDR R2, R5, #1
+LDR R3, R5, #-8
+ADD R2, R2, R3
+ADD R6, R6, #-3
+STR R1, R6, #0
+STR R0, R6, #1
+STR R2, R6, #2
+LD R0, FS_READ_BLK
+JSRR R0
+LDR R0, R6, #0
+ADD R6, R6, #4
+ADD R0, R0, #0
+BRn FS_READ_DONE
+BRnzp FS_READ_ADVANCE
+
+FS_READ_FILL		;the rest of the block, or of the run, into the buffer
+LD R1, FS_READ_BLOCK
+LDR R2, R5, #-12
+NOT R2, R2
+ADD R2, R2, #1
+ADD R1, R1, R2
+NOT R2, R1
+ADD R2, R2, #1
+ADD R2, R0, R2
+BRzp FS_READ_LEN
+ADD R1, R0, #0
+FS_READ_LEN
+LD R2, FS_READ_STATE
+AND R0, R0, #0
+STR R0, R2, #7
+LDR R0, R5, #-13
+LD R3, FS_READ_BUF
+ADD R6, R6, #-3
+STR R0, R6, #0
+STR R1, R6, #1
+STR R3, R6, #2
+LD R0, FS_READ_BLK
+JSRR R0
+LDR R0, R6, #0
+ADD R6, R6, #4
+ADD R0, R0, #0
+BRn FS_READ_DONE
+LD R1, FS_READ_STATE
+STR R0, R1, #7
+LDR R2, R5, #0
+STR R2, R1, #5
+LDR R2, R5, #-9
+STR R2, R1, #6
+AND R2, R2, #0
+
+FS_READ_COPY		;min(R0, n - done) words from offset R2 of the buffer
+LDR R1, R5, #-15
+NOT R3, R0
+ADD R3, R3, #1
+ADD R3, R1, R3
+BRzp FS_READ_COPYN
+ADD R0, R1, #0
+FS_READ_COPYN
+LD R1, FS_READ_BUF
+ADD R1, R1, R2
+LDR R2, R5, #1
+LDR R3, R5, #-8
+ADD R2, R2, R3
+ADD R3, R0, #0
+FS_READ_WORD
+LDR R7, R1, #0
+STR R7, R2, #0
+ADD R1, R1, #1
+ADD R2, R2, #1
+ADD R3, R3, #-1
+BRp FS_READ_WORD
+
+FS_READ_ADVANCE		;R0 words were read
+LDR R1, R5, #-8
+ADD R1, R1, R0
+STR R1, R5, #-8
+LD R1, FS_READ_STATE
+LDR R2, R5, #0
+ADD R1, R1, R2
+LDR R2, R1, #16
+ADD R2, R2, R0
+STR R2, R1, #16
+BRnzp FS_READ_LOOP
+
+FS_READ_BAD
+AND R0, R0, #0
+ADD R0, R0, #-1
+BRnzp FS_READ_RET
+FS_READ_DONE
+LDR R0, R5, #-8
+FS_READ_RET
+STR R0, R5, #-1
+ADD R6, R5, #0
+LDR R5, R6, #-7
+LDR R3, R6, #-6
+LDR R2, R6, #-5
+LDR R1, R6, #-4
+LDR R0, R6, #-2
+LDR R7, R6, #-3
+ADD R6, R6, #-1
+RET
+
 .END
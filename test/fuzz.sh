@@ -0,0 +1,62 @@
+#!/usr/bin/env bash
+#
+# --fuzz 的冒烟测试: 用固定的种子生成一组随机输入, 在同一个快照上依次执行,
+# 输出必须与每个输入单独启动一次 lc3-vmm 的输出拼接起来相同 (快照恢复不能漏页).
+#
+#   test/fuzz.sh [guest]   默认 lc3-vm/test_scanf.c
+#
+# 环境变量:
+#   FUZZ_SEED    随机种子, 默认 1
+#   FUZZ_INPUTS  输入个数, 默认 50
+
+cd $(dirname $0)/..
+
+ROOT=$(pwd)
+VMM=${ROOT}/lc3-vmm/lc3-vmm
+GUEST=${1:-${ROOT}/lc3-vm/test_scanf.c}
+FUZZ_SEED=${FUZZ_SEED:-1}
+FUZZ_INPUTS=${FUZZ_INPUTS:-50}
+TEST_TIMEOUT=${TEST_TIMEOUT:-20}
+
+if [ ! -x ${VMM} ]; then
+    echo "missing ${VMM}, run make first"
+    exit 2
+fi
+
+work=$(mktemp -d)
+trap "rm -rf $work" EXIT
+export LC3_CACHE_DIR="$work/cache"
+
+# 数字, 符号, 字母和换行, 长度 0 − 60
+chars='0123456789 -+,abcxyz
+'
+RANDOM=${FUZZ_SEED}
+mkdir "$work/in"
+for ((i = 0; i < FUZZ_INPUTS; i++)); do
+    len=$((RANDOM % 61))
+    s=
+    for ((j = 0; j < len; j++)); do
+        s+=${chars:$((RANDOM % ${#chars})):1}
+    done
+    printf "%s" "$s" > "$work/in/$(printf %03d $i)"
+done
+
+# 设备初始化等主机端的提示不算客户机输出
+for f in "$work"/in/*; do
+    timeout ${TEST_TIMEOUT} ${VMM} ${GUEST} < "$f" 2>&1
+done | grep -av '^>>> ' > "$work/expect"
+
+timeout ${TEST_TIMEOUT} ${VMM} --fuzz ${GUEST} "$work"/in/* > "$work/out" 2> "$work/stats"
+status=$?
+grep -av '^>>> ' "$work/out" > "$work/actual"
+
+if [ $status -ne 0 ]; then
+    echo "FAIL fuzz exit status $status"
+    sed 's/^/    /' "$work/stats"
+    exit 1
+elif ! cmp -s "$work/expect" "$work/actual"; then
+    echo "FAIL fuzz output differs from separate runs (seed ${FUZZ_SEED})"
+    diff -a "$work/expect" "$work/actual" | head -20 | sed 's/^/    /'
+    exit 1
+fi
+echo "PASS fuzz $(grep '^>>> fuzz:' "$work/stats" | sed 's/^>>> fuzz: //') (seed ${FUZZ_SEED})"
@@ -0,0 +1,48 @@
+#!/usr/bin/env bash
+#
+# 用 test/host/rsp 通过 Unix socket 驱动 lc3-vmm --gdb, 回复与 test/golden/test_gdb.rsp 比较.
+# 客户机为 lc3-vm/test_gdb.asm: 查询停止原因, 读寄存器和内存, 设断点, 继续运行到断点,
+# 再读寄存器, 最后 k 结束 VMM.
+#
+#   test/gdb.sh            运行测试
+#   test/gdb.sh --update   用当前输出更新期望文件
+
+cd $(dirname $0)/..
+
+ROOT=$(pwd)
+VMM=${ROOT}/lc3-vmm/lc3-vmm
+RSP=${ROOT}/test/host/rsp
+GOLDEN=${ROOT}/test/golden/test_gdb.rsp
+TEST_TIMEOUT=${TEST_TIMEOUT:-20}
+
+if [ ! -x ${VMM} ] || [ ! -x ${RSP} ]; then
+    echo "missing ${VMM} or ${RSP}, run make first"
+    exit 2
+fi
+
+work=$(mktemp -d)
+trap "rm -rf $work" EXIT
+
+# 镜像缓存放在临时目录, 不影响用户的缓存
+(cd "$work" && LC3_CACHE_DIR="$work/cache" exec timeout ${TEST_TIMEOUT} ${VMM} --gdb gdb.sock \
+    ${ROOT}/lc3-vm/test_gdb.asm > "$work/vmm" 2>&1) &
+vmm=$!
+timeout ${TEST_TIMEOUT} ${RSP} "$work/gdb.sock" '?' g m3000,8 Z0,3005,2 c g k > "$work/actual" 2>&1
+status=$?
+wait $vmm
+[ $status -eq 0 ] && status=$?
+
+if [ "$1" = "--update" ]; then
+    cp "$work/actual" ${GOLDEN}
+    echo "UPDT test_gdb"
+elif [ $status -ne 0 ]; then
+    echo "FAIL test_gdb exit status $status"
+    sed 's/^/    /' "$work/actual" "$work/vmm"
+    exit 1
+elif ! cmp -s "$work/actual" ${GOLDEN}; then
+    echo "FAIL test_gdb output differs"
+    diff ${GOLDEN} "$work/actual" | sed 's/^/    /'
+    exit 1
+else
+    echo "PASS test_gdb"
+fi
@@ -0,0 +1,132 @@
+// 两个 liblc3vm 虚拟机交替运行, 每次只给一小段指令预算, 检查:
+//   - 运行一个 VM 时另一个 VM 的寄存器和内存不变
+//   - 交替运行的结果与各自一次运行完的结果相同
+#include <stdio.h>
+#include <string.h>
+
+#include "lc3vm.h"
+
+#define TWO_SLICE 37   /* 与循环长度互质, 切换点落在不同的指令上 */
+#define TWO_WORDS 13
+
+// sum = 0; for (i = 0; n > 0; n--, i++) sum += val;  结果在 R2/R3 和 SUM 中
+static const uint16_t two_code[TWO_WORDS] = {
+    0x2209,  /* x3000 LD R1, VAL */
+    0x2809,  /* x3001 LD R4, N */
+    0x54A0,  /* x3002 AND R2, R2, #0 */
+    0x56E0,  /* x3003 AND R3, R3, #0 */
+    0x1481,  /* x3004 ADD R2, R2, R1 */
+    0x3406,  /* x3005 ST R2, SUM */
+    0x16E1,  /* x3006 ADD R3, R3, #1 */
+    0x193F,  /* x3007 ADD R4, R4, #-1 */
+    0x03FB,  /* x3008 BRp x3004 */
+    0xF025,  /* x3009 HALT */
+    0x0000,  /* x300A VAL */
+    0x0000,  /* x300B N */
+    0x0000,  /* x300C SUM */
+};
+
+struct two_state {
+    uint16_t reg[R_COUNT];
+    uint16_t mem[TWO_WORDS];
+    uint64_t icount;
+};
+
+static int two_trap(lc3vm_t *vm, uint16_t trap, void *opaque)
+{
+    return trap == TRAP_HALT ? 0 : -1;
+}
+
+static lc3vm_t *two_create(uint16_t val, uint16_t n)
+{
+    static const struct lc3vm_ops ops = { .trap = two_trap };
+    uint8_t obj[2 + TWO_WORDS * 2];
+    lc3vm_t *vm;
+    int i;
+
+    obj[0] = 0x30;
+    obj[1] = 0x00;
+    for (i = 0; i < TWO_WORDS; i++) {
+        obj[2 + i * 2] = two_code[i] >> 8;
+        obj[3 + i * 2] = two_code[i] & 0xFF;
+    }
+    vm = lc3vm_create(&ops, NULL);
+    if (!vm || lc3vm_load(vm, obj, sizeof(obj)) != TWO_WORDS)
+        return NULL;
+    lc3vm_write(vm, 0x300A, val);
+    lc3vm_write(vm, 0x300B, n);
+    lc3vm_reset(vm, 0x3000);
+    return vm;
+}
+
+static void two_save(lc3vm_t *vm, struct two_state *st)
+{
+    int i;
+
+    for (i = 0; i < R_COUNT; i++)
+        st->reg[i] = lc3vm_get_reg(vm, i);
+    for (i = 0; i < TWO_WORDS; i++)
+        st->mem[i] = lc3vm_read(vm, 0x3000 + i);
+    st->icount = lc3vm_icount(vm);
+}
+
+int main()
+{
+    lc3vm_t *vm[2], *ref[2];
+    struct two_state before, after, st[2], rst[2];
+    uint16_t val[2] = { 3, 7 }, n[2] = { 1000, 1500 };
+    int halted[2] = { 0, 0 }, i, ret, slices = 0;
+
+    for (i = 0; i < 2; i++) {
+        vm[i] = two_create(val[i], n[i]);
+        ref[i] = two_create(val[i], n[i]);
+        if (!vm[i] || !ref[i]) {
+            printf("FAIL lc3vm_two: failed to create VM\n");
+            return 1;
+        }
+    }
+
+    while (!halted[0] || !halted[1]) {
+        for (i = 0; i < 2; i++) {
+            if (halted[i])
+                continue;
+            two_save(vm[!i], &before);
+            ret = lc3vm_run(vm[i], TWO_SLICE);
+            two_save(vm[!i], &after);
+            if (memcmp(&before, &after, sizeof(before))) {
+                printf("FAIL lc3vm_two: running VM %d changed VM %d\n", i, !i);
+                return 1;
+            }
+            if (ret == LC3VM_HALT) {
+                halted[i] = 1;
+            } else if (ret != LC3VM_BUDGET) {
+                printf("FAIL lc3vm_two: VM %d stopped with %d\n", i, ret);
+                return 1;
+            }
+            slices++;
+        }
+    }
+
+    for (i = 0; i < 2; i++) {
+        if (lc3vm_run(ref[i], 1000000) != LC3VM_HALT) {
+            printf("FAIL lc3vm_two: reference VM %d did not halt\n", i);
+            return 1;
+        }
+        two_save(vm[i], &st[i]);
+        two_save(ref[i], &rst[i]);
+        if (memcmp(&st[i], &rst[i], sizeof(st[i])) ||
+                st[i].mem[12] != (uint16_t)(val[i] * n[i]) || st[i].reg[R_R3] != n[i]) {
+            printf("FAIL lc3vm_two: VM %d: sum %u count %u icount %llu, expected sum %u count %u icount %llu\n",
+                    i, st[i].mem[12], st[i].reg[R_R3], (unsigned long long)st[i].icount,
+                    (uint16_t)(val[i] * n[i]), n[i], (unsigned long long)rst[i].icount);
+            return 1;
+        }
+    }
+
+    for (i = 0; i < 2; i++) {
+        lc3vm_destroy(vm[i]);
+        lc3vm_destroy(ref[i]);
+    }
+    printf("PASS lc3vm_two: %d slices, sums %u and %u\n", slices, st[0].mem[12], st[1].mem[12]);
+    return 0;
+}
@@ -0,0 +1,123 @@
+// 按顺序向 lc3-vmm --gdb 的 Unix socket 发送 RSP 包, 每行打印一个包和它的回复.
+//   rsp /tmp/lc3.sock '?' g m3000,4 Z0,3005,2 c k
+// k 包之后 VMM 直接退出, 没有回复.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define RSP_PACKET_MAX 4096
+
+static int rsp_fd = -1;
+
+static int rsp_connect(const char *path)
+{
+    struct sockaddr_un addr;
+    int i;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path))
+        return -1;
+    strcpy(addr.sun_path, path);
+
+    // VMM 可能还没开始监听, 最多等 5 秒
+    for (i = 0; i < 250; i++) {
+        rsp_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (rsp_fd < 0)
+            return -1;
+        if (connect(rsp_fd, (struct sockaddr *)&addr, sizeof(addr)) == 0)
+            return 0;
+        close(rsp_fd);
+        rsp_fd = -1;
+        usleep(20000);
+    }
+    return -1;
+}
+
+static int rsp_getc()
+{
+    unsigned char c;
+
+    if (read(rsp_fd, &c, 1) != 1)
+        return -1;
+    return c;
+}
+
+static int rsp_send(const char *data)
+{
+    char buf[RSP_PACKET_MAX + 5];
+    unsigned char sum = 0;
+    size_t i, len = strlen(data);
+
+    if (len > RSP_PACKET_MAX)
+        return -1;
+    for (i = 0; i < len; i++)
+        sum += (unsigned char)data[i];
+    snprintf(buf, sizeof(buf), "$%s#%02x", data, sum);
+    if (write(rsp_fd, buf, len + 4) != (ssize_t)(len + 4))
+        return -1;
+    return rsp_getc() == '+' ? 0 : -1;
+}
+
+// 读一个回复包, 校验和正确时应答 '+'
+static int rsp_recv(char *buf)
+{
+    unsigned char sum = 0;
+    char ck[3];
+    int c, d, len = 0;
+
+    while ((c = rsp_getc()) != '$') {
+        if (c < 0)
+            return -1;
+    }
+    while ((c = rsp_getc()) >= 0 && c != '#') {
+        if (len < RSP_PACKET_MAX - 1)
+            buf[len++] = c;
+        sum += c;
+    }
+    buf[len] = '\0';
+    if (c < 0 || (c = rsp_getc()) < 0 || (d = rsp_getc()) < 0)
+        return -1;
+    ck[0] = c;
+    ck[1] = d;
+    ck[2] = '\0';
+    if (strtoul(ck, NULL, 16) != sum)
+        return -1;
+    return write(rsp_fd, "+", 1) == 1 ? len : -1;
+}
+
+int main(int argc, char *argv[])
+{
+    char reply[RSP_PACKET_MAX];
+    int i;
+
+    if (argc < 3) {
+        printf("usage: %s <socket> <packet> ...\n", argv[0]);
+        return 2;
+    }
+    if (rsp_connect(argv[1]) < 0) {
+        printf("failed to connect to %s\n", argv[1]);
+        return 1;
+    }
+
+    for (i = 2; i < argc; i++) {
+        if (rsp_send(argv[i]) < 0) {
+            printf("%s: no ack\n", argv[i]);
+            return 1;
+        }
+        if (!strcmp(argv[i], "k")) {
+            printf("%s\n", argv[i]);
+            break;
+        }
+        if (rsp_recv(reply) < 0) {
+            printf("%s: bad reply\n", argv[i]);
+            return 1;
+        }
+        printf("%s -> %s\n", argv[i], reply);
+    }
+    close(rsp_fd);
+    return 0;
+}
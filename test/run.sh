@@ -0,0 +1,291 @@
+#!/usr/bin/env bash
+#
+# 并行编译并运行 lc3-vm 下的所有客户机程序, 与 test/golden 中的期望输出比较.
+#
+#   test/run.sh                    运行全部测试 (test/golden 中每个 .out 对应一个测试)
+#   test/run.sh test_sort          只运行指定测试
+#   test/run.sh --update [name]    用当前输出更新期望文件, 也用于添加新测试
+#   test/run.sh --aot [name]       用 lc3-aot 翻译成本地程序后运行, 与同一份期望输出比较
+#   test/run.sh --link [name]      用 lc3-asm 汇编链接 (删除未引用的代码), 代替 lcc/lc3as
+#   test/run.sh --opt [name]       同 --link, 并打开 lc3-asm -O 窥孔优化
+#   test/run.sh --migrate [name]   执行到 MIGRATE_AT 条指令时热迁移到另一个 lc3-vmm,
+#                                  两个进程的输出拼接后与期望输出比较
+#   test/run.sh --vhost [name]     带 .disk 的测试经 --vhost-backend 进程运行, 客户机输出, 设备日志
+#                                  和运行后的磁盘镜像都要与进程内 virtio 设备的运行结果相同
+#
+# test/golden/<name>.in 为标准输入, <name>.args 为额外的命令行参数 (如 --banks 16),
+# <name>.disk 为 virtio 块设备的镜像, 复制一份后以 --disk 传入, 测试不会改动原文件.
+#
+# 环境变量:
+#   JOBS         并行数, 默认 CPU 核数
+#   LC3_CACHE    .obj 缓存目录, 以预处理后的源文件和 lc3lib 的哈希为键, 默认 test/.cache
+#   LCC_PATH     lcc 工具链目录
+#   TEST_TIMEOUT 单个测试的超时时间 (秒)
+#   MIGRATE_AT   --migrate 时开始迁移的指令数, 默认 1000
+
+cd $(dirname $0)/..
+
+ROOT=$(pwd)
+GUEST_DIR=${ROOT}/lc3-vm
+GOLDEN_DIR=${ROOT}/test/golden
+VMM=${ROOT}/lc3-vmm/lc3-vmm
+AOT=${ROOT}/lc3-aot/lc3-aot
+ASM=${ROOT}/lc3-asm/lc3-asm
+
+LCC_PATH=${LCC_PATH:-/usr/local/bin/lcc-1.3/install}
+LC3LIB_DIR=$(dirname ${LCC_PATH})/lc3lib
+LC3_CACHE=${LC3_CACHE:-${ROOT}/test/.cache}
+JOBS=${JOBS:-$(nproc)}
+TEST_TIMEOUT=${TEST_TIMEOUT:-20}
+MIGRATE_AT=${MIGRATE_AT:-1000}
+
+export ROOT GUEST_DIR GOLDEN_DIR VMM AOT ASM LCC_PATH LC3LIB_DIR LC3_CACHE TEST_TIMEOUT MIGRATE_AT
+
+now_ms()
+{
+    echo $(( $(date +%s%N) / 1000000 ))
+}
+
+# 编译 (或从缓存取出) 一个客户机程序, 输出 .obj 路径
+build_one()
+{
+    local src=$1 out=$2 link=$3
+    local key obj tmp inc=-I$(dirname "$src")
+
+    # C 源文件按预处理后的内容哈希, 被包含的本地头文件变化时缓存也失效;
+    # 工具链库也参与哈希, lc3lib 变化时缓存自动失效; lc3-asm 链接的结果单独缓存
+    key=$( (case "$src" in
+                *.c) PATH=${LCC_PATH}:$PATH lcc -E -w $inc "$src" || echo "cpp failed $$" ;;
+                *)   cat "$src" ;;
+            esac
+            cat ${LC3LIB_DIR}/*.asm ${LC3LIB_DIR}/*.h 2>/dev/null;
+            [ "$link" = "1" ] && cat ${ASM} && echo ${ASM_FLAGS}) 2>/dev/null | sha256sum | cut -c1-32)
+    obj=${LC3_CACHE}/${key}.obj
+
+    if [ -f "$obj" ]; then
+        echo "cached" > "$out.how"
+    else
+        tmp=$(mktemp -d)
+        cp "$src" "$tmp/"
+        (
+            cd "$tmp"
+            export PATH=${LCC_PATH}:$PATH
+            if [ "$link" = "1" ]; then
+                ${ASM} ${ASM_FLAGS} $inc $(basename "$src") -o guest.obj
+            else
+                case "$src" in
+                    *.asm) lc3as $(basename "$src") ;;
+                    *.c)   lcc -w $inc $(basename "$src") -o guest.obj ;;
+                esac
+            fi
+        ) > "$out.build" 2>&1
+
+        local built=$(ls "$tmp"/*.obj 2>/dev/null | head -1)
+        if [ -z "$built" ]; then
+            rm -rf "$tmp"
+            return 1
+        fi
+        mkdir -p ${LC3_CACHE}
+        # 先写临时文件再改名, 并行测试共享缓存时不会读到半个文件
+        cp "$built" "$obj.$$" && mv "$obj.$$" "$obj"
+        rm -rf "$tmp"
+        echo "built" > "$out.how"
+    fi
+
+    echo "$obj"
+}
+
+run_one()
+{
+    local name=$1 update=$2 aot=$3 link=$4 migrate=$5 vhost=$6
+    local src work obj input args t0 t1 t2 status dst backend
+    local run=${VMM} expect=${GOLDEN_DIR}/${name}.out
+
+    src=$(ls ${GUEST_DIR}/${name}.c ${GUEST_DIR}/${name}.asm 2>/dev/null | head -1)
+    if [ -z "$src" ]; then
+        printf "FAIL %-16s no source in %s\n" "$name" ${GUEST_DIR}
+        return 1
+    fi
+    work=$(mktemp -d)
+
+    t0=$(now_ms)
+    obj=$(build_one "$src" "$work/out" "$link")
+
+    if [ -z "$obj" ]; then
+        printf "FAIL %-16s build error\n" "$name"
+        sed 's/^/    /' "$work/out.build"
+        rm -rf "$work"
+        return 1
+    fi
+
+    if [ "$aot" = "1" ]; then
+        if ! ${AOT} "$obj" -o "$work/native" > "$work/out.build" 2>&1; then
+            printf "FAIL %-16s aot translate error\n" "$name"
+            sed 's/^/    /' "$work/out.build"
+            rm -rf "$work"
+            return 1
+        fi
+        run="$work/native"
+        obj=
+    fi
+    t1=$(now_ms)
+
+    input=/dev/null
+    [ -f ${GOLDEN_DIR}/${name}.in ] && input=${GOLDEN_DIR}/${name}.in
+    args=
+    [ -f ${GOLDEN_DIR}/${name}.args ] && args=$(cat ${GOLDEN_DIR}/${name}.args)
+    if [ "$vhost" = "1" ] && [ ! -f ${GOLDEN_DIR}/${name}.disk ]; then
+        printf "SKIP %-16s no virtio disk\n" "$name"
+        rm -rf "$work"
+        return 0
+    fi
+    if [ -f ${GOLDEN_DIR}/${name}.disk ]; then
+        cp ${GOLDEN_DIR}/${name}.disk "$work/disk"
+        [ "$vhost" = "1" ] || args="$args --disk disk"
+    fi
+
+    if [ "$migrate" = "1" ]; then
+        case "$args" in
+            *--smp*|*--banks*|*--chan*)
+                printf "SKIP %-16s %s not supported with --migrate\n" "$name" "$args"
+                rm -rf "$work"
+                return 0 ;;
+        esac
+        # 源端已经读进缓冲区的标准输入不会随客户机迁移
+        if [ "$input" != /dev/null ]; then
+            printf "SKIP %-16s stdin not supported with --migrate\n" "$name"
+            rm -rf "$work"
+            return 0
+        fi
+    fi
+
+    # 在临时目录中运行, 参数中的相对路径 (如 --disk disk) 不会出现在输出里
+    if [ "$migrate" = "1" ]; then
+        # 目的端先监听, 源端的输出在前, 目的端接着输出
+        (cd "$work" && exec timeout ${TEST_TIMEOUT} ${run} $args --migrate-from migrate.sock > "$work/dst" 2>&1) &
+        dst=$!
+        for i in $(seq 100); do
+            [ -S "$work/migrate.sock" ] && break
+            sleep 0.02
+        done
+        (cd "$work" && timeout ${TEST_TIMEOUT} ${run} $args --migrate-to migrate.sock --migrate-at ${MIGRATE_AT} \
+            $obj < $input > "$work/actual" 2>&1)
+        status=$?
+        # 客户机在开始迁移前就停机了, 目的端还在等待连接 (连接后 socket 文件即删除)
+        if [ -S "$work/migrate.sock" ]; then
+            kill $dst
+            wait $dst
+        else
+            wait $dst
+            dst=$?
+            [ $status -eq 0 ] && status=$dst
+        fi
+        # 目的端重新打开磁盘时的提示不算客户机输出
+        grep -v '^>>> disk: ' "$work/dst" >> "$work/actual"
+    elif [ "$vhost" = "1" ]; then
+        # 参考结果: 同一个磁盘镜像用进程内的设备运行一遍
+        mkdir "$work/ref"
+        cp "$work/disk" "$work/ref/disk"
+        (cd "$work/ref" && timeout ${TEST_TIMEOUT} ${run} $args --disk disk $obj < $input > "$work/ref/out" 2>&1)
+        ref=$?
+        (cd "$work" && exec timeout ${TEST_TIMEOUT} ${run} --vhost-backend vhost.sock --disk disk > "$work/backend" 2>&1) &
+        backend=$!
+        for i in $(seq 100); do
+            [ -S "$work/vhost.sock" ] && break
+            sleep 0.02
+        done
+        (cd "$work" && timeout ${TEST_TIMEOUT} ${run} $args --vhost vhost.sock $obj < $input > "$work/out" 2>&1)
+        status=$?
+        [ $status -eq 0 ] && status=$ref
+        # 后端在前端断开后才把脏页写回磁盘
+        for i in $(seq 100); do
+            grep -q '^>>> vhost frontend disconnected' "$work/backend" && break
+            sleep 0.02
+        done
+        kill $backend 2>/dev/null
+        wait $backend 2>/dev/null
+
+        # 设备日志由后端打印, 其余输出由 VMM 打印; 两边分开比较
+        local dev='^>>> \(virtio handler\|read pos\|write pos\|disk read error\|disk write error\)'
+        local host='^>>> \(disk: \|vhost\)'
+        { grep -v "$dev" "$work/ref/out" | grep -v "$host"; echo "--- device"; grep "$dev" "$work/ref/out";
+          echo "--- disk"; sha256sum < "$work/ref/disk"; } > "$work/expect"
+        { grep -v "$dev" "$work/out" | grep -v "$host"; echo "--- device"; grep "$dev" "$work/backend";
+          echo "--- disk"; sha256sum < "$work/disk"; } > "$work/actual"
+        expect="$work/expect"
+        update=0
+    else
+        (cd "$work" && timeout ${TEST_TIMEOUT} ${run} $args $obj < $input > "$work/actual" 2>&1)
+        status=$?
+    fi
+    t2=$(now_ms)
+
+    if [ "$update" = "1" ]; then
+        cp "$work/actual" ${GOLDEN_DIR}/${name}.out
+        printf "UPDT %-16s compile %5dms (%s)  run %5dms\n" "$name" $((t1 - t0)) $(cat "$work/out.how") $((t2 - t1))
+    elif [ $status -eq 124 ]; then
+        printf "FAIL %-16s timeout after %ss\n" "$name" ${TEST_TIMEOUT}
+    elif [ $status -ne 0 ]; then
+        # 输出正确但 VMM 异常退出也算失败
+        printf "FAIL %-16s exit status %d\n" "$name" $status
+        tail -5 "$work/actual" | sed 's/^/    /'
+    elif cmp -s "$work/actual" "$expect"; then
+        printf "PASS %-16s compile %5dms (%s)  run %5dms\n" "$name" $((t1 - t0)) $(cat "$work/out.how") $((t2 - t1))
+    else
+        printf "FAIL %-16s output differs\n" "$name"
+        diff "$expect" "$work/actual" | head -20 | sed 's/^/    /'
+    fi
+
+    rm -rf "$work"
+}
+
+export -f now_ms build_one run_one
+
+UPDATE=0
+AOT_MODE=0
+LINK_MODE=0
+MIGRATE_MODE=0
+VHOST_MODE=0
+ASM_FLAGS=
+TESTS=()
+for arg in "$@"; do
+    case "$arg" in
+        --update) UPDATE=1 ;;
+        --aot) AOT_MODE=1 ;;
+        --link) LINK_MODE=1 ;;
+        --opt) LINK_MODE=1; ASM_FLAGS=-O ;;
+        --migrate) MIGRATE_MODE=1 ;;
+        --vhost) VHOST_MODE=1 ;;
+        *) TESTS+=("$arg") ;;
+    esac
+done
+
+export ASM_FLAGS
+
+if [ ${#TESTS[@]} -eq 0 ]; then
+    for f in ${GOLDEN_DIR}/*.out; do
+        [ -f "$f" ] || continue
+        name=$(basename "$f")
+        TESTS+=("${name%.out}")
+    done
+fi
+
+if [ ! -x ${VMM} ]; then
+    echo "missing ${VMM}, run make first"
+    exit 2
+fi
+
+mkdir -p ${GOLDEN_DIR}
+
+START=$(now_ms)
+RESULTS=$(printf "%s\n" "${TESTS[@]}" | xargs -P ${JOBS} -I{} bash -c "run_one {} ${UPDATE} ${AOT_MODE} ${LINK_MODE} ${MIGRATE_MODE} ${VHOST_MODE}")
+END=$(now_ms)
+
+echo "$RESULTS"
+
+PASSED=$(echo "$RESULTS" | grep -c "^PASS")
+FAILED=$(echo "$RESULTS" | grep -c "^FAIL")
+SKIPPED=$(echo "$RESULTS" | grep -c "^SKIP")
+echo "${#TESTS[@]} tests, ${PASSED} passed, ${FAILED} failed, ${SKIPPED} skipped in $((END - START))ms (${JOBS} jobs)"
+
+[ ${FAILED} -eq 0 ]